@@ -559,6 +559,140 @@ gsl_bspline_deriv_eval_nonzero (const double x, const size_t nderiv,
     }
 } /* gsl_bspline_deriv_eval_nonzero() */
 
+/*
+bspline_calc()
+  Evaluate the spline sum_i c_i B_i(x) at x. The knot interval
+is taken from *left if x lies in it or in the next interval,
+otherwise it is located by bspline_find_interval(). On output
+*left holds the interval used, so that a sweep over increasing
+x needs O(1) operations per point to find the intervals.
+
+Inputs: x      - point for evaluation
+        c      - spline coefficients (length n)
+        left   - (input/output) knot interval of the previous point,
+                 or 0 if none
+        result - (output) spline value
+        w      - bspline workspace
+
+Return: success or error
+*/
+
+static int
+bspline_calc (const double x, const gsl_vector * c, size_t * left,
+              double *result, gsl_bspline_workspace * w)
+{
+  const double *t = w->knots->data;
+  const size_t stride = w->knots->stride;
+  const size_t ilast = w->k + w->l - 2; /* last interval */
+  size_t i = *left;
+  size_t j;
+  double sum = 0.0;
+
+  if (i >= w->k - 1 && i < ilast && x >= t[(i + 1) * stride]
+      && x < t[(i + 2) * stride])
+    {
+      i++;
+    }
+  else if (!(i >= w->k - 1 && i <= ilast && x >= t[i * stride]
+             && x < t[(i + 1) * stride]))
+    {
+      int flag = 0;
+      int error;
+
+      i = bspline_find_interval (x, &flag, w);
+      error = bspline_process_interval_for_eval (x, &i, flag, w);
+      if (error)
+        return error;
+    }
+
+  bspline_pppack_bsplvb (w->knots, w->k, 1, x, i, &j, w->deltal,
+                         w->deltar, w->B);
+
+  for (j = 0; j < w->k; j++)
+    sum += gsl_vector_get (c, i - w->k + 1 + j) * gsl_vector_get (w->B, j);
+
+  *left = i;
+  *result = sum;
+
+  return GSL_SUCCESS;
+} /* bspline_calc() */
+
+/*
+gsl_bspline_calc()
+  Evaluate the spline s(x) = sum_i c_i B_i(x) at the point x.
+
+Inputs: x      - point for evaluation
+        c      - spline coefficients (length n)
+        result - (output) s(x)
+        w      - bspline workspace
+
+Return: success or error
+*/
+
+int
+gsl_bspline_calc (const double x, const gsl_vector * c, double *result,
+                  gsl_bspline_workspace * w)
+{
+  if (c->size != w->n)
+    {
+      GSL_ERROR ("coefficient vector c not of length n", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t left = 0;
+
+      return bspline_calc (x, c, &left, result, w);
+    }
+} /* gsl_bspline_calc() */
+
+/*
+gsl_bspline_calc_array()
+  Evaluate the spline s(x) = sum_i c_i B_i(x) at each of the
+points x_j. Only the k non-zero basis functions are computed for
+each point. When the points are in increasing order the knot
+intervals are found by a sweep through the knots, so that the cost
+is O(k^2) per point independent of the number of breakpoints.
+
+Inputs: x - points for evaluation
+        c - spline coefficients (length n)
+        y - (output) s(x_j)
+        w - bspline workspace
+
+Return: success or error
+*/
+
+int
+gsl_bspline_calc_array (const gsl_vector * x, const gsl_vector * c,
+                        gsl_vector * y, gsl_bspline_workspace * w)
+{
+  if (c->size != w->n)
+    {
+      GSL_ERROR ("coefficient vector c not of length n", GSL_EBADLEN);
+    }
+  else if (y->size != x->size)
+    {
+      GSL_ERROR ("x and y vectors have different lengths", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t left = 0;
+      size_t j;
+
+      for (j = 0; j < x->size; j++)
+        {
+          double yj;
+          int error = bspline_calc (gsl_vector_get (x, j), c, &left, &yj, w);
+
+          if (error)
+            return error;
+
+          gsl_vector_set (y, j, yj);
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_bspline_calc_array() */
+
 /****************************************
  *          INTERNAL ROUTINES           *
  ****************************************/
@@ -574,7 +708,10 @@ Inputs: x    - x value
 
 Return: i (index in w->knots corresponding to left limit of interval)
 
-Notes: The error conditions are reported as follows:
+Notes: 1) The interval is located by a binary search over the
+          breakpoints, in O(log l) operations.
+
+       2) The error conditions are reported as follows:
 
        Condition                        Return value        Flag
        ---------                        ------------        ----
@@ -587,39 +724,40 @@ Notes: The error conditions are reported as follows:
 static inline size_t
 bspline_find_interval (const double x, int *flag, gsl_bspline_workspace * w)
 {
-  size_t i;
+  const double *t = w->knots->data;
+  const size_t stride = w->knots->stride;
+  size_t ilo = w->k - 1;
+  size_t ihi = w->k + w->l - 1;
 
-  if (x < gsl_vector_get (w->knots, 0))
+  if (x < t[0])
     {
       *flag = -1;
       return 0;
     }
 
-  /* find i such that t_i <= x < t_{i+1} */
-  for (i = w->k - 1; i < w->k + w->l - 1; i++)
+  if (x > t[ihi * stride])
     {
-      const double ti = gsl_vector_get (w->knots, i);
-      const double tip1 = gsl_vector_get (w->knots, i + 1);
-
-      if (tip1 < ti)
-	{
-	  GSL_ERROR ("knots vector is not increasing", GSL_EINVAL);
-	}
+      *flag = 1;
+      return ihi;
+    }
 
-      if (ti <= x && x < tip1)
-	break;
+  /*
+   * binary search for the largest i < k + l - 1 with t_i <= x, so
+   * that t_i <= x < t_{i+1}, or t_i < x = t_{i+1} at the right end
+   */
+  while (ihi > ilo + 1)
+    {
+      const size_t imid = (ilo + ihi) / 2;
 
-      if (ti < x && x == tip1 && tip1 == gsl_vector_get (w->knots, w->k + w->l
-							 - 1))
-	break;
+      if (x < t[imid * stride])
+        ihi = imid;
+      else
+        ilo = imid;
     }
 
-  if (i == w->k + w->l - 1)
-    *flag = 1;
-  else
-    *flag = 0;
+  *flag = 0;
 
-  return i;
+  return ilo;
 }				/* bspline_find_interval() */
 
 /*
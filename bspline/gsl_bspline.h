@@ -103,6 +103,25 @@ gsl_bspline_deriv_eval_nonzero(const double x,
                                size_t *iend,
                                gsl_bspline_workspace *w);
 
+int
+gsl_bspline_calc(const double x, const gsl_vector *c, double *result,
+                 gsl_bspline_workspace *w);
+
+int
+gsl_bspline_calc_array(const gsl_vector *x, const gsl_vector *c,
+                       gsl_vector *y, gsl_bspline_workspace *w);
+
+int
+gsl_bspline_lsfit(const gsl_vector *x, const gsl_vector *y,
+                  const gsl_vector *wts, gsl_vector *c, double *chisq,
+                  gsl_bspline_workspace *w);
+
+int
+gsl_bspline_plsfit(const gsl_vector *x, const gsl_vector *y,
+                   const gsl_vector *wts, const double lambda,
+                   const size_t order, gsl_vector *c, double *chisq,
+                   gsl_bspline_workspace *w);
+
 __END_DECLS
 
 #endif /* __GSL_BSPLINE_H__ */
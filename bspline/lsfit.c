@@ -0,0 +1,360 @@
+/* bspline/lsfit.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_bspline.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+
+/*
+ * Least squares fitting of a spline s(x) = sum_j c_j B_j(x) to data
+ * (x_i, y_i). At each x_i only the k basis functions B_j with
+ * istart <= j <= istart + k - 1 are non-zero, so the normal equations
+ *
+ *   (B^T W B + lambda D_d^T D_d) c = B^T W y
+ *
+ * form a symmetric banded matrix with k - 1 sub-diagonals (d for the
+ * penalty term, if larger). The matrix is accumulated one data point
+ * at a time in O(k^2) operations and solved by a banded Cholesky
+ * factorization in O(n k^2) operations, so that neither the n-by-p
+ * design matrix nor a dense p-by-p matrix is formed. The storage is
+ * O(p k) for p coefficients.
+ *
+ * The lower band is stored by columns, A(j+m,j) = AB[j*(kd+1) + m]
+ * for 0 <= m <= kd.
+ *
+ * The penalty lambda ||D_d c||^2, with D_d the d-th order difference
+ * matrix, gives the P-splines of
+ *
+ * P.H.C. Eilers and B.D. Marx, "Flexible smoothing with B-splines and
+ * penalties", Statistical Science 11 (1996), 89-121.
+ */
+
+static int bspline_lsfit (const gsl_vector * x, const gsl_vector * y,
+                          const gsl_vector * wts, const double lambda,
+                          const size_t order, gsl_vector * c,
+                          double *chisq, gsl_bspline_workspace * w);
+static int bspline_band_cholesky (double *AB, const size_t n,
+                                  const size_t kd);
+static void bspline_band_solve (const double *AB, const size_t n,
+                                const size_t kd, double *b);
+
+/*
+gsl_bspline_lsfit()
+  Compute the coefficients of the spline which minimizes
+
+    chisq = sum_i w_i (y_i - sum_j c_j B_j(x_i))^2
+
+Inputs: x     - data abscissae, within the knot interval
+        y     - data values
+        wts   - weights w_i, or NULL for unit weights
+        c     - (output) spline coefficients (length n)
+        chisq - (output) weighted residual sum of squares
+        w     - bspline workspace, with knots initialized
+
+Return: success or error
+*/
+
+int
+gsl_bspline_lsfit (const gsl_vector * x, const gsl_vector * y,
+                   const gsl_vector * wts, gsl_vector * c, double *chisq,
+                   gsl_bspline_workspace * w)
+{
+  return bspline_lsfit (x, y, wts, 0.0, 0, c, chisq, w);
+} /* gsl_bspline_lsfit() */
+
+/*
+gsl_bspline_plsfit()
+  Compute the coefficients of the penalized spline (P-spline)
+which minimizes
+
+    sum_i w_i (y_i - sum_j c_j B_j(x_i))^2 + lambda ||D_d c||^2
+
+where D_d is the difference operator of order d acting on the
+coefficients.
+
+Inputs: x      - data abscissae, within the knot interval
+        y      - data values
+        wts    - weights w_i, or NULL for unit weights
+        lambda - smoothing parameter, lambda >= 0
+        order  - order d of the difference penalty, d < n
+        c      - (output) spline coefficients (length n)
+        chisq  - (output) weighted residual sum of squares, not
+                 including the penalty term
+        w      - bspline workspace, with knots initialized
+
+Return: success or error
+*/
+
+int
+gsl_bspline_plsfit (const gsl_vector * x, const gsl_vector * y,
+                    const gsl_vector * wts, const double lambda,
+                    const size_t order, gsl_vector * c, double *chisq,
+                    gsl_bspline_workspace * w)
+{
+  if (lambda < 0.0)
+    {
+      GSL_ERROR ("lambda must be non-negative", GSL_EINVAL);
+    }
+  else if (order >= w->n)
+    {
+      GSL_ERROR ("penalty order must be less than number of coefficients",
+                 GSL_EINVAL);
+    }
+  else
+    {
+      return bspline_lsfit (x, y, wts, lambda, order, c, chisq, w);
+    }
+} /* gsl_bspline_plsfit() */
+
+static int
+bspline_lsfit (const gsl_vector * x, const gsl_vector * y,
+               const gsl_vector * wts, const double lambda,
+               const size_t order, gsl_vector * c, double *chisq,
+               gsl_bspline_workspace * w)
+{
+  const size_t n = w->n;
+  const size_t k = w->k;
+  const size_t kd = (order > k - 1) ? order : k - 1;
+
+  if (y->size != x->size)
+    {
+      GSL_ERROR ("x and y vectors have different lengths", GSL_EBADLEN);
+    }
+  else if (wts != NULL && wts->size != x->size)
+    {
+      GSL_ERROR ("weight vector must match data length", GSL_EBADLEN);
+    }
+  else if (c->size != n)
+    {
+      GSL_ERROR ("coefficient vector c not of length n", GSL_EBADLEN);
+    }
+  else
+    {
+      double *AB, *rhs;
+      size_t i, j, a, b;
+      size_t istart, iend;
+      double r2 = 0.0;
+      int status;
+
+      AB = calloc (n * (kd + 1), sizeof (double));
+      rhs = calloc (n, sizeof (double));
+
+      if (AB == 0 || rhs == 0)
+        {
+          free (AB);
+          free (rhs);
+          GSL_ERROR ("failed to allocate space for normal equations",
+                     GSL_ENOMEM);
+        }
+
+      /* accumulate B^T W B and B^T W y */
+
+      for (i = 0; i < x->size; i++)
+        {
+          const double wi = (wts != NULL) ? gsl_vector_get (wts, i) : 1.0;
+          const double yi = gsl_vector_get (y, i);
+          const double *Bk = w->B->data;
+          const size_t stride = w->B->stride;
+
+          status = gsl_bspline_eval_nonzero (gsl_vector_get (x, i), w->B,
+                                             &istart, &iend, w);
+          if (status)
+            {
+              free (AB);
+              free (rhs);
+              return status;
+            }
+
+          for (a = 0; a < k; a++)
+            {
+              const double wba = wi * Bk[a * stride];
+              double *col = AB + (istart + a) * (kd + 1);
+
+              for (b = a; b < k; b++)
+                col[b - a] += wba * Bk[b * stride];
+
+              rhs[istart + a] += wba * yi;
+            }
+        }
+
+      /* add lambda D_d^T D_d, row r of D_d having the entries
+         (-1)^(d-m) binomial(d,m) in columns r+m, 0 <= m <= d */
+
+      if (lambda > 0.0)
+        {
+          double *dd = malloc ((order + 1) * sizeof (double));
+
+          if (dd == 0)
+            {
+              free (AB);
+              free (rhs);
+              GSL_ERROR ("failed to allocate space for penalty", GSL_ENOMEM);
+            }
+
+          dd[0] = 1.0;
+          for (j = 1; j <= order; j++)
+            {
+              dd[j] = 0.0;
+              for (a = j; a > 0; a--)
+                dd[a] = dd[a - 1] - dd[a];
+              dd[0] = -dd[0];
+            }
+
+          for (j = 0; j + order < n; j++)
+            {
+              for (a = 0; a <= order; a++)
+                {
+                  double *col = AB + (j + a) * (kd + 1);
+
+                  for (b = a; b <= order; b++)
+                    col[b - a] += lambda * dd[a] * dd[b];
+                }
+            }
+
+          free (dd);
+        }
+
+      status = bspline_band_cholesky (AB, n, kd);
+      if (status)
+        {
+          free (AB);
+          free (rhs);
+          GSL_ERROR ("normal equations are not positive definite, "
+                     "knot intervals may lack data", GSL_EDOM);
+        }
+
+      bspline_band_solve (AB, n, kd, rhs);
+
+      for (j = 0; j < n; j++)
+        gsl_vector_set (c, j, rhs[j]);
+
+      free (AB);
+      free (rhs);
+
+      /* residual sum of squares */
+
+      if (chisq != NULL)
+        {
+          for (i = 0; i < x->size; i++)
+            {
+              const double wi = (wts != NULL) ? gsl_vector_get (wts, i) : 1.0;
+              double si, ri;
+
+              status = gsl_bspline_calc (gsl_vector_get (x, i), c, &si, w);
+              if (status)
+                return status;
+
+              ri = gsl_vector_get (y, i) - si;
+              r2 += wi * ri * ri;
+            }
+
+          *chisq = r2;
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* bspline_lsfit() */
+
+/*
+bspline_band_cholesky()
+  Cholesky factorization A = L L^T of a symmetric positive definite
+banded matrix with kd sub-diagonals, in place in the lower band
+storage AB.
+
+Return: success, or GSL_EDOM if A is not positive definite
+*/
+
+static int
+bspline_band_cholesky (double *AB, const size_t n, const size_t kd)
+{
+  const size_t ld = kd + 1;
+  size_t i, j, m;
+
+  for (j = 0; j < n; j++)
+    {
+      const size_t m0 = (j > kd) ? j - kd : 0;
+      const size_t iend = (j + kd < n - 1) ? j + kd : n - 1;
+      double *colj = AB + j * ld;
+      double ajj = colj[0];
+
+      for (m = m0; m < j; m++)
+        {
+          const double ljm = AB[m * ld + (j - m)];
+          ajj -= ljm * ljm;
+        }
+
+      if (ajj <= 0.0)
+        return GSL_EDOM;
+
+      ajj = sqrt (ajj);
+      colj[0] = ajj;
+
+      for (i = j + 1; i <= iend; i++)
+        {
+          const size_t mi = (i > kd) ? i - kd : 0;
+          double aij = colj[i - j];
+
+          for (m = mi; m < j; m++)
+            aij -= AB[m * ld + (i - m)] * AB[m * ld + (j - m)];
+
+          colj[i - j] = aij / ajj;
+        }
+    }
+
+  return GSL_SUCCESS;
+} /* bspline_band_cholesky() */
+
+/*
+bspline_band_solve()
+  Solve L L^T x = b in place, with L from bspline_band_cholesky()
+*/
+
+static void
+bspline_band_solve (const double *AB, const size_t n, const size_t kd,
+                    double *b)
+{
+  const size_t ld = kd + 1;
+  size_t i, j, m;
+
+  /* L z = b */
+  for (i = 0; i < n; i++)
+    {
+      const size_t m0 = (i > kd) ? i - kd : 0;
+      double bi = b[i];
+
+      for (m = m0; m < i; m++)
+        bi -= AB[m * ld + (i - m)] * b[m];
+
+      b[i] = bi / AB[i * ld];
+    }
+
+  /* L^T x = z */
+  for (j = n; j-- > 0;)
+    {
+      const size_t iend = (j + kd < n - 1) ? j + kd : n - 1;
+      const double *colj = AB + j * ld;
+      double bj = b[j];
+
+      for (i = j + 1; i <= iend; i++)
+        bj -= colj[i - j] * b[i];
+
+      b[j] = bj / colj[0];
+    }
+} /* bspline_band_solve() */
@@ -22,6 +22,7 @@
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_bspline.h>
+#include <gsl/gsl_linalg.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_nan.h>
 
@@ -84,6 +85,141 @@ test_bspline(gsl_bspline_workspace * bw)
   gsl_matrix_free(dB);
 }
 
+void
+test_lsfit(gsl_bspline_workspace * bw)
+{
+  size_t order = gsl_bspline_order(bw);
+  size_t nbreak = gsl_bspline_nbreak(bw);
+  size_t ncoeffs = gsl_bspline_ncoeffs(bw);
+  size_t npts = (nbreak - 1) * order + 1;
+  gsl_vector *B = gsl_vector_alloc(ncoeffs);
+  gsl_vector *c = gsl_vector_alloc(ncoeffs);
+  gsl_vector *cfit = gsl_vector_alloc(ncoeffs);
+  gsl_vector *x = gsl_vector_alloc(npts);
+  gsl_vector *xr = gsl_vector_alloc(npts);
+  gsl_vector *y = gsl_vector_alloc(npts);
+  gsl_vector *yr = gsl_vector_alloc(npts);
+  gsl_vector *s = gsl_vector_alloc(npts);
+  gsl_vector *wts = gsl_vector_alloc(npts);
+  double cmax = 0.0, err, chisq;
+  size_t i, j, m;
+
+  for (j = 0; j < ncoeffs; j++)
+    {
+      gsl_vector_set(c, j, cos(0.7 * j) + 0.1 * j);
+      cmax = GSL_MAX(cmax, fabs(gsl_vector_get(c, j)));
+    }
+
+  /* order points in each knot interval, and the right end point */
+  for (i = 0; i + 1 < nbreak; i++)
+    {
+      double t0 = gsl_bspline_breakpoint(i, bw);
+      double t1 = gsl_bspline_breakpoint(i + 1, bw);
+
+      for (m = 0; m < order; m++)
+        gsl_vector_set(x, i * order + m, t0 + (t1 - t0) * (m + 0.5) / order);
+    }
+
+  gsl_vector_set(x, npts - 1, gsl_bspline_breakpoint(nbreak - 1, bw));
+
+  for (i = 0; i < npts; i++)
+    {
+      double yi = 0.0;
+      gsl_bspline_eval(gsl_vector_get(x, i), B, bw);
+      for (j = 0; j < ncoeffs; j++)
+        yi += gsl_vector_get(c, j) * gsl_vector_get(B, j);
+      gsl_vector_set(y, i, yi);
+      gsl_vector_set(wts, i, 1.0 + 0.5 * sin(1.0 * i));
+      gsl_vector_set(xr, npts - 1 - i, gsl_vector_get(x, i));
+    }
+
+  /* batched evaluation, in increasing and decreasing order */
+  gsl_bspline_calc_array(x, c, s, bw);
+  gsl_bspline_calc_array(xr, c, yr, bw);
+
+  err = 0.0;
+  for (i = 0; i < npts; i++)
+    {
+      err = GSL_MAX(err, fabs(gsl_vector_get(s, i) - gsl_vector_get(y, i)));
+      err = GSL_MAX(err, fabs(gsl_vector_get(yr, npts - 1 - i)
+                              - gsl_vector_get(y, i)));
+    }
+
+  gsl_test_abs(err, 0.0, 100 * order * cmax * GSL_DBL_EPSILON,
+               "b-spline order %d nbreak %d calc_array", order, nbreak);
+
+  /* least squares fit recovers the spline */
+  gsl_bspline_lsfit(x, y, wts, cfit, &chisq, bw);
+
+  err = 0.0;
+  for (j = 0; j < ncoeffs; j++)
+    err = GSL_MAX(err, fabs(gsl_vector_get(cfit, j) - gsl_vector_get(c, j)));
+
+  gsl_test_abs(err, 0.0, 1.0e-8 * cmax,
+               "b-spline order %d nbreak %d lsfit coefficients", order, nbreak);
+  gsl_test_abs(chisq, 0.0, 1.0e-14 * npts * cmax * cmax,
+               "b-spline order %d nbreak %d lsfit chisq", order, nbreak);
+
+  /* P-spline fit agrees with the dense penalized normal equations */
+  if (ncoeffs > 2)
+    {
+      const double lambda = 0.5;
+      gsl_matrix *A = gsl_matrix_calloc(ncoeffs, ncoeffs);
+      gsl_vector *rhs = gsl_vector_calloc(ncoeffs);
+      gsl_vector *cdense = gsl_vector_alloc(ncoeffs);
+      double d[3] = { 1.0, -2.0, 1.0 };
+
+      for (i = 0; i < npts; i++)
+        {
+          double wi = gsl_vector_get(wts, i);
+          double yi = gsl_vector_get(y, i) + 0.1 * cos(3.0 * i);
+
+          gsl_vector_set(yr, i, yi);
+          gsl_bspline_eval(gsl_vector_get(x, i), B, bw);
+
+          for (j = 0; j < ncoeffs; j++)
+            {
+              double Bj = gsl_vector_get(B, j);
+              for (m = 0; m < ncoeffs; m++)
+                *gsl_matrix_ptr(A, j, m) += wi * Bj * gsl_vector_get(B, m);
+              *gsl_vector_ptr(rhs, j) += wi * Bj * yi;
+            }
+        }
+
+      for (i = 0; i + 2 < ncoeffs; i++)
+        for (j = 0; j < 3; j++)
+          for (m = 0; m < 3; m++)
+            *gsl_matrix_ptr(A, i + j, i + m) += lambda * d[j] * d[m];
+
+      gsl_linalg_cholesky_decomp(A);
+      gsl_linalg_cholesky_solve(A, rhs, cdense);
+
+      gsl_bspline_plsfit(x, yr, wts, lambda, 2, cfit, &chisq, bw);
+
+      err = 0.0;
+      for (j = 0; j < ncoeffs; j++)
+        err = GSL_MAX(err, fabs(gsl_vector_get(cfit, j)
+                                - gsl_vector_get(cdense, j)));
+
+      gsl_test_abs(err, 0.0, 1.0e-8 * cmax,
+                   "b-spline order %d nbreak %d plsfit", order, nbreak);
+
+      gsl_matrix_free(A);
+      gsl_vector_free(rhs);
+      gsl_vector_free(cdense);
+    }
+
+  gsl_vector_free(B);
+  gsl_vector_free(c);
+  gsl_vector_free(cfit);
+  gsl_vector_free(x);
+  gsl_vector_free(xr);
+  gsl_vector_free(y);
+  gsl_vector_free(yr);
+  gsl_vector_free(s);
+  gsl_vector_free(wts);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -102,6 +238,7 @@ main(int argc, char **argv)
           gsl_bspline_workspace *bw = gsl_bspline_alloc(order, breakpoints);
           gsl_bspline_knots_uniform(a, b, bw);
           test_bspline(bw);
+          test_lsfit(bw);
           gsl_bspline_free(bw);
         }
     }
@@ -123,6 +260,7 @@ main(int argc, char **argv)
             };
           gsl_bspline_knots(k, bw);
           test_bspline(bw);
+          test_lsfit(bw);
           gsl_vector_free(k);
           gsl_bspline_free(bw);
         }
@@ -29,13 +29,16 @@ int gsl_cheb_calc_deriv(gsl_cheb_series * deriv, const gsl_cheb_series * f)
   const double con = 2.0 / (f->b - f->a);
   size_t i;
   
-  if(deriv->order != f->order) 
+  if(deriv->order_max < f->order) 
     {
-      GSL_ERROR ("order of chebyshev series must be equal", GSL_ENOMEM);
+      GSL_ERROR ("order of chebyshev series is too small", GSL_ENOMEM);
     }
   
   /* set the other parameters in the chebyshev struct */
 
+  deriv->order = f->order;
+  deriv->order_sp = f->order;
+
   deriv->a = f->a;
   deriv->b = f->b;
 
@@ -46,6 +46,52 @@ gsl_cheb_eval (const gsl_cheb_series * cs, const double x)
   return y * d1 - d2 + 0.5 * cs->c[0];
 }
 
+/* The points are processed in blocks, running the Clenshaw recurrence
+   for all the points of a block together so that the inner loop over
+   the points has no dependencies and can be vectorized */
+
+#define CHEB_BLOCK 64
+
+int
+gsl_cheb_eval_array (const gsl_cheb_series * cs, const double x[],
+                     double y[], const size_t n)
+{
+  const double *c = cs->c;
+  const double scale = 2.0 / (cs->b - cs->a);
+  const double shift = -(cs->a + cs->b) / (cs->b - cs->a);
+  double d1[CHEB_BLOCK], d2[CHEB_BLOCK], y2[CHEB_BLOCK];
+  size_t j0, i, k;
+
+  for (j0 = 0; j0 < n; j0 += CHEB_BLOCK)
+    {
+      const size_t nb = GSL_MIN (CHEB_BLOCK, n - j0);
+
+      for (k = 0; k < nb; k++)
+        {
+          y2[k] = 2.0 * (scale * x[j0 + k] + shift);
+          d1[k] = 0.0;
+          d2[k] = 0.0;
+        }
+
+      for (i = cs->order; i >= 1; i--)
+        {
+          const double ci = c[i];
+
+          for (k = 0; k < nb; k++)
+            {
+              double temp = d1[k];
+              d1[k] = y2[k] * d1[k] - d2[k] + ci;
+              d2[k] = temp;
+            }
+        }
+
+      for (k = 0; k < nb; k++)
+        y[j0 + k] = 0.5 * y2[k] * d1[k] - d2[k] + 0.5 * c[0];
+    }
+
+  return GSL_SUCCESS;
+}
+
 double
 gsl_cheb_eval_n (const gsl_cheb_series * cs, const size_t n, const double x)
 {
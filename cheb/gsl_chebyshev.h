@@ -60,10 +60,23 @@ struct gsl_cheb_series_struct {
   /* Additional elements not used by specfunc */
 
   double * f;   /* function evaluated at chebyschev points  */
+  size_t order_max; /* order of the allocated storage       */
 };
 typedef struct gsl_cheb_series_struct gsl_cheb_series;
 
 
+/* data for a piecewise Chebyshev series, with one series on
+ * each of the intervals [breakpts[i], breakpts[i+1]]
+ */
+typedef struct
+{
+  size_t npieces;             /* number of pieces in use     */
+  size_t max_pieces;          /* number of pieces allocated  */
+  double * breakpts;          /* breakpoints, npieces + 1    */
+  gsl_cheb_series ** pieces;  /* series on each interval     */
+} gsl_cheb_piecewise;
+
+
 /* Calculate a Chebyshev series of specified order over
  * a specified interval, for a given function.
  * Return 0 on failure.
@@ -82,6 +95,13 @@ void gsl_cheb_free(gsl_cheb_series * cs);
 int gsl_cheb_init(gsl_cheb_series * cs, const gsl_function * func,
                   const double a, const double b);
 
+/* Calculate a Chebyshev series, choosing the order adaptively
+ * up to the order with which it was created, so that the
+ * trailing coefficients are less than tol times the largest.
+ */
+int gsl_cheb_init_adaptive(gsl_cheb_series * cs, const gsl_function * func,
+                           const double a, const double b, const double tol);
+
 /* Return the order, size of coefficient array and coefficient array ptr */
 size_t gsl_cheb_order (const gsl_cheb_series * cs);
 size_t gsl_cheb_size (const gsl_cheb_series * cs);
@@ -95,6 +115,12 @@ int gsl_cheb_eval_err(const gsl_cheb_series * cs, const double x,
                       double * result, double * abserr);
 
 
+/* Evaluate a Chebyshev series at each of n points x[i].
+ */
+int gsl_cheb_eval_array(const gsl_cheb_series * cs, const double x[],
+                        double y[], const size_t n);
+
+
 /* Evaluate a Chebyshev series at a given point, to (at most) the given order.
  * No errors can occur for a struct obtained from gsl_cheb_new().
  */
@@ -126,6 +152,30 @@ int gsl_cheb_calc_deriv(gsl_cheb_series * deriv, const gsl_cheb_series * cs);
 int gsl_cheb_calc_integ(gsl_cheb_series * integ, const gsl_cheb_series * cs);
 
 
+/* Piecewise Chebyshev series, with at most max_pieces pieces
+ * of at most the given order each.
+ */
+gsl_cheb_piecewise * gsl_cheb_piecewise_alloc(const size_t order,
+                                              const size_t max_pieces);
+void gsl_cheb_piecewise_free(gsl_cheb_piecewise * pw);
+
+/* Calculate a piecewise Chebyshev series over (a,b), bisecting
+ * the intervals on which gsl_cheb_init_adaptive() does not reach
+ * the tolerance.
+ */
+int gsl_cheb_piecewise_init(gsl_cheb_piecewise * pw,
+                            const gsl_function * func,
+                            const double a, const double b,
+                            const double tol);
+
+size_t gsl_cheb_piecewise_npieces(const gsl_cheb_piecewise * pw);
+
+double gsl_cheb_piecewise_eval(const gsl_cheb_piecewise * pw, const double x);
+int gsl_cheb_piecewise_eval_array(const gsl_cheb_piecewise * pw,
+                                  const double x[], double y[],
+                                  const size_t n);
+
+
 
 
 __END_DECLS
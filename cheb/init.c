@@ -20,9 +20,34 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_chebyshev.h>
+#include <gsl/gsl_fft_real.h>
+
+/* The coefficients are the discrete cosine transform (DCT-II) of the
+   function values at the Chebyshev points,
+
+     c_j = 2/n sum_k f_k cos(pi j (k+1/2)/n),   n = order + 1,
+
+   which is computed in O(n log n) operations with a real FFT of
+   length n of the reordered values (Makhoul 1980). Small orders use
+   the direct O(n^2) sum, which is faster than setting up the FFT. */
+
+#define CHEB_DCT_MIN 32
+
+/* The adaptive initialization starts with CHEB_ADAPT_N0 points and
+   triples the number of points until the trailing coefficients are
+   negligible. The Chebyshev points of the first kind are nested under
+   tripling, so each function value is computed only once. */
+
+#define CHEB_ADAPT_N0 9
+
+static int cheb_dct (double c[], const double f[], const size_t n);
+static int cheb_init_adaptive (gsl_cheb_series * cs,
+                               const gsl_function * func, const double a,
+                               const double b, const double tol);
 
 /*-*-*-*-*-*-*-*-*-*-*-* Allocators *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -37,6 +62,7 @@ gsl_cheb_alloc(const size_t order)
   
   cs->order    = order;
   cs->order_sp = order;
+  cs->order_max = order;
 
   cs->c = (double *) malloc((order+1) * sizeof(double));
 
@@ -67,7 +93,7 @@ void gsl_cheb_free(gsl_cheb_series * cs)
 int gsl_cheb_init(gsl_cheb_series * cs, const gsl_function *func,
                   const double a, const double b)
 {
-  size_t k, j;
+  size_t k;
 
   if(a >= b) {
     GSL_ERROR_VAL("null function interval [a,b]", GSL_EDOM, 0);
@@ -76,24 +102,294 @@ int gsl_cheb_init(gsl_cheb_series * cs, const gsl_function *func,
   cs->b = b;
   /* cs->err = 0.0; */
 
+  /* use the full allocated order, which gsl_cheb_init_adaptive may
+     have reduced */
+  cs->order = cs->order_max;
+  cs->order_sp = cs->order_max;
+
   { 
     double bma = 0.5 * (cs->b - cs->a);
     double bpa = 0.5 * (cs->b + cs->a);
-    double fac = 2.0/(cs->order +1.0);
 
     for(k = 0; k<=cs->order; k++) {
       double y = cos(M_PI * (k+0.5)/(cs->order+1));
       cs->f[k] = GSL_FN_EVAL(func, (y*bma + bpa));
     }
-    
-    for(j = 0; j<=cs->order; j++) {
-      double sum = 0.0;
-      for(k = 0; k<=cs->order; k++) 
-        sum += cs->f[k]*cos(M_PI * j*(k+0.5)/(cs->order+1));
-      cs->c[j] = fac * sum;
-    }
-    
   }
+
+  return cheb_dct (cs->c, cs->f, cs->order + 1);
+}
+
+int gsl_cheb_init_adaptive(gsl_cheb_series * cs, const gsl_function *func,
+                           const double a, const double b, const double tol)
+{
+  int status;
+
+  if(a >= b) {
+    GSL_ERROR_VAL("null function interval [a,b]", GSL_EDOM, 0);
+  }
+
+  if(tol <= 0.0) {
+    GSL_ERROR("tolerance must be positive", GSL_EBADTOL);
+  }
+
+  status = cheb_init_adaptive (cs, func, a, b, tol);
+
+  if (status == GSL_ETOL) {
+    GSL_ERROR("failed to reach tolerance with the maximum order", GSL_ETOL);
+  }
+
+  return status;
+}
+
+/* Returns GSL_ETOL without calling the error handler if the maximum
+   order is reached, for use by the piecewise initialization */
+
+static int
+cheb_init_adaptive (gsl_cheb_series * cs, const gsl_function * func,
+                    const double a, const double b, const double tol)
+{
+  const size_t nmax = cs->order_max + 1;
+  const double bma = 0.5 * (b - a);
+  const double bpa = 0.5 * (b + a);
+  size_t n = GSL_MIN (CHEB_ADAPT_N0, nmax);
+  size_t k, j;
+
+  cs->a = a;
+  cs->b = b;
+
+  for (k = 0; k < n; k++)
+    {
+      double y = cos (M_PI * (k + 0.5) / n);
+      cs->f[k] = GSL_FN_EVAL (func, (y * bma + bpa));
+    }
+
+  while (1)
+    {
+      const size_t ntail = GSL_MAX (2, n / 8);
+      double cmax, ctail = 0.0;
+      int status = cheb_dct (cs->c, cs->f, n);
+
+      if (status)
+        return status;
+
+      cmax = 0.5 * fabs (cs->c[0]);
+
+      for (j = 1; j < n; j++)
+        cmax = GSL_MAX (cmax, fabs (cs->c[j]));
+
+      for (j = (n > ntail) ? n - ntail : 1; j < n; j++)
+        ctail = GSL_MAX (ctail, fabs (cs->c[j]));
+
+      if (ctail <= tol * cmax || n == nmax)
+        {
+          /* chop the negligible trailing coefficients */
+
+          size_t order = 0;
+
+          for (j = n - 1; j > 0; j--)
+            {
+              if (fabs (cs->c[j]) > tol * cmax)
+                {
+                  order = j;
+                  break;
+                }
+            }
+
+          if (ctail > tol * cmax)
+            order = n - 1;
+
+          cs->order = order;
+          cs->order_sp = order;
+
+          return (ctail <= tol * cmax) ? GSL_SUCCESS : GSL_ETOL;
+        }
+
+      if (3 * n <= nmax)
+        {
+          /* point k of the n point grid is point 3k+1 of the 3n grid */
+
+          for (k = n; k-- > 0;)
+            cs->f[3 * k + 1] = cs->f[k];
+
+          n *= 3;
+
+          for (k = 0; k < n; k++)
+            {
+              if (k % 3 != 1)
+                {
+                  double y = cos (M_PI * (k + 0.5) / n);
+                  cs->f[k] = GSL_FN_EVAL (func, (y * bma + bpa));
+                }
+            }
+        }
+      else
+        {
+          n = nmax;
+
+          for (k = 0; k < n; k++)
+            {
+              double y = cos (M_PI * (k + 0.5) / n);
+              cs->f[k] = GSL_FN_EVAL (func, (y * bma + bpa));
+            }
+        }
+    }
+}
+
+static int
+cheb_dct (double c[], const double f[], const size_t n)
+{
+  const double fac = 2.0 / n;
+  size_t j, k;
+
+  if (n < CHEB_DCT_MIN)
+    {
+      for (j = 0; j < n; j++)
+        {
+          double sum = 0.0;
+          for (k = 0; k < n; k++)
+            sum += f[k] * cos (M_PI * j * (k + 0.5) / n);
+          c[j] = fac * sum;
+        }
+    }
+  else
+    {
+      gsl_fft_real_wavetable *wavetable = gsl_fft_real_wavetable_alloc (n);
+      gsl_fft_real_workspace *work = gsl_fft_real_workspace_alloc (n);
+      double *v = (double *) malloc (n * sizeof (double));
+      int status;
+
+      if (wavetable == 0 || work == 0 || v == 0)
+        {
+          gsl_fft_real_wavetable_free (wavetable);
+          gsl_fft_real_workspace_free (work);
+          free (v);
+          GSL_ERROR ("failed to allocate space for DCT", GSL_ENOMEM);
+        }
+
+      /* even points in increasing order, then odd points in
+         decreasing order */
+
+      for (k = 0; 2 * k < n; k++)
+        v[k] = f[2 * k];
+
+      for (k = 0; 2 * k + 1 < n; k++)
+        v[n - 1 - k] = f[2 * k + 1];
+
+      status = gsl_fft_real_transform (v, 1, n, wavetable, work);
+
+      if (status == GSL_SUCCESS)
+        {
+          /* c_j = Re(exp(-i pi j/2n) V_j), with V_j from the
+             halfcomplex array, V_j = conj(V_{n-j}) for j > n/2 */
+
+          c[0] = fac * v[0];
+
+          for (j = 1; j < n; j++)
+            {
+              const double theta = M_PI * j / (2.0 * n);
+              double re, im;
+
+              if (2 * j < n)
+                {
+                  re = v[2 * j - 1];
+                  im = v[2 * j];
+                }
+              else if (2 * j == n)
+                {
+                  re = v[n - 1];
+                  im = 0.0;
+                }
+              else
+                {
+                  re = v[2 * (n - j) - 1];
+                  im = -v[2 * (n - j)];
+                }
+
+              c[j] = fac * (cos (theta) * re + sin (theta) * im);
+            }
+        }
+
+      gsl_fft_real_wavetable_free (wavetable);
+      gsl_fft_real_workspace_free (work);
+      free (v);
+
+      return status;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Initialize a piecewise series in the manner of chebfun. The
+   intervals are processed from left to right. An interval on which
+   the adaptive series does not converge within the maximum order is
+   bisected and its left half is tried next, so that the breakpoints
+   are refined only near the features of the function which need
+   them, e.g. near singularities of its derivatives. */
+
+int
+gsl_cheb_piecewise_init (gsl_cheb_piecewise * pw,
+                         const gsl_function * func,
+                         const double a, const double b, const double tol)
+{
+  int status = GSL_SUCCESS;
+  size_t i = 0;
+
+  if (a >= b)
+    {
+      GSL_ERROR ("null function interval [a,b]", GSL_EDOM);
+    }
+
+  if (tol <= 0.0)
+    {
+      GSL_ERROR ("tolerance must be positive", GSL_EBADTOL);
+    }
+
+  pw->npieces = 1;
+  pw->breakpts[0] = a;
+  pw->breakpts[1] = b;
+
+  while (i < pw->npieces)
+    {
+      const double xl = pw->breakpts[i];
+      const double xr = pw->breakpts[i + 1];
+      int s = cheb_init_adaptive (pw->pieces[i], func, xl, xr, tol);
+
+      if (s == GSL_ETOL && pw->npieces < pw->max_pieces)
+        {
+          /* bisect, keeping the series pointers as a permutation of
+             the allocated ones */
+
+          const size_t np = pw->npieces;
+          gsl_cheb_series *spare = pw->pieces[np];
+
+          memmove (pw->pieces + i + 2, pw->pieces + i + 1,
+                   (np - i - 1) * sizeof (gsl_cheb_series *));
+          pw->pieces[i + 1] = spare;
+
+          memmove (pw->breakpts + i + 2, pw->breakpts + i + 1,
+                   (np - i) * sizeof (double));
+          pw->breakpts[i + 1] = 0.5 * (xl + xr);
+
+          pw->npieces++;
+        }
+      else
+        {
+          if (s == GSL_ETOL)
+            status = GSL_ETOL;
+          else if (s)
+            return s;
+
+          i++;
+        }
+    }
+
+  if (status == GSL_ETOL)
+    {
+      GSL_ERROR ("failed to reach tolerance with the maximum number of pieces",
+                 GSL_ETOL);
+    }
+
   return GSL_SUCCESS;
 }
 
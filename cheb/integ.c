@@ -28,13 +28,16 @@ int gsl_cheb_calc_integ(gsl_cheb_series * integ, const gsl_cheb_series * f)
   const size_t n = f->order + 1;
   const double con = 0.25 * (f->b - f->a);
 
-  if(integ->order != f->order) 
+  if(integ->order_max < f->order) 
     {
-      GSL_ERROR ("order of chebyshev series must be equal", GSL_ENOMEM);
+      GSL_ERROR ("order of chebyshev series is too small", GSL_ENOMEM);
     }
 
   /* set the other parameters in the chebyshev struct */
 
+  integ->order = f->order;
+  integ->order_sp = f->order;
+
   integ->a = f->a;
   integ->b = f->b;
 
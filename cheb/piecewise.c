@@ -0,0 +1,152 @@
+/* cheb/piecewise.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Piecewise Chebyshev approximation, in the manner of chebfun. The
+ * initialization is in init.c.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_chebyshev.h>
+
+gsl_cheb_piecewise *
+gsl_cheb_piecewise_alloc (const size_t order, const size_t max_pieces)
+{
+  gsl_cheb_piecewise *pw;
+  size_t i;
+
+  if (max_pieces == 0)
+    {
+      GSL_ERROR_NULL ("max_pieces must be at least 1", GSL_EINVAL);
+    }
+
+  pw = (gsl_cheb_piecewise *) calloc (1, sizeof (gsl_cheb_piecewise));
+
+  if (pw == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate piecewise series struct",
+                      GSL_ENOMEM);
+    }
+
+  pw->max_pieces = max_pieces;
+
+  pw->breakpts = (double *) malloc ((max_pieces + 1) * sizeof (double));
+  pw->pieces = (gsl_cheb_series **) calloc (max_pieces,
+                                            sizeof (gsl_cheb_series *));
+
+  if (pw->breakpts == 0 || pw->pieces == 0)
+    {
+      gsl_cheb_piecewise_free (pw);
+      GSL_ERROR_NULL ("failed to allocate piecewise series", GSL_ENOMEM);
+    }
+
+  for (i = 0; i < max_pieces; i++)
+    {
+      pw->pieces[i] = gsl_cheb_alloc (order);
+
+      if (pw->pieces[i] == 0)
+        {
+          gsl_cheb_piecewise_free (pw);
+          GSL_ERROR_NULL ("failed to allocate piecewise series", GSL_ENOMEM);
+        }
+    }
+
+  return pw;
+}
+
+void
+gsl_cheb_piecewise_free (gsl_cheb_piecewise * pw)
+{
+  size_t i;
+
+  RETURN_IF_NULL (pw);
+
+  if (pw->pieces)
+    {
+      for (i = 0; i < pw->max_pieces; i++)
+        {
+          if (pw->pieces[i])
+            gsl_cheb_free (pw->pieces[i]);
+        }
+
+      free (pw->pieces);
+    }
+
+  free (pw->breakpts);
+  free (pw);
+}
+
+size_t
+gsl_cheb_piecewise_npieces (const gsl_cheb_piecewise * pw)
+{
+  return pw->npieces;
+}
+
+static size_t
+piecewise_find (const gsl_cheb_piecewise * pw, const double x)
+{
+  /* piece i with breakpts[i] <= x < breakpts[i+1], points outside
+     [a,b] use the first or last piece */
+
+  size_t lo = 0, hi = pw->npieces;
+
+  while (hi > lo + 1)
+    {
+      size_t mid = (lo + hi) / 2;
+
+      if (x < pw->breakpts[mid])
+        hi = mid;
+      else
+        lo = mid;
+    }
+
+  return lo;
+}
+
+double
+gsl_cheb_piecewise_eval (const gsl_cheb_piecewise * pw, const double x)
+{
+  return gsl_cheb_eval (pw->pieces[piecewise_find (pw, x)], x);
+}
+
+int
+gsl_cheb_piecewise_eval_array (const gsl_cheb_piecewise * pw,
+                               const double x[], double y[], const size_t n)
+{
+  size_t j = 0;
+
+  /* evaluate runs of consecutive points in the same piece together */
+
+  while (j < n)
+    {
+      const size_t i = piecewise_find (pw, x[j]);
+      const double xl = (i > 0) ? pw->breakpts[i] : -GSL_DBL_MAX;
+      const double xr = (i + 1 < pw->npieces) ? pw->breakpts[i + 1] : GSL_DBL_MAX;
+      size_t m = j + 1;
+
+      while (m < n && x[m] >= xl && x[m] < xr)
+        m++;
+
+      gsl_cheb_eval_array (pw->pieces[i], x + j, y + j, m - j);
+
+      j = m;
+    }
+
+  return GSL_SUCCESS;
+}
@@ -108,6 +108,177 @@ test_dim (const size_t n, const double a, const double b,
   gsl_cheb_free(cs);
 }
 
+double f_smooth (double x, void * p) {
+  p = 0;
+  return exp(sin(5.0*x));
+}
+
+double f_kink (double x, void * p) {
+  p = 0;
+  return exp(x) + fabs(x - 0.25);
+}
+
+void
+test_dct (const size_t order)
+{
+  const double a = -1.0, b = 2.0;
+  gsl_cheb_series * cs = gsl_cheb_alloc(order);
+  double * y = malloc(101 * sizeof(double));
+  double * x = malloc(101 * sizeof(double));
+  gsl_function F;
+  double cmax = 0.0, err = 0.0;
+  size_t j, k;
+
+  F.function = f_smooth;
+  F.params = 0;
+
+  gsl_cheb_init(cs, &F, a, b);
+
+  /* compare with the direct sum */
+
+  for (j = 0; j <= order; j++)
+    {
+      double sum = 0.0;
+      for (k = 0; k <= order; k++)
+        {
+          double t = cos(M_PI * (k + 0.5) / (order + 1.0));
+          sum += f_smooth(0.5 * (b - a) * t + 0.5 * (b + a), 0)
+            * cos(M_PI * j * (k + 0.5) / (order + 1.0));
+        }
+      sum *= 2.0 / (order + 1.0);
+      cmax = GSL_MAX(cmax, fabs(sum));
+      err = GSL_MAX(err, fabs(cs->c[j] - sum));
+    }
+
+  gsl_test_abs(err, 0.0, 10.0 * order * GSL_DBL_EPSILON * cmax,
+               "gsl_cheb_init, order %u coefficients", order);
+
+  /* batched evaluation */
+
+  for (k = 0; k <= 100; k++)
+    x[k] = a + (b - a) * ((k * 37) % 101) / 100.0;
+
+  gsl_cheb_eval_array(cs, x, y, 101);
+
+  err = 0.0;
+  for (k = 0; k <= 100; k++)
+    err = GSL_MAX(err, fabs(y[k] - gsl_cheb_eval(cs, x[k])));
+
+  gsl_test_abs(err, 0.0, 10.0 * order * GSL_DBL_EPSILON,
+               "gsl_cheb_eval_array, order %u", order);
+
+  free(x);
+  free(y);
+  gsl_cheb_free(cs);
+}
+
+void
+test_adaptive (void)
+{
+  double tol = 1.0e-14;
+  gsl_cheb_series * cs = gsl_cheb_alloc(500);
+  gsl_cheb_series * csd = gsl_cheb_alloc(500);
+  gsl_cheb_piecewise * pw = gsl_cheb_piecewise_alloc(32, 20);
+  gsl_function F, F_kink, F_T2;
+  gsl_error_handler_t * h;
+  double x[201], y[201], err;
+  size_t k;
+  int status;
+
+  F.function = f_smooth;
+  F.params = 0;
+  F_kink.function = f_kink;
+  F_kink.params = 0;
+  F_T2.function = f_T2;
+  F_T2.params = 0;
+
+  status = gsl_cheb_init_adaptive(cs, &F, 0.0, 2.0, tol);
+  gsl_test(status, "gsl_cheb_init_adaptive, exp(sin(5x)) status");
+  gsl_test(cs->order < 20 || cs->order >= 500,
+           "gsl_cheb_init_adaptive, exp(sin(5x)) order %u", cs->order);
+
+  err = 0.0;
+  for (k = 0; k <= 200; k++)
+    {
+      double xk = k / 100.0;
+      err = GSL_MAX(err, fabs(gsl_cheb_eval(cs, xk) - f_smooth(xk, 0)));
+    }
+
+  gsl_test_abs(err, 0.0, 1.0e-13, "gsl_cheb_init_adaptive, exp(sin(5x))");
+
+  /* derivative of a series of reduced order */
+
+  gsl_cheb_calc_deriv(csd, cs);
+  gsl_test(csd->order != cs->order, "gsl_cheb_calc_deriv, adaptive order");
+
+  err = 0.0;
+  for (k = 0; k <= 200; k++)
+    {
+      double xk = k / 100.0;
+      double d = 5.0 * cos(5.0 * xk) * f_smooth(xk, 0);
+      err = GSL_MAX(err, fabs(gsl_cheb_eval(csd, xk) - d));
+    }
+
+  gsl_test_abs(err, 0.0, 1.0e-10, "gsl_cheb_calc_deriv, adaptive exp(sin(5x))");
+
+  /* a polynomial is represented exactly */
+
+  status = gsl_cheb_init_adaptive(cs, &F_T2, -1.0, 1.0, tol);
+  gsl_test(status, "gsl_cheb_init_adaptive, T_2(x) status");
+  gsl_test(cs->order != 2, "gsl_cheb_init_adaptive, T_2(x) order %u", cs->order);
+
+  /* plain initialization after adaptive uses the full order again */
+
+  gsl_cheb_init(cs, &F, 0.0, 2.0);
+  gsl_test(cs->order != 500 || cs->order_sp != 500,
+           "gsl_cheb_init after adaptive, order %u", cs->order);
+
+  err = 0.0;
+  for (k = 0; k <= 200; k++)
+    {
+      double xk = k / 100.0;
+      err = GSL_MAX(err, fabs(gsl_cheb_eval(cs, xk) - f_smooth(xk, 0)));
+    }
+
+  gsl_test_abs(err, 0.0, 1.0e-11, "gsl_cheb_init after adaptive, exp(sin(5x))");
+
+  /* maximum order too small */
+
+  h = gsl_set_error_handler_off();
+  gsl_cheb_free(csd);
+  csd = gsl_cheb_alloc(16);
+  status = gsl_cheb_init_adaptive(csd, &F, 0.0, 2.0, tol);
+  gsl_test(status != GSL_ETOL, "gsl_cheb_init_adaptive, order 16 status");
+  gsl_test(csd->order != 16, "gsl_cheb_init_adaptive, order 16 order");
+  gsl_set_error_handler(h);
+
+  /* piecewise series with a kink at a dyadic point */
+
+  status = gsl_cheb_piecewise_init(pw, &F_kink, -1.0, 1.0, tol);
+  gsl_test(status, "gsl_cheb_piecewise_init status");
+  gsl_test(gsl_cheb_piecewise_npieces(pw) > 6,
+           "gsl_cheb_piecewise_init, npieces %u",
+           gsl_cheb_piecewise_npieces(pw));
+
+  for (k = 0; k <= 200; k++)
+    x[k] = -1.0 + k / 100.0;
+
+  gsl_cheb_piecewise_eval_array(pw, x, y, 201);
+
+  err = 0.0;
+  for (k = 0; k <= 200; k++)
+    {
+      err = GSL_MAX(err, fabs(y[k] - f_kink(x[k], 0)));
+      err = GSL_MAX(err, fabs(gsl_cheb_piecewise_eval(pw, x[k]) - f_kink(x[k], 0)));
+    }
+
+  gsl_test_abs(err, 0.0, 1.0e-13, "gsl_cheb_piecewise_eval, exp(x) + |x-1/4|");
+
+  gsl_cheb_piecewise_free(pw);
+  gsl_cheb_free(csd);
+  gsl_cheb_free(cs);
+}
+
 int 
 main(void)
 {
@@ -293,5 +464,17 @@ main(void)
   test_dim (2, -5.0, 5.0, &F_P, &F_DP, &F_IP2);
   test_dim (1, -5.0, 5.0, &F_P, &F_DP, &F_IP1);
 
+  /* Test DCT initialization, below and above the FFT threshold */
+  test_dct (4);
+  test_dct (30);
+  test_dct (31);
+  test_dct (32);
+  test_dct (100);
+  test_dct (126);
+  test_dct (242);
+  test_dct (500);
+
+  test_adaptive ();
+
   exit (gsl_test_summary());
 }
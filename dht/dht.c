@@ -25,13 +25,151 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_sf_bessel.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_dht.h>
 
 
+/* Number of vectors accumulated together by the dense kernel. */
+#define DHT_DENSE_BLOCK 8
+
+static int
+dht_dense_alloc(gsl_dht * t)
+{
+  const size_t size = t->size;
+
+  t->Jjj = (double *)malloc(size*(size+1)/2 * sizeof(double));
+
+  if(t->Jjj == 0) {
+    GSL_ERROR("could not allocate memory for Jjj", GSL_ENOMEM);
+  }
+
+  t->J2 = (double *)malloc((size+1)*sizeof(double));
+
+  if(t->J2 == 0) {
+    free(t->Jjj);
+    t->Jjj = 0;
+    GSL_ERROR("could not allocate memory for J2", GSL_ENOMEM);
+  }
+
+  return GSL_SUCCESS;
+}
+
+static int
+dht_dense_init(gsl_dht * t)
+{
+  const double nu = t->nu;
+  const double jN = t->j[t->size+1];
+  size_t n, m;
+  int stat_J = 0;
+
+  t->J2[0] = 0.0;
+  for(m=1; m<t->size+1; m++) {
+    gsl_sf_result J;
+    stat_J += gsl_sf_bessel_Jnu_e(nu + 1.0, t->j[m], &J);
+    t->J2[m] = J.val * J.val;
+  }
+
+  /* J_nu(j[n] j[m] / j[N]) = Jjj[n(n-1)/2 + m - 1], 1 <= n,m <= size
+   */
+  for(n=1; n<t->size+1; n++) {
+    for(m=1; m<=n; m++) {
+      double arg = t->j[n] * t->j[m] / jN;
+      gsl_sf_result J;
+      stat_J += gsl_sf_bessel_Jnu_e(nu, arg, &J);
+      t->Jjj[n*(n-1)/2 + m - 1] = J.val;
+    }
+  }
+
+  if(stat_J != 0) {
+    GSL_ERROR("error computing bessel function", GSL_EFAILED);
+  }
+
+  return GSL_SUCCESS;
+}
+
+static int
+dht_dense_apply(const gsl_dht * t, size_t nvec,
+                const double * f_in, size_t tda_in,
+                double * f_out, size_t tda_out)
+{
+  const double jN = t->j[t->size + 1];
+  const double r  = t->xmax / jN;
+  size_t v0;
+  size_t m;
+  size_t i;
+
+  /* Each kernel element is formed once per block of vectors,
+   * so a batch costs little more than a single matrix pass.
+   */
+  for(v0=0; v0<nvec; v0 += DHT_DENSE_BLOCK) {
+    const size_t nv = GSL_MIN(DHT_DENSE_BLOCK, nvec - v0);
+    const double * in = f_in + v0*tda_in;
+    double * out = f_out + v0*tda_out;
+    size_t v;
+
+    for(m=0; m<t->size; m++) {
+      double sum[DHT_DENSE_BLOCK];
+      double Y;
+
+      for(v=0; v<nv; v++) sum[v] = 0.0;
+
+      for(i=0; i<t->size; i++) {
+        /* Need to find max and min so that we
+         * address the symmetric Jjj matrix properly.
+         * FIXME: we can presumably optimize this
+         * by just running over the elements of Jjj
+         * in a deterministic manner.
+         */
+        size_t m_local; 
+        size_t n_local;
+        if(i < m) {
+          m_local = i;
+          n_local = m;
+        }
+        else {
+          m_local = m;
+          n_local = i;
+        }
+        Y = t->Jjj[n_local*(n_local+1)/2 + m_local] / t->J2[i+1];
+        for(v=0; v<nv; v++) sum[v] += Y * in[v*tda_in + i];
+      }
+
+      for(v=0; v<nv; v++) out[v*tda_out + m] = sum[v] * 2.0 * r*r;
+    }
+  }
+
+  return GSL_SUCCESS;
+}
+
+static void
+dht_dense_free(gsl_dht * t)
+{
+  free(t->J2);
+  free(t->Jjj);
+}
+
+static const gsl_dht_type dense_type = {
+  "dense",
+  &dht_dense_alloc,
+  &dht_dense_init,
+  &dht_dense_apply,
+  &dht_dense_free
+};
+
+const gsl_dht_type * gsl_dht_dense = &dense_type;
+
+
 gsl_dht *
 gsl_dht_alloc (size_t size)
+{
+  return gsl_dht_alloc_with_type(gsl_dht_dense, size);
+}
+
+gsl_dht *
+gsl_dht_alloc_with_type (const gsl_dht_type * T, size_t size)
 {
   gsl_dht * t;
+  int status;
 
   if(size == 0) {
     GSL_ERROR_VAL("size == 0", GSL_EDOM, 0);
@@ -48,6 +186,11 @@ gsl_dht_alloc (size_t size)
   t->xmax = -1.0; /* Make it clear that this needs to be calculated. */
   t->nu   = -1.0; 
 
+  t->Jjj   = 0;
+  t->J2    = 0;
+  t->type  = T;
+  t->state = 0;
+
   t->j = (double *)malloc((size+2)*sizeof(double));
 
   if(t->j == 0) {
@@ -55,21 +198,12 @@ gsl_dht_alloc (size_t size)
     GSL_ERROR_VAL("could not allocate memory for j", GSL_ENOMEM, 0);
   }
 
-  t->Jjj = (double *)malloc(size*(size+1)/2 * sizeof(double));
-
-  if(t->Jjj == 0) {
-    free(t->j);
-    free(t);
-    GSL_ERROR_VAL("could not allocate memory for Jjj", GSL_ENOMEM, 0);
-  }
-
-  t->J2 = (double *)malloc((size+1)*sizeof(double));
+  status = (T->alloc)(t);
 
-  if(t->J2 == 0) {
-    free(t->Jjj);
+  if(status) {
     free(t->j);
     free(t);
-    GSL_ERROR_VAL("could not allocate memory for J2", GSL_ENOMEM, 0);
+    GSL_ERROR_VAL("could not allocate transform workspace", GSL_ENOMEM, 0);
   }
 
   return t;
@@ -97,10 +231,16 @@ dht_bessel_zeros(gsl_dht * t)
 
 gsl_dht *
 gsl_dht_new (size_t size, double nu, double xmax)
+{
+  return gsl_dht_new_with_type(gsl_dht_dense, size, nu, xmax);
+}
+
+gsl_dht *
+gsl_dht_new_with_type (const gsl_dht_type * T, size_t size, double nu, double xmax)
 {
   int status;
 
-  gsl_dht * dht = gsl_dht_alloc (size);
+  gsl_dht * dht = gsl_dht_alloc_with_type (T, size);
 
   if (dht == 0)
     return 0;
@@ -122,10 +262,8 @@ gsl_dht_init(gsl_dht * t, double nu, double xmax)
     GSL_ERROR ("nu is negative", GSL_EDOM);
   }
   else {
-    size_t n, m;
     int stat_bz = GSL_SUCCESS;
-    int stat_J  = 0;
-    double jN;
+    int stat_t;
 
     if(nu != t->nu) {
       /* Recalculate Bessel zeros if necessary. */
@@ -133,31 +271,13 @@ gsl_dht_init(gsl_dht * t, double nu, double xmax)
       stat_bz = dht_bessel_zeros(t);
     }
 
-    jN = t->j[t->size+1];
-
     t->xmax = xmax;
-    t->kmax = jN / xmax;
-
-    t->J2[0] = 0.0;
-    for(m=1; m<t->size+1; m++) {
-      gsl_sf_result J;
-      stat_J += gsl_sf_bessel_Jnu_e(nu + 1.0, t->j[m], &J);
-      t->J2[m] = J.val * J.val;
-    }
+    t->kmax = t->j[t->size+1] / xmax;
 
-    /* J_nu(j[n] j[m] / j[N]) = Jjj[n(n-1)/2 + m - 1], 1 <= n,m <= size
-     */
-    for(n=1; n<t->size+1; n++) {
-      for(m=1; m<=n; m++) {
-        double arg = t->j[n] * t->j[m] / jN;
-        gsl_sf_result J;
-        stat_J += gsl_sf_bessel_Jnu_e(nu, arg, &J);
-        t->Jjj[n*(n-1)/2 + m - 1] = J.val;
-      }
-    }
+    stat_t = (t->type->init)(t);
 
-    if(stat_J != 0) {
-      GSL_ERROR("error computing bessel function", GSL_EFAILED);
+    if(stat_t != GSL_SUCCESS) {
+      return stat_t;
     }
     else {
       return stat_bz;
@@ -166,6 +286,12 @@ gsl_dht_init(gsl_dht * t, double nu, double xmax)
 }
 
 
+const char * gsl_dht_name(const gsl_dht * t)
+{
+  return t->type->name;
+}
+
+
 double gsl_dht_x_sample(const gsl_dht * t, int n)
 {
   return t->j[n+1]/t->j[t->size+1] * t->xmax;
@@ -181,8 +307,7 @@ double gsl_dht_k_sample(const gsl_dht * t, int n)
 void gsl_dht_free(gsl_dht * t)
 {
   RETURN_IF_NULL (t);
-  free(t->J2);
-  free(t->Jjj);
+  (t->type->free)(t);
   free(t->j);
   free(t);
 }
@@ -191,37 +316,24 @@ void gsl_dht_free(gsl_dht * t)
 int
 gsl_dht_apply(const gsl_dht * t, double * f_in, double * f_out)
 {
-  const double jN = t->j[t->size + 1];
-  const double r  = t->xmax / jN;
-  size_t m;
-  size_t i;
+  return (t->type->apply)(t, 1, f_in, t->size, f_out, t->size);
+}
 
-  for(m=0; m<t->size; m++) {
-    double sum = 0.0;
-    double Y;
-    for(i=0; i<t->size; i++) {
-      /* Need to find max and min so that we
-       * address the symmetric Jjj matrix properly.
-       * FIXME: we can presumably optimize this
-       * by just running over the elements of Jjj
-       * in a deterministic manner.
-       */
-      size_t m_local; 
-      size_t n_local;
-      if(i < m) {
-        m_local = i;
-        n_local = m;
-      }
-      else {
-        m_local = m;
-        n_local = i;
-      }
-      Y = t->Jjj[n_local*(n_local+1)/2 + m_local] / t->J2[i+1];
-      sum += Y * f_in[i];
-    }
-    f_out[m] = sum * 2.0 * r*r;
-  }
 
-  return GSL_SUCCESS;
+int
+gsl_dht_apply_matrix(const gsl_dht * t, const gsl_matrix * F_in, gsl_matrix * F_out)
+{
+  if(F_in->size2 != t->size || F_out->size2 != t->size) {
+    GSL_ERROR("matrix rows must match transform size", GSL_EBADLEN);
+  }
+  else if(F_in->size1 != F_out->size1) {
+    GSL_ERROR("input and output matrices must have the same number of rows", GSL_EBADLEN);
+  }
+  else if(F_in->size1 == 0) {
+    return GSL_SUCCESS;
+  }
+  else {
+    return (t->type->apply)(t, F_in->size1, F_in->data, F_in->tda,
+                            F_out->data, F_out->tda);
+  }
 }
-
@@ -0,0 +1,477 @@
+/* dht/fftlog.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Quasi-discrete Hankel transform by the FFTLog method
+ * (A. J. S. Hamilton, MNRAS 312, 257 (2000)).
+ *
+ * The samples f(x_n) are interpolated onto a logarithmic grid
+ * r_j = r_0 exp(j delta), j = 0 ... n-1, and the biased function
+ * p(r) = r f(r) (r/r_0)^(-q) is expanded as a discrete Fourier
+ * series in ln r.  Each term (r/r_0)^(q - i eta_m) has an analytic
+ * Hankel transform, so on the reciprocal grid k_l = k_0 exp(l delta)
+ *
+ *   k F(k) (k r_0)^q = sum_m c_m (k_0 r_0)^(i eta_m) U(q - i eta_m) e^(2 pi i m l/n)
+ *
+ * with eta_m = 2 pi m / (n delta) and
+ *
+ *   U(x) = 2^x Gamma((nu+1+x)/2) / Gamma((nu+1-x)/2).
+ *
+ * The transform is therefore a forward FFT, a diagonal multiply and
+ * an inverse FFT.  The result is interpolated back onto the sample
+ * points k_m = j_{nu,m+1} / xmax of the dense transform, so that the
+ * two types are interchangeable.
+ *
+ * The resampling interpolates f(x) / x^nu, which is regular at the
+ * origin for the functions a Bessel series of order nu can represent,
+ * and extrapolates it below the first sample; above xmax f is zero.
+ * The transform is unbiased, q = 0: r f(r) vanishes as r^(nu+1) at
+ * the origin and k F(k) as k^(nu+1), so padding both ends of the grid
+ * by a fixed multiple of 1/(nu+1) in the logarithm keeps the periodic
+ * images of the FFT below a fixed tolerance.
+ *
+ * The state is read-only after initialization; the FFT buffers are
+ * allocated on each call to apply, so one transform object can be
+ * used by several threads at once.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sf_gamma.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_dht.h>
+
+/* points of the log grid per sample interval at x = xmax */
+#define FFTLOG_OVERSAMPLE 2.0
+
+/* the padding below x_0 and above xmax suppresses the periodic
+   images of r f(r) and k F(k) by exp(-FFTLOG_DECAY) */
+#define FFTLOG_DECAY 24.0
+
+/* Lagrange interpolation order used for the resampling */
+#define FFTLOG_NPTS 6
+
+typedef struct
+{
+  size_t n;             /* FFT length, even with factors 2, 3 and 5 */
+  double * u;           /* kernel multipliers, halfcomplex, n */
+  size_t * in_idx;      /* first sample used for r_j, n */
+  double * in_w;        /* weights for r_j, FFTLOG_NPTS*n */
+  size_t * out_idx;     /* first log grid point used for k_m, size */
+  double * out_w;       /* weights for k_m, FFTLOG_NPTS*size */
+  gsl_fft_real_wavetable * wt_real;
+  gsl_fft_halfcomplex_wavetable * wt_hc;
+} fftlog_state_t;
+
+static void fftlog_free_grid (fftlog_state_t * state);
+static size_t fftlog_length (size_t npoints);
+static double fftlog_x (const gsl_dht * t, size_t i);
+static void fftlog_lagrange (const double * xs, size_t npts, double x,
+                             double * w);
+
+static int
+fftlog_alloc (gsl_dht * t)
+{
+  const size_t size = t->size;
+  fftlog_state_t * state;
+
+  state = (fftlog_state_t *) calloc (1, sizeof (fftlog_state_t));
+
+  if (state == 0)
+    {
+      GSL_ERROR ("failed to allocate space for fftlog state", GSL_ENOMEM);
+    }
+
+  state->out_idx = (size_t *) malloc (size * sizeof (size_t));
+  state->out_w = (double *) malloc (FFTLOG_NPTS * size * sizeof (double));
+
+  if (state->out_idx == 0 || state->out_w == 0)
+    {
+      free (state->out_idx);
+      free (state->out_w);
+      free (state);
+      GSL_ERROR ("failed to allocate space for fftlog state", GSL_ENOMEM);
+    }
+
+  t->state = state;
+
+  return GSL_SUCCESS;
+}
+
+static void
+fftlog_free (gsl_dht * t)
+{
+  fftlog_state_t * state = (fftlog_state_t *) t->state;
+
+  fftlog_free_grid (state);
+  free (state->out_idx);
+  free (state->out_w);
+  free (state);
+}
+
+static void
+fftlog_free_grid (fftlog_state_t * state)
+{
+  free (state->u);
+  free (state->in_idx);
+  free (state->in_w);
+  if (state->wt_real)
+    gsl_fft_real_wavetable_free (state->wt_real);
+  if (state->wt_hc)
+    gsl_fft_halfcomplex_wavetable_free (state->wt_hc);
+  state->wt_real = 0;
+  state->wt_hc = 0;
+  state->u = 0;
+  state->in_idx = 0;
+  state->in_w = 0;
+  state->n = 0;
+}
+
+/* smallest even n >= npoints with no prime factors above 5 */
+static size_t
+fftlog_length (size_t npoints)
+{
+  size_t n = GSL_MAX (npoints, 8);
+
+  n += n % 2;
+
+  for (;; n += 2)
+    {
+      size_t r = n;
+
+      while (r % 2 == 0)
+        r /= 2;
+      while (r % 3 == 0)
+        r /= 3;
+      while (r % 5 == 0)
+        r /= 5;
+
+      if (r == 1)
+        return n;
+    }
+}
+
+/* x sample i, with i = size giving xmax */
+static double
+fftlog_x (const gsl_dht * t, size_t i)
+{
+  return t->j[i + 1] / t->j[t->size + 1] * t->xmax;
+}
+
+/* Lagrange weights at x for the nodes xs[0 .. npts-1] */
+static void
+fftlog_lagrange (const double * xs, size_t npts, double x, double * w)
+{
+  size_t k, l;
+
+  for (k = 0; k < npts; k++)
+    {
+      double wk = 1.0;
+
+      for (l = 0; l < npts; l++)
+        {
+          if (l != k)
+            wk *= (x - xs[l]) / (xs[k] - xs[l]);
+        }
+
+      w[k] = wk;
+    }
+}
+
+static int
+fftlog_init (gsl_dht * t)
+{
+  fftlog_state_t * state = (fftlog_state_t *) t->state;
+  const size_t size = t->size;
+  const double nu = t->nu;
+  const double q = 0.0;
+  const size_t npts_in = GSL_MIN (FFTLOG_NPTS, size + 1);
+  const size_t npts_out = FFTLOG_NPTS;
+  const double x0 = fftlog_x (t, 0);
+  const double lnk_first = log (t->j[1] / t->xmax);
+  const double lnk_last = log (t->j[size] / t->xmax);
+  double xs[FFTLOG_NPTS];
+  double delta, pad, lnr0, lnk0, lnkr, eta_nyq;
+  size_t n, npoints, i, j, m;
+  int stat_g = 0;
+
+  /* log spacing from the last sample interval, the coarsest in ln x */
+
+  if (size > 1)
+    delta = log (t->xmax / fftlog_x (t, size - 1)) / FFTLOG_OVERSAMPLE;
+  else
+    delta = log (t->xmax / x0) / FFTLOG_OVERSAMPLE;
+
+  pad = FFTLOG_DECAY / (1.0 + nu);
+  lnr0 = log (x0) - pad;
+  npoints = (size_t) ceil ((log (t->xmax) + pad - lnr0) / delta) + 1;
+
+  n = fftlog_length (npoints);
+
+  if (n != state->n)
+    {
+      fftlog_free_grid (state);
+
+      state->u = (double *) malloc (n * sizeof (double));
+      state->in_idx = (size_t *) malloc (n * sizeof (size_t));
+      state->in_w = (double *) malloc (FFTLOG_NPTS * n * sizeof (double));
+      state->wt_real = gsl_fft_real_wavetable_alloc (n);
+      state->wt_hc = gsl_fft_halfcomplex_wavetable_alloc (n);
+
+      if (state->u == 0 || state->in_idx == 0 || state->in_w == 0
+          || state->wt_real == 0 || state->wt_hc == 0)
+        {
+          fftlog_free_grid (state);
+          GSL_ERROR ("failed to allocate space for fftlog grid", GSL_ENOMEM);
+        }
+
+      state->n = n;
+    }
+
+  /* centre the k grid on the k samples, then shift it by at most
+   * delta/2 so that the Nyquist multiplier is real, which avoids
+   * ringing (Hamilton's low-ringing condition) */
+
+  lnk0 = 0.5 * (lnk_first + lnk_last) - 0.5 * (n - 1) * delta;
+  lnkr = lnk0 + lnr0;
+  eta_nyq = M_PI / delta;
+
+  {
+    gsl_sf_result lr1, a1, lr2, a2;
+    double theta, phase;
+
+    stat_g += gsl_sf_lngamma_complex_e (0.5 * (nu + 1.0 + q), -0.5 * eta_nyq,
+                                        &lr1, &a1);
+    stat_g += gsl_sf_lngamma_complex_e (0.5 * (nu + 1.0 - q), 0.5 * eta_nyq,
+                                        &lr2, &a2);
+    theta = -eta_nyq * M_LN2 + a1.val - a2.val;
+    phase = eta_nyq * lnkr + theta;
+    lnkr += (M_PI * floor (phase / M_PI + 0.5) - phase) / eta_nyq;
+    lnk0 = lnkr - lnr0;
+  }
+
+  /* kernel multipliers u_m = (k_0 r_0)^(i eta_m) U(q - i eta_m),
+   * in the packed halfcomplex order of the mixed-radix FFT */
+
+  for (m = 0; m <= n / 2; m++)
+    {
+      const double eta = 2.0 * M_PI * m / (n * delta);
+      gsl_sf_result lr1, a1, lr2, a2;
+      double re, im;
+
+      stat_g += gsl_sf_lngamma_complex_e (0.5 * (nu + 1.0 + q), -0.5 * eta,
+                                          &lr1, &a1);
+      stat_g += gsl_sf_lngamma_complex_e (0.5 * (nu + 1.0 - q), 0.5 * eta,
+                                          &lr2, &a2);
+
+      re = q * M_LN2 + lr1.val - lr2.val;
+      im = eta * (lnkr - M_LN2) + a1.val - a2.val;
+
+      if (m == 0)
+        {
+          state->u[0] = exp (re);
+        }
+      else if (m == n / 2)
+        {
+          state->u[n - 1] = exp (re) * cos (im);
+        }
+      else
+        {
+          state->u[2 * m - 1] = exp (re) * cos (im);
+          state->u[2 * m] = exp (re) * sin (im);
+        }
+    }
+
+  if (stat_g != 0)
+    {
+      GSL_ERROR ("error computing gamma function", GSL_EFAILED);
+    }
+
+  /* resampling of f(x_i) onto r_j, including the factor
+   * r (r/r_0)^(-q); the extra node i = size is xmax, where f = 0 */
+
+  i = 0;
+
+  for (j = 0; j < n; j++)
+    {
+      const double lnr = lnr0 + j * delta;
+      const double r = exp (lnr);
+      const double scale = exp ((1.0 - q) * lnr + q * lnr0);
+      double * w = state->in_w + FFTLOG_NPTS * j;
+      size_t k, s;
+
+      for (k = 0; k < FFTLOG_NPTS; k++)
+        w[k] = 0.0;
+
+      state->in_idx[j] = 0;
+
+      if (r >= t->xmax)
+        {
+          continue;
+        }
+
+      while (i + 1 < size && fftlog_x (t, i + 1) <= r)
+        i++;
+
+      s = (i + 1 >= npts_in / 2) ? i + 1 - npts_in / 2 : 0;
+      if (s + npts_in > size + 1)
+        s = size + 1 - npts_in;
+
+      for (k = 0; k < npts_in; k++)
+        xs[k] = fftlog_x (t, s + k);
+
+      fftlog_lagrange (xs, npts_in, r, w);
+
+      for (k = 0; k < npts_in; k++)
+        w[k] *= scale * pow (r / xs[k], nu);
+
+      state->in_idx[j] = s;
+    }
+
+  /* interpolation from the k grid back to the k samples, including
+   * the factor 1 / (k (k r_0)^q) */
+
+  for (m = 0; m < size; m++)
+    {
+      const double tm = (log (t->j[m + 1] / t->xmax) - lnk0) / delta;
+      double * w = state->out_w + FFTLOG_NPTS * m;
+      size_t k, s;
+      double fl = floor (tm);
+
+      if (fl < (double) (npts_out / 2 - 1))
+        s = 0;
+      else
+        s = (size_t) fl + 1 - npts_out / 2;
+
+      if (s + npts_out > n)
+        s = n - npts_out;
+
+      for (k = 0; k < npts_out; k++)
+        xs[k] = (double) (s + k);
+
+      fftlog_lagrange (xs, npts_out, tm, w);
+
+      for (k = 0; k < npts_out; k++)
+        {
+          const double lnk = lnk0 + (s + k) * delta;
+          w[k] *= exp (-(1.0 + q) * lnk - q * lnr0);
+        }
+
+      state->out_idx[m] = s;
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+fftlog_apply (const gsl_dht * t, size_t nvec,
+              const double * f_in, size_t tda_in,
+              double * f_out, size_t tda_out)
+{
+  const fftlog_state_t * state = (const fftlog_state_t *) t->state;
+  const size_t size = t->size;
+  const size_t n = state->n;
+  const double * u = state->u;
+  gsl_fft_real_workspace * ws;
+  double * fext, * work;
+  size_t v, i, j, k, m;
+
+  /* samples with f(xmax) = 0 appended (size+1), and the FFT buffer (n) */
+  fext = (double *) malloc ((size + 1 + n) * sizeof (double));
+  ws = gsl_fft_real_workspace_alloc (n);
+
+  if (fext == 0 || ws == 0)
+    {
+      free (fext);
+      if (ws)
+        gsl_fft_real_workspace_free (ws);
+      GSL_ERROR ("failed to allocate space for fftlog buffers", GSL_ENOMEM);
+    }
+
+  work = fext + size + 1;
+
+  for (v = 0; v < nvec; v++)
+    {
+      const double * in = f_in + v * tda_in;
+      double * out = f_out + v * tda_out;
+
+      for (i = 0; i < size; i++)
+        fext[i] = in[i];
+
+      fext[size] = 0.0;
+
+      for (j = 0; j < n; j++)
+        {
+          const double * w = state->in_w + FFTLOG_NPTS * j;
+          const double * f = fext + state->in_idx[j];
+          double sum = 0.0;
+
+          for (k = 0; k < FFTLOG_NPTS && state->in_idx[j] + k <= size; k++)
+            sum += w[k] * f[k];
+
+          work[j] = sum;
+        }
+
+      gsl_fft_real_transform (work, 1, n, state->wt_real, ws);
+
+      /* multiply the conjugate spectrum by the kernel */
+
+      work[0] *= u[0];
+
+      for (m = 1; m < n / 2; m++)
+        {
+          const double ar = work[2 * m - 1], ai = work[2 * m];
+          const double ur = u[2 * m - 1], ui = u[2 * m];
+          work[2 * m - 1] = ar * ur + ai * ui;
+          work[2 * m] = ar * ui - ai * ur;
+        }
+
+      work[n - 1] *= u[n - 1];
+
+      gsl_fft_halfcomplex_inverse (work, 1, n, state->wt_hc, ws);
+
+      for (m = 0; m < size; m++)
+        {
+          const double * w = state->out_w + FFTLOG_NPTS * m;
+          const double * g = work + state->out_idx[m];
+          double sum = 0.0;
+
+          for (k = 0; k < FFTLOG_NPTS; k++)
+            sum += w[k] * g[k];
+
+          out[m] = sum;
+        }
+    }
+
+  free (fext);
+  gsl_fft_real_workspace_free (ws);
+
+  return GSL_SUCCESS;
+}
+
+static const gsl_dht_type fftlog_type = {
+  "fftlog",
+  &fftlog_alloc,
+  &fftlog_init,
+  &fftlog_apply,
+  &fftlog_free
+};
+
+const gsl_dht_type * gsl_dht_fftlog = &fftlog_type;
@@ -22,6 +22,10 @@
 #ifndef __GSL_DHT_H__
 #define __GSL_DHT_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_types.h>
+#include <gsl/gsl_matrix_double.h>
+
 #undef __BEGIN_DECLS
 #undef __END_DECLS
 #ifdef __cplusplus
@@ -34,6 +38,25 @@
 
 __BEGIN_DECLS
 
+struct gsl_dht_struct;
+
+/* Transform algorithms. The dense type applies the full
+ * size x size kernel J_nu(j_i j_m / j_N) in O(size^2); the
+ * fftlog type resamples onto a logarithmic grid and evaluates
+ * the transform as an FFT convolution in O(size log size).
+ */
+typedef struct {
+  const char * name;
+  int (*alloc) (struct gsl_dht_struct * t);
+  int (*init) (struct gsl_dht_struct * t);
+  int (*apply) (const struct gsl_dht_struct * t, size_t nvec,
+                const double * f_in, size_t tda_in,
+                double * f_out, size_t tda_out);
+  void (*free) (struct gsl_dht_struct * t);
+} gsl_dht_type;
+
+GSL_VAR const gsl_dht_type * gsl_dht_dense;
+GSL_VAR const gsl_dht_type * gsl_dht_fftlog;
 
 struct gsl_dht_struct {
   size_t    size;  /* size of the sample arrays to be transformed    */
@@ -43,6 +66,8 @@ struct gsl_dht_struct {
   double *  j;     /* array of computed J_nu zeros, j_{nu,s} = j[s]  */
   double *  Jjj;   /* transform numerator, J_nu(j_i j_m / j_N)       */
   double *  J2;    /* transform denominator, J_{nu+1}^2(j_m)         */
+  const gsl_dht_type * type;  /* transform algorithm                   */
+  void *    state; /* algorithm specific workspace                   */
 };
 typedef struct gsl_dht_struct gsl_dht;
 
@@ -53,6 +78,14 @@ typedef struct gsl_dht_struct gsl_dht;
 gsl_dht * gsl_dht_alloc(size_t size);
 gsl_dht * gsl_dht_new(size_t size, double nu, double xmax);
 
+/* As above, using the given transform algorithm. The
+ * plain versions use gsl_dht_dense.
+ */
+gsl_dht * gsl_dht_alloc_with_type(const gsl_dht_type * T, size_t size);
+gsl_dht * gsl_dht_new_with_type(const gsl_dht_type * T, size_t size, double nu, double xmax);
+
+const char * gsl_dht_name(const gsl_dht * t);
+
 /* Recalculate a transform object for given values of nu, xmax.
  * You cannot change the size of the object since the internal
  * allocation is reused.
@@ -82,6 +115,13 @@ void gsl_dht_free(gsl_dht * t);
 int gsl_dht_apply(const gsl_dht * t, double * f_in, double * f_out);
 
 
+/* Transform each row of F_in into the corresponding row of F_out,
+ * sharing the kernel (or FFT plan) across all rows.
+ * F_in and F_out are nvec x size.
+ */
+int gsl_dht_apply_matrix(const gsl_dht * t, const gsl_matrix * F_in, gsl_matrix * F_out);
+
+
 __END_DECLS
 
 #endif /* __GSL_DHT_H__ */
@@ -25,6 +25,7 @@
 #include <math.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_test.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_dht.h>
 
 
@@ -180,6 +181,111 @@ test_dht_poly1(void)
 }
 
 
+/* Test the fast transform
+ * Integrate[ x^(nu+1) exp(-x^2/2) J_nu(a x), {x,0,Inf}] = a^nu exp(-a^2/2)
+ */
+int
+test_dht_fftlog_gauss(double nu)
+{
+  int stat = 0;
+  int n;
+  double f_in[512];
+  double f_out[512];
+  gsl_dht * t = gsl_dht_new_with_type(gsl_dht_fftlog, 512, nu, 12.0);
+
+  for(n=0; n<512; n++) {
+    const double x = gsl_dht_x_sample(t, n);
+    f_in[n] = pow(x, nu) * exp(-0.5*x*x);
+  }
+
+  gsl_dht_apply(t, f_in, f_out);
+
+  /* The function is smooth and negligible beyond xmax,
+   * so the resampling is very accurate.
+   */
+  for(n=0; n<512; n++) {
+    const double k = gsl_dht_k_sample(t, n);
+    const double F = pow(k, nu) * exp(-0.5*k*k);
+    if(fabs(f_out[n] - F) > 1.0e-09) stat++;
+  }
+
+  gsl_dht_free(t);
+
+  return stat;
+}
+
+
+/* Compare the fast and dense transforms of the polynomial
+ * in test_dht_poly1.
+ */
+int
+test_dht_fftlog_poly1(void)
+{
+  int stat = 0;
+  int n;
+  double f_in[128];
+  double f_dense[128];
+  double f_fast[128];
+  gsl_dht * t = gsl_dht_new(128, 1.0, 1.0);
+  gsl_dht * tf = gsl_dht_new_with_type(gsl_dht_fftlog, 128, 1.0, 1.0);
+
+  for(n=0; n<128; n++) {
+    const double x = gsl_dht_x_sample(t, n);
+    f_in[n] = x * (1.0 - x*x);
+  }
+
+  gsl_dht_apply(t, f_in, f_dense);
+  gsl_dht_apply(tf, f_in, f_fast);
+
+  for(n=0; n<128; n++) {
+    if(fabs(f_fast[n] - f_dense[n]) > 1.0e-05 * fabs(f_dense[0])) stat++;
+  }
+
+  gsl_dht_free(tf);
+  gsl_dht_free(t);
+
+  return stat;
+}
+
+
+/* Batched transforms must agree with one-at-a-time ones.
+ */
+int
+test_dht_matrix(const gsl_dht_type * T)
+{
+  int stat = 0;
+  size_t i, n;
+  const size_t size = 100;
+  const size_t nvec = 11;
+  gsl_dht * t = gsl_dht_new_with_type(T, size, 0.5, 3.0);
+  gsl_matrix * F_in = gsl_matrix_alloc(nvec, size);
+  gsl_matrix * F_out = gsl_matrix_alloc(nvec, size);
+  double f_out[100];
+
+  for(i=0; i<nvec; i++) {
+    for(n=0; n<size; n++) {
+      const double x = gsl_dht_x_sample(t, n);
+      gsl_matrix_set(F_in, i, n, exp(-(i+1.0)*x*x) * cos(i*x));
+    }
+  }
+
+  gsl_dht_apply_matrix(t, F_in, F_out);
+
+  for(i=0; i<nvec; i++) {
+    gsl_dht_apply(t, gsl_matrix_ptr(F_in, i, 0), f_out);
+    for(n=0; n<size; n++) {
+      if(f_out[n] != gsl_matrix_get(F_out, i, n)) stat++;
+    }
+  }
+
+  gsl_matrix_free(F_out);
+  gsl_matrix_free(F_in);
+  gsl_dht_free(t);
+
+  return stat;
+}
+
+
 int main()
 {
   gsl_ieee_env_setup ();
@@ -189,5 +295,11 @@ int main()
   gsl_test( test_dht_exp1(),    "Exp  J1 DHT");
   gsl_test( test_dht_poly1(),   "Poly J1 DHT");
 
+  gsl_test( test_dht_fftlog_gauss(0.0), "FFTLog Gauss J0 DHT");
+  gsl_test( test_dht_fftlog_gauss(2.0), "FFTLog Gauss J2 DHT");
+  gsl_test( test_dht_fftlog_poly1(),    "FFTLog Poly J1 DHT");
+  gsl_test( test_dht_matrix(gsl_dht_dense),  "Dense  DHT matrix");
+  gsl_test( test_dht_matrix(gsl_dht_fftlog), "FFTLog DHT matrix");
+
   exit (gsl_test_summary());
 }
@@ -38,12 +38,33 @@
  *
  * See Golub & Van Loan, "Matrix Computations" (3rd ed),
  * algorithm 7.5.2
+ *
+ * For large matrices, a small-bulge multishift QR sweep with
+ * aggressive early deflation can optionally be used instead of the
+ * double shift sweep. See
+ *
+ * K. Braman, R. Byers and R. Mathias, "The multishift QR algorithm,
+ * Part I: Maintaining well-focused shifts and level 3 performance",
+ * SIAM J. Matrix Anal. Appl. 23 (2002), 929-947
+ *
+ * K. Braman, R. Byers and R. Mathias, "The multishift QR algorithm,
+ * Part II: Aggressive early deflation", SIAM J. Matrix Anal. Appl.
+ * 23 (2002), 948-973
  */
 
 /* exceptional shift coefficients - these values are from LAPACK DLAHQR */
 #define GSL_FRANCIS_COEFF1        (0.75)
 #define GSL_FRANCIS_COEFF2        (-0.4375)
 
+/* smallest active matrix for which the multishift sweep is used */
+#define GSL_FRANCIS_NMIN          75
+
+/*
+ * if aggressive early deflation deflates more than this percentage
+ * of the deflation window, the next QR sweep is skipped (LAPACK DLAQR0)
+ */
+#define GSL_FRANCIS_NIBBLE        14
+
 static inline void francis_schur_decomp(gsl_matrix * H,
                                         gsl_vector_complex * eval,
                                         gsl_eigen_francis_workspace * w);
@@ -56,6 +77,34 @@ static inline void francis_schur_standardize(gsl_matrix *A,
                                              gsl_eigen_francis_workspace *w);
 static inline size_t francis_get_submatrix(gsl_matrix *A, gsl_matrix *B);
 static void francis_standard_form(gsl_matrix *A, double *cs, double *sn);
+static void francis_multishift_free(gsl_eigen_francis_workspace *w);
+static size_t francis_nshifts(const size_t n);
+static size_t francis_nwindow(const size_t n);
+static int francis_multishift(gsl_matrix * H,
+                              gsl_eigen_francis_workspace * w);
+static int francis_aed(gsl_matrix * H, const size_t nw, const size_t ns_max,
+                       size_t * nd, size_t * nbulge,
+                       gsl_eigen_francis_workspace * w);
+static size_t francis_aed_shifts(const gsl_matrix * T, const size_t ns,
+                                 const size_t ns_max,
+                                 gsl_vector_complex * shifts);
+static int francis_move_block(gsl_matrix * T, gsl_matrix * V,
+                              const size_t ifst, const size_t ilst,
+                              const size_t nb);
+static int francis_swap(gsl_matrix * T, gsl_matrix * V, const size_t j1,
+                        const size_t n1, const size_t n2);
+static void francis_sweep(gsl_matrix * H, const size_t nbulge,
+                          gsl_eigen_francis_workspace * w);
+static void francis_bulge_step(gsl_matrix * H, const size_t k,
+                               const size_t r0, const size_t r1,
+                               const gsl_complex * shift, gsl_matrix * U);
+static void francis_update_offdiag(gsl_matrix * H, const size_t i0,
+                                   const gsl_matrix * U,
+                                   gsl_eigen_francis_workspace * w);
+static void francis_mul_right(gsl_matrix * A, const gsl_matrix * U,
+                              gsl_matrix * work);
+static void francis_mul_left(const gsl_matrix * U, gsl_matrix * A,
+                             gsl_matrix * work);
 
 /*
 gsl_eigen_francis_alloc()
@@ -92,6 +141,16 @@ gsl_eigen_francis_alloc(void)
   w->Z = NULL;
   w->H = NULL;
 
+  /* multishift QR is disabled by default */
+  w->nmax = 0;
+  w->T = NULL;
+  w->V = NULL;
+  w->U = NULL;
+  w->work = NULL;
+  w->evals = NULL;
+  w->shifts = NULL;
+  w->tau = NULL;
+
   return (w);
 } /* gsl_eigen_francis_alloc() */
 
@@ -104,6 +163,7 @@ void
 gsl_eigen_francis_free (gsl_eigen_francis_workspace *w)
 {
   RETURN_IF_NULL (w);
+  francis_multishift_free(w);
   free(w);
 } /* gsl_eigen_francis_free() */
 
@@ -122,6 +182,62 @@ gsl_eigen_francis_T (const int compute_t, gsl_eigen_francis_workspace *w)
   w->compute_t = compute_t;
 }
 
+/*
+gsl_eigen_francis_multishift()
+  Enable or disable the multishift QR algorithm with aggressive
+early deflation for large matrices. Active matrices of order at
+least GSL_FRANCIS_NMIN are then reduced with multishift sweeps,
+smaller ones with double shift sweeps.
+
+Inputs: nmax - order of the largest matrix which will be passed
+               to gsl_eigen_francis(); the number of shifts and the
+               size of the deflation window are chosen for this
+               size. Set to 0 to disable multishift QR
+        w    - francis workspace
+
+Return: success or error
+
+Notes: the workspace is O(ns^2), where ns <= 256 is the number of
+       shifts used for matrices of order nmax. Larger matrices
+       may still be passed to gsl_eigen_francis(), but use at
+       most ns shifts
+*/
+
+int
+gsl_eigen_francis_multishift (const size_t nmax,
+                              gsl_eigen_francis_workspace *w)
+{
+  francis_multishift_free(w);
+
+  if (nmax > 0)
+    {
+      const size_t ns = francis_nshifts(nmax);
+      const size_t nw = GSL_MIN(francis_nwindow(nmax), nmax);
+      const size_t nu = GSL_MIN(4 * ns, nmax);
+      const size_t nwork = GSL_MAX(nu, nw);
+
+      w->T = gsl_matrix_alloc(nw, nw);
+      w->V = gsl_matrix_alloc(nw, nw);
+      w->U = gsl_matrix_alloc(nu, nu);
+      w->work = gsl_matrix_alloc(nwork, nwork);
+      w->evals = gsl_vector_complex_alloc(nw);
+      w->shifts = gsl_vector_complex_alloc(ns);
+      w->tau = gsl_vector_alloc(nw);
+
+      if (w->T == 0 || w->V == 0 || w->U == 0 || w->work == 0 ||
+          w->evals == 0 || w->shifts == 0 || w->tau == 0)
+        {
+          francis_multishift_free(w);
+          GSL_ERROR ("failed to allocate space for multishift workspace",
+                     GSL_ENOMEM);
+        }
+
+      w->nmax = nmax;
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_eigen_francis_multishift() */
+
 /*
 gsl_eigen_francis()
 
@@ -308,9 +424,16 @@ francis_schur_decomp(gsl_matrix * H, gsl_vector_complex * eval,
         {
           /*
            * no small subdiagonal element found - perform a QR
-           * sweep on the active reduced hessenberg matrix
+           * sweep on the active reduced hessenberg matrix. The
+           * double shift sweep is used for small matrices and
+           * for the exceptional shifts
            */
-          francis_qrstep(&m.matrix, w);
+          if (w->nmax > 0 && N >= GSL_FRANCIS_NMIN &&
+              (w->n_iter % 10) != 0)
+            francis_multishift(&m.matrix, w);
+          else
+            francis_qrstep(&m.matrix, w);
+
           continue;
         }
 
@@ -1046,3 +1169,1135 @@ francis_standard_form(gsl_matrix *A, double *cs, double *sn)
   gsl_matrix_set(A, 1, 0, c);
   gsl_matrix_set(A, 1, 1, d);
 } /* francis_standard_form() */
+
+/*
+francis_multishift_free()
+  Free the multishift QR workspace
+*/
+
+static void
+francis_multishift_free(gsl_eigen_francis_workspace *w)
+{
+  if (w->T)
+    gsl_matrix_free(w->T);
+
+  if (w->V)
+    gsl_matrix_free(w->V);
+
+  if (w->U)
+    gsl_matrix_free(w->U);
+
+  if (w->work)
+    gsl_matrix_free(w->work);
+
+  if (w->evals)
+    gsl_vector_complex_free(w->evals);
+
+  if (w->shifts)
+    gsl_vector_complex_free(w->shifts);
+
+  if (w->tau)
+    gsl_vector_free(w->tau);
+
+  w->nmax = 0;
+  w->T = NULL;
+  w->V = NULL;
+  w->U = NULL;
+  w->work = NULL;
+  w->evals = NULL;
+  w->shifts = NULL;
+  w->tau = NULL;
+} /* francis_multishift_free() */
+
+/*
+francis_nshifts()
+  Number of simultaneous shifts for a matrix of order n; these
+values are from LAPACK IPARMQ
+*/
+
+static size_t
+francis_nshifts(const size_t n)
+{
+  size_t ns;
+
+  if (n < 30)
+    ns = 2;
+  else if (n < 60)
+    ns = 4;
+  else if (n < 150)
+    ns = 10;
+  else if (n < 590)
+    {
+      size_t lg = (size_t) floor(log((double) n) / M_LN2 + 0.5);
+      ns = GSL_MAX(10, n / lg);
+    }
+  else if (n < 3000)
+    ns = 64;
+  else if (n < 6000)
+    ns = 128;
+  else
+    ns = 256;
+
+  /* shifts are used in pairs */
+  ns -= ns % 2;
+
+  return GSL_MAX(ns, 2);
+} /* francis_nshifts() */
+
+/*
+francis_nwindow()
+  Size of the aggressive early deflation window for a matrix of
+order n (LAPACK IPARMQ)
+*/
+
+static size_t
+francis_nwindow(const size_t n)
+{
+  const size_t ns = francis_nshifts(n);
+
+  if (n <= 500)
+    return ns;
+  else
+    return 3 * ns / 2;
+} /* francis_nwindow() */
+
+/*
+francis_multishift()
+  Perform one iteration of the multishift QR algorithm on the active
+matrix H: an aggressive early deflation step, followed by a
+multishift sweep on the undeflated part of H using the eigenvalues
+of the deflation window as shifts. Deflated eigenvalues are left on
+the diagonal of H with zero subdiagonal elements, where they are
+found by francis_search_subdiag_small_elements().
+
+Inputs: H - upper Hessenberg matrix, order at least GSL_FRANCIS_NMIN
+        w - workspace
+
+Notes: based on LAPACK DLAQR0
+*/
+
+static int
+francis_multishift(gsl_matrix * H, gsl_eigen_francis_workspace * w)
+{
+  const size_t N = H->size1;
+  size_t ns, nw, nd, nbulge;
+  int status;
+
+  /*
+   * number of shifts and window size, limited by the size of the
+   * active matrix and of the workspace. The U matrix of a sweep
+   * with ns shifts has order at most 4 * ns
+   */
+  ns = GSL_MIN(francis_nshifts(N), (N + 6) / 9);
+  ns = GSL_MIN(ns, w->shifts->size);
+  ns = GSL_MIN(ns, w->U->size1 / 4);
+  ns -= ns % 2;
+
+  nw = GSL_MIN(francis_nwindow(N), (N - 1) / 3);
+  nw = GSL_MIN(nw, w->T->size1);
+
+  if (ns < 2 || nw < 2)
+    return francis_qrstep(H, w);
+
+  status = francis_aed(H, nw, ns, &nd, &nbulge, w);
+  if (status)
+    {
+      /* QR iteration on the window failed to converge */
+      return francis_qrstep(H, w);
+    }
+
+  if (nd > 0 && 100 * nd > GSL_FRANCIS_NIBBLE * nw)
+    {
+      /*
+       * enough eigenvalues were deflated that the caller should
+       * split them off before the next sweep
+       */
+      return GSL_SUCCESS;
+    }
+
+  if (nbulge == 0)
+    {
+      if (nd == 0)
+        return francis_qrstep(H, w);
+
+      return GSL_SUCCESS;
+    }
+
+  /* sweep over the undeflated part of H */
+  {
+    gsl_matrix_view m = gsl_matrix_submatrix(H, 0, 0, N - nd, N - nd);
+    francis_sweep(&m.matrix, nbulge, w);
+  }
+
+  return GSL_SUCCESS;
+} /* francis_multishift() */
+
+/*
+francis_aed()
+  Aggressive early deflation: compute the Schur decomposition
+
+T = V^t H_w V
+
+of the trailing nw-by-nw window H_w of H, and deflate the
+eigenvalues whose component of the spike s V(1,:) is negligible,
+where s = H(kwtop,kwtop-1) couples H_w to the rest of H. The
+undeflatable eigenvalues are moved to the top of T, and the
+remaining part of the window is returned to Hessenberg form. If
+nothing can be deflated H is left unchanged.
+
+Inputs: H      - upper Hessenberg matrix
+        nw     - size of deflation window, nw < N
+        ns_max - maximum number of shifts to return
+        nd     - (output) number of deflated eigenvalues; these
+                 are in the trailing nd-by-nd block of H, which
+                 is decoupled from the rest of H
+        nbulge - (output) number of shift pairs stored in w->shifts
+        w      - workspace
+
+Return: success, or error if the QR iteration on the window failed
+
+Notes: based on LAPACK DLAQR3
+*/
+
+static int
+francis_aed(gsl_matrix * H, const size_t nw, const size_t ns_max,
+            size_t * nd, size_t * nbulge, gsl_eigen_francis_workspace * w)
+{
+  const size_t N = H->size1;
+  const size_t kwtop = N - nw;
+  const double eps = GSL_DBL_EPSILON;
+  const double smlnum = GSL_DBL_MIN * ((double) N / eps);
+  gsl_matrix_view T = gsl_matrix_submatrix(w->T, 0, 0, nw, nw);
+  gsl_matrix_view V = gsl_matrix_submatrix(w->V, 0, 0, nw, nw);
+  gsl_vector_complex_view eval = gsl_vector_complex_subvector(w->evals, 0, nw);
+  gsl_matrix_view Hw = gsl_matrix_submatrix(H, kwtop, kwtop, nw, nw);
+  gsl_eigen_francis_workspace inner = *w;
+  double s = gsl_matrix_get(H, kwtop, kwtop - 1);
+  size_t ns, ilst, i;
+
+  /* compute the Schur form of the window with double shift sweeps */
+
+  gsl_matrix_memcpy(&T.matrix, &Hw.matrix);
+  gsl_linalg_hessenberg_set_zero(&T.matrix);
+  gsl_matrix_set_identity(&V.matrix);
+
+  inner.size = nw;
+  inner.max_iterations = 30 * nw;
+  inner.n_iter = 0;
+  inner.n_evals = 0;
+  inner.compute_t = 1;
+  inner.H = &T.matrix;
+  inner.Z = &V.matrix;
+  inner.nmax = 0;
+
+  francis_schur_decomp(&T.matrix, &eval.vector, &inner);
+
+  if (inner.n_evals != nw)
+    return GSL_EMAXITER;
+
+  /* remove the scratch elements left below the subdiagonal */
+  gsl_linalg_hessenberg_set_zero(&T.matrix);
+
+  /*
+   * deflation detection: check the diagonal blocks of T from the
+   * bottom up. Blocks with a small spike component are deflated,
+   * the others are moved to the top of T
+   */
+
+  ns = nw;
+  ilst = 0;
+
+  while (ilst < ns)
+    {
+      size_t nb = 1;    /* size of bottom undeflated block */
+      size_t j;
+      double foo, spike;
+
+      if (ns > 1 && gsl_matrix_get(&T.matrix, ns - 1, ns - 2) != 0.0)
+        nb = 2;
+
+      j = ns - nb;
+
+      if (nb == 1)
+        {
+          foo = fabs(gsl_matrix_get(&T.matrix, j, j));
+          spike = fabs(s * gsl_matrix_get(&V.matrix, 0, j));
+        }
+      else
+        {
+          foo = fabs(gsl_matrix_get(&T.matrix, j + 1, j + 1)) +
+                sqrt(fabs(gsl_matrix_get(&T.matrix, j, j + 1))) *
+                sqrt(fabs(gsl_matrix_get(&T.matrix, j + 1, j)));
+          spike = GSL_MAX(fabs(s * gsl_matrix_get(&V.matrix, 0, j)),
+                          fabs(s * gsl_matrix_get(&V.matrix, 0, j + 1)));
+        }
+
+      if (foo == 0.0)
+        foo = fabs(s);
+
+      if (spike <= GSL_MAX(smlnum, eps * foo))
+        {
+          /* deflatable */
+          ns -= nb;
+        }
+      else
+        {
+          /*
+           * undeflatable - move it to the top of the window. If the
+           * swap is rejected as too ill-conditioned, stop looking
+           * for further deflations
+           */
+          if (francis_move_block(&T.matrix, &V.matrix, j, ilst, nb))
+            break;
+
+          ilst += nb;
+        }
+    }
+
+  /* the undeflated eigenvalues are the shifts for the next sweep */
+  *nbulge = francis_aed_shifts(&T.matrix, ns, ns_max, w->shifts);
+  *nd = nw - ns;
+
+  if (ns == 0)
+    s = 0.0;
+
+  if (ns < nw || s == 0.0)
+    {
+      if (ns > 1 && s != 0.0)
+        {
+          gsl_matrix_view T11 = gsl_matrix_submatrix(&T.matrix, 0, 0, ns, ns);
+          gsl_matrix_view V1 = gsl_matrix_submatrix(&V.matrix, 0, 0, nw, ns);
+          gsl_matrix_view Uh = gsl_matrix_submatrix(w->U, 0, 0, ns, ns);
+          gsl_vector_view tau = gsl_vector_subvector(w->tau, 0, ns);
+          gsl_vector_view x = gsl_matrix_subrow(w->work, 0, 0, ns);
+          gsl_vector_const_view v1 = gsl_matrix_const_subrow(&V.matrix, 0, 0, ns);
+          gsl_matrix_view m;
+          double tau_s;
+
+          /*
+           * reflect the spike back into its first component, which
+           * destroys the quasi-triangular form of T(1:ns,1:ns)
+           */
+          gsl_vector_memcpy(&x.vector, &v1.vector);
+          tau_s = gsl_linalg_householder_transform(&x.vector);
+
+          gsl_linalg_householder_hm(tau_s, &x.vector, &T11.matrix);
+          if (ns < nw)
+            {
+              m = gsl_matrix_submatrix(&T.matrix, 0, ns, ns, nw - ns);
+              gsl_linalg_householder_hm(tau_s, &x.vector, &m.matrix);
+            }
+
+          gsl_linalg_householder_mh(tau_s, &x.vector, &T11.matrix);
+          gsl_linalg_householder_mh(tau_s, &x.vector, &V1.matrix);
+
+          /*
+           * reduce T(1:ns,1:ns) to Hessenberg form; the first row
+           * and column are not changed, so the spike stays zero
+           * below its first component
+           */
+          gsl_linalg_hessenberg_decomp(&T11.matrix, &tau.vector);
+          gsl_linalg_hessenberg_unpack(&T11.matrix, &tau.vector, &Uh.matrix);
+          gsl_linalg_hessenberg_set_zero(&T11.matrix);
+
+          if (ns < nw)
+            {
+              m = gsl_matrix_submatrix(&T.matrix, 0, ns, ns, nw - ns);
+              francis_mul_left(&Uh.matrix, &m.matrix, w->work);
+            }
+
+          francis_mul_right(&V1.matrix, &Uh.matrix, w->work);
+        }
+
+      /* copy the reduced window and the new spike into H */
+
+      gsl_matrix_memcpy(&Hw.matrix, &T.matrix);
+
+      gsl_matrix_set(H, kwtop, kwtop - 1, s * gsl_matrix_get(&V.matrix, 0, 0));
+      for (i = 1; i < nw; ++i)
+        gsl_matrix_set(H, kwtop + i, kwtop - 1, 0.0);
+
+      /* apply V to the rest of H and to Z */
+      francis_update_offdiag(H, kwtop, &V.matrix, w);
+    }
+
+  return GSL_SUCCESS;
+} /* francis_aed() */
+
+/*
+francis_aed_shifts()
+  Store the eigenvalues of the bottom diagonal blocks of the
+quasi-triangular matrix T(1:ns,1:ns) as pairs of shifts, either
+complex conjugate or both real
+
+Inputs: T      - upper quasi-triangular matrix in standard form
+        ns     - size of the leading block of T to use
+        ns_max - maximum number of shifts (even)
+        shifts - (output) shifts
+
+Return: number of shift pairs stored
+*/
+
+static size_t
+francis_aed_shifts(const gsl_matrix * T, const size_t ns,
+                   const size_t ns_max, gsl_vector_complex * shifts)
+{
+  size_t nshift = 0;
+  size_t j = ns;
+  int have_real = 0;
+  double sr = 0.0;
+  gsl_complex z;
+
+  while (j > 0 && nshift + 2 <= ns_max)
+    {
+      if (j > 1 && gsl_matrix_get(T, j - 1, j - 2) != 0.0)
+        {
+          /* 2-by-2 block in standard form: T11 = T22 = a */
+          double a = gsl_matrix_get(T, j - 2, j - 2);
+          double b = sqrt(fabs(gsl_matrix_get(T, j - 2, j - 1))) *
+                     sqrt(fabs(gsl_matrix_get(T, j - 1, j - 2)));
+
+          GSL_SET_COMPLEX(&z, a, b);
+          gsl_vector_complex_set(shifts, nshift, z);
+          GSL_SET_COMPLEX(&z, a, -b);
+          gsl_vector_complex_set(shifts, nshift + 1, z);
+          nshift += 2;
+
+          j -= 2;
+        }
+      else
+        {
+          double t = gsl_matrix_get(T, j - 1, j - 1);
+
+          if (have_real)
+            {
+              GSL_SET_COMPLEX(&z, sr, 0.0);
+              gsl_vector_complex_set(shifts, nshift, z);
+              GSL_SET_COMPLEX(&z, t, 0.0);
+              gsl_vector_complex_set(shifts, nshift + 1, z);
+              nshift += 2;
+              have_real = 0;
+            }
+          else
+            {
+              sr = t;
+              have_real = 1;
+            }
+
+          j -= 1;
+        }
+    }
+
+  return nshift / 2;
+} /* francis_aed_shifts() */
+
+/*
+francis_move_block()
+  Move the diagonal block of size nb at row ifst of the upper
+quasi-triangular matrix T up to row ilst by swapping it with the
+blocks above, accumulating the transformations into V (LAPACK DTREXC)
+
+Return: success, or failure if a swap was rejected or the block
+        split into two 1-by-1 blocks
+*/
+
+static int
+francis_move_block(gsl_matrix * T, gsl_matrix * V, const size_t ifst,
+                   const size_t ilst, const size_t nb)
+{
+  size_t here = ifst;
+
+  while (here > ilst)
+    {
+      size_t nbf = 1; /* size of the block above */
+      int status;
+
+      if (here > ilst + 1 && gsl_matrix_get(T, here - 1, here - 2) != 0.0)
+        nbf = 2;
+
+      status = francis_swap(T, V, here - nbf, nbf, nb);
+      if (status)
+        return status;
+
+      here -= nbf;
+
+      if (nb == 2 && gsl_matrix_get(T, here + 1, here) == 0.0)
+        return GSL_FAILURE;
+    }
+
+  return GSL_SUCCESS;
+} /* francis_move_block() */
+
+/*
+francis_reflector()
+  Compute a Householder reflection I - tau u u^t with u(p) = 1
+which maps the 3-vector x to a multiple of e_p, for p = 0 or 2.
+On output x contains u.
+*/
+
+static double
+francis_reflector(double x[3], const size_t p)
+{
+  double y[3];
+  gsl_vector_view v = gsl_vector_view_array(y, 3);
+  double tau;
+
+  /* householder_transform() reduces to the first component */
+  y[0] = x[p];
+  y[1] = x[1];
+  y[2] = x[2 - p];
+
+  tau = gsl_linalg_householder_transform(&v.vector);
+
+  x[p] = 1.0;
+  x[1] = y[1];
+  x[2 - p] = y[2];
+
+  return tau;
+} /* francis_reflector() */
+
+/*
+francis_reflect()
+  Apply the reflection I - tau u u^t with 3-vector u to the 3
+rows (left) or 3 columns (right) of A
+*/
+
+static void
+francis_reflect(const int left, const double tau, const double u[3],
+                gsl_matrix * A)
+{
+  const size_t n = left ? A->size2 : A->size1;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      double *a0 = left ? gsl_matrix_ptr(A, 0, i) : gsl_matrix_ptr(A, i, 0);
+      double *a1 = left ? gsl_matrix_ptr(A, 1, i) : gsl_matrix_ptr(A, i, 1);
+      double *a2 = left ? gsl_matrix_ptr(A, 2, i) : gsl_matrix_ptr(A, i, 2);
+      double sum = tau * (u[0] * *a0 + u[1] * *a1 + u[2] * *a2);
+
+      *a0 -= sum * u[0];
+      *a1 -= sum * u[1];
+      *a2 -= sum * u[2];
+    }
+} /* francis_reflect() */
+
+/*
+francis_sylvester()
+  Solve the small Sylvester equation
+
+T11 X - X T22 = T12
+
+with n1, n2 <= 2, where T11 = D(1:n1,1:n1), T12 = D(1:n1,n1+1:nd)
+and T22 = D(n1+1:nd,n1+1:nd), by Gaussian elimination with complete
+pivoting on the Kronecker product form. Small pivots are perturbed
+as in LAPACK DLASY2, since the swap is tested for stability later.
+
+Inputs: D - nd-by-nd matrix
+        x - (output) X stored by rows, x[i*n2 + j] = X(i,j)
+*/
+
+static void
+francis_sylvester(const gsl_matrix * D, const size_t n1, const size_t n2,
+                  double x[4])
+{
+  const size_t n = n1 * n2;
+  const double eps = GSL_DBL_EPSILON;
+  double K[4][4];
+  size_t perm[4];
+  size_t i, j, k, l;
+  double kmax = 0.0, smin;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          const size_t row = i * n2 + j;
+
+          for (k = 0; k < n1; ++k)
+            {
+              for (l = 0; l < n2; ++l)
+                {
+                  double kij = 0.0;
+
+                  if (l == j)
+                    kij += gsl_matrix_get(D, i, k);
+                  if (k == i)
+                    kij -= gsl_matrix_get(D, n1 + l, n1 + j);
+
+                  K[row][k * n2 + l] = kij;
+                  kmax = GSL_MAX(kmax, fabs(kij));
+                }
+            }
+
+          x[row] = gsl_matrix_get(D, i, n1 + j);
+        }
+    }
+
+  smin = GSL_MAX(eps * kmax, GSL_DBL_MIN / eps);
+
+  for (i = 0; i < n; ++i)
+    perm[i] = i;
+
+  /* elimination with complete pivoting */
+  for (k = 0; k < n; ++k)
+    {
+      size_t ip = k, jp = k;
+      double pmax = 0.0;
+
+      for (i = k; i < n; ++i)
+        {
+          for (j = k; j < n; ++j)
+            {
+              if (fabs(K[i][j]) > pmax)
+                {
+                  pmax = fabs(K[i][j]);
+                  ip = i;
+                  jp = j;
+                }
+            }
+        }
+
+      if (ip != k)
+        {
+          double tmp;
+
+          for (j = 0; j < n; ++j)
+            {
+              tmp = K[k][j];
+              K[k][j] = K[ip][j];
+              K[ip][j] = tmp;
+            }
+
+          tmp = x[k];
+          x[k] = x[ip];
+          x[ip] = tmp;
+        }
+
+      if (jp != k)
+        {
+          size_t itmp;
+
+          for (i = 0; i < n; ++i)
+            {
+              double tmp = K[i][k];
+              K[i][k] = K[i][jp];
+              K[i][jp] = tmp;
+            }
+
+          itmp = perm[k];
+          perm[k] = perm[jp];
+          perm[jp] = itmp;
+        }
+
+      if (fabs(K[k][k]) < smin)
+        K[k][k] = smin;
+
+      for (i = k + 1; i < n; ++i)
+        {
+          double lik = K[i][k] / K[k][k];
+
+          for (j = k + 1; j < n; ++j)
+            K[i][j] -= lik * K[k][j];
+
+          x[i] -= lik * x[k];
+        }
+    }
+
+  /* back substitution */
+  for (k = n; k-- > 0; )
+    {
+      for (j = k + 1; j < n; ++j)
+        x[k] -= K[k][j] * x[j];
+
+      x[k] /= K[k][k];
+    }
+
+  /* undo the column permutation */
+  {
+    double y[4];
+
+    for (k = 0; k < n; ++k)
+      y[perm[k]] = x[k];
+
+    for (k = 0; k < n; ++k)
+      x[k] = y[k];
+  }
+} /* francis_sylvester() */
+
+/*
+francis_swap()
+  Swap the adjacent diagonal blocks T11 (n1-by-n1) and T22
+(n2-by-n2) of the upper quasi-triangular matrix T, where T11 starts
+at row j1, with an orthogonal similarity transformation which is
+accumulated into V. The 2-by-2 blocks are returned in standard form.
+
+Return: success, or failure if the swap was rejected because the
+        result would be too far from quasi-triangular
+
+Notes: based on LAPACK DLAEXC
+*/
+
+static int
+francis_swap(gsl_matrix * T, gsl_matrix * V, const size_t j1,
+             const size_t n1, const size_t n2)
+{
+  const size_t N = T->size1;
+  const size_t nd = n1 + n2;
+  const size_t j2 = j1 + 1;
+  gsl_vector_view xv, yv;
+  gsl_matrix_view m;
+
+  if (n1 == 1 && n2 == 1)
+    {
+      /* swap two 1-by-1 blocks with a Givens rotation */
+      const double t11 = gsl_matrix_get(T, j1, j1);
+      const double t22 = gsl_matrix_get(T, j2, j2);
+      const double f = gsl_matrix_get(T, j1, j2);
+      const double g = t22 - t11;
+      const double r = gsl_hypot(f, g);
+      double cs, sn;
+
+      if (r == 0.0)
+        return GSL_SUCCESS;
+
+      cs = f / r;
+      sn = g / r;
+
+      if (j1 + 2 < N)
+        {
+          xv = gsl_matrix_subrow(T, j1, j1 + 2, N - j1 - 2);
+          yv = gsl_matrix_subrow(T, j2, j1 + 2, N - j1 - 2);
+          gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+        }
+
+      if (j1 > 0)
+        {
+          xv = gsl_matrix_subcolumn(T, j1, 0, j1);
+          yv = gsl_matrix_subcolumn(T, j2, 0, j1);
+          gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+        }
+
+      gsl_matrix_set(T, j1, j1, t22);
+      gsl_matrix_set(T, j2, j2, t11);
+
+      xv = gsl_matrix_column(V, j1);
+      yv = gsl_matrix_column(V, j2);
+      gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+    }
+  else
+    {
+      const double eps = GSL_DBL_EPSILON;
+      double d[16], x[4], u[3], u2[3];
+      gsl_matrix_view D = gsl_matrix_view_array(d, nd, nd);
+      double dnorm, thresh, tau, tau2;
+
+      /*
+       * solve T11 X - X T22 = T12; the columns of [ -X ; I ] span
+       * the invariant subspace of T22, which is moved to the top
+       * with reflections. The swap is first tried on a copy D of
+       * the blocks to check that it is stable
+       */
+
+      m = gsl_matrix_submatrix(T, j1, j1, nd, nd);
+      gsl_matrix_memcpy(&D.matrix, &m.matrix);
+
+      dnorm = GSL_MAX(fabs(gsl_matrix_max(&D.matrix)),
+                      fabs(gsl_matrix_min(&D.matrix)));
+      thresh = GSL_MAX(10.0 * eps * dnorm, GSL_DBL_MIN / eps);
+
+      francis_sylvester(&D.matrix, n1, n2, x);
+
+      if (n1 == 1)
+        {
+          /* n1 = 1, n2 = 2 */
+          const double t11 = gsl_matrix_get(T, j1, j1);
+
+          u[0] = 1.0;
+          u[1] = x[0];
+          u[2] = x[1];
+          tau = francis_reflector(u, 2);
+
+          francis_reflect(1, tau, u, &D.matrix);
+          francis_reflect(0, tau, u, &D.matrix);
+
+          /* reject the swap if D(3,1:2) or D(3,3) - t11 are not small */
+          if (GSL_MAX(GSL_MAX(fabs(d[6]), fabs(d[7])), fabs(d[8] - t11)) > thresh)
+            return GSL_FAILURE;
+
+          m = gsl_matrix_submatrix(T, j1, j1, 3, N - j1);
+          francis_reflect(1, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(T, 0, j1, j1 + 2, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+
+          gsl_matrix_set(T, j1 + 2, j1, 0.0);
+          gsl_matrix_set(T, j1 + 2, j1 + 1, 0.0);
+          gsl_matrix_set(T, j1 + 2, j1 + 2, t11);
+
+          m = gsl_matrix_submatrix(V, 0, j1, V->size1, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+        }
+      else if (n2 == 1)
+        {
+          /* n1 = 2, n2 = 1 */
+          const double t33 = gsl_matrix_get(T, j1 + 2, j1 + 2);
+
+          u[0] = -x[0];
+          u[1] = -x[1];
+          u[2] = 1.0;
+          tau = francis_reflector(u, 0);
+
+          francis_reflect(1, tau, u, &D.matrix);
+          francis_reflect(0, tau, u, &D.matrix);
+
+          if (GSL_MAX(GSL_MAX(fabs(d[3]), fabs(d[6])), fabs(d[0] - t33)) > thresh)
+            return GSL_FAILURE;
+
+          m = gsl_matrix_submatrix(T, 0, j1, j1 + 3, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(T, j1, j1 + 1, 3, N - j1 - 1);
+          francis_reflect(1, tau, u, &m.matrix);
+
+          gsl_matrix_set(T, j1, j1, t33);
+          gsl_matrix_set(T, j1 + 1, j1, 0.0);
+          gsl_matrix_set(T, j1 + 2, j1, 0.0);
+
+          m = gsl_matrix_submatrix(V, 0, j1, V->size1, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+        }
+      else
+        {
+          /* n1 = n2 = 2 */
+          double temp;
+
+          u[0] = -x[0];
+          u[1] = -x[2];
+          u[2] = 1.0;
+          tau = francis_reflector(u, 0);
+
+          temp = -tau * (x[1] + u[1] * x[3]);
+          u2[0] = -temp * u[1] - x[3];
+          u2[1] = -temp * u[2];
+          u2[2] = 1.0;
+          tau2 = francis_reflector(u2, 0);
+
+          m = gsl_matrix_submatrix(&D.matrix, 0, 0, 3, 4);
+          francis_reflect(1, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(&D.matrix, 0, 0, 4, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(&D.matrix, 1, 0, 3, 4);
+          francis_reflect(1, tau2, u2, &m.matrix);
+          m = gsl_matrix_submatrix(&D.matrix, 0, 1, 4, 3);
+          francis_reflect(0, tau2, u2, &m.matrix);
+
+          if (GSL_MAX(GSL_MAX(fabs(d[8]), fabs(d[9])),
+                      GSL_MAX(fabs(d[12]), fabs(d[13]))) > thresh)
+            return GSL_FAILURE;
+
+          m = gsl_matrix_submatrix(T, j1, j1, 3, N - j1);
+          francis_reflect(1, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(T, 0, j1, j1 + 4, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(T, j1 + 1, j1, 3, N - j1);
+          francis_reflect(1, tau2, u2, &m.matrix);
+          m = gsl_matrix_submatrix(T, 0, j1 + 1, j1 + 4, 3);
+          francis_reflect(0, tau2, u2, &m.matrix);
+
+          gsl_matrix_set(T, j1 + 2, j1, 0.0);
+          gsl_matrix_set(T, j1 + 2, j1 + 1, 0.0);
+          gsl_matrix_set(T, j1 + 3, j1, 0.0);
+          gsl_matrix_set(T, j1 + 3, j1 + 1, 0.0);
+
+          m = gsl_matrix_submatrix(V, 0, j1, V->size1, 3);
+          francis_reflect(0, tau, u, &m.matrix);
+          m = gsl_matrix_submatrix(V, 0, j1 + 1, V->size1, 3);
+          francis_reflect(0, tau2, u2, &m.matrix);
+        }
+
+      /* return the 2-by-2 blocks to standard form */
+      {
+        size_t jb[2];
+        size_t nblk = 0, b;
+
+        if (n2 == 2)
+          jb[nblk++] = j1;
+        if (n1 == 2)
+          jb[nblk++] = j1 + n2;
+
+        for (b = 0; b < nblk; ++b)
+          {
+            const size_t j = jb[b];
+            double cs, sn;
+
+            m = gsl_matrix_submatrix(T, j, j, 2, 2);
+            francis_standard_form(&m.matrix, &cs, &sn);
+
+            if (j + 2 < N)
+              {
+                xv = gsl_matrix_subrow(T, j, j + 2, N - j - 2);
+                yv = gsl_matrix_subrow(T, j + 1, j + 2, N - j - 2);
+                gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+              }
+
+            if (j > 0)
+              {
+                xv = gsl_matrix_subcolumn(T, j, 0, j);
+                yv = gsl_matrix_subcolumn(T, j + 1, 0, j);
+                gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+              }
+
+            xv = gsl_matrix_column(V, j);
+            yv = gsl_matrix_column(V, j + 1);
+            gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+          }
+      }
+    }
+
+  return GSL_SUCCESS;
+} /* francis_swap() */
+
+/*
+francis_sweep()
+  Perform a multishift QR sweep on the Hessenberg matrix H with
+nbulge double shift bulges, using the shift pairs stored in
+w->shifts. Bulge p follows bulge p - 1 at a distance of 4 rows, so
+the bulges never interact and the sweep is equivalent to nbulge
+consecutive double shift sweeps.
+
+The sweep is divided into windows of 4 * nbulge chase steps. The
+reflections of a window only act on rows and columns r0:r1 of H, so
+they are applied directly to H(r0:r1,r0:r1) and accumulated into an
+orthogonal matrix U, which is then applied to the rest of H (and
+Z) with matrix-matrix products.
+
+Notes: the bulges are spaced further apart than in LAPACK DLAQR5,
+       which packs them in chains of 3-by-3 bulges, and U is
+       treated as a full matrix
+*/
+
+static void
+francis_sweep(gsl_matrix * H, const size_t nbulge,
+              gsl_eigen_francis_workspace * w)
+{
+  const size_t N = H->size1;
+  const size_t kstep = 4 * nbulge;
+  const size_t tend = (N - 2) + 4 * (nbulge - 1); /* time of last step */
+  size_t t0;
+
+  for (t0 = 0; t0 <= tend; t0 += kstep)
+    {
+      const size_t t1 = GSL_MIN(t0 + kstep - 1, tend);
+      const size_t kmin = (t0 > 4 * (nbulge - 1)) ? t0 - 4 * (nbulge - 1) : 0;
+      const size_t kmax = GSL_MIN(N - 2, t1);
+      const size_t r0 = (kmin > 0) ? kmin - 1 : 0;
+      const size_t r1 = GSL_MIN(N - 1, kmax + 3);
+      gsl_matrix_view U = gsl_matrix_submatrix(w->U, 0, 0, r1 - r0 + 1, r1 - r0 + 1);
+      size_t t, p;
+
+      gsl_matrix_set_identity(&U.matrix);
+
+      for (t = t0; t <= t1; ++t)
+        {
+          /* at time t, bulge p is at step k = t - 4p */
+          for (p = 0; p < nbulge && 4 * p <= t; ++p)
+            {
+              const size_t k = t - 4 * p;
+
+              if (k <= N - 2)
+                {
+                  francis_bulge_step(H, k, r0, r1,
+                                     gsl_vector_complex_const_ptr(w->shifts, 2 * p),
+                                     &U.matrix);
+                }
+            }
+        }
+
+      francis_update_offdiag(H, r0, &U.matrix, w);
+    }
+} /* francis_sweep() */
+
+/*
+francis_bulge_step()
+  Step k of a double shift bulge chase: introduce the bulge with the
+shift pair shift[0], shift[1] (k = 0), or move it from column k - 1
+to column k. The reflection is applied to H(r0:r1,r0:r1) and
+accumulated into U, whose first row/column corresponds to r0.
+
+Notes: the first column of (H - s1 I)(H - s2 I) is computed as in
+       LAPACK DLAQR1
+*/
+
+static void
+francis_bulge_step(gsl_matrix * H, const size_t k, const size_t r0,
+                   const size_t r1, const gsl_complex * shift,
+                   gsl_matrix * U)
+{
+  const size_t N = H->size1;
+  const size_t nr = (k + 2 < N) ? 3 : 2;
+  double dat[3];
+  gsl_vector_view v = gsl_vector_view_array(dat, nr);
+  gsl_matrix_view m;
+  double tau;
+  size_t i, rlast;
+
+  if (k == 0)
+    {
+      const double sr1 = GSL_REAL(shift[0]), si1 = GSL_IMAG(shift[0]);
+      const double sr2 = GSL_REAL(shift[1]), si2 = GSL_IMAG(shift[1]);
+      const double h00 = gsl_matrix_get(H, 0, 0);
+      const double h10 = gsl_matrix_get(H, 1, 0);
+      const double s = fabs(h00 - sr2) + fabs(si2) + fabs(h10);
+
+      if (s == 0.0)
+        return;
+
+      {
+        const double h10s = h10 / s;
+
+        dat[0] = (h00 - sr1) * ((h00 - sr2) / s) - si1 * (si2 / s) +
+                 gsl_matrix_get(H, 0, 1) * h10s;
+        dat[1] = h10s * (h00 + gsl_matrix_get(H, 1, 1) - sr1 - sr2);
+        dat[2] = h10s * gsl_matrix_get(H, 2, 1);
+      }
+    }
+  else
+    {
+      for (i = 0; i < nr; ++i)
+        dat[i] = gsl_matrix_get(H, k + i, k - 1);
+    }
+
+  tau = gsl_linalg_householder_transform(&v.vector);
+
+  if (k > 0)
+    {
+      /* the bulge is chased out of column k - 1 */
+      gsl_matrix_set(H, k, k - 1, dat[0]);
+      for (i = 1; i < nr; ++i)
+        gsl_matrix_set(H, k + i, k - 1, 0.0);
+    }
+
+  if (tau == 0.0)
+    return;
+
+  /* apply left householder matrix (I - tau v v') to H(k:k+2,k:r1) */
+  m = gsl_matrix_submatrix(H, k, k, nr, r1 - k + 1);
+  gsl_linalg_householder_hm(tau, &v.vector, &m.matrix);
+
+  /* apply right householder matrix to H(r0:min(k+3,n),k:k+2) */
+  rlast = GSL_MIN(k + 3, N - 1);
+  m = gsl_matrix_submatrix(H, r0, k, rlast - r0 + 1, nr);
+  gsl_linalg_householder_mh(tau, &v.vector, &m.matrix);
+
+  /* accumulate the reflection into U */
+  m = gsl_matrix_submatrix(U, 0, k - r0, U->size1, nr);
+  gsl_linalg_householder_mh(tau, &v.vector, &m.matrix);
+} /* francis_bulge_step() */
+
+/*
+francis_update_offdiag()
+  Apply the orthogonal transformation U, which has been applied to
+the diagonal block H(i0:i0+n,i0:i0+n) (n = order of U), to the rest
+of the matrix:
+
+H(0:i0, i0:i0+n)  = H(0:i0, i0:i0+n) U
+H(i0:i0+n, i0+n:) = U^t H(i0:i0+n, i0+n:)
+Z(:, i0:i0+n)     = Z(:, i0:i0+n) U
+
+If the Schur form T is wanted, the rows and columns of the full
+matrix w->H are updated, otherwise only those of the active matrix H.
+*/
+
+static void
+francis_update_offdiag(gsl_matrix * H, const size_t i0,
+                       const gsl_matrix * U,
+                       gsl_eigen_francis_workspace * w)
+{
+  const size_t n = U->size1;
+  size_t top = 0;    /* location of H in the original matrix */
+  gsl_matrix *M;     /* matrix to update */
+  size_t j0;         /* row/column of the block in M */
+  gsl_matrix_view m;
+
+  if (w->compute_t || w->Z)
+    top = francis_get_submatrix(w->H, H);
+
+  if (w->compute_t)
+    {
+      M = w->H;
+      j0 = top + i0;
+    }
+  else
+    {
+      M = H;
+      j0 = i0;
+    }
+
+  if (j0 > 0)
+    {
+      m = gsl_matrix_submatrix(M, 0, j0, j0, n);
+      francis_mul_right(&m.matrix, U, w->work);
+    }
+
+  if (j0 + n < M->size2)
+    {
+      m = gsl_matrix_submatrix(M, j0, j0 + n, n, M->size2 - j0 - n);
+      francis_mul_left(U, &m.matrix, w->work);
+    }
+
+  if (w->Z)
+    {
+      m = gsl_matrix_submatrix(w->Z, 0, top + i0, w->Z->size1, n);
+      francis_mul_right(&m.matrix, U, w->work);
+    }
+} /* francis_update_offdiag() */
+
+/*
+francis_mul_right()
+  Compute A = A U with dgemm, in blocks of rows of A stored in work
+*/
+
+static void
+francis_mul_right(gsl_matrix * A, const gsl_matrix * U, gsl_matrix * work)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t nb = work->size1;
+  size_t i;
+
+  for (i = 0; i < M; i += nb)
+    {
+      const size_t b = GSL_MIN(nb, M - i);
+      gsl_matrix_view Ai = gsl_matrix_submatrix(A, i, 0, b, N);
+      gsl_matrix_view Wi = gsl_matrix_submatrix(work, 0, 0, b, N);
+
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &Ai.matrix, U,
+                     0.0, &Wi.matrix);
+      gsl_matrix_memcpy(&Ai.matrix, &Wi.matrix);
+    }
+} /* francis_mul_right() */
+
+/*
+francis_mul_left()
+  Compute A = U^t A with dgemm, in blocks of columns of A stored in
+work
+*/
+
+static void
+francis_mul_left(const gsl_matrix * U, gsl_matrix * A, gsl_matrix * work)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t nb = work->size2;
+  size_t j;
+
+  for (j = 0; j < N; j += nb)
+    {
+      const size_t b = GSL_MIN(nb, N - j);
+      gsl_matrix_view Aj = gsl_matrix_submatrix(A, 0, j, M, b);
+      gsl_matrix_view Wj = gsl_matrix_submatrix(work, 0, 0, M, b);
+
+      gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, &Aj.matrix,
+                     0.0, &Wj.matrix);
+      gsl_matrix_memcpy(&Aj.matrix, &Wj.matrix);
+    }
+} /* francis_mul_left() */
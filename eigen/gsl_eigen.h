@@ -94,12 +94,23 @@ typedef struct {
 
   gsl_matrix *H;         /* pointer to Hessenberg matrix */
   gsl_matrix *Z;         /* pointer to Schur vector matrix */
+
+  size_t nmax;           /* matrix size for multishift QR, 0 if disabled */
+  gsl_matrix *T;         /* Schur form of deflation window */
+  gsl_matrix *V;         /* Schur vectors of deflation window */
+  gsl_matrix *U;         /* accumulated reflectors of multishift sweep */
+  gsl_matrix *work;      /* workspace for off-diagonal updates */
+  gsl_vector_complex *evals;  /* eigenvalues of deflation window */
+  gsl_vector_complex *shifts; /* shifts for multishift sweep */
+  gsl_vector *tau;       /* Householder coefficients */
 } gsl_eigen_francis_workspace;
 
 gsl_eigen_francis_workspace * gsl_eigen_francis_alloc (void);
 void gsl_eigen_francis_free (gsl_eigen_francis_workspace * w);
 void gsl_eigen_francis_T (const int compute_t,
                           gsl_eigen_francis_workspace * w);
+int gsl_eigen_francis_multishift (const size_t nmax,
+                                  gsl_eigen_francis_workspace * w);
 int gsl_eigen_francis (gsl_matrix * H, gsl_vector_complex * eval,
                        gsl_eigen_francis_workspace * w);
 int gsl_eigen_francis_Z (gsl_matrix * H, gsl_vector_complex * eval,
@@ -121,6 +132,8 @@ gsl_eigen_nonsymm_workspace * gsl_eigen_nonsymm_alloc (const size_t n);
 void gsl_eigen_nonsymm_free (gsl_eigen_nonsymm_workspace * w);
 void gsl_eigen_nonsymm_params (const int compute_t, const int balance,
                                gsl_eigen_nonsymm_workspace *w);
+int gsl_eigen_nonsymm_multishift (const int multishift,
+                                  gsl_eigen_nonsymm_workspace *w);
 int gsl_eigen_nonsymm (gsl_matrix * A, gsl_vector_complex * eval,
                        gsl_eigen_nonsymm_workspace * w);
 int gsl_eigen_nonsymm_Z (gsl_matrix * A, gsl_vector_complex * eval,
@@ -141,6 +154,8 @@ gsl_eigen_nonsymmv_workspace * gsl_eigen_nonsymmv_alloc (const size_t n);
 void gsl_eigen_nonsymmv_free (gsl_eigen_nonsymmv_workspace * w);
 void gsl_eigen_nonsymmv_params (const int balance,
                                 gsl_eigen_nonsymmv_workspace *w);
+int gsl_eigen_nonsymmv_multishift (const int multishift,
+                                   gsl_eigen_nonsymmv_workspace *w);
 int gsl_eigen_nonsymmv (gsl_matrix * A, gsl_vector_complex * eval,
                         gsl_matrix_complex * evec,
                         gsl_eigen_nonsymmv_workspace * w);
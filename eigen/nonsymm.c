@@ -30,7 +30,8 @@
 
 /*
  * This module computes the eigenvalues of a real nonsymmetric
- * matrix, using the double shift Francis method.
+ * matrix, using the double shift Francis method, or optionally
+ * the multishift QR algorithm for large matrices.
  *
  * See the references in francis.c.
  *
@@ -140,6 +141,27 @@ gsl_eigen_nonsymm_params (const int compute_t, const int balance,
   w->do_balance = balance;
 } /* gsl_eigen_nonsymm_params() */
 
+/*
+gsl_eigen_nonsymm_multishift()
+  Select the QR algorithm used for the Schur decomposition. With
+multishift QR, matrices of order 75 or more are reduced with
+multishift sweeps and aggressive early deflation, which use Level 3
+BLAS and need far fewer sweeps than the double shift algorithm.
+
+Inputs: multishift - 1 to use multishift QR, 0 for double shift QR
+        w          - nonsymm workspace
+
+Return: success or error
+*/
+
+int
+gsl_eigen_nonsymm_multishift (const int multishift,
+                              gsl_eigen_nonsymm_workspace *w)
+{
+  return gsl_eigen_francis_multishift(multishift ? w->size : 0,
+                                      w->francis_workspace_p);
+} /* gsl_eigen_nonsymm_multishift() */
+
 /*
 gsl_eigen_nonsymm()
 
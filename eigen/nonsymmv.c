@@ -149,6 +149,24 @@ gsl_eigen_nonsymmv_params (const int balance,
   gsl_eigen_nonsymm_params(1, balance, w->nonsymm_workspace_p);
 } /* gsl_eigen_nonsymm_params() */
 
+/*
+gsl_eigen_nonsymmv_multishift()
+  Select the multishift QR algorithm for large matrices; see
+gsl_eigen_nonsymm_multishift()
+
+Inputs: multishift - 1 to use multishift QR, 0 for double shift QR
+        w          - nonsymmv workspace
+
+Return: success or error
+*/
+
+int
+gsl_eigen_nonsymmv_multishift (const int multishift,
+                               gsl_eigen_nonsymmv_workspace *w)
+{
+  return gsl_eigen_nonsymm_multishift(multishift, w->nonsymm_workspace_p);
+} /* gsl_eigen_nonsymmv_multishift() */
+
 /*
 gsl_eigen_nonsymmv()
 
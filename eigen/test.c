@@ -753,6 +753,49 @@ test_eigen_nonsymm_matrix(const gsl_matrix * m, size_t count,
   gsl_vector_complex_free(eval);
 }
 
+/* compare eigenvalues computed with multishift and double shift QR */
+void
+test_eigen_nonsymm_multishift(const gsl_matrix * m, size_t count,
+                              const char * desc)
+{
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector_complex * eval = gsl_vector_complex_alloc(N);
+  gsl_vector_complex * eval_ms = gsl_vector_complex_alloc(N);
+  gsl_eigen_nonsymm_workspace * w = gsl_eigen_nonsymm_alloc(N);
+  size_t i, j;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_nonsymm(A, eval, w);
+
+  gsl_eigen_nonsymm_multishift(1, w);
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_nonsymm(A, eval_ms, w);
+
+  /* each eigenvalue must match one of the double shift eigenvalues */
+  for (i = 0; i < N; ++i)
+    {
+      gsl_complex zi = gsl_vector_complex_get(eval_ms, i);
+      double dmin = GSL_POSINF;
+
+      for (j = 0; j < N; ++j)
+        {
+          gsl_complex zj = gsl_vector_complex_get(eval, j);
+          double d = gsl_complex_abs(gsl_complex_sub(zi, zj));
+
+          dmin = GSL_MIN(dmin, d);
+        }
+
+      gsl_test_abs(dmin, 0.0, 1.0e8 * GSL_DBL_EPSILON,
+                   "nonsymm(N=%u,cnt=%u), %s, eigenvalue(%d)", N, count, desc, i);
+    }
+
+  gsl_matrix_free(A);
+  gsl_vector_complex_free(eval);
+  gsl_vector_complex_free(eval_ms);
+  gsl_eigen_nonsymm_free(w);
+}
+
 void
 test_eigen_nonsymm(void)
 {
@@ -802,6 +845,31 @@ test_eigen_nonsymm(void)
 
     gsl_eigen_nonsymmv_free(w);
   }
+
+  /* larger matrices with multishift QR and aggressive early deflation */
+  {
+    const size_t sizes[] = { 80, 150, 250 };
+
+    r = gsl_rng_alloc(gsl_rng_default);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      {
+        gsl_matrix * m = gsl_matrix_alloc(sizes[i], sizes[i]);
+        gsl_eigen_nonsymmv_workspace * w = gsl_eigen_nonsymmv_alloc(sizes[i]);
+
+        create_random_nonsymm_matrix(m, r, -10, 10);
+
+        gsl_eigen_nonsymmv_multishift(1, w);
+        test_eigen_nonsymm_matrix(m, i, "random, multishift", w);
+
+        test_eigen_nonsymm_multishift(m, i, "random, multishift");
+
+        gsl_matrix_free(m);
+        gsl_eigen_nonsymmv_free(w);
+      }
+
+    gsl_rng_free(r);
+  }
 } /* test_eigen_nonsymm() */
 
 /******************************************
@@ -358,6 +358,29 @@ akima_eval_integ (const void * vstate,
 }
 
 
+static int
+akima_coeffs (const void * vstate,
+              const double x_array[], const double y_array[], size_t size,
+              double coef[])
+{
+  const akima_state_t *state = (const akima_state_t *) vstate;
+  size_t i;
+
+  DISCARD_POINTER(x_array); /* prevent warning about unused parameter */
+
+  for (i = 0; i < size - 1; i++)
+    {
+      double *p = coef + 4 * i;
+
+      p[0] = y_array[i];
+      p[1] = state->b[i];
+      p[2] = state->c[i];
+      p[3] = state->d[i];
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type akima_type = 
 {
   "akima", 
@@ -368,7 +391,8 @@ static const gsl_interp_type akima_type =
   &akima_eval_deriv,
   &akima_eval_deriv2,
   &akima_eval_integ,
-  &akima_free
+  &akima_free,
+  &akima_coeffs
 };
 
 const gsl_interp_type * gsl_interp_akima = &akima_type;
@@ -383,7 +407,8 @@ static const gsl_interp_type akima_periodic_type =
   &akima_eval_deriv,
   &akima_eval_deriv2,
   &akima_eval_integ,
-  &akima_free
+  &akima_free,
+  &akima_coeffs
 };
 
 const gsl_interp_type * gsl_interp_akima_periodic = &akima_periodic_type;
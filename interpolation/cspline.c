@@ -442,6 +442,27 @@ cspline_eval_integ (const void * vstate,
   return GSL_SUCCESS;
 }
 
+static int
+cspline_coeffs (const void * vstate,
+                const double x_array[], const double y_array[], size_t size,
+                double coef[])
+{
+  const cspline_state_t *state = (const cspline_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < size - 1; i++)
+    {
+      const double dx = x_array[i + 1] - x_array[i];
+      const double dy = y_array[i + 1] - y_array[i];
+      double *p = coef + 4 * i;
+
+      p[0] = y_array[i];
+      coeff_calc (state->c, dy, dx, i, &p[1], &p[2], &p[3]);
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type cspline_type = 
 {
   "cspline", 
@@ -452,7 +473,8 @@ static const gsl_interp_type cspline_type =
   &cspline_eval_deriv,
   &cspline_eval_deriv2,
   &cspline_eval_integ,
-  &cspline_free
+  &cspline_free,
+  &cspline_coeffs
 };
 
 const gsl_interp_type * gsl_interp_cspline = &cspline_type;
@@ -467,7 +489,8 @@ static const gsl_interp_type cspline_periodic_type =
   &cspline_eval_deriv,
   &cspline_eval_deriv2,
   &cspline_eval_integ,
-  &cspline_free
+  &cspline_free,
+  &cspline_coeffs
 };
 
 const gsl_interp_type * gsl_interp_cspline_periodic = &cspline_periodic_type;
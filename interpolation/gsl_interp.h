@@ -57,6 +57,7 @@ typedef struct {
   int     (*eval_deriv2) (const void *, const double xa[], const double ya[], size_t size, double x, gsl_interp_accel *, double * y_pp);
   int     (*eval_integ)  (const void *, const double xa[], const double ya[], size_t size, gsl_interp_accel *, double a, double b, double * result);
   void    (*free)         (void *);
+  int     (*coeffs)  (const void *, const double xa[], const double ya[], size_t size, double coef[]);
 
 } gsl_interp_type;
 
@@ -68,6 +69,8 @@ typedef struct {
   double  xmax;
   size_t  size;
   void * state;
+  double  xscale;   /* (size - 1) / (xmax - xmin) for uniform xa, else 0 */
+  double * coef;    /* piecewise cubic coefficients, 4 per interval */
 } gsl_interp;
 
 
@@ -145,6 +148,27 @@ gsl_interp_eval_integ(const gsl_interp * obj,
                       double a, double b,
                       gsl_interp_accel * acc);
 
+int
+gsl_interp_eval_array(const gsl_interp * obj,
+                      const double xa[], const double ya[],
+                      const double x[], double y[], size_t n);
+
+int
+gsl_interp_eval_deriv_array(const gsl_interp * obj,
+                            const double xa[], const double ya[],
+                            const double x[], double dydx[], size_t n);
+
+int
+gsl_interp_eval_deriv2_array(const gsl_interp * obj,
+                             const double xa[], const double ya[],
+                             const double x[], double d2[], size_t n);
+
+int
+gsl_interp_eval_integ_array(const gsl_interp * obj,
+                            const double xa[], const double ya[],
+                            double a, const double x[], double y[],
+                            size_t n);
+
 void
 gsl_interp_free(gsl_interp * interp);
 
@@ -0,0 +1,89 @@
+/* interpolation/gsl_interpnd.h
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_INTERPND_H__
+#define __GSL_INTERPND_H__
+
+#include <gsl/gsl_interp.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* maximum number of dimensions */
+#define GSL_INTERPND_MAX_DIM 10
+
+typedef struct {
+    const char * name;
+    unsigned int min_size;
+    unsigned int stencil;   /* number of grid points used along each axis */
+    int interpolating;      /* basis functions are 1 at their own grid point
+                               and 0 at the others */
+    size_t (*weights) (const double xa[], size_t size, size_t index,
+                       double x, double w[]);
+} gsl_interpnd_type;
+
+typedef struct {
+    const gsl_interpnd_type * type; /* interpolation type */
+    size_t ndim;                    /* number of dimensions */
+    size_t size[GSL_INTERPND_MAX_DIM];   /* grid points along each axis */
+    size_t stride[GSL_INTERPND_MAX_DIM]; /* distance between consecutive
+                                            points along each axis */
+    double * xa[GSL_INTERPND_MAX_DIM];   /* grid of each axis */
+    double * coef;                  /* coefficients of the basis functions,
+                                       last axis varying fastest */
+    size_t ncoef;                   /* total number of grid points */
+} gsl_interpnd;
+
+/* available types */
+GSL_VAR const gsl_interpnd_type * gsl_interpnd_linear;
+GSL_VAR const gsl_interpnd_type * gsl_interpnd_cubic;
+
+gsl_interpnd * gsl_interpnd_alloc (const gsl_interpnd_type * T,
+                                   const size_t ndim, const size_t size[]);
+
+int gsl_interpnd_init (gsl_interpnd * interp, const double * const xa[],
+                       const double za[]);
+
+const char * gsl_interpnd_name (const gsl_interpnd * interp);
+size_t gsl_interpnd_min_size (const gsl_interpnd * interp);
+
+size_t gsl_interpnd_idx (const gsl_interpnd * interp, const size_t index[]);
+
+int gsl_interpnd_eval_e (const gsl_interpnd * interp, const double x[],
+                         gsl_interp_accel * acc[], double * z);
+
+double gsl_interpnd_eval (const gsl_interpnd * interp, const double x[],
+                          gsl_interp_accel * acc[]);
+
+int gsl_interpnd_eval_array (const gsl_interpnd * interp, const double x[],
+                             double z[], const size_t n,
+                             gsl_interp_accel * acc[]);
+
+void gsl_interpnd_free (gsl_interpnd * interp);
+
+__END_DECLS
+
+#endif /* __GSL_INTERPND_H__ */
@@ -93,6 +93,23 @@ gsl_spline_eval_integ(const gsl_spline * spline,
                       double a, double b,
                       gsl_interp_accel * acc);
 
+int
+gsl_spline_eval_array(const gsl_spline * spline,
+                      const double x[], double y[], size_t n);
+
+int
+gsl_spline_eval_deriv_array(const gsl_spline * spline,
+                            const double x[], double dydx[], size_t n);
+
+int
+gsl_spline_eval_deriv2_array(const gsl_spline * spline,
+                             const double x[], double d2[], size_t n);
+
+int
+gsl_spline_eval_integ_array(const gsl_spline * spline,
+                            double a, const double x[], double y[],
+                            size_t n);
+
 void
 gsl_spline_free(gsl_spline * spline);
 
@@ -48,6 +48,20 @@ gsl_interp_alloc (const gsl_interp_type * T, size_t size)
   
   interp->type = T;
   interp->size = size;
+  interp->xscale = 0.0;
+  interp->coef = NULL;
+
+  if (interp->type->coeffs != NULL)
+    {
+      interp->coef = (double *) malloc (4 * (size - 1) * sizeof(double));
+
+      if (interp->coef == NULL)
+        {
+          free (interp);
+          GSL_ERROR_NULL ("failed to allocate space for coefficients",
+                          GSL_ENOMEM);
+        }
+    }
 
   if (interp->type->alloc == NULL)
     {
@@ -59,6 +73,7 @@ gsl_interp_alloc (const gsl_interp_type * T, size_t size)
   
   if (interp->state == NULL)
     {
+      free (interp->coef);
       free (interp);          
       GSL_ERROR_NULL ("failed to allocate space for interp state", GSL_ENOMEM);
     };
@@ -87,8 +102,34 @@ gsl_interp_init (gsl_interp * interp, const double x_array[], const double y_arr
   interp->xmin = x_array[0];
   interp->xmax = x_array[size - 1];
 
+  /* Uniform spacing allows the interval of x to be computed directly.
+     The tolerance only has to keep the computed index within one
+     interval of the correct one. */
+
+  {
+    const double h = (interp->xmax - interp->xmin) / (size - 1);
+
+    interp->xscale = 1.0 / h;
+
+    for (i = 1; i < size - 1; i++)
+      {
+        if (fabs (x_array[i] - (interp->xmin + i * h)) > 1e-6 * h)
+          {
+            interp->xscale = 0.0;
+            break;
+          }
+      }
+  }
+
   {
     int status = interp->type->init(interp->state, x_array, y_array, size);
+
+    if (status == GSL_SUCCESS && interp->coef != NULL)
+      {
+        status = interp->type->coeffs (interp->state, x_array, y_array,
+                                       size, interp->coef);
+      }
+
     return status;
   }
 }
@@ -118,6 +159,7 @@ gsl_interp_free (gsl_interp * interp)
 
   if (interp->type->free)
     interp->type->free (interp->state);
+  free (interp->coef);
   free (interp);
 }
 
@@ -0,0 +1,458 @@
+/* interpolation/interp_array.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Evaluation of an interpolation at many points.
+ *
+ * The interval containing each point is located first, and the
+ * point is then evaluated from the interval's coefficients, or by
+ * the interpolation type with an accelerator preset to that interval
+ * so that no further search is made. If the points are in increasing
+ * order the intervals are found by a single merge-like sweep through
+ * xa. Otherwise, for many points, the knots are copied into a search
+ * tree stored in Eytzinger (breadth first) order, whose top levels
+ * stay in cache and whose search loop has no unpredictable branches.
+ * For a few unsorted points the plain binary search is used, as
+ * building the tree costs O(size). For uniformly spaced xa the
+ * interval is computed directly.
+ *
+ * For the types which provide piecewise cubic coefficients the points
+ * are processed in blocks, locating all points of a block first so
+ * that the evaluation of the cubics is a simple loop which can be
+ * vectorized.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_interp.h>
+#include "packed_eval.h"
+
+#define ARRAY_BLOCK 256
+
+typedef struct
+{
+  int uniform;                  /* xa is uniformly spaced */
+  int sorted;                   /* points are in increasing order */
+  size_t cache;                 /* current interval of the sweep */
+  size_t nkey;                  /* number of keys of the search tree */
+  double *key;                  /* keys xa[0..size-2] in Eytzinger order */
+  size_t *rank;                 /* index in xa of each key */
+} interp_index;
+
+static size_t
+index_build (const double xa[], interp_index * idx, size_t i, size_t k)
+{
+  /* in-order traversal of the implicit tree, node k has children
+     2k and 2k+1 */
+
+  if (k <= idx->nkey)
+    {
+      i = index_build (xa, idx, i, 2 * k);
+      idx->key[k] = xa[i];
+      idx->rank[k] = i;
+      i = index_build (xa, idx, i + 1, 2 * k + 1);
+    }
+
+  return i;
+}
+
+static int
+index_init (interp_index * idx, const gsl_interp * interp,
+            const double xa[], const double x[], size_t n)
+{
+  const size_t size = interp->size;
+  size_t j, nlog = 0;
+
+  idx->uniform = (interp->xscale > 0.0);
+  idx->sorted = 1;
+  idx->cache = 0;
+  idx->nkey = 0;
+  idx->key = NULL;
+  idx->rank = NULL;
+
+  if (idx->uniform)
+    {
+      return GSL_SUCCESS;
+    }
+
+  for (j = 1; j < n; j++)
+    {
+      if (!(x[j] >= x[j - 1]))
+        {
+          idx->sorted = 0;
+          break;
+        }
+    }
+
+  if (idx->sorted)
+    {
+      if (n > 0)
+        idx->cache = gsl_interp_bsearch (xa, x[0], 0, size - 1);
+
+      return GSL_SUCCESS;
+    }
+
+  for (j = size; j > 1; j >>= 1)
+    nlog++;
+
+  if (n * nlog < size)
+    {
+      return GSL_SUCCESS;
+    }
+
+  /* the last knot is not a key, so that x >= xa[size-1] falls in the
+     last interval as in gsl_interp_bsearch */
+
+  idx->nkey = size - 1;
+  idx->key = (double *) malloc ((idx->nkey + 1) * sizeof (double));
+  idx->rank = (size_t *) malloc ((idx->nkey + 1) * sizeof (size_t));
+
+  if (idx->key == NULL || idx->rank == NULL)
+    {
+      free (idx->key);
+      free (idx->rank);
+      GSL_ERROR ("failed to allocate space for search index", GSL_ENOMEM);
+    }
+
+  index_build (xa, idx, 0, 1);
+
+  return GSL_SUCCESS;
+}
+
+static void
+index_free (interp_index * idx)
+{
+  free (idx->key);
+  free (idx->rank);
+}
+
+static size_t
+index_find (interp_index * idx, const gsl_interp * interp,
+            const double xa[], double x)
+{
+  const size_t size = interp->size;
+
+  if (idx->uniform)
+    {
+      return packed_uniform_index (interp, xa, x);
+    }
+  else if (idx->sorted)
+    {
+      size_t i = idx->cache;
+
+      while (i < size - 2 && xa[i + 1] <= x)
+        i++;
+
+      idx->cache = i;
+
+      return i;
+    }
+  else if (idx->key != NULL)
+    {
+      /* descend to a leaf, then strip the right turns taken after the
+         last left turn to reach the first key greater than x */
+
+      const double *key = idx->key;
+      const size_t nkey = idx->nkey;
+      size_t k = 1;
+
+      while (k <= nkey)
+        k = 2 * k + (key[k] <= x);
+
+      while (k & 1)
+        k >>= 1;
+
+      k >>= 1;
+
+      if (k == 0)
+        return nkey - 1;        /* all keys <= x */
+      else if (idx->rank[k] == 0)
+        return 0;               /* x < xa[0] */
+      else
+        return idx->rank[k] - 1;
+    }
+  else
+    {
+      return gsl_interp_bsearch (xa, x, 0, size - 1);
+    }
+}
+
+static int
+interp_eval_packed (const gsl_interp * interp, interp_index * idx,
+                    const double xa[], int nderiv,
+                    const double x[], double y[], size_t n)
+{
+  const double *coef = interp->coef;
+  size_t index[ARRAY_BLOCK];
+  int status = GSL_SUCCESS;
+  size_t j0, k;
+
+  for (j0 = 0; j0 < n; j0 += ARRAY_BLOCK)
+    {
+      const size_t nb = GSL_MIN (ARRAY_BLOCK, n - j0);
+      const double *xb = x + j0;
+      double *yb = y + j0;
+      int edom = 0;
+
+      for (k = 0; k < nb; k++)
+        {
+          if (xb[k] >= interp->xmin && xb[k] <= interp->xmax)
+            {
+              index[k] = index_find (idx, interp, xa, xb[k]);
+            }
+          else
+            {
+              index[k] = 0;
+              edom = 1;
+            }
+        }
+
+      switch (nderiv)
+        {
+        case 0:
+          for (k = 0; k < nb; k++)
+            {
+              const double *p = coef + 4 * index[k];
+              const double t = xb[k] - xa[index[k]];
+              yb[k] = p[0] + t * (p[1] + t * (p[2] + t * p[3]));
+            }
+          break;
+
+        case 1:
+          for (k = 0; k < nb; k++)
+            {
+              const double *p = coef + 4 * index[k];
+              const double t = xb[k] - xa[index[k]];
+              yb[k] = p[1] + t * (2.0 * p[2] + 3.0 * p[3] * t);
+            }
+          break;
+
+        default:
+          for (k = 0; k < nb; k++)
+            {
+              const double *p = coef + 4 * index[k];
+              const double t = xb[k] - xa[index[k]];
+              yb[k] = 2.0 * p[2] + 6.0 * p[3] * t;
+            }
+          break;
+        }
+
+      if (edom)
+        {
+          for (k = 0; k < nb; k++)
+            {
+              if (!(xb[k] >= interp->xmin && xb[k] <= interp->xmax))
+                yb[k] = GSL_NAN;
+            }
+
+          status = GSL_EDOM;
+        }
+    }
+
+  return status;
+}
+
+static int
+interp_eval_array (const gsl_interp * interp, int nderiv,
+                   const double xa[], const double ya[],
+                   const double x[], double y[], size_t n)
+{
+  interp_index idx;
+  gsl_interp_accel acc;
+  int status = GSL_SUCCESS;
+  size_t j;
+
+  int s = index_init (&idx, interp, xa, x, n);
+
+  if (s)
+    return s;
+
+  if (interp->coef != NULL)
+    {
+      status = interp_eval_packed (interp, &idx, xa, nderiv, x, y, n);
+      index_free (&idx);
+      return status;
+    }
+
+  acc.hit_count = 0;
+  acc.miss_count = 0;
+
+  for (j = 0; j < n; j++)
+    {
+      const double xj = x[j];
+
+      if (!(xj >= interp->xmin && xj <= interp->xmax))
+        {
+          y[j] = GSL_NAN;
+          status = GSL_EDOM;
+          continue;
+        }
+
+      acc.cache = index_find (&idx, interp, xa, xj);
+
+      switch (nderiv)
+        {
+        case 0:
+          s = interp->type->eval (interp->state, xa, ya, interp->size,
+                                  xj, &acc, &y[j]);
+          break;
+        case 1:
+          s = interp->type->eval_deriv (interp->state, xa, ya, interp->size,
+                                        xj, &acc, &y[j]);
+          break;
+        default:
+          s = interp->type->eval_deriv2 (interp->state, xa, ya, interp->size,
+                                         xj, &acc, &y[j]);
+          break;
+        }
+
+      if (s)
+        status = s;
+    }
+
+  index_free (&idx);
+
+  return status;
+}
+
+int
+gsl_interp_eval_array (const gsl_interp * interp,
+                       const double xa[], const double ya[],
+                       const double x[], double y[], size_t n)
+{
+  return interp_eval_array (interp, 0, xa, ya, x, y, n);
+}
+
+int
+gsl_interp_eval_deriv_array (const gsl_interp * interp,
+                             const double xa[], const double ya[],
+                             const double x[], double dydx[], size_t n)
+{
+  return interp_eval_array (interp, 1, xa, ya, x, dydx, n);
+}
+
+int
+gsl_interp_eval_deriv2_array (const gsl_interp * interp,
+                              const double xa[], const double ya[],
+                              const double x[], double d2[], size_t n)
+{
+  return interp_eval_array (interp, 2, xa, ya, x, d2, n);
+}
+
+static int
+interp_integ_knot (const gsl_interp * interp, const double xa[],
+                   const double ya[], const double F[], size_t i, double x,
+                   double *result)
+{
+  /* integral from xa[0] to x, with x in interval i */
+
+  gsl_interp_accel acc;
+  double r = 0.0;
+  int status = GSL_SUCCESS;
+
+  if (interp->coef != NULL)
+    {
+      r = packed_integ (interp->coef + 4 * i, x - xa[i]);
+    }
+  else if (x > xa[i])
+    {
+      acc.cache = i;
+      acc.hit_count = 0;
+      acc.miss_count = 0;
+      status = interp->type->eval_integ (interp->state, xa, ya,
+                                         interp->size, &acc, xa[i], x, &r);
+    }
+
+  *result = F[i] + r;
+
+  return status;
+}
+
+int
+gsl_interp_eval_integ_array (const gsl_interp * interp,
+                             const double xa[], const double ya[],
+                             double a, const double x[], double y[],
+                             size_t n)
+{
+  /* The integrals from xa[0] to each knot are accumulated first, so
+     that each point costs the integral over a part of one interval */
+
+  const size_t size = interp->size;
+  interp_index idx;
+  double *F, Fa;
+  int status = GSL_SUCCESS, s;
+  size_t i, j;
+
+  if (!(a >= interp->xmin && a <= interp->xmax))
+    {
+      for (j = 0; j < n; j++)
+        y[j] = GSL_NAN;
+
+      return GSL_EDOM;
+    }
+
+  F = (double *) malloc (size * sizeof (double));
+
+  if (F == NULL)
+    {
+      GSL_ERROR ("failed to allocate space for integrals", GSL_ENOMEM);
+    }
+
+  F[0] = 0.0;
+
+  for (i = 0; i + 1 < size; i++)
+    {
+      interp_integ_knot (interp, xa, ya, F, i, xa[i + 1], &F[i + 1]);
+    }
+
+  s = interp_integ_knot (interp, xa, ya, F,
+                         gsl_interp_bsearch (xa, a, 0, size - 1), a, &Fa);
+
+  if (s == GSL_SUCCESS)
+    s = index_init (&idx, interp, xa, x, n);
+
+  if (s)
+    {
+      free (F);
+      return s;
+    }
+
+  for (j = 0; j < n; j++)
+    {
+      const double xj = x[j];
+
+      if (!(xj >= interp->xmin && xj <= interp->xmax))
+        {
+          y[j] = GSL_NAN;
+          status = GSL_EDOM;
+          continue;
+        }
+
+      s = interp_integ_knot (interp, xa, ya, F,
+                             index_find (&idx, interp, xa, xj), xj, &y[j]);
+      y[j] -= Fa;
+
+      if (s)
+        status = s;
+    }
+
+  index_free (&idx);
+  free (F);
+
+  return status;
+}
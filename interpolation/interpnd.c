@@ -0,0 +1,419 @@
+/* interpolation/interpnd.c
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tensor product interpolation on rectilinear grids in N dimensions.
+ *
+ * The interpolant is sum_j c_j B_j0(x_0) ... B_jd(x_d), where the one
+ * dimensional basis functions of each axis are nonzero on a stencil
+ * of 'stencil' consecutive grid points. An evaluation locates the
+ * interval of each coordinate, computes the stencil weights of each
+ * axis and contracts them with the s^d coefficients of the stencil.
+ * The coefficients are stored with the last axis varying fastest, so
+ * that the innermost contraction reads s consecutive values.
+ *
+ * For types whose basis functions do not interpolate the grid values
+ * the coefficients are computed at initialization by solving the
+ * collocation equations along each axis in turn.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_interp.h>
+#include <gsl/gsl_interpnd.h>
+
+/* maximum stencil of the types */
+#define INTERPND_MAX_STENCIL 4
+
+static size_t
+linear_weights (const double xa[], size_t size, size_t index, double x,
+                double w[])
+{
+  const double u = (x - xa[index]) / (xa[index + 1] - xa[index]);
+
+  w[0] = 1.0 - u;
+  w[1] = u;
+
+  return index;
+}
+
+/* Cubic B-splines with knots at the grid points, except the second
+   and second to last ones (not-a-knot end conditions), so that there
+   is one basis function per grid point. The knots are t_0 ... t_{size+3}
+   with t_0 = ... = t_3 = xa[0] and t_size = ... = t_{size+3} = xa[size-1]. */
+
+static double
+cubic_knot (const double xa[], size_t size, size_t j)
+{
+  if (j <= 3)
+    return xa[0];
+  else if (j >= size)
+    return xa[size - 1];
+  else
+    return xa[j - 2];
+}
+
+static size_t
+cubic_weights (const double xa[], size_t size, size_t index, double x,
+               double w[])
+{
+  /* Cox-de Boor recursion for the four basis functions which are
+     nonzero in the knot span t_i <= x <= t_{i+1} containing grid
+     interval index */
+
+  double left[4], right[4];
+  size_t i = GSL_MIN (GSL_MAX (index + 2, 3), size - 1);
+  size_t j, r;
+
+  w[0] = 1.0;
+
+  for (j = 1; j <= 3; j++)
+    {
+      double saved = 0.0;
+
+      left[j] = x - cubic_knot (xa, size, i + 1 - j);
+      right[j] = cubic_knot (xa, size, i + j) - x;
+
+      for (r = 0; r < j; r++)
+        {
+          const double temp = w[r] / (right[r + 1] + left[j - r]);
+          w[r] = saved + right[r + 1] * temp;
+          saved = left[j - r] * temp;
+        }
+
+      w[j] = saved;
+    }
+
+  return i - 3;
+}
+
+static const gsl_interpnd_type linear_type = {
+  "linear",
+  2,
+  2,
+  1,
+  &linear_weights
+};
+
+const gsl_interpnd_type * gsl_interpnd_linear = &linear_type;
+
+static const gsl_interpnd_type cubic_type = {
+  "cubic",
+  4,
+  4,
+  0,
+  &cubic_weights
+};
+
+const gsl_interpnd_type * gsl_interpnd_cubic = &cubic_type;
+
+gsl_interpnd *
+gsl_interpnd_alloc (const gsl_interpnd_type * T, const size_t ndim,
+                    const size_t size[])
+{
+  gsl_interpnd *interp;
+  size_t k;
+
+  if (ndim == 0 || ndim > GSL_INTERPND_MAX_DIM)
+    {
+      GSL_ERROR_NULL ("number of dimensions must be between 1 and "
+                      "GSL_INTERPND_MAX_DIM", GSL_EINVAL);
+    }
+
+  for (k = 0; k < ndim; k++)
+    {
+      if (size[k] < T->min_size)
+        {
+          GSL_ERROR_NULL ("insufficient number of points for interpolation type",
+                          GSL_EINVAL);
+        }
+    }
+
+  interp = (gsl_interpnd *) calloc (1, sizeof (gsl_interpnd));
+
+  if (interp == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for interpnd struct",
+                      GSL_ENOMEM);
+    }
+
+  interp->type = T;
+  interp->ndim = ndim;
+  interp->ncoef = 1;
+
+  for (k = ndim; k-- > 0;)
+    {
+      interp->size[k] = size[k];
+      interp->stride[k] = interp->ncoef;
+      interp->ncoef *= size[k];
+
+      interp->xa[k] = (double *) malloc (size[k] * sizeof (double));
+
+      if (interp->xa[k] == NULL)
+        {
+          gsl_interpnd_free (interp);
+          GSL_ERROR_NULL ("failed to allocate space for grid", GSL_ENOMEM);
+        }
+    }
+
+  interp->coef = (double *) malloc (interp->ncoef * sizeof (double));
+
+  if (interp->coef == NULL)
+    {
+      gsl_interpnd_free (interp);
+      GSL_ERROR_NULL ("failed to allocate space for coefficients", GSL_ENOMEM);
+    }
+
+  return interp;
+}
+
+static int
+interpnd_prefilter (gsl_interpnd * interp, const size_t k)
+{
+  /* solves the collocation equations along axis k for all lines of
+     the coefficient array */
+
+  const size_t n = interp->size[k];
+  const size_t stride = interp->stride[k];
+  const double *xa = interp->xa[k];
+  gsl_matrix *A = gsl_matrix_calloc (n, n);
+  gsl_permutation *p = gsl_permutation_alloc (n);
+  double w[INTERPND_MAX_STENCIL];
+  size_t b, c, j, l;
+  int signum, status;
+
+  if (A == NULL || p == NULL)
+    {
+      gsl_matrix_free (A);
+      gsl_permutation_free (p);
+      GSL_ERROR ("failed to allocate space for collocation matrix",
+                 GSL_ENOMEM);
+    }
+
+  for (j = 0; j < n; j++)
+    {
+      const size_t index = GSL_MIN (j, n - 2);
+      const size_t start = interp->type->weights (xa, n, index, xa[j], w);
+
+      for (l = 0; l < interp->type->stencil; l++)
+        gsl_matrix_set (A, j, start + l, w[l]);
+    }
+
+  status = gsl_linalg_LU_decomp (A, p, &signum);
+
+  for (b = 0; status == GSL_SUCCESS && b < interp->ncoef; b += n * stride)
+    {
+      for (c = 0; status == GSL_SUCCESS && c < stride; c++)
+        {
+          gsl_vector_view v =
+            gsl_vector_view_array_with_stride (interp->coef + b + c,
+                                               stride, n);
+          status = gsl_linalg_LU_svx (A, p, &v.vector);
+        }
+    }
+
+  gsl_matrix_free (A);
+  gsl_permutation_free (p);
+
+  return status;
+}
+
+int
+gsl_interpnd_init (gsl_interpnd * interp, const double * const xa[],
+                   const double za[])
+{
+  size_t i, k;
+
+  for (k = 0; k < interp->ndim; k++)
+    {
+      for (i = 1; i < interp->size[k]; i++)
+        {
+          if (!(xa[k][i - 1] < xa[k][i]))
+            {
+              GSL_ERROR ("grid values must be strictly increasing",
+                         GSL_EINVAL);
+            }
+        }
+
+      memcpy (interp->xa[k], xa[k], interp->size[k] * sizeof (double));
+    }
+
+  memcpy (interp->coef, za, interp->ncoef * sizeof (double));
+
+  if (!interp->type->interpolating)
+    {
+      for (k = 0; k < interp->ndim; k++)
+        {
+          int status = interpnd_prefilter (interp, k);
+
+          if (status)
+            return status;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+const char *
+gsl_interpnd_name (const gsl_interpnd * interp)
+{
+  return interp->type->name;
+}
+
+size_t
+gsl_interpnd_min_size (const gsl_interpnd * interp)
+{
+  return interp->type->min_size;
+}
+
+size_t
+gsl_interpnd_idx (const gsl_interpnd * interp, const size_t index[])
+{
+  size_t k, idx = 0;
+
+  for (k = 0; k < interp->ndim; k++)
+    {
+      if (index[k] >= interp->size[k])
+        {
+          GSL_ERROR_VAL ("index out of range", GSL_ERANGE, 0);
+        }
+
+      idx += index[k] * interp->stride[k];
+    }
+
+  return idx;
+}
+
+static double
+interpnd_sum (const gsl_interpnd * interp,
+              const double w[][INTERPND_MAX_STENCIL], const size_t start[],
+              const size_t k, size_t offset)
+{
+  /* contracts the stencil with the weights of axes k, ..., ndim - 1 */
+
+  const unsigned int s = interp->type->stencil;
+  const size_t stride = interp->stride[k];
+  double sum = 0.0;
+  unsigned int l;
+
+  offset += start[k] * stride;
+
+  if (k == interp->ndim - 1)
+    {
+      const double *c = interp->coef + offset;
+
+      for (l = 0; l < s; l++)
+        sum += w[k][l] * c[l];
+    }
+  else
+    {
+      for (l = 0; l < s; l++)
+        sum += w[k][l] * interpnd_sum (interp, w, start, k + 1,
+                                       offset + l * stride);
+    }
+
+  return sum;
+}
+
+int
+gsl_interpnd_eval_e (const gsl_interpnd * interp, const double x[],
+                     gsl_interp_accel * acc[], double *z)
+{
+  double w[GSL_INTERPND_MAX_DIM][INTERPND_MAX_STENCIL];
+  size_t start[GSL_INTERPND_MAX_DIM];
+  size_t k;
+
+  for (k = 0; k < interp->ndim; k++)
+    {
+      const double *xa = interp->xa[k];
+      const size_t size = interp->size[k];
+      size_t index;
+
+      if (!(x[k] >= xa[0] && x[k] <= xa[size - 1]))
+        {
+          *z = GSL_NAN;
+          return GSL_EDOM;
+        }
+
+      if (acc != NULL && acc[k] != NULL)
+        index = gsl_interp_accel_find (acc[k], xa, size, x[k]);
+      else
+        index = gsl_interp_bsearch (xa, x[k], 0, size - 1);
+
+      start[k] = interp->type->weights (xa, size, index, x[k], w[k]);
+    }
+
+  *z = interpnd_sum (interp, (const double (*)[INTERPND_MAX_STENCIL]) w,
+                     start, 0, 0);
+
+  return GSL_SUCCESS;
+}
+
+double
+gsl_interpnd_eval (const gsl_interpnd * interp, const double x[],
+                   gsl_interp_accel * acc[])
+{
+  double z;
+  int status = gsl_interpnd_eval_e (interp, x, acc, &z);
+
+  if (status != GSL_SUCCESS)
+    {
+      GSL_ERROR_VAL ("interpolation error", status, GSL_NAN);
+    }
+
+  return z;
+}
+
+int
+gsl_interpnd_eval_array (const gsl_interpnd * interp, const double x[],
+                         double z[], const size_t n, gsl_interp_accel * acc[])
+{
+  /* x[i * ndim + k] is coordinate k of point i */
+
+  int status = GSL_SUCCESS;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      int s = gsl_interpnd_eval_e (interp, x + i * interp->ndim, acc, &z[i]);
+
+      if (s)
+        status = s;
+    }
+
+  return status;
+}
+
+void
+gsl_interpnd_free (gsl_interpnd * interp)
+{
+  size_t k;
+
+  RETURN_IF_NULL (interp);
+
+  for (k = 0; k < interp->ndim; k++)
+    free (interp->xa[k]);
+
+  free (interp->coef);
+  free (interp);
+}
@@ -182,6 +182,26 @@ linear_eval_integ (const void * vstate,
   return GSL_SUCCESS;
 }
 
+static int
+linear_coeffs (const void * vstate,
+               const double x_array[], const double y_array[], size_t size,
+               double coef[])
+{
+  size_t i;
+
+  for (i = 0; i < size - 1; i++)
+    {
+      double *p = coef + 4 * i;
+
+      p[0] = y_array[i];
+      p[1] = (y_array[i + 1] - y_array[i]) / (x_array[i + 1] - x_array[i]);
+      p[2] = 0.0;
+      p[3] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type linear_type = 
 {
   "linear", 
@@ -193,6 +213,7 @@ static const gsl_interp_type linear_type =
   &linear_eval_deriv2,
   &linear_eval_integ,
   NULL, /* free, not applicable */
+  &linear_coeffs
 };
 
 const gsl_interp_type * gsl_interp_linear = &linear_type;
@@ -0,0 +1,99 @@
+/* interpolation/packed_eval.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* evaluation of the piecewise cubic coefficients stored by
+   gsl_interp_init for the types which provide them. In interval i
+   the interpolant is
+
+     coef[4i] + t (coef[4i+1] + t (coef[4i+2] + t coef[4i+3]))
+
+   with t = x - xa[i].
+ */
+
+/* index of the interval containing x, with xmin <= x <= xmax and the
+   convention of gsl_interp_bsearch. For uniform xa it is computed by a
+   multiplication, and corrected by one interval for rounding. */
+
+static inline size_t
+packed_uniform_index (const gsl_interp * interp, const double xa[], double x)
+{
+  const size_t imax = interp->size - 2;
+  size_t index = (size_t) ((x - interp->xmin) * interp->xscale);
+
+  if (index > imax)
+    index = imax;
+
+  if (x < xa[index] && index > 0)
+    index--;
+  else if (index < imax && x >= xa[index + 1])
+    index++;
+
+  return index;
+}
+
+static inline size_t
+packed_index (const gsl_interp * interp, const double xa[], double x,
+              gsl_interp_accel * a)
+{
+  size_t index;
+
+  if (interp->xscale > 0.0)
+    {
+      index = packed_uniform_index (interp, xa, x);
+
+      if (a != 0)
+        {
+          a->cache = index;
+          a->hit_count++;
+        }
+    }
+  else if (a != 0)
+    {
+      index = gsl_interp_accel_find (a, xa, interp->size, x);
+    }
+  else
+    {
+      index = gsl_interp_bsearch (xa, x, 0, interp->size - 1);
+    }
+
+  return index;
+}
+
+/* value (nderiv = 0) or derivatives of the cubic p at t */
+
+static inline double
+packed_eval (const double p[], double t, int nderiv)
+{
+  switch (nderiv)
+    {
+    case 0:
+      return p[0] + t * (p[1] + t * (p[2] + t * p[3]));
+    case 1:
+      return p[1] + t * (2.0 * p[2] + 3.0 * p[3] * t);
+    default:
+      return 2.0 * p[2] + 6.0 * p[3] * t;
+    }
+}
+
+/* integral of the cubic p from 0 to t */
+
+static inline double
+packed_integ (const double p[], double t)
+{
+  return t * (p[0] + t * (0.5 * p[1]
+                          + t * ((1.0 / 3.0) * p[2] + 0.25 * t * p[3])));
+}
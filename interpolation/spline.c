@@ -20,8 +20,10 @@
 #include <config.h>
 #include <string.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_interp.h>
 #include <gsl/gsl_spline.h>
+#include "packed_eval.h"
 
 gsl_spline *
 gsl_spline_alloc (const gsl_interp_type * T, size_t size)
@@ -105,14 +107,67 @@ gsl_spline_free (gsl_spline * spline)
   free (spline);
 }
 
+/* evaluates the spline (nderiv = 0) or its derivatives at x from the
+   coefficients stored by gsl_interp_init, which are those of the data
+   held by the spline, or by the interpolation type if it does not
+   provide them */
+
+static int
+spline_eval_n (const gsl_spline * spline, double x,
+               gsl_interp_accel * a, int nderiv, double *y)
+{
+  const gsl_interp *interp = spline->interp;
+
+  if (interp->coef == NULL)
+    {
+      switch (nderiv)
+        {
+        case 0:
+          return gsl_interp_eval_e (interp, spline->x, spline->y, x, a, y);
+        case 1:
+          return gsl_interp_eval_deriv_e (interp, spline->x, spline->y,
+                                          x, a, y);
+        default:
+          return gsl_interp_eval_deriv2_e (interp, spline->x, spline->y,
+                                           x, a, y);
+        }
+    }
+
+  if (x < interp->xmin || x > interp->xmax)
+    {
+      *y = GSL_NAN;
+      return GSL_EDOM;
+    }
+
+  {
+    const size_t index = packed_index (interp, spline->x, x, a);
+    *y = packed_eval (interp->coef + 4 * index, x - spline->x[index], nderiv);
+  }
+
+  return GSL_SUCCESS;
+}
+
+static double
+spline_eval_val (const gsl_spline * spline, double x,
+                 gsl_interp_accel * a, int nderiv)
+{
+  double y;
+  int status = spline_eval_n (spline, x, a, nderiv, &y);
+
+  if (status != GSL_SUCCESS)
+    {
+      GSL_ERROR_VAL ("interpolation error", status, GSL_NAN);
+    }
+
+  return y;
+}
+
 int
 gsl_spline_eval_e (const gsl_spline * spline, 
                    double x,
                    gsl_interp_accel * a, double *y)
 {
-  return gsl_interp_eval_e (spline->interp, 
-                            spline->x, spline->y,
-                            x, a, y);
+  return spline_eval_n (spline, x, a, 0, y);
 }
 
 double
@@ -120,9 +175,7 @@ gsl_spline_eval (const gsl_spline * spline,
                  double x,
                  gsl_interp_accel * a)
 {
-  return gsl_interp_eval (spline->interp, 
-                          spline->x, spline->y,
-                          x, a);
+  return spline_eval_val (spline, x, a, 0);
 }
 
 
@@ -132,9 +185,7 @@ gsl_spline_eval_deriv_e (const gsl_spline * spline,
                          gsl_interp_accel * a,
                          double *dydx)
 {
-  return gsl_interp_eval_deriv_e (spline->interp, 
-                                  spline->x, spline->y,
-                                  x, a, dydx);
+  return spline_eval_n (spline, x, a, 1, dydx);
 }
 
 double
@@ -142,9 +193,7 @@ gsl_spline_eval_deriv (const gsl_spline * spline,
                        double x,
                        gsl_interp_accel * a)
 {
-  return gsl_interp_eval_deriv (spline->interp, 
-                                spline->x, spline->y,
-                                x, a);
+  return spline_eval_val (spline, x, a, 1);
 }
 
 
@@ -154,9 +203,7 @@ gsl_spline_eval_deriv2_e (const gsl_spline * spline,
                           gsl_interp_accel * a,
                           double * d2)
 {
-  return gsl_interp_eval_deriv2_e (spline->interp, 
-                                   spline->x, spline->y,
-                                   x, a, d2);
+  return spline_eval_n (spline, x, a, 2, d2);
 }
 
 double
@@ -164,9 +211,7 @@ gsl_spline_eval_deriv2 (const gsl_spline * spline,
                         double x,
                         gsl_interp_accel * a)
 {
-  return gsl_interp_eval_deriv2 (spline->interp, 
-                                 spline->x, spline->y,
-                                 x, a);
+  return spline_eval_val (spline, x, a, 2);
 }
 
 
@@ -192,3 +237,39 @@ gsl_spline_eval_integ (const gsl_spline * spline,
                                 a, b, acc);
 }
 
+int
+gsl_spline_eval_array (const gsl_spline * spline,
+                       const double x[], double y[], size_t n)
+{
+  return gsl_interp_eval_array (spline->interp,
+                                spline->x, spline->y,
+                                x, y, n);
+}
+
+int
+gsl_spline_eval_deriv_array (const gsl_spline * spline,
+                             const double x[], double dydx[], size_t n)
+{
+  return gsl_interp_eval_deriv_array (spline->interp,
+                                      spline->x, spline->y,
+                                      x, dydx, n);
+}
+
+int
+gsl_spline_eval_deriv2_array (const gsl_spline * spline,
+                              const double x[], double d2[], size_t n)
+{
+  return gsl_interp_eval_deriv2_array (spline->interp,
+                                       spline->x, spline->y,
+                                       x, d2, n);
+}
+
+int
+gsl_spline_eval_integ_array (const gsl_spline * spline,
+                             double a, const double x[], double y[],
+                             size_t n)
+{
+  return gsl_interp_eval_integ_array (spline->interp,
+                                      spline->x, spline->y,
+                                      a, x, y, n);
+}
@@ -370,6 +370,27 @@ steffen_copysign(const double x, const double y)
   return x;
 }
 
+static int
+steffen_coeffs (const void * vstate,
+                const double x_array[], const double y_array[], size_t size,
+                double coef[])
+{
+  const steffen_state_t *state = (const steffen_state_t *) vstate;
+  size_t i;
+
+  for (i = 0; i < size - 1; i++)
+    {
+      double *p = coef + 4 * i;
+
+      p[0] = state->d[i];
+      p[1] = state->c[i];
+      p[2] = state->b[i];
+      p[3] = state->a[i];
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_interp_type steffen_type = 
 {
   "steffen", 
@@ -380,7 +401,8 @@ static const gsl_interp_type steffen_type =
   &steffen_eval_deriv,
   &steffen_eval_deriv2,
   &steffen_eval_integ,
-  &steffen_free
+  &steffen_free,
+  &steffen_coeffs
 };
 
 const gsl_interp_type * gsl_interp_steffen = &steffen_type;
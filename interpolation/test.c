@@ -26,9 +26,12 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_interp.h>
+#include <gsl/gsl_spline.h>
+#include <gsl/gsl_interpnd.h>
 #include <gsl/gsl_ieee_utils.h>
 
 #include "test2d.c"
@@ -1205,6 +1208,361 @@ test_steffen2 (void)
   return s;
 }
 
+static int
+test_eval_array (const gsl_interp_type * T, size_t size)
+{
+  /* Compares the array functions with the spline functions for
+     single points, which evaluate the same interpolation of ya, for
+     points in increasing and in random order */
+
+  const size_t n = 4 * size;
+  double *xa = malloc (size * sizeof (double));
+  double *ya = malloc (size * sizeof (double));
+  double *x = malloc (n * sizeof (double));
+  double *y = malloc (n * sizeof (double));
+  double *dy = malloc (n * sizeof (double));
+  double *d2y = malloc (n * sizeof (double));
+  double *iy = malloc (n * sizeof (double));
+  gsl_interp *interp = gsl_interp_alloc (T, size);
+  gsl_spline *spline = gsl_spline_alloc (T, size);
+  gsl_interp_accel *acc = gsl_interp_accel_alloc ();
+  const double a = 0.3;
+  unsigned long int seed = 1;
+  int status = 0, order, s1, s2, s3, s4;
+  size_t i, j;
+
+  for (i = 0; i < size; i++)
+    {
+      xa[i] = i + 0.5 * sin (1.0 * i);
+      ya[i] = cos (0.7 * xa[i]);
+    }
+
+  if (T == gsl_interp_cspline_periodic || T == gsl_interp_akima_periodic)
+    ya[size - 1] = ya[0];
+
+  gsl_interp_init (interp, xa, ya, size);
+  gsl_spline_init (spline, xa, ya, size);
+
+  for (order = 0; order < 2; order++)
+    {
+      /* knots and points between them, then points outside */
+
+      for (j = 0; j < n - 4; j++)
+        {
+          i = j / 4;
+          x[j] = xa[i] + 0.25 * (j % 4) * (xa[i + 1] - xa[i]);
+        }
+
+      x[n - 4] = xa[size - 1];
+
+      if (order == 0)
+        {
+          x[n - 3] = xa[size - 1] + 1.0;
+          x[n - 2] = xa[size - 1] + 2.0;
+          x[n - 1] = xa[size - 1] + 3.0;
+        }
+      else
+        {
+          x[n - 3] = xa[0] - 1.0;
+          x[n - 2] = xa[size - 1] + 1.0;
+          x[n - 1] = GSL_NAN;
+
+          for (j = n - 1; j > 0; j--)
+            {
+              double tmp;
+              seed = (seed * 69069 + 1) & 0xffffffffUL;
+              i = seed % (j + 1);
+              tmp = x[i];
+              x[i] = x[j];
+              x[j] = tmp;
+            }
+        }
+
+      s1 = gsl_interp_eval_array (interp, xa, ya, x, y, n);
+      s2 = gsl_interp_eval_deriv_array (interp, xa, ya, x, dy, n);
+      s3 = gsl_interp_eval_deriv2_array (interp, xa, ya, x, d2y, n);
+      s4 = gsl_interp_eval_integ_array (interp, xa, ya, a, x, iy, n);
+
+      gsl_test_int (s1, GSL_EDOM, "%s eval_array order %d status",
+                    gsl_interp_name (interp), order);
+      gsl_test_int (s2, GSL_EDOM, "%s eval_deriv_array order %d status",
+                    gsl_interp_name (interp), order);
+      gsl_test_int (s3, GSL_EDOM, "%s eval_deriv2_array order %d status",
+                    gsl_interp_name (interp), order);
+      gsl_test_int (s4, GSL_EDOM, "%s eval_integ_array order %d status",
+                    gsl_interp_name (interp), order);
+
+      for (j = 0; j < n; j++)
+        {
+          double e, de, d2e, ie;
+
+          if (!(x[j] >= xa[0] && x[j] <= xa[size - 1]))
+            {
+              gsl_test (!gsl_isnan (y[j]) || !gsl_isnan (iy[j]),
+                        "%s eval_array order %d outside %d",
+                        gsl_interp_name (interp), order, (int) j);
+              continue;
+            }
+
+          gsl_interp_accel_reset (acc);
+          e = gsl_spline_eval (spline, x[j], acc);
+          de = gsl_spline_eval_deriv (spline, x[j], acc);
+          d2e = gsl_spline_eval_deriv2 (spline, x[j], acc);
+
+          if (x[j] >= a)
+            ie = gsl_spline_eval_integ (spline, a, x[j], acc);
+          else
+            ie = -gsl_spline_eval_integ (spline, x[j], a, acc);
+
+          gsl_test_rel (y[j], e, 1e-15, "%s eval_array order %d %d",
+                        gsl_interp_name (interp), order, (int) j);
+          gsl_test_rel (dy[j], de, 1e-15, "%s eval_deriv_array order %d %d",
+                        gsl_interp_name (interp), order, (int) j);
+          gsl_test_rel (d2y[j], d2e, 1e-15,
+                        "%s eval_deriv2_array order %d %d",
+                        gsl_interp_name (interp), order, (int) j);
+          gsl_test_abs (iy[j], ie, 1e-12, "%s eval_integ_array order %d %d",
+                        gsl_interp_name (interp), order, (int) j);
+        }
+    }
+
+  gsl_interp_accel_free (acc);
+  gsl_interp_free (interp);
+  gsl_spline_free (spline);
+  free (xa);
+  free (ya);
+  free (x);
+  free (y);
+  free (dy);
+  free (d2y);
+  free (iy);
+
+  return status;
+}
+
+static int
+test_uniform (const gsl_interp_type * T)
+{
+  /* Compares a spline on a uniform grid, where the interval is
+     computed directly, with the same grid perturbed by a relative
+     1e-5 of the spacing, where it is searched, and with
+     gsl_interp_eval */
+
+  const size_t size = 41;
+  double xa[41], xb[41], ya[41];
+  gsl_spline *sa = gsl_spline_alloc (T, size);
+  gsl_spline *sb = gsl_spline_alloc (T, size);
+  gsl_interp *ia = gsl_interp_alloc (T, size);
+  gsl_interp_accel *acc = gsl_interp_accel_alloc ();
+  int status = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    {
+      xa[i] = -1.0 + 0.1 * i;
+      xb[i] = xa[i];
+      ya[i] = exp (-xa[i] * xa[i]);
+    }
+
+  xb[size / 2] += 1e-6;
+
+  gsl_spline_init (sa, xa, ya, size);
+  gsl_spline_init (sb, xb, ya, size);
+  gsl_interp_init (ia, xa, ya, size);
+
+  gsl_test (!(sa->interp->xscale > 0.0), "%s uniform grid detected",
+            gsl_spline_name (sa));
+  gsl_test (sb->interp->xscale != 0.0, "%s nonuniform grid detected",
+            gsl_spline_name (sb));
+
+  for (i = 0; i <= 4 * (size - 1); i++)
+    {
+      const double x = (i % 4 == 0) ? xa[i / 4] : -1.0 + 0.025 * i;
+      double ea, eb, ei;
+
+      ea = gsl_spline_eval (sa, x, acc);
+      ei = gsl_interp_eval (ia, xa, ya, x, NULL);
+      gsl_test_rel (ea, ei, 1e-14, "%s uniform eval %d vs gsl_interp_eval",
+                    gsl_spline_name (sa), (int) i);
+
+      if (i % 4 == 0)
+        {
+          gsl_test_rel (ea, ya[i / 4], 1e-14, "%s uniform eval at knot %d",
+                        gsl_spline_name (sa), (int) i / 4);
+        }
+
+      /* away from the perturbed knot both grids give the same result */
+
+      if (fabs (x - xb[size / 2]) < 0.2)
+        continue;
+
+      eb = gsl_spline_eval (sb, x, NULL);
+      gsl_test_abs (ea, eb, 1e-4, "%s uniform eval %d",
+                    gsl_spline_name (sa), (int) i);
+    }
+
+  gsl_interp_accel_free (acc);
+  gsl_spline_free (sa);
+  gsl_spline_free (sb);
+  gsl_interp_free (ia);
+
+  return status;
+}
+
+static int
+test_linear_reuse (void)
+{
+  /* gsl_interp_eval uses the ya passed to it, so a linear
+     interpolation object can be used with several ya arrays */
+
+  const size_t size = 5;
+  double xa[5] = { 0.0, 1.0, 2.0, 3.0, 4.0 };
+  double ya[5] = { 0.0, 1.0, 4.0, 9.0, 16.0 };
+  double yb[5] = { 1.0, -1.0, 2.0, 0.5, 3.0 };
+  gsl_interp *interp = gsl_interp_alloc (gsl_interp_linear, size);
+  int status = 0;
+  size_t i;
+
+  gsl_interp_init (interp, xa, ya, size);
+
+  for (i = 0; i < 8; i++)
+    {
+      const double x = 0.5 * i + 0.25;
+      const size_t k = i / 2;
+      const double d = yb[k + 1] - yb[k];
+
+      gsl_test_rel (gsl_interp_eval (interp, xa, yb, x, NULL),
+                    yb[k] + (x - xa[k]) * d, 1e-15,
+                    "linear eval with other ya at %g", x);
+      gsl_test_rel (gsl_interp_eval_deriv (interp, xa, yb, x, NULL), d,
+                    1e-15, "linear eval_deriv with other ya at %g", x);
+    }
+
+  gsl_interp_free (interp);
+
+  return status;
+}
+
+static double
+interpnd_func (const double x[], size_t ndim, int cubic)
+{
+  /* tensor product of linear (cubic) polynomials in each coordinate */
+
+  double f = 1.0;
+  size_t k;
+
+  for (k = 0; k < ndim; k++)
+    {
+      const double xk = x[k] - 0.3 * k;
+      f *= cubic ? (1.0 + xk * (0.5 - xk * (0.2 - 0.1 * xk))) : (1.0 + 0.7 * xk);
+    }
+
+  return f + (cubic ? x[0] * x[0] * x[0] : x[0]);
+}
+
+static int
+test_interpnd (const gsl_interpnd_type * T, size_t ndim)
+{
+  /* Multilinear interpolation reproduces multilinear functions and
+     tensor cubic splines reproduce tensor cubic polynomials */
+
+  const int cubic = (T == gsl_interpnd_cubic);
+  const size_t npts = 200;
+  size_t size[GSL_INTERPND_MAX_DIM], index[GSL_INTERPND_MAX_DIM];
+  double *xa[GSL_INTERPND_MAX_DIM];
+  gsl_interp_accel *acc[GSL_INTERPND_MAX_DIM];
+  gsl_interpnd *interp;
+  double *za, *x, *z;
+  size_t i, k, n = 1;
+  unsigned long int seed = 7;
+  int status = 0, s;
+
+  for (k = 0; k < ndim; k++)
+    {
+      size[k] = 4 + 2 * k;
+      n *= size[k];
+      xa[k] = malloc (size[k] * sizeof (double));
+      acc[k] = gsl_interp_accel_alloc ();
+
+      for (i = 0; i < size[k]; i++)
+        xa[k][i] = -1.0 + 0.5 * i + 0.1 * sin (1.0 + i + k);
+    }
+
+  interp = gsl_interpnd_alloc (T, ndim, size);
+  za = malloc (n * sizeof (double));
+  x = malloc (npts * ndim * sizeof (double));
+  z = malloc (npts * sizeof (double));
+
+  /* grid values, with the index of the last axis varying fastest */
+
+  for (i = 0; i < n; i++)
+    {
+      double xg[GSL_INTERPND_MAX_DIM];
+      size_t r = i;
+
+      for (k = ndim; k-- > 0;)
+        {
+          index[k] = r % size[k];
+          r /= size[k];
+          xg[k] = xa[k][index[k]];
+        }
+
+      gsl_test_int (gsl_interpnd_idx (interp, index), i,
+                    "interpnd %s idx %d", gsl_interpnd_name (interp), (int) i);
+      za[i] = interpnd_func (xg, ndim, cubic);
+    }
+
+  gsl_interpnd_init (interp, (const double * const *) xa, za);
+
+  for (i = 0; i < npts; i++)
+    {
+      for (k = 0; k < ndim; k++)
+        {
+          const double a = xa[k][0], b = xa[k][size[k] - 1];
+          seed = (seed * 69069 + 1) & 0xffffffffUL;
+          x[i * ndim + k] = (i == 0) ? a : (i == 1) ? b
+            : a + (b - a) * (seed / 4294967296.0);
+        }
+    }
+
+  s = gsl_interpnd_eval_array (interp, x, z, npts, acc);
+  gsl_test (s, "interpnd %s %dd eval_array status", gsl_interpnd_name (interp),
+            (int) ndim);
+
+  for (i = 0; i < npts; i++)
+    {
+      const double f = interpnd_func (x + i * ndim, ndim, cubic);
+      const double e = gsl_interpnd_eval (interp, x + i * ndim, NULL);
+
+      gsl_test_abs (z[i], f, 1e-12, "interpnd %s %dd point %d",
+                    gsl_interpnd_name (interp), (int) ndim, (int) i);
+      gsl_test_abs (e, z[i], 1e-14, "interpnd %s %dd eval point %d",
+                    gsl_interpnd_name (interp), (int) ndim, (int) i);
+    }
+
+  /* points outside the grid */
+
+  x[0] = xa[0][0] - 0.1;
+  s = gsl_interpnd_eval_array (interp, x, z, 2, acc);
+  gsl_test_int (s, GSL_EDOM, "interpnd %s %dd outside status",
+                gsl_interpnd_name (interp), (int) ndim);
+  gsl_test (!gsl_isnan (z[0]), "interpnd %s %dd outside value",
+            gsl_interpnd_name (interp), (int) ndim);
+
+  for (k = 0; k < ndim; k++)
+    {
+      free (xa[k]);
+      gsl_interp_accel_free (acc[k]);
+    }
+
+  gsl_interpnd_free (interp);
+  free (za);
+  free (x);
+  free (z);
+
+  return status;
+}
+
 int 
 main (int argc, char **argv)
 {
@@ -1217,6 +1575,7 @@ main (int argc, char **argv)
 
   status += test_bsearch();
   status += test_linear();
+  status += test_linear_reuse();
   status += test_polynomial();
   status += test_cspline();
   status += test_cspline2();
@@ -1227,6 +1586,26 @@ main (int argc, char **argv)
   status += test_steffen1();
   status += test_steffen2();
 
+  status += test_eval_array(gsl_interp_linear, 50);
+  status += test_eval_array(gsl_interp_polynomial, 8);
+  status += test_eval_array(gsl_interp_cspline, 50);
+  status += test_eval_array(gsl_interp_cspline_periodic, 50);
+  status += test_eval_array(gsl_interp_akima, 50);
+  status += test_eval_array(gsl_interp_akima_periodic, 50);
+  status += test_eval_array(gsl_interp_steffen, 50);
+
+  status += test_uniform(gsl_interp_linear);
+  status += test_uniform(gsl_interp_cspline);
+  status += test_uniform(gsl_interp_akima);
+  status += test_uniform(gsl_interp_steffen);
+
+  status += test_interpnd(gsl_interpnd_linear, 1);
+  status += test_interpnd(gsl_interpnd_linear, 3);
+  status += test_interpnd(gsl_interpnd_linear, 5);
+  status += test_interpnd(gsl_interpnd_cubic, 1);
+  status += test_interpnd(gsl_interpnd_cubic, 2);
+  status += test_interpnd(gsl_interpnd_cubic, 4);
+
   status += test_interp2d_main();
 
   exit (gsl_test_summary());
@@ -42,6 +42,13 @@
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 
+/* matrices smaller than this are factored with the unblocked algorithm */
+#define CROSSOVER_CHOLESKY     24
+
+static int cholesky_decomp_L2(gsl_matrix * A);
+static int cholesky_decomp_L3(gsl_matrix * A);
+static void cholesky_update_upper(const double alpha, const gsl_vector * v,
+                                  gsl_matrix * A);
 static double cholesky_norm1(const gsl_matrix * LLT, gsl_vector * work);
 static int cholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
 
@@ -79,8 +86,8 @@ Inputs: A - (input) symmetric, positive definite matrix
 Return: success/error
 
 Notes:
-1) Based on algorithm 4.2.1 (Gaxpy Cholesky) of Golub and
-Van Loan, Matrix Computations (4th ed).
+1) The matrix is factored recursively (see cholesky_decomp_L3) so
+that most of the work is done in Level 3 BLAS
 
 2) original matrix is saved in upper triangle on output
 */
@@ -97,36 +104,10 @@ gsl_linalg_cholesky_decomp1 (gsl_matrix * A)
     }
   else
     {
-      size_t j;
-
       /* save original matrix in upper triangle for later rcond calculation */
       gsl_matrix_transpose_tricpy('L', 0, A, A);
 
-      for (j = 0; j < N; ++j)
-        {
-          double ajj;
-          gsl_vector_view v = gsl_matrix_subcolumn(A, j, j, N - j); /* A(j:n,j) */
-
-          if (j > 0)
-            {
-              gsl_vector_view w = gsl_matrix_subrow(A, j, 0, j);           /* A(j,1:j-1)^T */
-              gsl_matrix_view m = gsl_matrix_submatrix(A, j, 0, N - j, j); /* A(j:n,1:j-1) */
-
-              gsl_blas_dgemv(CblasNoTrans, -1.0, &m.matrix, &w.vector, 1.0, &v.vector);
-            }
-
-          ajj = gsl_matrix_get(A, j, j);
-
-          if (ajj <= 0.0)
-            {
-              GSL_ERROR("matrix is not positive definite", GSL_EDOM);
-            }
-
-          ajj = sqrt(ajj);
-          gsl_vector_scale(&v.vector, 1.0 / ajj);
-        }
-
-      return GSL_SUCCESS;
+      return cholesky_decomp_L3(A);
     }
 }
 
@@ -536,6 +517,280 @@ gsl_linalg_cholesky_rcond (const gsl_matrix * LLT, double * rcond,
     }
 }
 
+/*
+gsl_linalg_cholesky_update()
+  Update the Cholesky factorization of A to that of
+
+A + V V^T
+
+where V is N-by-k, with one sequence of Givens rotations per
+column of V, in O(k N^2) operations
+
+Inputs: LLT - (input) Cholesky factorization of A from
+                      gsl_linalg_cholesky_decomp1
+              (output) Cholesky factorization of A + V V^T;
+                       upper triangle contains A + V V^T
+        V   - N-by-k matrix, destroyed on output
+
+Return: success/error
+
+Notes:
+1) For each column v, the rotation in the (j, v) plane which
+annihilates v_j against L_jj is applied to column j of L and
+to v, for j = 1, ..., N. Since the rotations are orthogonal,
+L L^T + v v^T is preserved.
+*/
+
+int
+gsl_linalg_cholesky_update(gsl_matrix * LLT, gsl_matrix * V)
+{
+  const size_t N = LLT->size1;
+
+  if (N != LLT->size2)
+    {
+      GSL_ERROR ("cholesky matrix must be square", GSL_ENOTSQR);
+    }
+  else if (V->size1 != N)
+    {
+      GSL_ERROR ("V must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t j, k;
+
+      for (k = 0; k < V->size2; ++k)
+        {
+          gsl_vector_view v = gsl_matrix_column(V, k);
+
+          /* update original matrix in upper triangle */
+          cholesky_update_upper(1.0, &v.vector, LLT);
+
+          for (j = 0; j < N; ++j)
+            {
+              double *Ljj = gsl_matrix_ptr(LLT, j, j);
+              double vj = gsl_vector_get(&v.vector, j);
+              double r = hypot(*Ljj, vj);
+              double c = *Ljj / r;
+              double s = vj / r;
+
+              *Ljj = r;
+
+              if (j < N - 1)
+                {
+                  gsl_vector_view l = gsl_matrix_subcolumn(LLT, j, j + 1, N - j - 1);
+                  gsl_vector_view w = gsl_vector_subvector(&v.vector, j + 1, N - j - 1);
+
+                  /* [ l w ] <- [ c*l + s*w, c*w - s*l ] */
+                  gsl_blas_drot(&l.vector, &w.vector, c, s);
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_downdate()
+  Downdate the Cholesky factorization of A to that of
+
+A - V V^T
+
+where V is N-by-k, in O(k N^2) operations
+
+Inputs: LLT - (input) Cholesky factorization of A from
+                      gsl_linalg_cholesky_decomp1
+              (output) Cholesky factorization of A - V V^T;
+                       upper triangle contains A - V V^T
+        V   - N-by-k matrix, destroyed on output
+
+Return: success/error. If A - V V^T is not positive definite,
+GSL_EDOM is returned and LLT contains the factorization downdated
+by the columns of V preceding the one which caused the failure.
+
+Notes:
+1) This is the method of LINPACK routine DCHDD. For each column v,
+p = L^{-1} v is computed, and A - v v^T is positive definite if and
+only if alpha^2 = 1 - p^T p > 0. Rotations in the (j, N+1) planes,
+for j = N, ..., 1, then reduce [ p; alpha ] to e_{N+1}, and applied
+to [ L^T; 0 ] they produce [ L'^T; v^T ], where L' is the
+downdated factor.
+
+2) The vector v is overwritten by p in its leading elements and
+by the last row of the rotated matrix in its trailing elements,
+so no additional workspace is needed.
+*/
+
+int
+gsl_linalg_cholesky_downdate(gsl_matrix * LLT, gsl_matrix * V)
+{
+  const size_t N = LLT->size1;
+
+  if (N != LLT->size2)
+    {
+      GSL_ERROR ("cholesky matrix must be square", GSL_ENOTSQR);
+    }
+  else if (V->size1 != N)
+    {
+      GSL_ERROR ("V must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t j, k;
+
+      for (k = 0; k < V->size2; ++k)
+        {
+          gsl_vector_view v = gsl_matrix_column(V, k);
+          double pnorm, alpha;
+
+          /* v <- p = L^{-1} v */
+          gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, LLT, &v.vector);
+
+          pnorm = gsl_blas_dnrm2(&v.vector);
+          if (pnorm >= 1.0)
+            {
+              GSL_ERROR ("downdated matrix is not positive definite", GSL_EDOM);
+            }
+
+          alpha = sqrt((1.0 - pnorm) * (1.0 + pnorm));
+
+          for (j = N; j-- > 0; )
+            {
+              double *pj = gsl_vector_ptr(&v.vector, j);
+              double r = hypot(alpha, *pj);
+              double c = alpha / r;
+              double s = *pj / r;
+              gsl_vector_view l = gsl_matrix_subcolumn(LLT, j, j, N - j);
+              gsl_vector_view w = gsl_vector_subvector(&v.vector, j, N - j);
+
+              alpha = r;
+              *pj = 0.0;
+
+              /* [ l w ] <- [ c*l - s*w, c*w + s*l ] */
+              gsl_blas_drot(&l.vector, &w.vector, c, -s);
+            }
+
+          /* v now contains the original column; update upper triangle */
+          cholesky_update_upper(-1.0, &v.vector, LLT);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+cholesky_decomp_L2()
+  Unblocked Cholesky decomposition of the lower triangle of A
+
+Notes:
+1) Based on algorithm 4.2.1 (Gaxpy Cholesky) of Golub and
+Van Loan, Matrix Computations (4th ed).
+*/
+
+static int
+cholesky_decomp_L2(gsl_matrix * A)
+{
+  const size_t N = A->size1;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      double ajj;
+      gsl_vector_view v = gsl_matrix_subcolumn(A, j, j, N - j); /* A(j:n,j) */
+
+      if (j > 0)
+        {
+          gsl_vector_view w = gsl_matrix_subrow(A, j, 0, j);           /* A(j,1:j-1)^T */
+          gsl_matrix_view m = gsl_matrix_submatrix(A, j, 0, N - j, j); /* A(j:n,1:j-1) */
+
+          gsl_blas_dgemv(CblasNoTrans, -1.0, &m.matrix, &w.vector, 1.0, &v.vector);
+        }
+
+      ajj = gsl_matrix_get(A, j, j);
+
+      if (ajj <= 0.0)
+        {
+          GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+        }
+
+      ajj = sqrt(ajj);
+      gsl_vector_scale(&v.vector, 1.0 / ajj);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+cholesky_decomp_L3()
+  Recursive Cholesky decomposition of the lower triangle of A.
+Partitioning
+
+A = [ A11 A21^T ] = [ L11  0  ] [ L11^T L21^T ]
+    [ A21 A22   ]   [ L21 L22 ] [  0    L22^T ]
+
+gives
+
+1. A11 = L11 L11^T               (recursive)
+2. L21 = A21 L11^{-T}            (dtrsm)
+3. A22 - L21 L21^T = L22 L22^T   (dsyrk, then recursive)
+
+Only the lower triangle of A is referenced.
+
+Notes:
+1) Based on the recursive algorithm of E. Peise and P. Bientinesi,
+"Recursive algorithms for dense linear algebra: the ReLAPACK
+collection", 2016.
+*/
+
+static int
+cholesky_decomp_L3(gsl_matrix * A)
+{
+  const size_t N = A->size1;
+
+  if (N <= CROSSOVER_CHOLESKY)
+    {
+      return cholesky_decomp_L2(A);
+    }
+  else
+    {
+      const size_t N1 = N / 2;
+      const size_t N2 = N - N1;
+      gsl_matrix_view A11 = gsl_matrix_submatrix(A, 0, 0, N1, N1);
+      gsl_matrix_view A21 = gsl_matrix_submatrix(A, N1, 0, N2, N1);
+      gsl_matrix_view A22 = gsl_matrix_submatrix(A, N1, N1, N2, N2);
+      int status;
+
+      status = cholesky_decomp_L3(&A11.matrix);
+      if (status)
+        return status;
+
+      gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                     1.0, &A11.matrix, &A21.matrix);
+
+      gsl_blas_dsyrk(CblasLower, CblasNoTrans, -1.0, &A21.matrix,
+                     1.0, &A22.matrix);
+
+      return cholesky_decomp_L3(&A22.matrix);
+    }
+}
+
+/* A <- A + alpha v v^T in the strict upper triangle of A */
+static void
+cholesky_update_upper(const double alpha, const gsl_vector * v,
+                      gsl_matrix * A)
+{
+  const size_t N = A->size1;
+  size_t i;
+
+  for (i = 0; i + 1 < N; ++i)
+    {
+      gsl_vector_view a = gsl_matrix_subrow(A, i, i + 1, N - i - 1);
+      gsl_vector_const_view w = gsl_vector_const_subvector(v, i + 1, N - i - 1);
+
+      gsl_blas_daxpy(alpha * gsl_vector_get(v, i), &w.vector, &a.vector);
+    }
+}
+
 /* compute 1-norm of original matrix, stored in upper triangle of LLT;
  * diagonal entries have to be reconstructed */
 static double
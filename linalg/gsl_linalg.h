@@ -169,6 +169,53 @@ gsl_linalg_SV_solve (const gsl_matrix * U,
 
 int gsl_linalg_SV_leverage(const gsl_matrix *U, gsl_vector *h);
 
+/* Truncated Singular Value Decomposition
+
+ * A ~= U diag(S) V^T, with U and V having k columns, computed
+ * from products with A and A^T only
+ */
+
+typedef struct
+{
+  /* y = op(A) x, with op(A) = A or A^T */
+  int (* matvec) (CBLAS_TRANSPOSE_t TransA, const gsl_vector * x,
+                  gsl_vector * y, void * params);
+  size_t size1;                   /* number of rows of A */
+  size_t size2;                   /* number of columns of A */
+  void * params;                  /* user parameters */
+} gsl_linalg_operator;
+
+typedef struct
+{
+  size_t M;                       /* number of rows of A */
+  size_t N;                       /* number of columns of A */
+  size_t L;                       /* subspace dimension */
+  gsl_matrix *Q;                  /* left basis, M-by-L */
+  gsl_matrix *P;                  /* right basis, N-by-(L+1) */
+  gsl_matrix *B;                  /* L-by-L */
+  gsl_matrix *W;                  /* L-by-L */
+  gsl_vector *S;                  /* singular values of projected matrix, size L */
+  gsl_vector *work;               /* workspace, size L+1 */
+} gsl_linalg_tsvd_workspace;
+
+/* gsl_rng, declared here without including gsl_rng.h, whose inline
+ * functions would otherwise be compiled into linalg/inline.c */
+struct gsl_rng_struct;
+
+gsl_linalg_tsvd_workspace * gsl_linalg_tsvd_alloc (const size_t M, const size_t N,
+                                                   const size_t L);
+void gsl_linalg_tsvd_free (gsl_linalg_tsvd_workspace * w);
+gsl_linalg_operator gsl_linalg_operator_matrix (const gsl_matrix * A);
+int gsl_linalg_tsvd_rand (const gsl_linalg_operator * A, const size_t q,
+                          struct gsl_rng_struct * r, gsl_matrix * U, gsl_vector * S,
+                          gsl_matrix * V, gsl_linalg_tsvd_workspace * w);
+int gsl_linalg_tsvd_lanczos (const gsl_linalg_operator * A, struct gsl_rng_struct * r,
+                             gsl_matrix * U, gsl_vector * S, gsl_matrix * V,
+                             gsl_linalg_tsvd_workspace * w);
+int gsl_linalg_tsvd_solve (const gsl_matrix * U, const gsl_vector * S,
+                           const gsl_matrix * V, const double tol,
+                           const gsl_vector * b, gsl_vector * x, size_t * rank);
+
 
 /* LU Decomposition, Gaussian elimination with partial pivoting
  */
@@ -506,6 +553,10 @@ int gsl_linalg_cholesky_solve2 (const gsl_matrix * LLT,
 int gsl_linalg_cholesky_rcond (const gsl_matrix * LLT, double * rcond,
                                gsl_vector * work);
 
+int gsl_linalg_cholesky_update (gsl_matrix * LLT, gsl_matrix * V);
+
+int gsl_linalg_cholesky_downdate (gsl_matrix * LLT, gsl_matrix * V);
+
 /* Complex Cholesky Decomposition */
 
 int gsl_linalg_complex_cholesky_decomp (gsl_matrix_complex * A);
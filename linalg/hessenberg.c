@@ -21,6 +21,26 @@
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_errno.h>
+
+static int hessenberg_decomp_L2(gsl_matrix * A, gsl_vector * tau,
+                                const size_t start);
+static int hessenberg_panel(gsl_matrix * A, gsl_vector * tau, const size_t c0,
+                            gsl_matrix * V, gsl_matrix * T, gsl_matrix * Y,
+                            gsl_vector * b, gsl_vector * w);
+static int hessenberg_update(gsl_matrix * A, const size_t c0,
+                             const gsl_matrix * V, const gsl_matrix * T,
+                             const gsl_matrix * Y, gsl_matrix * W);
+static int hessenberg_larft(const gsl_matrix * H, const gsl_vector * tau,
+                            const size_t c0, gsl_matrix * V, gsl_matrix * T);
+
+/* block size of the panels in the blocked algorithms */
+#define HESSENBERG_BLOCK       32
+
+/* the blocked algorithms switch to the unblocked code once the
+ * remaining matrix has order less than or equal to this */
+#define CROSSOVER_HESSENBERG   128
 
 /*
 gsl_linalg_hessenberg_decomp()
@@ -61,6 +81,18 @@ row i + 3, column i, and so on.
 Also note that for the purposes of computing U(i),
 v(1:i) = 0, v(i + 1) = 1, and v(i+2:n) is what is stored in
 column i of A beneath the subdiagonal.
+
+For large matrices, the columns are reduced in panels of
+HESSENBERG_BLOCK columns (LAPACK DLAHRD/DLAHR2). The Householder
+matrices of a panel are accumulated in the compact WY form
+
+U(c0) ... U(c0 + nb - 1) = I - V T V^t
+
+and the trailing columns are updated with Level 3 BLAS once per
+panel rather than with two rank-1 updates per column; see
+
+Quintana-Orti and van de Geijn, "Improving the performance of
+reduction to Hessenberg form", ACM Trans. Math. Soft. 32 (2006).
 */
 
 int
@@ -82,53 +114,264 @@ gsl_linalg_hessenberg_decomp(gsl_matrix *A, gsl_vector *tau)
       /* nothing to do */
       return GSL_SUCCESS;
     }
+  else if (N <= CROSSOVER_HESSENBERG)
+    {
+      return hessenberg_decomp_L2(A, tau, 0);
+    }
   else
     {
-      size_t i;           /* looping */
-      gsl_vector_view c,  /* matrix column */
-                      hv; /* householder vector */
-      gsl_matrix_view m;
-      double tau_i;       /* beta in algorithm 7.4.2 */
+      const size_t nb = HESSENBERG_BLOCK;
+      gsl_matrix *V = gsl_matrix_alloc(N, nb);
+      gsl_matrix *Y = gsl_matrix_alloc(N, nb);
+      gsl_matrix *T = gsl_matrix_alloc(nb, nb);
+      gsl_matrix *W = gsl_matrix_alloc(nb, N);
+      gsl_vector *b = gsl_vector_alloc(N);
+      gsl_vector *w = gsl_vector_alloc(nb);
+      size_t c0 = 0;
+      int status;
+
+      if (V == NULL || Y == NULL || T == NULL || W == NULL ||
+          b == NULL || w == NULL)
+        {
+          status = GSL_ENOMEM;
+        }
+      else
+        {
+          while (N - c0 > CROSSOVER_HESSENBERG)
+            {
+              /* reduce columns c0:c0+nb-1 and form Y = A V T */
+              hessenberg_panel(A, tau, c0, V, T, Y, b, w);
 
-      for (i = 0; i < N - 2; ++i)
+              /* apply I - V T V^t to the trailing columns */
+              hessenberg_update(A, c0, V, T, Y, W);
+
+              c0 += nb;
+            }
+
+          /* reduce the remaining columns one at a time */
+          status = hessenberg_decomp_L2(A, tau, c0);
+        }
+
+      if (V)
+        gsl_matrix_free(V);
+      if (Y)
+        gsl_matrix_free(Y);
+      if (T)
+        gsl_matrix_free(T);
+      if (W)
+        gsl_matrix_free(W);
+      if (b)
+        gsl_vector_free(b);
+      if (w)
+        gsl_vector_free(w);
+
+      if (status)
         {
-          /*
-           * make a copy of A(i + 1:n, i) and store it in the section
-           * of 'tau' that we haven't stored coefficients in yet
-           */
+          GSL_ERROR ("failed to allocate space for Hessenberg workspace",
+                     status);
+        }
 
-          c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+      return GSL_SUCCESS;
+    }
+} /* gsl_linalg_hessenberg_decomp() */
 
-          hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
-          gsl_vector_memcpy(&hv.vector, &c.vector);
+/*
+hessenberg_decomp_L2()
+  Unblocked Hessenberg reduction of columns start:N-3 of A; the
+columns 0:start-1 must already be reduced with the trailing
+matrix updated accordingly
+*/
 
-          /* compute householder transformation of A(i+1:n,i) */
-          tau_i = gsl_linalg_householder_transform(&hv.vector);
+static int
+hessenberg_decomp_L2(gsl_matrix * A, gsl_vector * tau, const size_t start)
+{
+  const size_t N = A->size1;
+  size_t i;           /* looping */
+  gsl_vector_view c,  /* matrix column */
+                  hv; /* householder vector */
+  gsl_matrix_view m;
+  double tau_i;       /* beta in algorithm 7.4.2 */
 
-          /* apply left householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
-          gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+  for (i = start; i < N - 2; ++i)
+    {
+      /*
+       * make a copy of A(i + 1:n, i) and store it in the section
+       * of 'tau' that we haven't stored coefficients in yet
+       */
+
+      c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+
+      hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
+      gsl_vector_memcpy(&hv.vector, &c.vector);
+
+      /* compute householder transformation of A(i+1:n,i) */
+      tau_i = gsl_linalg_householder_transform(&hv.vector);
+
+      /* apply left householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
+      gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+
+      /* apply right householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
+      gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+
+      /* save Householder coefficient */
+      gsl_vector_set(tau, i, tau_i);
+
+      /*
+       * store Householder vector below the subdiagonal in column
+       * i of the matrix. hv(1) does not need to be stored since
+       * it is always 1.
+       */
+      c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
+      hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
+      gsl_vector_memcpy(&c.vector, &hv.vector);
+    }
 
-          /* apply right householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
-          gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+  return GSL_SUCCESS;
+} /* hessenberg_decomp_L2() */
 
-          /* save Householder coefficient */
-          gsl_vector_set(tau, i, tau_i);
+/*
+hessenberg_panel()
+  Reduce the columns c0:c0+nb-1 of A, where nb = V->size2. The
+trailing columns c0+nb:N-1 are not modified. On output
+
+U(c0) ... U(c0 + nb - 1) = I - V T V^t
+
+with V stored explicitly (including the zeros and unit entries),
+T upper triangular, and Y = A V T where A is the matrix on input.
+
+Inputs: A   - matrix, columns 0:c0-1 already reduced
+        tau - Householder coefficients
+        c0  - first column of panel
+        V   - (output) N-by-nb Householder vectors
+        T   - (output) nb-by-nb triangular factor
+        Y   - (output) N-by-nb matrix A V T
+        b   - workspace, length N
+        w   - workspace, length nb
+*/
 
-          /*
-           * store Householder vector below the subdiagonal in column
-           * i of the matrix. hv(1) does not need to be stored since
-           * it is always 1.
-           */
-          c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
-          hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
-          gsl_vector_memcpy(&c.vector, &hv.vector);
+static int
+hessenberg_panel(gsl_matrix * A, gsl_vector * tau, const size_t c0,
+                 gsl_matrix * V, gsl_matrix * T, gsl_matrix * Y,
+                 gsl_vector * b, gsl_vector * w)
+{
+  const size_t N = A->size1;
+  const size_t nb = V->size2;
+  size_t i;
+
+  gsl_matrix_set_zero(V);
+
+  for (i = 0; i < nb; ++i)
+    {
+      const size_t j = c0 + i;
+      gsl_vector_view aj = gsl_matrix_column(A, j);
+      gsl_vector_view vi = gsl_matrix_subcolumn(V, i, j + 1, N - j - 1);
+      gsl_vector_view yi = gsl_matrix_column(Y, i);
+      gsl_vector_view x = gsl_vector_subvector(b, j + 1, N - j - 1);
+      double tau_i;
+
+      gsl_vector_memcpy(b, &aj.vector);
+
+      if (i > 0)
+        {
+          gsl_matrix_view Yp = gsl_matrix_submatrix(Y, 0, 0, N, i);
+          gsl_matrix_view Vp = gsl_matrix_submatrix(V, c0 + 1, 0, N - c0 - 1, i);
+          gsl_matrix_view Tp = gsl_matrix_submatrix(T, 0, 0, i, i);
+          gsl_vector_view vj = gsl_matrix_subrow(V, j, 0, i);
+          gsl_vector_view bp = gsl_vector_subvector(b, c0 + 1, N - c0 - 1);
+          gsl_vector_view wp = gsl_vector_subvector(w, 0, i);
+
+          /* apply the previous reflectors from the right: b -= Y V(j,:)^t */
+          gsl_blas_dgemv(CblasNoTrans, -1.0, &Yp.matrix, &vj.vector, 1.0, b);
+
+          /* and from the left: b -= V T^t V^t b */
+          gsl_blas_dgemv(CblasTrans, 1.0, &Vp.matrix, &bp.vector, 0.0, &wp.vector);
+          gsl_blas_dtrmv(CblasUpper, CblasTrans, CblasNonUnit, &Tp.matrix, &wp.vector);
+          gsl_blas_dgemv(CblasNoTrans, -1.0, &Vp.matrix, &wp.vector, 1.0, &bp.vector);
         }
 
-      return GSL_SUCCESS;
+      /* compute householder transformation of b(j+1:n) */
+      tau_i = gsl_linalg_householder_transform(&x.vector);
+      gsl_vector_set(tau, j, tau_i);
+
+      /*
+       * column j is now final: the Hessenberg entries, beta on the
+       * subdiagonal and the Householder vector below it
+       */
+      gsl_vector_memcpy(&aj.vector, b);
+
+      gsl_vector_memcpy(&vi.vector, &x.vector);
+      gsl_vector_set(&vi.vector, 0, 1.0);
+
+      /* Y(:,i) = tau_i (A(:,j+1:n) v - Y(:,0:i) V(:,0:i)^t v) */
+      {
+        gsl_matrix_view m = gsl_matrix_submatrix(A, 0, j + 1, N, N - j - 1);
+        gsl_blas_dgemv(CblasNoTrans, tau_i, &m.matrix, &vi.vector, 0.0, &yi.vector);
+      }
+
+      if (i > 0)
+        {
+          gsl_matrix_view Yp = gsl_matrix_submatrix(Y, 0, 0, N, i);
+          gsl_matrix_view Vp = gsl_matrix_submatrix(V, j + 1, 0, N - j - 1, i);
+          gsl_matrix_view Tp = gsl_matrix_submatrix(T, 0, 0, i, i);
+          gsl_vector_view ti = gsl_matrix_subcolumn(T, i, 0, i);
+
+          /* T(0:i,i) = V(:,0:i)^t v */
+          gsl_blas_dgemv(CblasTrans, 1.0, &Vp.matrix, &vi.vector, 0.0, &ti.vector);
+
+          gsl_blas_dgemv(CblasNoTrans, -tau_i, &Yp.matrix, &ti.vector, 1.0, &yi.vector);
+
+          /* T(0:i,i) = -tau_i T(0:i,0:i) V(:,0:i)^t v */
+          gsl_blas_dtrmv(CblasUpper, CblasNoTrans, CblasNonUnit, &Tp.matrix, &ti.vector);
+          gsl_vector_scale(&ti.vector, -tau_i);
+        }
+
+      gsl_matrix_set(T, i, i, tau_i);
     }
-} /* gsl_linalg_hessenberg_decomp() */
+
+  return GSL_SUCCESS;
+} /* hessenberg_panel() */
+
+/*
+hessenberg_update()
+  Apply the panel transformation Q = I - V T V^t computed by
+hessenberg_panel() to the trailing columns c0+nb:N-1 of A,
+
+A(:,c0+nb:n) := Q^t (A Q)(:,c0+nb:n)
+
+Inputs: A  - matrix
+        c0 - first column of panel
+        V  - Householder vectors of panel
+        T  - triangular factor of panel
+        Y  - A V T
+        W  - workspace, nb-by-N
+*/
+
+static int
+hessenberg_update(gsl_matrix * A, const size_t c0,
+                  const gsl_matrix * V, const gsl_matrix * T,
+                  const gsl_matrix * Y, gsl_matrix * W)
+{
+  const size_t N = A->size1;
+  const size_t nb = V->size2;
+  const size_t m = N - c0 - nb; /* number of trailing columns */
+  gsl_matrix_view A2 = gsl_matrix_submatrix(A, 0, c0 + nb, N, m);
+  gsl_matrix_const_view V2 = gsl_matrix_const_submatrix(V, c0 + nb, 0, m, nb);
+  gsl_matrix_view A3 = gsl_matrix_submatrix(A, c0 + 1, c0 + nb, N - c0 - 1, m);
+  gsl_matrix_const_view V3 = gsl_matrix_const_submatrix(V, c0 + 1, 0, N - c0 - 1, nb);
+  gsl_matrix_view W3 = gsl_matrix_submatrix(W, 0, 0, nb, m);
+
+  /* right update: A(:,c0+nb:n) -= Y V(c0+nb:n,:)^t */
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, -1.0, Y, &V2.matrix, 1.0, &A2.matrix);
+
+  /* left update: A(c0+1:n,c0+nb:n) -= V T^t V^t A(c0+1:n,c0+nb:n) */
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &V3.matrix, &A3.matrix, 0.0, &W3.matrix);
+  gsl_blas_dtrmm(CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, 1.0, T, &W3.matrix);
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, -1.0, &V3.matrix, &W3.matrix, 1.0, &A3.matrix);
+
+  return GSL_SUCCESS;
+} /* hessenberg_update() */
 
 /*
 gsl_linalg_hessenberg_unpack()
@@ -224,7 +467,7 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
     }
   else
     {
-      size_t j;           /* looping */
+      size_t j = 0;       /* looping */
       double tau_j;       /* householder coefficient */
       gsl_vector_view c,  /* matrix column */
                       hv; /* householder vector */
@@ -236,7 +479,52 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
           return GSL_SUCCESS;
         }
 
-      for (j = 0; j < (N - 2); ++j)
+      if (N > CROSSOVER_HESSENBERG)
+        {
+          /*
+           * accumulate blocks of HESSENBERG_BLOCK Householder matrices
+           * in the form I - Vb T Vb^t and apply them with Level 3 BLAS:
+           *
+           * V -> V - (V Vb) T Vb^t
+           */
+          const size_t nb = HESSENBERG_BLOCK;
+          gsl_matrix *Vb = gsl_matrix_alloc(N - 1, nb);
+          gsl_matrix *T = gsl_matrix_alloc(nb, nb);
+          gsl_matrix *W = gsl_matrix_alloc(V->size1, nb);
+
+          if (Vb == NULL || T == NULL || W == NULL)
+            {
+              if (Vb)
+                gsl_matrix_free(Vb);
+              if (T)
+                gsl_matrix_free(T);
+              if (W)
+                gsl_matrix_free(W);
+
+              GSL_ERROR ("failed to allocate space for Hessenberg workspace",
+                         GSL_ENOMEM);
+            }
+
+          while (N - j > CROSSOVER_HESSENBERG)
+            {
+              gsl_matrix_view Vj = gsl_matrix_submatrix(Vb, 0, 0, N - j - 1, nb);
+
+              hessenberg_larft(H, tau, j, &Vj.matrix, T);
+
+              m = gsl_matrix_submatrix(V, 0, j + 1, V->size1, N - (j + 1));
+              gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &m.matrix, &Vj.matrix, 0.0, W);
+              gsl_blas_dtrmm(CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, T, W);
+              gsl_blas_dgemm(CblasNoTrans, CblasTrans, -1.0, W, &Vj.matrix, 1.0, &m.matrix);
+
+              j += nb;
+            }
+
+          gsl_matrix_free(Vb);
+          gsl_matrix_free(T);
+          gsl_matrix_free(W);
+        }
+
+      for (; j < (N - 2); ++j)
         {
           c = gsl_matrix_column(H, j);
 
@@ -268,6 +556,56 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
     }
 } /* gsl_linalg_hessenberg_unpack_accum() */
 
+/*
+hessenberg_larft()
+  Form the triangular factor T of the block reflector
+
+U(c0) ... U(c0 + nb - 1) = I - V T V^t
+
+from the Householder vectors stored in H by
+gsl_linalg_hessenberg_decomp(), with nb = V->size2. Row r of
+V corresponds to row c0 + 1 + r of H; the unit entries and zeros
+above them are stored explicitly (LAPACK DLARFT).
+*/
+
+static int
+hessenberg_larft(const gsl_matrix * H, const gsl_vector * tau,
+                 const size_t c0, gsl_matrix * V, gsl_matrix * T)
+{
+  const size_t N = H->size1;
+  const size_t nb = V->size2;
+  size_t i;
+
+  gsl_matrix_set_zero(V);
+
+  for (i = 0; i < nb; ++i)
+    {
+      const size_t j = c0 + i;
+      const double tau_i = gsl_vector_get(tau, j);
+      gsl_vector_const_view h = gsl_matrix_const_subcolumn(H, j, j + 2, N - j - 2);
+      gsl_vector_view vi = gsl_matrix_subcolumn(V, i, i + 1, N - j - 2);
+
+      gsl_matrix_set(V, i, i, 1.0);
+      gsl_vector_memcpy(&vi.vector, &h.vector);
+
+      if (i > 0)
+        {
+          gsl_matrix_const_view Vp = gsl_matrix_const_submatrix(V, i, 0, N - j - 1, i);
+          gsl_vector_const_view v = gsl_matrix_const_subcolumn(V, i, i, N - j - 1);
+          gsl_matrix_const_view Tp = gsl_matrix_const_submatrix(T, 0, 0, i, i);
+          gsl_vector_view ti = gsl_matrix_subcolumn(T, i, 0, i);
+
+          /* T(0:i,i) = -tau_i T(0:i,0:i) V(:,0:i)^t v */
+          gsl_blas_dgemv(CblasTrans, -tau_i, &Vp.matrix, &v.vector, 0.0, &ti.vector);
+          gsl_blas_dtrmv(CblasUpper, CblasNoTrans, CblasNonUnit, &Tp.matrix, &ti.vector);
+        }
+
+      gsl_matrix_set(T, i, i, tau_i);
+    }
+
+  return GSL_SUCCESS;
+} /* hessenberg_larft() */
+
 /*
 gsl_linalg_hessenberg_set_zero()
   Zero out the lower triangular portion of the Hessenberg matrix H.
@@ -559,7 +559,9 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
     {
       const size_t M = A->size1;
       const size_t N = A->size2;
-      size_t i, j, k;
+      const size_t nplayers = N + (N % 2); /* N rounded up to even */
+      gsl_matrix *At, *Qt;
+      size_t i, j, round;
 
       /* Initialize the rotation counter and the sweep counter. */
       int count = 1;
@@ -571,30 +573,55 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
       /* Always do at least 12 sweeps. */
       sweepmax = GSL_MAX (sweepmax, 12);
 
+      /* Work with A^T and Q^T, so that the columns being rotated are
+         contiguous rows in memory */
+
+      At = gsl_matrix_alloc (N, M);
+      if (At == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for A^T", GSL_ENOMEM);
+        }
+
+      Qt = gsl_matrix_alloc (N, N);
+      if (Qt == NULL)
+        {
+          gsl_matrix_free (At);
+          GSL_ERROR ("failed to allocate space for Q^T", GSL_ENOMEM);
+        }
+
+      gsl_matrix_transpose_memcpy (At, A);
+
       /* Set Q to the identity matrix. */
-      gsl_matrix_set_identity (Q);
+      gsl_matrix_set_identity (Qt);
 
       /* Store the column error estimates in S, for use during the
          orthogonalization */
 
       for (j = 0; j < N; j++)
         {
-          gsl_vector_view cj = gsl_matrix_column (A, j);
+          gsl_vector_view cj = gsl_matrix_row (At, j);
           double sj = gsl_blas_dnrm2 (&cj.vector);
           gsl_vector_set(S, j, GSL_DBL_EPSILON * sj);
         }
     
-      /* Orthogonalize A by plane rotations. */
+      /* Orthogonalize A by plane rotations. Each sweep visits all
+         column pairs in the round-robin order of Brent and Luk: the
+         N(N-1)/2 pairs are split into nplayers - 1 rounds of
+         nplayers/2 disjoint pairs, so the rotations within a round are
+         independent of each other and could be applied concurrently.
+         For odd N, a dummy column N pads the schedule and its pairs
+         are skipped. */
 
       while (count > 0 && sweep <= sweepmax)
         {
           /* Initialize rotation counter. */
           count = N * (N - 1) / 2;
 
-          for (j = 0; j < N - 1; j++)
+          for (round = 0; round + 1 < nplayers; round++)
             {
-              for (k = j + 1; k < N; k++)
+              for (i = 0; i < nplayers / 2; i++)
                 {
+                  size_t j1, k1, k;
                   double a = 0.0;
                   double b = 0.0;
                   double p = 0.0;
@@ -602,10 +629,29 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
                   double cosine, sine;
                   double v;
                   double abserr_a, abserr_b;
-                  int sorted, orthog, noisya, noisyb;
+                  int orthog, noisya, noisyb;
+                  gsl_vector_view cj, ck;
 
-                  gsl_vector_view cj = gsl_matrix_column (A, j);
-                  gsl_vector_view ck = gsl_matrix_column (A, k);
+                  /* column nplayers - 1 is fixed, the others rotate */
+                  if (i == 0)
+                    {
+                      j1 = round;
+                      k1 = nplayers - 1;
+                    }
+                  else
+                    {
+                      j1 = (round + i) % (nplayers - 1);
+                      k1 = (round + nplayers - 1 - i) % (nplayers - 1);
+                    }
+
+                  j = GSL_MIN (j1, k1);
+                  k = GSL_MAX (j1, k1);
+
+                  if (k >= N)
+                    continue; /* dummy column */
+
+                  cj = gsl_matrix_row (At, j);
+                  ck = gsl_matrix_row (At, k);
 
                   gsl_blas_ddot (&cj.vector, &ck.vector, &p);
                   p *= 2.0 ;  /* equation 9a:  p = 2 x.y */
@@ -621,49 +667,34 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
                   abserr_a = gsl_vector_get(S,j);
                   abserr_b = gsl_vector_get(S,k);
 
-                  sorted = (GSL_COERCE_DBL(a) >= GSL_COERCE_DBL(b));
                   orthog = (fabs (p) <= tolerance * GSL_COERCE_DBL(a * b));
                   noisya = (a < abserr_a);
                   noisyb = (b < abserr_b);
 
-                  if (sorted && (orthog || noisya || noisyb))
+                  if (orthog || noisya || noisyb)
                     {
                       count--;
                       continue;
                     }
 
-                  /* calculate rotation angles */
-                  if (v == 0 || !sorted)
-                    {
-                      cosine = 0.0;
-                      sine = 1.0;
-                    }
-                  else
-                    {
-                      cosine = sqrt((v + q) / (2.0 * v));
-                      sine = p / (2.0 * v * cosine);
-                    }
+                  /* calculate rotation angles, choosing the smaller
+                     rotation |theta| <= pi/4 whatever the order of the
+                     column norms; the columns are sorted at the end */
+                  cosine = sqrt((v + fabs(q)) / (2.0 * v));
+                  sine = ((q < 0.0) ? -p : p) / (2.0 * v * cosine);
 
                   /* apply rotation to A */
-                  for (i = 0; i < M; i++)
-                    {
-                      const double Aik = gsl_matrix_get (A, i, k);
-                      const double Aij = gsl_matrix_get (A, i, j);
-                      gsl_matrix_set (A, i, j, Aij * cosine + Aik * sine);
-                      gsl_matrix_set (A, i, k, -Aij * sine + Aik * cosine);
-                    }
+                  gsl_blas_drot (&cj.vector, &ck.vector, cosine, sine);
 
-                  gsl_vector_set(S, j, fabs(cosine) * abserr_a + fabs(sine) * abserr_b);
-                  gsl_vector_set(S, k, fabs(sine) * abserr_a + fabs(cosine) * abserr_b);
+                  /* the rounding errors in the two columns are rotated
+                     along with them, so their combined size is unchanged */
+                  gsl_vector_set(S, j, hypot(cosine * abserr_a, sine * abserr_b));
+                  gsl_vector_set(S, k, hypot(sine * abserr_a, cosine * abserr_b));
 
                   /* apply rotation to Q */
-                  for (i = 0; i < N; i++)
-                    {
-                      const double Qij = gsl_matrix_get (Q, i, j);
-                      const double Qik = gsl_matrix_get (Q, i, k);
-                      gsl_matrix_set (Q, i, j, Qij * cosine + Qik * sine);
-                      gsl_matrix_set (Q, i, k, -Qij * sine + Qik * cosine);
-                    }
+                  cj = gsl_matrix_row (Qt, j);
+                  ck = gsl_matrix_row (Qt, k);
+                  gsl_blas_drot (&cj.vector, &ck.vector, cosine, sine);
                 }
             }
 
@@ -671,6 +702,27 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
           sweep++;
         }
 
+      /* Sort the columns into order of decreasing norm */
+
+      for (j = 0; j < N; j++)
+        {
+          gsl_vector_view cj = gsl_matrix_row (At, j);
+          gsl_vector_set (S, j, gsl_blas_dnrm2 (&cj.vector));
+        }
+
+      for (j = 0; j + 1 < N; j++)
+        {
+          gsl_vector_view Sj = gsl_vector_subvector (S, j, N - j);
+          size_t kmax = j + gsl_vector_max_index (&Sj.vector);
+
+          if (kmax != j)
+            {
+              gsl_vector_swap_elements (S, j, kmax);
+              gsl_matrix_swap_rows (At, j, kmax);
+              gsl_matrix_swap_rows (Qt, j, kmax);
+            }
+        }
+
       /* 
        * Orthogonalization complete. Compute singular values.
        */
@@ -680,7 +732,7 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
 
         for (j = 0; j < N; j++)
           {
-            gsl_vector_view column = gsl_matrix_column (A, j);
+            gsl_vector_view column = gsl_matrix_row (At, j);
             double norm = gsl_blas_dnrm2 (&column.vector);
 
             /* Determine if singular value is zero, according to the
@@ -705,6 +757,12 @@ gsl_linalg_SV_decomp_jacobi (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S)
           }
       }
 
+      gsl_matrix_transpose_memcpy (A, At);
+      gsl_matrix_transpose_memcpy (Q, Qt);
+
+      gsl_matrix_free (At);
+      gsl_matrix_free (Qt);
+
       if (count > 0)
         {
           /* reached sweep limit */
@@ -407,6 +407,7 @@ gsl_matrix * moler10;
 
 #include "test_cholesky.c"
 #include "test_cod.c"
+#include "test_tsvd.c"
 
 int
 test_LU_solve_dim(const gsl_matrix * m, const double * actual, double eps)
@@ -3289,6 +3290,66 @@ int test_SV_decomp_jacobi(void)
   }
 #endif
 
+  /* larger matrices, with odd and even numbers of columns for the
+     round-robin ordering */
+  {
+    size_t N;
+
+    for (N = 30; N <= 31; N++)
+      {
+        gsl_matrix * m = create_general_matrix(50, N);
+
+        f = test_SV_decomp_jacobi_dim(m, 256 * GSL_DBL_EPSILON);
+        gsl_test(f, "  SV_decomp_jacobi general(50,%zu)", N);
+        s += f;
+
+        gsl_matrix_free(m);
+      }
+  }
+
+  /* compare singular values of a larger random matrix with
+     Golub-Reinsch; many rotations are needed per sweep, so this
+     also checks that the column error estimates stay bounded */
+  {
+    const size_t M = 200;
+    const size_t N = 100;
+    gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+    gsl_matrix * m = gsl_matrix_alloc(M, N);
+    gsl_matrix * u = gsl_matrix_alloc(M, N);
+    gsl_matrix * q = gsl_matrix_alloc(N, N);
+    gsl_vector * d = gsl_vector_alloc(N);
+    gsl_vector * d_expected = gsl_vector_alloc(N);
+    gsl_vector * work = gsl_vector_alloc(N);
+    size_t i, j;
+
+    for (i = 0; i < M; i++)
+      {
+        for (j = 0; j < N; j++)
+          gsl_matrix_set(m, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+      }
+
+    gsl_matrix_memcpy(u, m);
+    gsl_linalg_SV_decomp(u, q, d_expected, work);
+
+    gsl_matrix_memcpy(u, m);
+    gsl_linalg_SV_decomp_jacobi(u, q, d);
+
+    for (j = 0; j < N; j++)
+      {
+        gsl_test_rel(gsl_vector_get(d, j), gsl_vector_get(d_expected, j),
+                     1.0e-12, "  SV_decomp_jacobi random(%zu,%zu) S[%zu]",
+                     M, N, j);
+      }
+
+    gsl_rng_free(r);
+    gsl_matrix_free(m);
+    gsl_matrix_free(u);
+    gsl_matrix_free(q);
+    gsl_vector_free(d);
+    gsl_vector_free(d_expected);
+    gsl_vector_free(work);
+  }
+
   {
     int i;
     unsigned long k = 0;
@@ -4265,6 +4326,88 @@ int test_bidiag_decomp(void)
   return s;
 }
 
+/* compare the Hessenberg reduction of a random matrix with the
+ * unblocked reduction of gsl_linalg_hessenberg_submatrix, and check
+ * that A = U H U^T */
+int
+test_hessenberg_decomp_eps(const size_t N, const double eps, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * H = gsl_matrix_alloc(N, N);
+  gsl_matrix * H_expected = gsl_matrix_alloc(N, N);
+  gsl_matrix * U = gsl_matrix_alloc(N, N);
+  gsl_matrix * UH = gsl_matrix_alloc(N, N);
+  gsl_vector * tau = gsl_vector_alloc(N);
+  size_t i, j;
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        gsl_matrix_set(A, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+    }
+
+  gsl_matrix_memcpy(H_expected, A);
+  gsl_linalg_hessenberg_submatrix(H_expected, H_expected, 0, tau);
+  gsl_linalg_hessenberg_set_zero(H_expected);
+
+  gsl_matrix_memcpy(H, A);
+  s += gsl_linalg_hessenberg_decomp(H, tau);
+  s += gsl_linalg_hessenberg_unpack(H, tau, U);
+  gsl_linalg_hessenberg_set_zero(H);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          gsl_test_abs(gsl_matrix_get(H, i, j),
+                       gsl_matrix_get(H_expected, i, j), eps,
+                       "  hessenberg_decomp random(%zu) H(%zu,%zu)", N, i, j);
+        }
+    }
+
+  /* A = U H U^T */
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, U, H, 0.0, UH);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, UH, U, 0.0, H);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          gsl_test_abs(gsl_matrix_get(H, i, j), gsl_matrix_get(A, i, j), eps,
+                       "  hessenberg_decomp random(%zu) A(%zu,%zu)", N, i, j);
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(H);
+  gsl_matrix_free(H_expected);
+  gsl_matrix_free(U);
+  gsl_matrix_free(UH);
+  gsl_vector_free(tau);
+
+  return s;
+}
+
+int
+test_hessenberg_decomp(void)
+{
+  const size_t sizes[] = { 5, 50, 150, 300 };
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  size_t i;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      const size_t N = sizes[i];
+      s += test_hessenberg_decomp_eps(N, 16.0 * N * GSL_DBL_EPSILON, r);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
 int
 test_tri_invert2(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_rng * r, const double tol)
 {
@@ -4407,6 +4550,7 @@ main(void)
   gsl_test(test_tri_invert(r),           "Triangular Inverse");
 
   gsl_test(test_bidiag_decomp(),         "Bidiagonal Decomposition");
+  gsl_test(test_hessenberg_decomp(),     "Hessenberg Decomposition");
   gsl_test(test_LU_solve(),              "LU Decomposition and Solve");
   gsl_test(test_LUc_solve(),             "Complex LU Decomposition and Solve");
   gsl_test(test_QR_decomp(),             "QR Decomposition");
@@ -4439,12 +4583,14 @@ main(void)
   gsl_test(test_SV_decomp_jacobi(),      "Singular Value Decomposition (Jacobi)");
   gsl_test(test_SV_decomp_mod(),         "Singular Value Decomposition (Mod)");
   gsl_test(test_SV_solve(),              "SVD Solve");
+  gsl_test(test_tsvd(),                  "Truncated SVD");
 
   gsl_test(test_cholesky_decomp_unit(),  "Cholesky Decomposition [unit triangular]");
   gsl_test(test_cholesky_solve(),        "Cholesky Solve");
 
   gsl_test(test_cholesky_decomp(r),      "Cholesky Decomposition");
   gsl_test(test_cholesky_invert(r),      "Cholesky Inverse");
+  gsl_test(test_cholesky_update(r),      "Cholesky Update");
   gsl_test(test_pcholesky_decomp(r),     "Pivoted Cholesky Decomposition");
   gsl_test(test_pcholesky_solve(r),      "Pivoted Cholesky Solve");
   gsl_test(test_pcholesky_invert(r),     "Pivoted Cholesky Inverse");
@@ -36,6 +36,10 @@ static int test_cholesky_decomp_eps(const int scale, const gsl_matrix * m,
 static int test_cholesky_decomp(gsl_rng * r);
 int test_cholesky_invert_eps(const gsl_matrix * m, const double eps, const char *desc);
 int test_cholesky_invert(gsl_rng * r);
+static int test_cholesky_update_eps(const gsl_matrix * m, const gsl_matrix * V,
+                                    const int downdate, const double eps,
+                                    const char * desc);
+static int test_cholesky_update(gsl_rng * r);
 static int test_pcholesky_decomp_eps(const int scale, const gsl_matrix * m,
                                      const double expected_rcond, const double eps,
                                      const char * desc);
@@ -165,6 +169,17 @@ test_cholesky_decomp(gsl_rng * r)
       gsl_matrix_free(m);
     }
 
+  /* larger matrices for several levels of recursion */
+  for (N = 97; N <= 300; N += 203)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_posdef_matrix(m, r);
+      test_cholesky_decomp_eps(0, m, -1.0, 1.0e2 * N * GSL_DBL_EPSILON, "cholesky_decomp unscaled random");
+
+      gsl_matrix_free(m);
+    }
+
   return s;
 }
 
@@ -232,6 +247,128 @@ test_cholesky_invert(gsl_rng * r)
   return s;
 }
 
+static int
+test_cholesky_update_eps(const gsl_matrix * m, const gsl_matrix * V,
+                         const int downdate, const double eps,
+                         const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  const size_t k = V->size2;
+  size_t i, j;
+  gsl_matrix * LLT = gsl_matrix_alloc(N, N);
+  gsl_matrix * W = gsl_matrix_alloc(N, k);
+  gsl_matrix * L = gsl_matrix_calloc(N, N);
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  double Bmax;
+
+  /* B = m +/- V V^T */
+  gsl_matrix_memcpy(B, m);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, downdate ? -1.0 : 1.0, V, V, 1.0, B);
+  Bmax = GSL_MAX(gsl_matrix_max(B), -gsl_matrix_min(B));
+
+  gsl_matrix_memcpy(LLT, m);
+  gsl_matrix_memcpy(W, V);
+
+  s += gsl_linalg_cholesky_decomp1(LLT);
+
+  if (downdate)
+    s += gsl_linalg_cholesky_downdate(LLT, W);
+  else
+    s += gsl_linalg_cholesky_update(LLT, W);
+
+  /* compute A = L L^T */
+  gsl_matrix_tricpy('L', 1, L, LLT);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, L, L, 0.0, A);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double Aij = gsl_matrix_get(A, i, j);
+          double Bij = gsl_matrix_get(B, i, j);
+
+          gsl_test_abs(Aij, Bij, eps * Bmax,
+                       "%s: (%3lu,%3lu)[%lu,%lu] k=%lu: %22.18g   %22.18g\n",
+                       desc, N, N, i, j, k, Aij, Bij);
+
+          if (i < j)
+            {
+              /* upper triangle should contain the modified matrix */
+              Aij = gsl_matrix_get(LLT, i, j);
+
+              gsl_test_abs(Aij, Bij, eps * Bmax,
+                           "%s upper: (%3lu,%3lu)[%lu,%lu] k=%lu: %22.18g   %22.18g\n",
+                           desc, N, N, i, j, k, Aij, Bij);
+            }
+        }
+    }
+
+  gsl_matrix_free(LLT);
+  gsl_matrix_free(W);
+  gsl_matrix_free(L);
+  gsl_matrix_free(A);
+  gsl_matrix_free(B);
+
+  return s;
+}
+
+static int
+test_cholesky_update(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N, k;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_posdef_matrix(m, r);
+
+      for (k = 1; k <= 3; k += 2)
+        {
+          gsl_matrix * V = gsl_matrix_alloc(N, k);
+          size_t i, j;
+
+          for (i = 0; i < N; ++i)
+            {
+              for (j = 0; j < k; ++j)
+                gsl_matrix_set(V, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+            }
+
+          test_cholesky_update_eps(m, V, 0, 1.0e2 * N * GSL_DBL_EPSILON, "cholesky_update random");
+          test_cholesky_update_eps(m, V, 1, 1.0e2 * N * GSL_DBL_EPSILON, "cholesky_downdate random");
+
+          gsl_matrix_free(V);
+        }
+
+      gsl_matrix_free(m);
+    }
+
+  /* downdate of I by 2 e_1 is not positive definite */
+  {
+    gsl_error_handler_t *err_handler = gsl_set_error_handler_off();
+    gsl_matrix * m = gsl_matrix_alloc(5, 5);
+    gsl_matrix * V = gsl_matrix_calloc(5, 1);
+    int status;
+
+    gsl_matrix_set_identity(m);
+    gsl_matrix_set(V, 0, 0, 2.0);
+
+    gsl_linalg_cholesky_decomp1(m);
+    status = gsl_linalg_cholesky_downdate(m, V);
+    gsl_test_int(status, GSL_EDOM, "cholesky_downdate indefinite");
+
+    gsl_matrix_free(m);
+    gsl_matrix_free(V);
+    gsl_set_error_handler(err_handler);
+  }
+
+  return s;
+}
+
 static int
 test_mcholesky_decomp_eps(const int posdef, const int scale, const gsl_matrix * m,
                           const double expected_rcond, const double eps, const char * desc)
@@ -0,0 +1,283 @@
+/* linalg/test_tsvd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* create a random M-by-N matrix with orthonormal columns */
+static int
+create_orthonormal_matrix(gsl_matrix * Q, gsl_rng * r)
+{
+  const size_t M = Q->size1;
+  const size_t N = Q->size2;
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_vector * tau = gsl_vector_alloc(N);
+  size_t i, j;
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        gsl_matrix_set(A, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+    }
+
+  gsl_linalg_QR_decomp(A, tau);
+
+  /* Q = first N columns of the orthogonal factor */
+  gsl_matrix_set_identity(Q);
+  for (j = N; j-- > 0; )
+    {
+      gsl_vector_const_view h = gsl_matrix_const_subcolumn(A, j, j, M - j);
+      gsl_matrix_view m = gsl_matrix_submatrix(Q, j, 0, M - j, N);
+      gsl_linalg_householder_hm(gsl_vector_get(tau, j), &h.vector, &m.matrix);
+    }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(tau);
+
+  return GSL_SUCCESS;
+}
+
+/* A = U0 diag(s) V0^T with random orthonormal U0, V0 */
+static int
+create_svd_matrix(const gsl_vector * s, gsl_matrix * A, gsl_rng * r)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t n = s->size;
+  gsl_matrix * U0 = gsl_matrix_alloc(M, n);
+  gsl_matrix * V0 = gsl_matrix_alloc(N, n);
+  size_t j;
+
+  create_orthonormal_matrix(U0, r);
+  create_orthonormal_matrix(V0, r);
+
+  for (j = 0; j < n; ++j)
+    {
+      gsl_vector_view c = gsl_matrix_column(U0, j);
+      gsl_vector_scale(&c.vector, gsl_vector_get(s, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, U0, V0, 0.0, A);
+
+  gsl_matrix_free(U0);
+  gsl_matrix_free(V0);
+
+  return GSL_SUCCESS;
+}
+
+/* check U^T U = I */
+static int
+test_tsvd_orthonormal(const gsl_matrix * U, const double eps, const char * desc)
+{
+  const size_t k = U->size2;
+  gsl_matrix * UTU = gsl_matrix_alloc(k, k);
+  size_t i, j;
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, U, 0.0, UTU);
+
+  for (i = 0; i < k; ++i)
+    {
+      for (j = 0; j < k; ++j)
+        {
+          double aij = gsl_matrix_get(UTU, i, j);
+          double expected = (i == j) ? 1.0 : 0.0;
+
+          gsl_test_abs(aij, expected, eps, "%s orthonormal (%zu,%zu)",
+                       desc, i, j);
+        }
+    }
+
+  gsl_matrix_free(UTU);
+
+  return GSL_SUCCESS;
+}
+
+static int
+test_tsvd_eps(const gsl_matrix * A, const gsl_vector * s, const int lanczos,
+              const size_t k, const size_t L, const size_t q,
+              const double eps, gsl_rng * r, const char * desc)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const double s0 = gsl_vector_get(s, 0);
+  gsl_linalg_tsvd_workspace * w = gsl_linalg_tsvd_alloc(M, N, L);
+  gsl_linalg_operator op = gsl_linalg_operator_matrix(A);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_vector * res = gsl_vector_alloc(M);
+  size_t i;
+  int status;
+
+  if (lanczos)
+    status = gsl_linalg_tsvd_lanczos(&op, r, U, S, V, w);
+  else
+    status = gsl_linalg_tsvd_rand(&op, q, r, U, S, V, w);
+
+  gsl_test(status, "%s (%zu,%zu) k=%zu L=%zu status", desc, M, N, k, L);
+
+  for (i = 0; i < k; ++i)
+    {
+      gsl_vector_view ui = gsl_matrix_column(U, i);
+      gsl_vector_view vi = gsl_matrix_column(V, i);
+      double si = gsl_vector_get(S, i);
+
+      gsl_test_abs(si, gsl_vector_get(s, i), eps * s0,
+                   "%s (%zu,%zu) k=%zu L=%zu S[%zu]", desc, M, N, k, L, i);
+
+      /* res = A v_i - s_i u_i */
+      gsl_vector_memcpy(res, &ui.vector);
+      gsl_blas_dgemv(CblasNoTrans, 1.0, A, &vi.vector, -si, res);
+
+      gsl_test_abs(gsl_blas_dnrm2(res), 0.0, eps * s0,
+                   "%s (%zu,%zu) k=%zu L=%zu residual[%zu]", desc, M, N, k, L, i);
+    }
+
+  test_tsvd_orthonormal(U, eps, desc);
+  test_tsvd_orthonormal(V, eps, desc);
+
+  gsl_linalg_tsvd_free(w);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_vector_free(res);
+
+  return GSL_SUCCESS;
+}
+
+/* compare gsl_linalg_tsvd_solve with gsl_linalg_SV_solve on a
+ * full SVD with the small singular values set to zero */
+static int
+test_tsvd_solve_eps(const gsl_matrix * A, const size_t k, const double tol,
+                    const double eps, gsl_rng * r, const char * desc)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_linalg_tsvd_workspace * w = gsl_linalg_tsvd_alloc(M, N, k + 10);
+  gsl_linalg_operator op = gsl_linalg_operator_matrix(A);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_matrix * UF = gsl_matrix_alloc(M, N);
+  gsl_matrix * VF = gsl_matrix_alloc(N, N);
+  gsl_vector * SF = gsl_vector_alloc(N);
+  gsl_vector * work = gsl_vector_alloc(N);
+  gsl_vector * b = gsl_vector_alloc(M);
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_vector * x_expected = gsl_vector_alloc(N);
+  size_t i, rank, rank_expected = 0;
+  double s0;
+
+  create_random_vector(b, r);
+
+  gsl_matrix_memcpy(UF, A);
+  gsl_linalg_SV_decomp(UF, VF, SF, work);
+
+  s0 = gsl_vector_get(SF, 0);
+  for (i = 0; i < N; ++i)
+    {
+      if (i < k && gsl_vector_get(SF, i) > tol * s0)
+        ++rank_expected;
+      else
+        gsl_vector_set(SF, i, 0.0);
+    }
+
+  gsl_linalg_SV_solve(UF, VF, SF, b, x_expected);
+
+  gsl_linalg_tsvd_rand(&op, 2, r, U, S, V, w);
+  gsl_linalg_tsvd_solve(U, S, V, tol, b, x, &rank);
+
+  gsl_test_int(rank, rank_expected, "%s (%zu,%zu) k=%zu rank", desc, M, N, k);
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(x, i), gsl_vector_get(x_expected, i), eps,
+                   "%s (%zu,%zu) k=%zu x[%zu]", desc, M, N, k, i);
+    }
+
+  gsl_linalg_tsvd_free(w);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_matrix_free(UF);
+  gsl_matrix_free(VF);
+  gsl_vector_free(SF);
+  gsl_vector_free(work);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(x_expected);
+
+  return GSL_SUCCESS;
+}
+
+static int
+test_tsvd(void)
+{
+  const size_t M = 200;
+  const size_t N = 100;
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_vector * s = gsl_vector_alloc(N);
+  size_t i;
+
+  /* geometrically decaying singular values */
+  for (i = 0; i < N; ++i)
+    gsl_vector_set(s, i, pow(0.5, (double) i));
+
+  create_svd_matrix(s, A, r);
+
+  test_tsvd_eps(A, s, 0, 10, 20, 2, 1.0e-10, r, "tsvd_rand decay");
+  test_tsvd_eps(A, s, 1, 10, 20, 0, 1.0e-10, r, "tsvd_lanczos decay");
+
+  test_tsvd_solve_eps(A, 10, 1.0e-2, 1.0e-8, r, "tsvd_solve decay");
+
+  /* exact rank 5, which causes breakdown of the Lanczos recurrence */
+  for (i = 0; i < N; ++i)
+    gsl_vector_set(s, i, (i < 5) ? 5.0 - i : 0.0);
+
+  create_svd_matrix(s, A, r);
+
+  test_tsvd_eps(A, s, 0, 5, 10, 0, 1.0e-10, r, "tsvd_rand rank5");
+  test_tsvd_eps(A, s, 1, 5, 10, 0, 1.0e-10, r, "tsvd_lanczos rank5");
+  test_tsvd_eps(A, s, 1, 8, 12, 0, 1.0e-10, r, "tsvd_lanczos rank5");
+
+  /* invalid sizes */
+  {
+    gsl_error_handler_t *err_handler = gsl_set_error_handler_off();
+    gsl_linalg_tsvd_workspace * w = gsl_linalg_tsvd_alloc(M, N, 10);
+    gsl_linalg_operator op = gsl_linalg_operator_matrix(A);
+    gsl_matrix * U = gsl_matrix_alloc(M, 11);
+    gsl_matrix * V = gsl_matrix_alloc(N, 11);
+    gsl_vector * S = gsl_vector_alloc(11);
+    int status;
+
+    status = gsl_linalg_tsvd_rand(&op, 0, r, U, S, V, w);
+    gsl_test_int(status, GSL_EBADLEN, "tsvd_rand k > L");
+
+    gsl_test(gsl_linalg_tsvd_alloc(M, N, N + 1) != NULL, "tsvd_alloc L > N");
+
+    gsl_linalg_tsvd_free(w);
+    gsl_matrix_free(U);
+    gsl_matrix_free(V);
+    gsl_vector_free(S);
+
+    gsl_set_error_handler(err_handler);
+  }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(s);
+  gsl_rng_free(r);
+
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,662 @@
+/* linalg/tsvd.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * This module computes the k largest singular triplets of an
+ * M-by-N matrix A,
+ *
+ * A ~= U diag(S) V^T
+ *
+ * where U is M-by-k and V is N-by-k, using only products A x and
+ * A^T y supplied by a user callback. Two methods are provided:
+ *
+ * 1. Randomized range finder with q power iterations (Halko,
+ *    Martinsson and Tropp, 2011, Algorithm 4.4): an orthonormal
+ *    basis Q for the range of (A A^T)^q A Omega, with Omega an N-by-L
+ *    random matrix, is computed, and the SVD of the small matrix
+ *    B = Q^T A gives the triplets.
+ *
+ * 2. Golub-Kahan-Lanczos bidiagonalization with full
+ *    reorthogonalization: after L steps, A P_L = Q_L B_L with B_L
+ *    upper bidiagonal, and the SVD of B_L gives the triplets.
+ *
+ * In both cases L >= k is the size of the subspace, chosen when the
+ * workspace is allocated; typically L = k + 10 or larger.
+ */
+
+static int tsvd_matvec(const gsl_linalg_operator * A, CBLAS_TRANSPOSE_t TransA,
+                       const gsl_vector * x, gsl_vector * y);
+static int tsvd_dense_matvec(CBLAS_TRANSPOSE_t TransA, const gsl_vector * x,
+                             gsl_vector * y, void * params);
+static void tsvd_random(gsl_rng * r, gsl_vector * x);
+static int tsvd_orth(gsl_matrix * X, gsl_vector * tau);
+static double tsvd_reorth(const gsl_matrix * X, const size_t ncol,
+                          gsl_vector * x, gsl_vector * work);
+static void tsvd_newvec(gsl_rng * r, const gsl_matrix * X, const size_t ncol,
+                        gsl_vector * x, gsl_vector * work);
+
+gsl_linalg_tsvd_workspace *
+gsl_linalg_tsvd_alloc (const size_t M, const size_t N, const size_t L)
+{
+  gsl_linalg_tsvd_workspace *w;
+
+  if (L == 0)
+    {
+      GSL_ERROR_NULL ("subspace dimension L must be positive", GSL_EINVAL);
+    }
+  else if (L > M || L > N)
+    {
+      GSL_ERROR_NULL ("subspace dimension L must not exceed matrix dimensions",
+                      GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_linalg_tsvd_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->M = M;
+  w->N = N;
+  w->L = L;
+
+  w->Q = gsl_matrix_alloc(M, L);
+  if (w->Q == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for Q", GSL_ENOMEM);
+    }
+
+  w->P = gsl_matrix_alloc(N, L + 1);
+  if (w->P == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for P", GSL_ENOMEM);
+    }
+
+  w->B = gsl_matrix_alloc(L, L);
+  if (w->B == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for B", GSL_ENOMEM);
+    }
+
+  w->W = gsl_matrix_alloc(L, L);
+  if (w->W == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for W", GSL_ENOMEM);
+    }
+
+  w->S = gsl_vector_alloc(L);
+  if (w->S == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for S", GSL_ENOMEM);
+    }
+
+  w->work = gsl_vector_alloc(L + 1);
+  if (w->work == NULL)
+    {
+      gsl_linalg_tsvd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_linalg_tsvd_free (gsl_linalg_tsvd_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->Q)
+    gsl_matrix_free(w->Q);
+
+  if (w->P)
+    gsl_matrix_free(w->P);
+
+  if (w->B)
+    gsl_matrix_free(w->B);
+
+  if (w->W)
+    gsl_matrix_free(w->W);
+
+  if (w->S)
+    gsl_vector_free(w->S);
+
+  if (w->work)
+    gsl_vector_free(w->work);
+
+  free(w);
+}
+
+/*
+gsl_linalg_operator_matrix()
+  Return an operator which computes products with the
+dense matrix A. The matrix must remain valid while the
+operator is in use.
+*/
+
+gsl_linalg_operator
+gsl_linalg_operator_matrix (const gsl_matrix * A)
+{
+  gsl_linalg_operator op;
+
+  op.matvec = tsvd_dense_matvec;
+  op.size1 = A->size1;
+  op.size2 = A->size2;
+  op.params = (void *) A;
+
+  return op;
+}
+
+/*
+gsl_linalg_tsvd_rand()
+  Compute the k largest singular triplets of A with a
+randomized range finder
+
+Inputs: A - operator for the M-by-N matrix A
+        q - number of power iterations; each one requires
+            2L additional products with A and A^T, and
+            improves the accuracy when the singular values
+            decay slowly
+        r - random number generator for the starting matrix
+        U - (output) M-by-k left singular vectors
+        S - (output) k largest singular values, in
+            decreasing order
+        V - (output) N-by-k right singular vectors
+        w - workspace, k <= L
+
+Return: success/error
+
+Notes:
+1) On output, w->Q contains the orthonormal basis for the
+range of A
+*/
+
+int
+gsl_linalg_tsvd_rand (const gsl_linalg_operator * A, const size_t q,
+                      gsl_rng * r, gsl_matrix * U, gsl_vector * S,
+                      gsl_matrix * V, gsl_linalg_tsvd_workspace * w)
+{
+  const size_t M = w->M;
+  const size_t N = w->N;
+  const size_t L = w->L;
+
+  if (A->size1 != M || A->size2 != N)
+    {
+      GSL_ERROR ("operator size does not match workspace", GSL_EBADLEN);
+    }
+  else if (U->size1 != M || V->size1 != N)
+    {
+      GSL_ERROR ("U must have M rows and V must have N rows", GSL_EBADLEN);
+    }
+  else if (U->size2 != S->size || V->size2 != S->size)
+    {
+      GSL_ERROR ("U and V must have k columns, where k is the size of S",
+                 GSL_EBADLEN);
+    }
+  else if (S->size > L)
+    {
+      GSL_ERROR ("number of singular values k must not exceed L",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix *Q = w->Q;
+      gsl_matrix_view P = gsl_matrix_submatrix(w->P, 0, 0, N, L);
+      gsl_vector_view tau = gsl_vector_subvector(w->work, 0, L);
+      size_t i, j;
+      int status;
+
+      /* P = Omega, N-by-L random matrix */
+      for (j = 0; j < L; ++j)
+        {
+          gsl_vector_view pj = gsl_matrix_column(&P.matrix, j);
+          tsvd_random(r, &pj.vector);
+        }
+
+      for (i = 0; i <= q; ++i)
+        {
+          if (i > 0)
+            {
+              /* P = orth(A^T Q) */
+              for (j = 0; j < L; ++j)
+                {
+                  gsl_vector_view qj = gsl_matrix_column(Q, j);
+                  gsl_vector_view pj = gsl_matrix_column(&P.matrix, j);
+
+                  status = tsvd_matvec(A, CblasTrans, &qj.vector, &pj.vector);
+                  if (status)
+                    return status;
+                }
+
+              status = tsvd_orth(&P.matrix, &tau.vector);
+              if (status)
+                return status;
+            }
+
+          /* Q = orth(A P) */
+          for (j = 0; j < L; ++j)
+            {
+              gsl_vector_view pj = gsl_matrix_column(&P.matrix, j);
+              gsl_vector_view qj = gsl_matrix_column(Q, j);
+
+              status = tsvd_matvec(A, CblasNoTrans, &pj.vector, &qj.vector);
+              if (status)
+                return status;
+            }
+
+          status = tsvd_orth(Q, &tau.vector);
+          if (status)
+            return status;
+        }
+
+      /* P = B^T = A^T Q, N-by-L */
+      for (j = 0; j < L; ++j)
+        {
+          gsl_vector_view qj = gsl_matrix_column(Q, j);
+          gsl_vector_view pj = gsl_matrix_column(&P.matrix, j);
+
+          status = tsvd_matvec(A, CblasTrans, &qj.vector, &pj.vector);
+          if (status)
+            return status;
+        }
+
+      /* B^T = P_B diag(S) W^T, so A ~= Q B = (Q W) diag(S) P_B^T */
+      status = gsl_linalg_SV_decomp(&P.matrix, w->W, w->S, &tau.vector);
+      if (status)
+        return status;
+
+      {
+        const size_t k = S->size;
+        gsl_matrix_view Wk = gsl_matrix_submatrix(w->W, 0, 0, L, k);
+        gsl_matrix_view Pk = gsl_matrix_submatrix(&P.matrix, 0, 0, N, k);
+        gsl_vector_view Sk = gsl_vector_subvector(w->S, 0, k);
+
+        /* U = Q W(:,1:k) */
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, Q, &Wk.matrix, 0.0, U);
+        gsl_matrix_memcpy(V, &Pk.matrix);
+        gsl_vector_memcpy(S, &Sk.vector);
+      }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_tsvd_lanczos()
+  Compute the k largest singular triplets of A with L steps
+of Golub-Kahan-Lanczos bidiagonalization
+
+Inputs: A - operator for the M-by-N matrix A
+        r - random number generator for the starting vector
+        U - (output) M-by-k left singular vectors
+        S - (output) k largest singular values, in
+            decreasing order
+        V - (output) N-by-k right singular vectors
+        w - workspace, k <= L
+
+Return: success/error
+
+Notes:
+1) The recurrence is
+
+alpha_j q_j = A p_j - beta_{j-1} q_{j-1}
+beta_j p_{j+1} = A^T q_j - alpha_j p_j
+
+and each new vector is reorthogonalized against all previous
+ones, so that the bases Q_L and P_L remain orthonormal to
+working precision. This requires L products with A and L - 1
+products with A^T.
+
+2) If alpha_j or beta_j vanishes, an invariant subspace has been
+found; the recurrence is continued with a random vector
+orthogonal to the previous ones.
+
+3) On output, w->Q contains the left Lanczos vectors Q_L
+*/
+
+int
+gsl_linalg_tsvd_lanczos (const gsl_linalg_operator * A, gsl_rng * r,
+                         gsl_matrix * U, gsl_vector * S, gsl_matrix * V,
+                         gsl_linalg_tsvd_workspace * w)
+{
+  const size_t M = w->M;
+  const size_t N = w->N;
+  const size_t L = w->L;
+
+  if (A->size1 != M || A->size2 != N)
+    {
+      GSL_ERROR ("operator size does not match workspace", GSL_EBADLEN);
+    }
+  else if (U->size1 != M || V->size1 != N)
+    {
+      GSL_ERROR ("U must have M rows and V must have N rows", GSL_EBADLEN);
+    }
+  else if (U->size2 != S->size || V->size2 != S->size)
+    {
+      GSL_ERROR ("U and V must have k columns, where k is the size of S",
+                 GSL_EBADLEN);
+    }
+  else if (S->size > L)
+    {
+      GSL_ERROR ("number of singular values k must not exceed L",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t k = S->size;
+      gsl_matrix *Q = w->Q;
+      gsl_matrix *P = w->P;
+      gsl_matrix *B = w->W;     /* bidiagonal matrix B_L */
+      double anorm = 0.0;       /* estimate of ||A|| */
+      double alpha, beta = 0.0;
+      size_t j;
+      int status;
+
+      gsl_matrix_set_zero(B);
+
+      /* random unit starting vector p_0 */
+      {
+        gsl_vector_view p0 = gsl_matrix_column(P, 0);
+        tsvd_newvec(r, P, 0, &p0.vector, w->work);
+      }
+
+      for (j = 0; j < L; ++j)
+        {
+          gsl_vector_view pj = gsl_matrix_column(P, j);
+          gsl_vector_view qj = gsl_matrix_column(Q, j);
+
+          /* q_j = A p_j - beta_{j-1} q_{j-1} */
+          status = tsvd_matvec(A, CblasNoTrans, &pj.vector, &qj.vector);
+          if (status)
+            return status;
+
+          if (j > 0)
+            {
+              gsl_vector_view qjm1 = gsl_matrix_column(Q, j - 1);
+              gsl_blas_daxpy(-beta, &qjm1.vector, &qj.vector);
+            }
+
+          alpha = tsvd_reorth(Q, j, &qj.vector, w->work);
+          anorm = GSL_MAX(anorm, alpha);
+
+          if (alpha <= GSL_DBL_EPSILON * anorm)
+            {
+              alpha = 0.0;
+              tsvd_newvec(r, Q, j, &qj.vector, w->work);
+            }
+          else
+            {
+              gsl_vector_scale(&qj.vector, 1.0 / alpha);
+            }
+
+          gsl_matrix_set(B, j, j, alpha);
+
+          if (j + 1 < L)
+            {
+              gsl_vector_view pj1 = gsl_matrix_column(P, j + 1);
+
+              /* p_{j+1} = A^T q_j - alpha_j p_j */
+              status = tsvd_matvec(A, CblasTrans, &qj.vector, &pj1.vector);
+              if (status)
+                return status;
+
+              gsl_blas_daxpy(-alpha, &pj.vector, &pj1.vector);
+
+              beta = tsvd_reorth(P, j + 1, &pj1.vector, w->work);
+              anorm = GSL_MAX(anorm, beta);
+
+              if (beta <= GSL_DBL_EPSILON * anorm)
+                {
+                  beta = 0.0;
+                  tsvd_newvec(r, P, j + 1, &pj1.vector, w->work);
+                }
+              else
+                {
+                  gsl_vector_scale(&pj1.vector, 1.0 / beta);
+                }
+
+              gsl_matrix_set(B, j, j + 1, beta);
+            }
+        }
+
+      /* B_L = B_U diag(S) B_V^T, so A P_L B_V ~= Q_L B_U diag(S) */
+      {
+        gsl_vector_view work = gsl_vector_subvector(w->work, 0, L);
+        gsl_matrix_view PL = gsl_matrix_submatrix(P, 0, 0, N, L);
+        gsl_matrix_view BUk, BVk;
+        gsl_vector_view Sk = gsl_vector_subvector(w->S, 0, k);
+
+        status = gsl_linalg_SV_decomp(B, w->B, w->S, &work.vector);
+        if (status)
+          return status;
+
+        BUk = gsl_matrix_submatrix(B, 0, 0, L, k);
+        BVk = gsl_matrix_submatrix(w->B, 0, 0, L, k);
+
+        /* U = Q_L B_U(:,1:k), V = P_L B_V(:,1:k) */
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, Q, &BUk.matrix, 0.0, U);
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &PL.matrix, &BVk.matrix, 0.0, V);
+        gsl_vector_memcpy(S, &Sk.vector);
+      }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_tsvd_solve()
+  Solve the least squares problem min ||A x - b|| using
+a truncated SVD of A, discarding singular values
+
+s_j <= tol * s_0
+
+as in gsl_multifit_linear_tsvd
+
+Inputs: U    - M-by-k left singular vectors
+        S    - k singular values in decreasing order
+        V    - N-by-k right singular vectors
+        tol  - truncation tolerance
+        b    - right hand side, length M
+        x    - (output) solution, length N
+        rank - (output) number of singular values used
+
+Return: success/error
+*/
+
+int
+gsl_linalg_tsvd_solve (const gsl_matrix * U, const gsl_vector * S,
+                       const gsl_matrix * V, const double tol,
+                       const gsl_vector * b, gsl_vector * x, size_t * rank)
+{
+  const size_t k = S->size;
+
+  if (U->size1 != b->size)
+    {
+      GSL_ERROR ("first dimension of matrix U must size of vector b",
+                 GSL_EBADLEN);
+    }
+  else if (V->size1 != x->size)
+    {
+      GSL_ERROR ("first dimension of matrix V must size of vector x",
+                 GSL_EBADLEN);
+    }
+  else if (U->size2 != k || V->size2 != k)
+    {
+      GSL_ERROR ("U and V must have k columns, where k is the size of S",
+                 GSL_EBADLEN);
+    }
+  else if (tol <= 0.0)
+    {
+      GSL_ERROR ("tolerance must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      const double s0 = (k > 0) ? gsl_vector_get(S, 0) : 0.0;
+      size_t j, nrank = 0;
+
+      gsl_vector_set_zero(x);
+
+      for (j = 0; j < k; ++j)
+        {
+          double sj = gsl_vector_get(S, j);
+          gsl_vector_const_view uj = gsl_matrix_const_column(U, j);
+          gsl_vector_const_view vj = gsl_matrix_const_column(V, j);
+          double ujb;
+
+          if (sj <= tol * s0 || sj == 0.0)
+            continue;
+
+          /* x += (u_j^T b / s_j) v_j */
+          gsl_blas_ddot(&uj.vector, b, &ujb);
+          gsl_blas_daxpy(ujb / sj, &vj.vector, x);
+
+          ++nrank;
+        }
+
+      *rank = nrank;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* y = op(A) x */
+static int
+tsvd_matvec(const gsl_linalg_operator * A, CBLAS_TRANSPOSE_t TransA,
+            const gsl_vector * x, gsl_vector * y)
+{
+  int status = (A->matvec)(TransA, x, y, A->params);
+
+  if (status)
+    {
+      GSL_ERROR ("error in user matrix-vector product", status);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* matrix-vector product for gsl_linalg_operator_matrix() */
+static int
+tsvd_dense_matvec(CBLAS_TRANSPOSE_t TransA, const gsl_vector * x,
+                  gsl_vector * y, void * params)
+{
+  const gsl_matrix *A = (const gsl_matrix *) params;
+  return gsl_blas_dgemv(TransA, 1.0, A, x, 0.0, y);
+}
+
+/* fill x with uniform random numbers on [-1,1] */
+static void
+tsvd_random(gsl_rng * r, gsl_vector * x)
+{
+  size_t i;
+
+  for (i = 0; i < x->size; ++i)
+    gsl_vector_set(x, i, 2.0 * gsl_rng_uniform(r) - 1.0);
+}
+
+/*
+tsvd_orth()
+  Replace the columns of the m-by-n matrix X, m >= n, with
+an orthonormal basis for their span, using a Householder
+QR decomposition followed by accumulation of the thin Q
+factor in place (as in LAPACK DORG2R)
+*/
+
+static int
+tsvd_orth(gsl_matrix * X, gsl_vector * tau)
+{
+  const size_t M = X->size1;
+  const size_t N = X->size2;
+  size_t i, j;
+  int status;
+
+  status = gsl_linalg_QR_decomp(X, tau);
+  if (status)
+    return status;
+
+  for (j = N; j-- > 0; )
+    {
+      gsl_matrix_view m = gsl_matrix_submatrix(X, j, j, M - j, N - j);
+      double tj = gsl_vector_get(tau, j);
+
+      gsl_linalg_householder_hm1(tj, &m.matrix);
+
+      for (i = 0; i < j; ++i)
+        gsl_matrix_set(X, i, j, 0.0);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+tsvd_reorth()
+  Orthogonalize x against the first ncol columns of X, which
+are orthonormal, with two passes of classical Gram-Schmidt
+
+Return: ||x|| after orthogonalization
+*/
+
+static double
+tsvd_reorth(const gsl_matrix * X, const size_t ncol, gsl_vector * x,
+            gsl_vector * work)
+{
+  if (ncol > 0)
+    {
+      gsl_matrix_const_view Xj = gsl_matrix_const_submatrix(X, 0, 0, X->size1, ncol);
+      gsl_vector_view h = gsl_vector_subvector(work, 0, ncol);
+      size_t pass;
+
+      for (pass = 0; pass < 2; ++pass)
+        {
+          /* x <- x - X (X^T x) */
+          gsl_blas_dgemv(CblasTrans, 1.0, &Xj.matrix, x, 0.0, &h.vector);
+          gsl_blas_dgemv(CblasNoTrans, -1.0, &Xj.matrix, &h.vector, 1.0, x);
+        }
+    }
+
+  return gsl_blas_dnrm2(x);
+}
+
+/* store in x a random unit vector orthogonal to the first ncol columns of X */
+static void
+tsvd_newvec(gsl_rng * r, const gsl_matrix * X, const size_t ncol,
+            gsl_vector * x, gsl_vector * work)
+{
+  double xnorm;
+
+  do
+    {
+      tsvd_random(r, x);
+      xnorm = tsvd_reorth(X, ncol, x, work);
+    }
+  while (xnorm == 0.0);
+
+  gsl_vector_scale(x, 1.0 / xnorm);
+}
@@ -39,6 +39,15 @@
 
 __BEGIN_DECLS
 
+/* method used by gsl_multifit_linear() and gsl_multifit_wlinear() */
+typedef enum
+{
+  GSL_MULTIFIT_LINEAR_SVD,        /* singular value decomposition */
+  GSL_MULTIFIT_LINEAR_QR,         /* Householder QR */
+  GSL_MULTIFIT_LINEAR_CHOLESKY,   /* normal equations */
+  GSL_MULTIFIT_LINEAR_AUTO        /* choose by condition number */
+} gsl_multifit_linear_solver_type;
+
 typedef struct 
 {
   size_t nmax;         /* maximum number of observations */
@@ -53,6 +62,8 @@ typedef struct
   gsl_vector * xt;
   gsl_vector * D;
   double rcond;        /* reciprocal condition number */
+  gsl_vector * work3;  /* workspace for rcond estimates, 3*pmax */
+  gsl_multifit_linear_solver_type solver; /* method for linear()/wlinear() */
 } 
 gsl_multifit_linear_workspace;
 
@@ -62,6 +73,10 @@ gsl_multifit_linear_alloc (const size_t n, const size_t p);
 void
 gsl_multifit_linear_free (gsl_multifit_linear_workspace * w);
 
+int
+gsl_multifit_linear_set_solver (gsl_multifit_linear_workspace * w,
+                                const gsl_multifit_linear_solver_type solver);
+
 int
 gsl_multifit_linear (const gsl_matrix * X,
                      const gsl_vector * y,
@@ -0,0 +1,261 @@
+/* multifit/linear_fast.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Least squares solution by the normal equations or by QR, as
+ * alternatives to the SVD for full rank problems.
+ *
+ * For an n-by-p matrix with n >> p the normal equations cost
+ * n p^2 flops, in a single level 3 BLAS call, and the Householder QR
+ * 2 n p^2 flops, against about 6 n p^2 flops for the SVD. The
+ * accuracy of the normal equations depends on cond(X)^2 and that of
+ * QR on cond(X), so the automatic selection uses the normal equations
+ * when the reciprocal condition number estimate of X^T X is at least
+ * MULTIFIT_CHOLESKY_RCOND, then QR when that of R is at least
+ * MULTIFIT_QR_RCOND, and otherwise the truncated SVD, which also
+ * handles rank deficient matrices.
+ */
+
+#define MULTIFIT_CHOLESKY_RCOND   (1.0e-8)
+#define MULTIFIT_QR_RCOND         (1.0e-12)
+
+#define MULTIFIT_CHOLESKY_CROSSOVER  24
+
+/*
+multifit_cholesky_L3()
+  Recursive Cholesky decomposition of the lower triangle of A, as
+in gsl_linalg_cholesky_decomp1, but returning GSL_EDOM without
+calling the error handler if A is not positive definite, since the
+automatic selection then falls back to QR
+*/
+
+static int
+multifit_cholesky_L3 (gsl_matrix * A)
+{
+  const size_t N = A->size1;
+
+  if (N <= MULTIFIT_CHOLESKY_CROSSOVER)
+    {
+      size_t j;
+
+      for (j = 0; j < N; ++j)
+        {
+          gsl_vector_view v = gsl_matrix_subcolumn (A, j, j, N - j);
+          double ajj;
+
+          if (j > 0)
+            {
+              gsl_vector_view w = gsl_matrix_subrow (A, j, 0, j);
+              gsl_matrix_view m = gsl_matrix_submatrix (A, j, 0, N - j, j);
+
+              gsl_blas_dgemv (CblasNoTrans, -1.0, &m.matrix, &w.vector,
+                              1.0, &v.vector);
+            }
+
+          ajj = gsl_matrix_get (A, j, j);
+
+          if (!(ajj > 0.0))
+            return GSL_EDOM;
+
+          gsl_vector_scale (&v.vector, 1.0 / sqrt (ajj));
+        }
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t N1 = N / 2;
+      const size_t N2 = N - N1;
+      gsl_matrix_view A11 = gsl_matrix_submatrix (A, 0, 0, N1, N1);
+      gsl_matrix_view A21 = gsl_matrix_submatrix (A, N1, 0, N2, N1);
+      gsl_matrix_view A22 = gsl_matrix_submatrix (A, N1, N1, N2, N2);
+      int status;
+
+      status = multifit_cholesky_L3 (&A11.matrix);
+      if (status)
+        return status;
+
+      gsl_blas_dtrsm (CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                      1.0, &A11.matrix, &A21.matrix);
+
+      gsl_blas_dsyrk (CblasLower, CblasNoTrans, -1.0, &A21.matrix,
+                      1.0, &A22.matrix);
+
+      return multifit_cholesky_L3 (&A22.matrix);
+    }
+}
+
+/* factor A in the layout of gsl_linalg_cholesky_decomp1, with the
+   original matrix saved in the upper triangle for the rcond estimate */
+static int
+multifit_cholesky_decomp (gsl_matrix * A)
+{
+  gsl_matrix_transpose_tricpy ('L', 0, A, A);
+
+  return multifit_cholesky_L3 (A);
+}
+
+/*
+multifit_linear_fast()
+  Solve the least squares problem min ||b - A c|| with the normal
+equations or QR
+
+Inputs: solver    - GSL_MULTIFIT_LINEAR_CHOLESKY, GSL_MULTIFIT_LINEAR_QR
+                    or GSL_MULTIFIT_LINEAR_AUTO
+        A         - n-by-p least squares matrix, a view of work->A,
+                    destroyed on output
+        b         - right hand side, a view of work->t, destroyed on
+                    output
+        c         - (output) solution vector
+        cov       - (output) covariance matrix
+        chisq     - (output) ||b - A c||^2
+        scale_cov - if nonzero, scale the covariance by chisq / (n - p)
+        work      - workspace
+
+Return: GSL_SUCCESS, or GSL_CONTINUE if the automatic selection
+rejects both methods, in which case the caller should use the SVD
+*/
+
+static int
+multifit_linear_fast (const gsl_multifit_linear_solver_type solver,
+                      gsl_matrix * A, gsl_vector * b, gsl_vector * c,
+                      gsl_matrix * cov, double *chisq, const int scale_cov,
+                      gsl_multifit_linear_workspace * work)
+{
+  const size_t n = A->size1;
+  const size_t p = A->size2;
+  gsl_matrix_view G = gsl_matrix_submatrix (work->Q, 0, 0, p, p);
+  gsl_vector_view S = gsl_vector_subvector (work->D, 0, p);
+  gsl_vector_view xt = gsl_vector_subvector (work->xt, 0, p);
+  gsl_vector_view w3 = gsl_vector_subvector (work->work3, 0, 3 * p);
+  double rcond = 0.0, s2;
+  int status;
+
+  work->n = n;
+  work->p = p;
+
+  if (solver != GSL_MULTIFIT_LINEAR_QR)
+    {
+      /* normal equations (A^T A) c = A^T b, with the diagonal scaling
+         S_i = 1/sqrt((A^T A)_ii) to reduce the condition number */
+
+      gsl_blas_dsyrk (CblasLower, CblasTrans, 1.0, A, 0.0, &G.matrix);
+      gsl_blas_dgemv (CblasTrans, 1.0, A, b, 0.0, &xt.vector);
+
+      gsl_linalg_cholesky_scale (&G.matrix, &S.vector);
+      gsl_linalg_cholesky_scale_apply (&G.matrix, &S.vector);
+
+      status = multifit_cholesky_decomp (&G.matrix);
+
+      if (status == GSL_SUCCESS)
+        gsl_linalg_cholesky_rcond (&G.matrix, &rcond, &w3.vector);
+
+      if (solver == GSL_MULTIFIT_LINEAR_CHOLESKY && status)
+        {
+          GSL_ERROR ("normal equations matrix is not positive definite",
+                     GSL_EDOM);
+        }
+
+      if (status == GSL_SUCCESS &&
+          (solver == GSL_MULTIFIT_LINEAR_CHOLESKY ||
+           rcond >= MULTIFIT_CHOLESKY_RCOND))
+        {
+          size_t i, j;
+          double rnorm;
+
+          gsl_linalg_cholesky_solve2 (&G.matrix, &S.vector, &xt.vector, c);
+
+          /* b <- b - A c */
+          gsl_blas_dgemv (CblasNoTrans, -1.0, A, c, 1.0, b);
+          rnorm = gsl_blas_dnrm2 (b);
+          *chisq = rnorm * rnorm;
+
+          s2 = scale_cov ? *chisq / (double) (n - p) : 1.0;
+
+          /* cov = s2 diag(S) (S A^T A S)^{-1} diag(S) */
+          gsl_linalg_cholesky_invert (&G.matrix);
+
+          for (i = 0; i < p; ++i)
+            {
+              double si = gsl_vector_get (&S.vector, i);
+
+              for (j = 0; j <= i; ++j)
+                {
+                  double sj = gsl_vector_get (&S.vector, j);
+                  double cij = s2 * si * sj * gsl_matrix_get (&G.matrix, i, j);
+
+                  gsl_matrix_set (cov, i, j, cij);
+                  gsl_matrix_set (cov, j, i, cij);
+                }
+            }
+
+          work->rcond = sqrt (rcond);
+
+          return GSL_SUCCESS;
+        }
+    }
+
+  /* Householder QR, A = Q R */
+  {
+    gsl_matrix_view R = gsl_matrix_submatrix (A, 0, 0, p, p);
+    gsl_matrix_view Rinv = gsl_matrix_submatrix (work->QSI, 0, 0, p, p);
+    gsl_vector_view tau = gsl_vector_subvector (work->S, 0, p);
+    gsl_vector_view b1 = gsl_vector_subvector (b, 0, p);
+
+    status = gsl_linalg_QR_decomp (A, &tau.vector);
+    if (status)
+      return status;
+
+    status = gsl_linalg_tri_upper_rcond (&R.matrix, &rcond, &w3.vector);
+    if (status)
+      return status;
+
+    if (solver == GSL_MULTIFIT_LINEAR_AUTO && rcond < MULTIFIT_QR_RCOND)
+      return GSL_CONTINUE;
+
+    /* b <- Q^T b, c = R^{-1} b(1:p), chisq = ||b(p+1:n)||^2 */
+    gsl_linalg_QR_QTvec (A, &tau.vector, b);
+
+    gsl_vector_memcpy (c, &b1.vector);
+    gsl_blas_dtrsv (CblasUpper, CblasNoTrans, CblasNonUnit, &R.matrix, c);
+
+    if (n > p)
+      {
+        gsl_vector_view b2 = gsl_vector_subvector (b, p, n - p);
+        double rnorm = gsl_blas_dnrm2 (&b2.vector);
+        *chisq = rnorm * rnorm;
+      }
+    else
+      {
+        *chisq = 0.0;
+      }
+
+    s2 = scale_cov ? *chisq / (double) (n - p) : 1.0;
+
+    /* cov = s2 R^{-1} R^{-T} */
+    gsl_matrix_set_zero (&Rinv.matrix);
+    gsl_matrix_tricpy ('U', 1, &Rinv.matrix, &R.matrix);
+    gsl_linalg_tri_upper_invert (&Rinv.matrix);
+
+    gsl_blas_dsyrk (CblasUpper, CblasNoTrans, s2, &Rinv.matrix, 0.0, cov);
+    gsl_matrix_transpose_tricpy ('U', 0, cov, cov);
+
+    work->rcond = rcond;
+
+    return GSL_SUCCESS;
+  }
+}
@@ -28,6 +28,13 @@
  * computing robust regression estimates via iteratively
  * reweighted least squares," The American Statistician, v. 42, 
  * pp. 152-154.
+ *
+ * The initial ordinary least squares fit uses the SVD, which also gives
+ * the statistical leverages. Each reweighted fit of the iteration then
+ * uses the weighted normal equations, falling back to QR or the SVD if
+ * X^T W X is ill-conditioned (see linear_fast.c), and the MAD estimate
+ * of sigma uses selection rather than sorting, so that an iteration
+ * costs O(n p^2) with a small constant.
  */
 
 #include <config.h>
@@ -36,13 +43,12 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_statistics.h>
-#include <gsl/gsl_sort.h>
-#include <gsl/gsl_sort_vector.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 
 static int robust_test_convergence(const gsl_vector *c_prev, const gsl_vector *c,
                                    const double tol);
+static double robust_select(double *a, const size_t n, const size_t k);
 static double robust_madsigma(const gsl_vector *r, const size_t p, gsl_vector *workn);
 static double robust_robsigma(const gsl_vector *r, const double s,
                               const double tune, gsl_multifit_robust_workspace *w);
@@ -361,7 +367,9 @@ gsl_multifit_robust(const gsl_matrix * X,
       if (sig_lower == 0.0)
         sig_lower = 1.0;
 
-      /* compute initial estimates using ordinary least squares */
+      /* compute initial estimates using ordinary least squares; the SVD
+       * is needed for the leverages below */
+      gsl_multifit_linear_set_solver(w->multifit_p, GSL_MULTIFIT_LINEAR_SVD);
       s = gsl_multifit_linear(X, y, c, cov, &chisq, w->multifit_p);
       if (s)
         return s;
@@ -394,6 +402,9 @@ gsl_multifit_robust(const gsl_matrix * X,
       /* compute estimate of sigma from ordinary least squares */
       w->stats.sigma_ols = gsl_blas_dnrm2(w->r) / sqrt((double) w->stats.dof);
 
+      /* reweighted fits by the normal equations when well-conditioned */
+      gsl_multifit_linear_set_solver(w->multifit_p, GSL_MULTIFIT_LINEAR_AUTO);
+
       while (!converged && ++numit <= w->maxiter)
         {
           double sig;
@@ -588,6 +599,65 @@ robust_test_convergence(const gsl_vector *c_prev, const gsl_vector *c,
   return 1;
 } /* robust_test_convergence() */
 
+/*
+robust_select()
+  Find the k-th smallest element of a[0..n-1] by Hoare's selection
+algorithm, in expected O(n) operations. On output a is partitioned
+so that a[i] <= a[k] for i < k and a[i] >= a[k] for i > k.
+*/
+
+static double
+robust_select(double *a, const size_t n, const size_t k)
+{
+  size_t lo = 0, hi = n - 1;
+
+  while (hi > lo)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      double pivot, tmp;
+      size_t i, j;
+
+      /* median of three pivot, left in a[mid] */
+      if (a[mid] < a[lo])
+        { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; }
+      if (a[hi] < a[lo])
+        { tmp = a[hi]; a[hi] = a[lo]; a[lo] = tmp; }
+      if (a[hi] < a[mid])
+        { tmp = a[hi]; a[hi] = a[mid]; a[mid] = tmp; }
+
+      pivot = a[mid];
+      i = lo;
+      j = hi;
+
+      while (i <= j)
+        {
+          while (a[i] < pivot)
+            ++i;
+          while (a[j] > pivot)
+            --j;
+
+          if (i <= j)
+            {
+              tmp = a[i]; a[i] = a[j]; a[j] = tmp;
+              ++i;
+              if (j == 0)
+                break;
+              --j;
+            }
+        }
+
+      /* now a[lo..j] <= pivot <= a[i..hi], with j < i */
+      if (k <= j)
+        hi = j;
+      else if (k >= i)
+        lo = i;
+      else
+        break;
+    }
+
+  return a[k];
+} /* robust_select() */
+
 /*
 robust_madsigma()
   Estimate the standard deviation of the residuals using
@@ -606,27 +676,41 @@ static double
 robust_madsigma(const gsl_vector *r, const size_t p, gsl_vector *workn)
 {
   size_t n = r->size;
-  double sigma;
-  size_t i;
-
-  /* allow for the possibility that r->size < w->n */
-  gsl_vector_view v1 = gsl_vector_subvector(workn, 0, n);
-  gsl_vector_view v2;
+  double *a = workn->data; /* unit stride from gsl_vector_alloc */
+  double sigma, med;
+  size_t i, m, k;
 
   /* copy |r| into workn */
   for (i = 0; i < n; ++i)
     {
-      gsl_vector_set(&v1.vector, i, fabs(gsl_vector_get(r, i)));
+      a[i] = fabs(gsl_vector_get(r, i));
     }
 
-  gsl_sort_vector(&v1.vector);
-
   /*
    * ignore the smallest p residuals when computing the median
-   * (see Street et al 1988)
+   * (see Street et al 1988), i.e. take the median of the m = n - p + 1
+   * largest values, which are the order statistics p - 1, ..., n - 1
    */
-  v2 = gsl_vector_subvector(&v1.vector, p - 1, n - p + 1);
-  sigma = gsl_stats_median_from_sorted_data(v2.vector.data, v2.vector.stride, v2.vector.size) / 0.6745;
+  m = n - p + 1;
+  k = p - 1 + m / 2;
+
+  med = robust_select(a, n, k);
+
+  if (m % 2 == 0)
+    {
+      /* the element below the median is the largest of a[0..k-1] */
+      double lower = a[0];
+
+      for (i = 1; i < k; ++i)
+        {
+          if (a[i] > lower)
+            lower = a[i];
+        }
+
+      med = 0.5 * (med + lower);
+    }
+
+  sigma = med / 0.6745;
 
   return sigma;
 } /* robust_madsigma() */
@@ -26,6 +26,7 @@
 #include <gsl/gsl_linalg.h>
 
 #include "linear_common.c"
+#include "linear_fast.c"
 
 int
 gsl_multifit_wlinear (const gsl_matrix * X,
@@ -35,8 +36,52 @@ gsl_multifit_wlinear (const gsl_matrix * X,
                       gsl_matrix * cov,
                       double *chisq, gsl_multifit_linear_workspace * work)
 {
+  const size_t n = X->size1;
+  const size_t p = X->size2;
   size_t rank;
-  int status = gsl_multifit_wlinear_tsvd(X, w, y, GSL_DBL_EPSILON, c, cov, chisq, &rank, work);
+  int status;
+
+  if (work->solver != GSL_MULTIFIT_LINEAR_SVD && n >= p && n > 0 && p > 0)
+    {
+      if (n > work->nmax || p > work->pmax)
+        {
+          GSL_ERROR("observation matrix larger than workspace", GSL_EBADLEN);
+        }
+      else if (y->size != n)
+        {
+          GSL_ERROR("number of observations in y does not match matrix",
+                    GSL_EBADLEN);
+        }
+      else if (w->size != n)
+        {
+          GSL_ERROR("number of weights in w does not match matrix",
+                    GSL_EBADLEN);
+        }
+      else if (p != c->size)
+        {
+          GSL_ERROR ("number of parameters c does not match matrix",
+                     GSL_EBADLEN);
+        }
+      else
+        {
+          gsl_matrix_view A = gsl_matrix_submatrix(work->A, 0, 0, n, p);
+          gsl_vector_view b = gsl_vector_subvector(work->t, 0, n);
+
+          /* compute A = sqrt(W) X, b = sqrt(W) y */
+          status = gsl_multifit_linear_applyW(X, w, y, &A.matrix, &b.vector);
+          if (status)
+            return status;
+
+          status = multifit_linear_fast(work->solver, &A.matrix, &b.vector,
+                                        c, cov, chisq, 0, work);
+
+          /* fall back to the SVD for ill-conditioned matrices */
+          if (status != GSL_CONTINUE)
+            return status;
+        }
+    }
+
+  status = gsl_multifit_wlinear_tsvd(X, w, y, GSL_DBL_EPSILON, c, cov, chisq, &rank, work);
 
   return status;
 }
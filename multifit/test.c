@@ -31,6 +31,8 @@
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_permutation.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics.h>
 
 #include <gsl/gsl_ieee_utils.h>
 
@@ -67,6 +67,8 @@ test_random_vector_noise(const gsl_rng *r, gsl_vector *y)
 #include "test_estimator.c"
 #include "test_reg.c"
 #include "test_shaw.c"
+#include "test_solver.c"
+#include "test_robust.c"
 
 /* test linear regression */
 
@@ -79,4 +81,6 @@ test_linear(void)
   test_estimator();
   test_reg();
   test_shaw();
+  test_solver();
+  test_robust();
 }
@@ -0,0 +1,99 @@
+/* multifit/test_robust.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* MAD estimate of sigma from the final residuals, ignoring the
+ * smallest p, computed by sorting */
+static double
+test_robust_madsigma(const gsl_vector *r, const size_t p)
+{
+  const size_t n = r->size;
+  double *a = malloc(n * sizeof(double));
+  double sigma;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    a[i] = fabs(gsl_vector_get(r, i));
+
+  gsl_sort(a, 1, n);
+  sigma = gsl_stats_median_from_sorted_data(a + p - 1, 1, n - p + 1) / 0.6745;
+
+  free(a);
+
+  return sigma;
+}
+
+/* fit a line to data with outliers */
+static void
+test_robust1(const gsl_multifit_robust_type *T, const size_t n,
+             const gsl_rng *r)
+{
+  const size_t p = 2;
+  const double c0 = 1.5, c1 = -0.5;
+  gsl_multifit_robust_workspace *w = gsl_multifit_robust_alloc(T, n, p);
+  gsl_matrix *X = gsl_matrix_alloc(n, p);
+  gsl_vector *y = gsl_vector_alloc(n);
+  gsl_vector *c = gsl_vector_alloc(p);
+  gsl_matrix *cov = gsl_matrix_alloc(p, p);
+  gsl_multifit_robust_stats stats;
+  size_t i;
+  int s;
+
+  for (i = 0; i < n; ++i)
+    {
+      double xi = (double) i / (n - 1.0);
+      double yi = c0 + c1 * xi + 1.0e-3 * (gsl_rng_uniform(r) - 0.5);
+
+      /* every tenth point is an outlier */
+      if (i % 10 == 3)
+        yi += 5.0;
+
+      gsl_matrix_set(X, i, 0, 1.0);
+      gsl_matrix_set(X, i, 1, xi);
+      gsl_vector_set(y, i, yi);
+    }
+
+  s = gsl_multifit_robust(X, y, c, cov, w);
+  gsl_test(s, "robust %s n=%zu status", gsl_multifit_robust_name(w), n);
+
+  gsl_test_abs(gsl_vector_get(c, 0), c0, 1.0e-3, "robust %s n=%zu c0",
+               gsl_multifit_robust_name(w), n);
+  gsl_test_abs(gsl_vector_get(c, 1), c1, 1.0e-3, "robust %s n=%zu c1",
+               gsl_multifit_robust_name(w), n);
+
+  stats = gsl_multifit_robust_statistics(w);
+  gsl_test_rel(stats.sigma_mad, test_robust_madsigma(stats.r, p), 1.0e-15,
+               "robust %s n=%zu sigma_mad", gsl_multifit_robust_name(w), n);
+
+  gsl_matrix_free(X);
+  gsl_vector_free(y);
+  gsl_vector_free(c);
+  gsl_matrix_free(cov);
+  gsl_multifit_robust_free(w);
+}
+
+static void
+test_robust(void)
+{
+  gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
+
+  test_robust1(gsl_multifit_robust_bisquare, 100, r);
+  test_robust1(gsl_multifit_robust_bisquare, 1001, r);
+  test_robust1(gsl_multifit_robust_welsch, 100, r);
+  test_robust1(gsl_multifit_robust_cauchy, 1001, r);
+
+  gsl_rng_free(r);
+}
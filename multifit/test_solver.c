@@ -0,0 +1,155 @@
+/* multifit/test_solver.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* solve system with given solver and test against SVD solution */
+static void
+test_solver1(const gsl_multifit_linear_solver_type solver,
+             const gsl_matrix * X, const gsl_vector * y,
+             const gsl_vector * wts, const double tol,
+             gsl_multifit_linear_workspace * w, const char * desc)
+{
+  const size_t p = X->size2;
+  double chisq0, chisq1;
+  gsl_vector *c0 = gsl_vector_alloc(p);
+  gsl_vector *c1 = gsl_vector_alloc(p);
+  gsl_matrix *cov0 = gsl_matrix_alloc(p, p);
+  gsl_matrix *cov1 = gsl_matrix_alloc(p, p);
+  size_t i, j;
+
+  gsl_multifit_linear_set_solver(w, GSL_MULTIFIT_LINEAR_SVD);
+
+  if (wts)
+    gsl_multifit_wlinear(X, wts, y, c0, cov0, &chisq0, w);
+  else
+    gsl_multifit_linear(X, y, c0, cov0, &chisq0, w);
+
+  gsl_multifit_linear_set_solver(w, solver);
+
+  if (wts)
+    gsl_multifit_wlinear(X, wts, y, c1, cov1, &chisq1, w);
+  else
+    gsl_multifit_linear(X, y, c1, cov1, &chisq1, w);
+
+  gsl_test_rel(chisq1, chisq0, tol, "%s chisq", desc);
+
+  for (i = 0; i < p; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(c1, i), gsl_vector_get(c0, i), tol,
+                   "%s c[%zu]", desc, i);
+
+      for (j = 0; j < p; ++j)
+        {
+          gsl_test_rel(gsl_matrix_get(cov1, i, j),
+                       gsl_matrix_get(cov0, i, j), tol,
+                       "%s cov(%zu,%zu)", desc, i, j);
+        }
+    }
+
+  gsl_multifit_linear_set_solver(w, GSL_MULTIFIT_LINEAR_SVD);
+
+  gsl_vector_free(c0);
+  gsl_vector_free(c1);
+  gsl_matrix_free(cov0);
+  gsl_matrix_free(cov1);
+}
+
+static void
+test_solver(void)
+{
+  const size_t n = 100;
+  const size_t p = 12;
+  gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
+  gsl_multifit_linear_workspace *w = gsl_multifit_linear_alloc(n, p);
+  gsl_matrix *X = gsl_matrix_alloc(n, p);
+  gsl_vector *y = gsl_vector_alloc(n);
+  gsl_vector *wts = gsl_vector_alloc(n);
+  gsl_vector *c = gsl_vector_alloc(p);
+  gsl_matrix *cov = gsl_matrix_alloc(p, p);
+  double chisq;
+
+  /* well-conditioned random system */
+  test_random_matrix(X, r, -1.0, 1.0);
+  test_random_vector(y, r, -1.0, 1.0);
+  test_random_vector(wts, r, 0.0, 1.0);
+
+  test_solver1(GSL_MULTIFIT_LINEAR_QR, X, y, NULL, 1.0e-10, w,
+               "solver QR unweighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_CHOLESKY, X, y, NULL, 1.0e-10, w,
+               "solver cholesky unweighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_AUTO, X, y, NULL, 1.0e-10, w,
+               "solver auto unweighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_QR, X, y, wts, 1.0e-10, w,
+               "solver QR weighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_CHOLESKY, X, y, wts, 1.0e-10, w,
+               "solver cholesky weighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_AUTO, X, y, wts, 1.0e-10, w,
+               "solver auto weighted");
+
+  /* square system */
+  {
+    gsl_matrix_view Xs = gsl_matrix_submatrix(X, 0, 0, p, p);
+    gsl_vector_view ys = gsl_vector_subvector(y, 0, p);
+    gsl_vector_view ws = gsl_vector_subvector(wts, 0, p);
+
+    test_solver1(GSL_MULTIFIT_LINEAR_QR, &Xs.matrix, &ys.vector,
+                 &ws.vector, 1.0e-8, w, "solver QR square");
+  }
+
+  /* rank deficient system: the automatic selection must fall back
+   * to the SVD and reproduce it exactly */
+  test_random_matrix_ill(X, r);
+
+  test_solver1(GSL_MULTIFIT_LINEAR_AUTO, X, y, NULL, 0.0, w,
+               "solver auto ill-conditioned unweighted");
+  test_solver1(GSL_MULTIFIT_LINEAR_AUTO, X, y, wts, 0.0, w,
+               "solver auto ill-conditioned weighted");
+
+  /* an exactly singular normal equations matrix falls back to the
+   * SVD without calling the error handler in the automatic selection,
+   * and is an error for the Cholesky solver */
+  gsl_matrix_set_zero(X);
+
+  {
+    int status;
+
+    gsl_multifit_linear_set_solver(w, GSL_MULTIFIT_LINEAR_AUTO);
+    status = gsl_multifit_linear(X, y, c, cov, &chisq, w);
+    gsl_test_int(status, GSL_SUCCESS, "solver auto singular");
+  }
+
+  {
+    gsl_error_handler_t *err_handler = gsl_set_error_handler_off();
+    int status;
+
+    gsl_multifit_linear_set_solver(w, GSL_MULTIFIT_LINEAR_CHOLESKY);
+    status = gsl_multifit_linear(X, y, c, cov, &chisq, w);
+    gsl_test_int(status, GSL_EDOM, "solver cholesky singular");
+
+    status = gsl_multifit_linear_set_solver(w, (gsl_multifit_linear_solver_type) 99);
+    gsl_test_int(status, GSL_EINVAL, "solver invalid");
+
+    gsl_set_error_handler(err_handler);
+  }
+
+  gsl_matrix_free(X);
+  gsl_vector_free(y);
+  gsl_vector_free(wts);
+  gsl_vector_free(c);
+  gsl_matrix_free(cov);
+  gsl_multifit_linear_free(w);
+  gsl_rng_free(r);
+}
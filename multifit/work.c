@@ -39,6 +39,7 @@ gsl_multifit_linear_alloc (const size_t nmax, const size_t pmax)
   w->n = 0;
   w->p = 0;
   w->rcond = 0.0;
+  w->solver = GSL_MULTIFIT_LINEAR_SVD;
 
   w->A = gsl_matrix_alloc (nmax, pmax);
 
@@ -96,6 +97,14 @@ gsl_multifit_linear_alloc (const size_t nmax, const size_t pmax)
       GSL_ERROR_VAL ("failed to allocate space for D", GSL_ENOMEM, 0);
     }
 
+  w->work3 = gsl_vector_alloc (3 * pmax);
+
+  if (w->work3 == 0)
+    {
+      gsl_multifit_linear_free(w);
+      GSL_ERROR_VAL ("failed to allocate space for work3", GSL_ENOMEM, 0);
+    }
+
   return w;
 }
 
@@ -125,6 +134,33 @@ gsl_multifit_linear_free (gsl_multifit_linear_workspace * w)
   if (w->D)
     gsl_vector_free (w->D);
 
+  if (w->work3)
+    gsl_vector_free (w->work3);
+
   free (w);
 }
 
+/*
+gsl_multifit_linear_set_solver()
+  Select the method used by gsl_multifit_linear() and
+gsl_multifit_wlinear()
+*/
+
+int
+gsl_multifit_linear_set_solver (gsl_multifit_linear_workspace * w,
+                                const gsl_multifit_linear_solver_type solver)
+{
+  switch (solver)
+    {
+    case GSL_MULTIFIT_LINEAR_SVD:
+    case GSL_MULTIFIT_LINEAR_QR:
+    case GSL_MULTIFIT_LINEAR_CHOLESKY:
+    case GSL_MULTIFIT_LINEAR_AUTO:
+      w->solver = solver;
+      return GSL_SUCCESS;
+
+    default:
+      GSL_ERROR ("unknown linear least squares solver", GSL_EINVAL);
+    }
+}
+
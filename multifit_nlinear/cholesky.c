@@ -55,6 +55,7 @@ typedef struct
   gsl_permutation *perm;     /* permutation matrix for modified Cholesky */
   gsl_vector *work3p;        /* workspace, size 3*p */
   double mu;                 /* current regularization parameter */
+  int current;               /* J^T J is up to date with current J */
 } cholesky_state_t;
 
 static void *cholesky_alloc (const size_t n, const size_t p);
@@ -62,6 +63,8 @@ static int cholesky_init(const void * vtrust_state, void * vstate);
 static int cholesky_presolve(const double mu, const void * vtrust_state, void * vstate);
 static int cholesky_solve(const gsl_vector * f, gsl_vector *x,
                           const  void * vtrust_state, void *vstate);
+static int cholesky_update(const gsl_vector * u, const gsl_vector * v,
+                           const void * vtrust_state, void * vstate);
 static int cholesky_solve_rhs(const gsl_vector * b, gsl_vector *x, cholesky_state_t *state);
 static int cholesky_regularize(const double mu, const gsl_vector * diag, gsl_matrix * A,
                                cholesky_state_t * state);
@@ -111,6 +114,7 @@ cholesky_alloc (const size_t n, const size_t p)
     }
 
   state->mu = -1.0;
+  state->current = 0;
 
   return state;
 }
@@ -145,8 +149,68 @@ cholesky_init(const void * vtrust_state, void * vstate)
     (const gsl_multifit_nlinear_trust_state *) vtrust_state;
   cholesky_state_t *state = (cholesky_state_t *) vstate;
 
+  if (state->current)
+    {
+      /* J has not changed, or J^T J was updated by cholesky_update() */
+      return GSL_SUCCESS;
+    }
+
   /* compute J^T J */
   gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, trust_state->J, 0.0, state->JTJ);
+  state->current = 1;
+
+  return GSL_SUCCESS;
+}
+
+/*
+cholesky_update()
+  Called when the Jacobian changes. If u and v are NULL, J was
+recomputed and J^T J will be formed again by the next call to
+cholesky_init(). Otherwise J was updated by a rank-1 matrix,
+
+J_new = J + u v^T
+
+and, writing w = J_new^T u = J^T u + (u^T u) v,
+
+J_new^T J_new = J^T J + w v^T + v w^T - (u^T u) v v^T
+
+so that only the matrix-vector product w is needed, which requires
+O(n p) operations instead of the O(n p^2) needed to form J_new^T J_new.
+
+Inputs: u            - vector of length n, or NULL
+        v            - vector of length p, or NULL
+        vtrust_state - trust state, with J = J_new
+        vstate       - workspace
+*/
+
+static int
+cholesky_update(const gsl_vector * u, const gsl_vector * v,
+                const void * vtrust_state, void * vstate)
+{
+  const gsl_multifit_nlinear_trust_state *trust_state =
+    (const gsl_multifit_nlinear_trust_state *) vtrust_state;
+  cholesky_state_t *state = (cholesky_state_t *) vstate;
+
+  if (u == NULL || v == NULL || !state->current)
+    {
+      state->current = 0;
+    }
+  else
+    {
+      gsl_vector_view w = gsl_vector_subvector(state->work3p, 0, v->size);
+      double utu = gsl_blas_dnrm2(u);
+
+      /* w = J_new^T u */
+      gsl_blas_dgemv(CblasTrans, 1.0, trust_state->J, u, 0.0, &w.vector);
+
+      utu *= utu;
+
+      gsl_blas_dsyr2(CblasLower, 1.0, &w.vector, v, state->JTJ);
+      gsl_blas_dsyr(CblasLower, -utu, v, state->JTJ);
+
+      /* the decomposition in work_JTJ no longer matches J^T J */
+      state->mu = -1.0;
+    }
 
   return GSL_SUCCESS;
 }
@@ -295,7 +359,8 @@ static const gsl_multifit_nlinear_solver cholesky_type =
   cholesky_presolve,
   cholesky_solve,
   cholesky_rcond,
-  cholesky_free
+  cholesky_free,
+  cholesky_update
 };
 
 const gsl_multifit_nlinear_solver *gsl_multifit_nlinear_solver_cholesky = &cholesky_type;
@@ -0,0 +1,443 @@
+/* multifit_nlinear/fdcolor.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Finite difference Jacobians using a batched residual function and
+ * a known sparsity pattern, for inclusion in trust.c
+ *
+ * Columns of J which have no nonzero row in common may be perturbed
+ * together, since each row of f(x + sum_j delta_j e_j) - f(x) then
+ * depends on only one of them. The columns are colored greedily so
+ * that no two columns of one color share a row, and the Jacobian is
+ * found from one evaluation of f per color (two for centered
+ * differences). For banded or block structured problems the number
+ * of colors does not grow with p. See
+ *
+ * A. R. Curtis, M. J. D. Powell and J. K. Reid, On the estimation of
+ * sparse Jacobian matrices, J. Inst. Maths Applics 13 (1974), 117-119.
+ *
+ * If a batched residual function is provided, all of the perturbed
+ * parameter vectors are passed to it in a single call, so that it
+ * may evaluate them concurrently.
+ */
+
+typedef struct
+{
+  size_t ncolor;        /* number of colors */
+  size_t *color;        /* color of each column, size p */
+  size_t *colptr;       /* pattern column pointers, size p + 1, or NULL for dense */
+  size_t *rowidx;       /* pattern row indices */
+  gsl_matrix *X;        /* perturbed parameter vectors, k-by-p */
+  gsl_matrix *F;        /* residual vectors f(X_m), k-by-n */
+} fdcolor_state_t;
+
+static void fdcolor_free(fdcolor_state_t *state);
+
+/*
+fdcolor_pattern()
+  Store the sparsity pattern in compressed column form and color
+its columns
+
+Inputs: S     - sparsity pattern of J, n-by-p, in any storage format
+        state - workspace
+
+Return: success/error
+*/
+
+static int
+fdcolor_pattern(const gsl_spmatrix * S, fdcolor_state_t * state)
+{
+  const size_t n = S->size1;
+  const size_t p = S->size2;
+  const size_t nz = S->nz;
+  const size_t nzmax = GSL_MAX(nz, 1);
+  size_t *ri, *ci;           /* (row, column) of each entry */
+  size_t *rowptr, *colidx;   /* pattern in compressed row form */
+  size_t *mark;
+  size_t i, j, k;
+  int status = GSL_SUCCESS;
+
+  state->colptr = calloc(p + 1, sizeof(size_t));
+  state->rowidx = malloc(nzmax * sizeof(size_t));
+  rowptr = calloc(n + 1, sizeof(size_t));
+  colidx = malloc(nzmax * sizeof(size_t));
+  ri = malloc(nzmax * sizeof(size_t));
+  ci = malloc(nzmax * sizeof(size_t));
+  mark = malloc(GSL_MAX(GSL_MAX(n, p), 1) * sizeof(size_t));
+
+  if (state->colptr == NULL || state->rowidx == NULL || rowptr == NULL ||
+      colidx == NULL || ri == NULL || ci == NULL || mark == NULL)
+    {
+      status = GSL_ENOMEM;
+      goto cleanup;
+    }
+
+  /* list the entries */
+  if (GSL_SPMATRIX_ISTRIPLET(S))
+    {
+      for (k = 0; k < nz; ++k)
+        {
+          ri[k] = S->i[k];
+          ci[k] = S->p[k];
+        }
+    }
+  else if (GSL_SPMATRIX_ISCCS(S))
+    {
+      for (j = 0; j < p; ++j)
+        {
+          for (k = S->p[j]; k < S->p[j + 1]; ++k)
+            {
+              ri[k] = S->i[k];
+              ci[k] = j;
+            }
+        }
+    }
+  else
+    {
+      for (i = 0; i < n; ++i)
+        {
+          for (k = S->p[i]; k < S->p[i + 1]; ++k)
+            {
+              ri[k] = i;
+              ci[k] = S->i[k];
+            }
+        }
+    }
+
+  /* compressed column and compressed row forms */
+  for (k = 0; k < nz; ++k)
+    {
+      state->colptr[ci[k] + 1]++;
+      rowptr[ri[k] + 1]++;
+    }
+
+  for (j = 0; j < p; ++j)
+    state->colptr[j + 1] += state->colptr[j];
+
+  for (i = 0; i < n; ++i)
+    rowptr[i + 1] += rowptr[i];
+
+  for (j = 0; j < p; ++j)
+    mark[j] = state->colptr[j];
+
+  for (k = 0; k < nz; ++k)
+    state->rowidx[mark[ci[k]]++] = ri[k];
+
+  for (i = 0; i < n; ++i)
+    mark[i] = rowptr[i];
+
+  for (k = 0; k < nz; ++k)
+    colidx[mark[ri[k]]++] = ci[k];
+
+  /* greedy coloring: column j takes the smallest color not used by
+   * a previous column sharing a row with it, mark[c] == j flagging
+   * color c as used */
+  for (k = 0; k < p; ++k)
+    mark[k] = p;
+
+  state->ncolor = 0;
+
+  for (j = 0; j < p; ++j)
+    {
+      size_t c;
+
+      for (k = state->colptr[j]; k < state->colptr[j + 1]; ++k)
+        {
+          size_t m;
+
+          i = state->rowidx[k];
+
+          for (m = rowptr[i]; m < rowptr[i + 1]; ++m)
+            {
+              if (colidx[m] < j)
+                mark[state->color[colidx[m]]] = j;
+            }
+        }
+
+      for (c = 0; mark[c] == j; ++c)
+        ;
+
+      state->color[j] = c;
+
+      if (c + 1 > state->ncolor)
+        state->ncolor = c + 1;
+    }
+
+cleanup:
+  free(rowptr);
+  free(colidx);
+  free(ri);
+  free(ci);
+  free(mark);
+
+  if (status)
+    {
+      GSL_ERROR("failed to allocate space for sparsity pattern", status);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+fdcolor_alloc()
+  Allocate workspace for finite difference Jacobians by batched
+or colored evaluation
+
+Inputs: params - solver parameters, with fbatch and/or jac_pattern set
+        n      - number of residuals
+        p      - number of parameters
+
+Return: pointer to workspace
+*/
+
+static fdcolor_state_t *
+fdcolor_alloc(const gsl_multifit_nlinear_parameters * params,
+              const size_t n, const size_t p)
+{
+  fdcolor_state_t *state;
+  size_t j, k;
+
+  if (params->jac_pattern != NULL &&
+      (params->jac_pattern->size1 != n || params->jac_pattern->size2 != p))
+    {
+      GSL_ERROR_NULL ("Jacobian pattern does not match problem size",
+                      GSL_EBADLEN);
+    }
+
+  state = calloc(1, sizeof(fdcolor_state_t));
+  if (state == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate fdcolor state", GSL_ENOMEM);
+    }
+
+  state->color = malloc(p * sizeof(size_t));
+  if (state->color == NULL)
+    {
+      fdcolor_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for color", GSL_ENOMEM);
+    }
+
+  if (params->jac_pattern != NULL)
+    {
+      int status = fdcolor_pattern(params->jac_pattern, state);
+      if (status)
+        {
+          fdcolor_free(state);
+          return NULL;
+        }
+    }
+  else
+    {
+      /* dense Jacobian, one column per color */
+      for (j = 0; j < p; ++j)
+        state->color[j] = j;
+
+      state->ncolor = p;
+    }
+
+  k = state->ncolor;
+  if (params->fdtype == GSL_MULTIFIT_NLINEAR_CTRDIFF)
+    k *= 2;
+
+  state->X = gsl_matrix_alloc(GSL_MAX(k, 1), p);
+  if (state->X == NULL)
+    {
+      fdcolor_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for X", GSL_ENOMEM);
+    }
+
+  state->F = gsl_matrix_alloc(GSL_MAX(k, 1), n);
+  if (state->F == NULL)
+    {
+      fdcolor_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for F", GSL_ENOMEM);
+    }
+
+  return state;
+}
+
+static void
+fdcolor_free(fdcolor_state_t *state)
+{
+  if (state->color)
+    free(state->color);
+
+  if (state->colptr)
+    free(state->colptr);
+
+  if (state->rowidx)
+    free(state->rowidx);
+
+  if (state->X)
+    gsl_matrix_free(state->X);
+
+  if (state->F)
+    gsl_matrix_free(state->F);
+
+  free(state);
+}
+
+/*
+fdcolor_jac()
+  Compute approximate Jacobian using forward or centered differences,
+perturbing all columns of a color together
+
+Inputs: h      - finite difference step size
+        fdtype - finite difference method
+        fbatch - batched residual function, or NULL
+        x      - parameter vector
+        swts   - data weights sqrt(W), or NULL
+        fdf    - fdf struct
+        f      - (input) vector of function values f_i(x)
+        J      - (output) Jacobian matrix
+        state  - workspace
+
+Return: success or error
+*/
+
+static int
+fdcolor_jac(const double h, const gsl_multifit_nlinear_fdtype fdtype,
+            int (* fbatch) (const gsl_matrix * X, void * params, gsl_matrix * F),
+            const gsl_vector * x, const gsl_vector * swts,
+            gsl_multifit_nlinear_fdf * fdf, const gsl_vector * f,
+            gsl_matrix * J, fdcolor_state_t * state)
+{
+  const size_t n = fdf->n;
+  const size_t p = fdf->p;
+  const size_t nc = state->ncolor;
+  const int center = (fdtype == GSL_MULTIFIT_NLINEAR_CTRDIFF);
+  const size_t k = center ? 2 * nc : nc;
+  gsl_matrix_view X = gsl_matrix_submatrix(state->X, 0, 0, k, p);
+  gsl_matrix_view F = gsl_matrix_submatrix(state->F, 0, 0, k, n);
+  int status = GSL_SUCCESS;
+  size_t i, j, m;
+
+  if (fdtype != GSL_MULTIFIT_NLINEAR_FWDIFF && !center)
+    {
+      GSL_ERROR("invalid specified fdtype", GSL_EINVAL);
+    }
+
+  /* rows of X are x plus the perturbations of each color, the
+   * second half holding the backward perturbations if centered */
+  for (m = 0; m < k; ++m)
+    {
+      gsl_vector_view xm = gsl_matrix_row(&X.matrix, m);
+      gsl_vector_memcpy(&xm.vector, x);
+    }
+
+  for (j = 0; j < p; ++j)
+    {
+      const double xj = gsl_vector_get(x, j);
+      const size_t c = state->color[j];
+      double delta = h * fabs(xj);
+
+      if (delta == 0.0)
+        delta = h;
+
+      if (center)
+        {
+          gsl_matrix_set(&X.matrix, c, j, xj + 0.5 * delta);
+          gsl_matrix_set(&X.matrix, nc + c, j, xj - 0.5 * delta);
+        }
+      else
+        {
+          gsl_matrix_set(&X.matrix, c, j, xj + delta);
+        }
+    }
+
+  /* evaluate the residuals */
+  if (fbatch)
+    {
+      status = (*fbatch) (&X.matrix, fdf->params, &F.matrix);
+      fdf->nevalf += k;
+
+      if (swts)
+        {
+          for (m = 0; m < k; ++m)
+            {
+              gsl_vector_view fm = gsl_matrix_row(&F.matrix, m);
+              gsl_vector_mul(&fm.vector, swts);
+            }
+        }
+    }
+  else
+    {
+      for (m = 0; m < k && status == GSL_SUCCESS; ++m)
+        {
+          gsl_vector_view xm = gsl_matrix_row(&X.matrix, m);
+          gsl_vector_view fm = gsl_matrix_row(&F.matrix, m);
+
+          status = gsl_multifit_nlinear_eval_f(fdf, &xm.vector, swts, &fm.vector);
+        }
+    }
+
+  if (status)
+    return status;
+
+  /* form the columns of J from the differences */
+  if (state->colptr == NULL)
+    {
+      for (j = 0; j < p; ++j)
+        {
+          const double xj = gsl_vector_get(x, j);
+          double delta = h * fabs(xj);
+          gsl_vector_view Jj = gsl_matrix_column(J, j);
+          gsl_vector_const_view fplus = gsl_matrix_const_row(&F.matrix, j);
+          gsl_vector_const_view fminus = center ?
+            gsl_matrix_const_row(&F.matrix, nc + j) :
+            gsl_vector_const_subvector(f, 0, n);
+
+          if (delta == 0.0)
+            delta = h;
+
+          gsl_vector_memcpy(&Jj.vector, &fplus.vector);
+          gsl_vector_sub(&Jj.vector, &fminus.vector);
+          gsl_vector_scale(&Jj.vector, 1.0 / delta);
+        }
+    }
+  else
+    {
+      gsl_matrix_set_zero(J);
+
+      for (j = 0; j < p; ++j)
+        {
+          const double xj = gsl_vector_get(x, j);
+          const size_t c = state->color[j];
+          double delta = h * fabs(xj);
+          size_t ki;
+
+          if (delta == 0.0)
+            delta = h;
+
+          delta = 1.0 / delta;
+
+          for (ki = state->colptr[j]; ki < state->colptr[j + 1]; ++ki)
+            {
+              double fplus, fminus;
+
+              i = state->rowidx[ki];
+              fplus = gsl_matrix_get(&F.matrix, c, i);
+              fminus = center ? gsl_matrix_get(&F.matrix, nc + c, i) :
+                                gsl_vector_get(f, i);
+
+              gsl_matrix_set(J, i, j, (fplus - fminus) * delta);
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
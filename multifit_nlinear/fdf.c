@@ -144,6 +144,9 @@ gsl_multifit_nlinear_default_parameters(void)
   params.avmax = 0.75;
   params.h_df = GSL_SQRT_DBL_EPSILON;
   params.h_fvv = 0.02;
+  params.fbatch = NULL;
+  params.jac_pattern = NULL;
+  params.jac_reuse = 0;
 
   return params;
 }
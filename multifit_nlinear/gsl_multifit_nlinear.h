@@ -27,6 +27,7 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -97,6 +98,13 @@ typedef struct
  *              used for cholesky method in order to factor
  *              the (J^T J + mu D^T D) matrix
  * 3. solve: solve the least square system for a given rhs
+ *
+ * A solver may also provide an update function, which is called
+ * whenever J changes: with u = v = NULL after J is recomputed, or
+ * with vectors u and v after a Broyden rank-1 update J <- J + u v^T.
+ * This allows init to skip work when J is unchanged or to update
+ * its state cheaply. If update is NULL, init is assumed to always
+ * recompute its state.
  */
 typedef struct
 {
@@ -108,6 +116,8 @@ typedef struct
                 const void * vtrust_state, void * vstate);
   int (*rcond) (double * rcond, void * vstate);
   void (*free) (void * vstate);
+  int (*update) (const gsl_vector * u, const gsl_vector * v,
+                 const void * vtrust_state, void * vstate);
 } gsl_multifit_nlinear_solver;
 
 /* tunable parameters */
@@ -122,6 +132,10 @@ typedef struct
   double avmax;                               /* max allowed |a|/|v| */
   double h_df;                                /* step size for finite difference Jacobian */
   double h_fvv;                               /* step size for finite difference fvv */
+  int (* fbatch) (const gsl_matrix * X, void * params,
+                  gsl_matrix * F);            /* batched f for finite difference Jacobian, or NULL */
+  const gsl_spmatrix * jac_pattern;           /* sparsity pattern of J for finite differences, or NULL */
+  size_t jac_reuse;                           /* max Broyden updates between Jacobian evaluations */
 } gsl_multifit_nlinear_parameters;
 
 typedef struct
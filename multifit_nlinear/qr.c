@@ -280,7 +280,8 @@ static const gsl_multifit_nlinear_solver qr_type =
   qr_presolve,
   qr_solve,
   qr_rcond,
-  qr_free
+  qr_free,
+  NULL
 };
 
 const gsl_multifit_nlinear_solver *gsl_multifit_nlinear_solver_qr = &qr_type;
@@ -263,7 +263,8 @@ static const gsl_multifit_nlinear_solver svd_type =
   svd_presolve,
   svd_solve,
   svd_rcond,
-  svd_free
+  svd_free,
+  NULL
 };
 
 const gsl_multifit_nlinear_solver *gsl_multifit_nlinear_solver_svd = &svd_type;
@@ -31,6 +31,8 @@
 #include <gsl/gsl_ieee_utils.h>
 
 #include "test_fdf.c"
+#include "test_fdcolor.c"
+#include "test_broyden.c"
 
 static void
 test_proc(const gsl_multifit_nlinear_trs *trs,
@@ -101,5 +103,8 @@ main (void)
         }
     }
 
+  test_fdcolor();
+  test_broyden();
+
   exit (gsl_test_summary ());
 }
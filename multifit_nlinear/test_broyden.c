@@ -0,0 +1,207 @@
+/* multifit_nlinear/test_broyden.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Test Broyden updates of the Jacobian (params.jac_reuse > 0) on
+ * a nonlinear system with a sum of squares term,
+ *
+ * f_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1, i < p
+ * f_{p+i} = 0.1 (x_i - 1) + 0.05 x_i^2,          i < p
+ */
+
+#define broyden_P        10
+#define broyden_N        (2 * broyden_P)
+
+static int
+broyden_f(const gsl_vector * x, void *params, gsl_vector * f)
+{
+  size_t i;
+
+  (void) params;
+
+  for (i = 0; i < broyden_P; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+      double xm = (i > 0) ? gsl_vector_get(x, i - 1) : 0.0;
+      double xp = (i + 1 < broyden_P) ? gsl_vector_get(x, i + 1) : 0.0;
+
+      gsl_vector_set(f, i, (3.0 - 2.0 * xi) * xi - xm - 2.0 * xp + 1.0);
+      gsl_vector_set(f, broyden_P + i, 0.1 * (xi - 1.0) + 0.05 * xi * xi);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+broyden_df(const gsl_vector * x, void *params, gsl_matrix * J)
+{
+  size_t i;
+
+  (void) params;
+
+  gsl_matrix_set_zero(J);
+
+  for (i = 0; i < broyden_P; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+
+      if (i > 0)
+        gsl_matrix_set(J, i, i - 1, -1.0);
+
+      gsl_matrix_set(J, i, i, 3.0 - 4.0 * xi);
+
+      if (i + 1 < broyden_P)
+        gsl_matrix_set(J, i, i + 1, -2.0);
+
+      gsl_matrix_set(J, broyden_P + i, i, 0.1 + 0.1 * xi);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static gsl_multifit_nlinear_workspace *
+test_broyden_alloc(const gsl_multifit_nlinear_trs * trs,
+                   const gsl_multifit_nlinear_solver * solver,
+                   const size_t jac_reuse, gsl_multifit_nlinear_fdf * fdf)
+{
+  gsl_multifit_nlinear_parameters params =
+    gsl_multifit_nlinear_default_parameters();
+  gsl_multifit_nlinear_workspace *w;
+  gsl_vector *x0 = gsl_vector_alloc(broyden_P);
+
+  params.trs = trs;
+  params.solver = solver;
+  params.jac_reuse = jac_reuse;
+
+  fdf->f = broyden_f;
+  fdf->df = broyden_df;
+  fdf->fvv = NULL;
+  fdf->n = broyden_N;
+  fdf->p = broyden_P;
+  fdf->params = NULL;
+
+  w = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params,
+                                 broyden_N, broyden_P);
+
+  gsl_vector_set_all(x0, -1.0);
+  gsl_multifit_nlinear_init(x0, fdf, w);
+
+  gsl_vector_free(x0);
+
+  return w;
+}
+
+/* compare iterates of the cholesky solver, which updates J^T J, with
+ * those of a solver which recomputes its factorization */
+static void
+test_broyden_iter(const gsl_multifit_nlinear_trs * trs,
+                  const gsl_multifit_nlinear_solver * solver)
+{
+  const double tol = 1.0e-8;
+  const size_t jac_reuse = 4;
+  gsl_multifit_nlinear_fdf fdf0, fdf1;
+  gsl_multifit_nlinear_workspace *w0 =
+    test_broyden_alloc(trs, gsl_multifit_nlinear_solver_cholesky, jac_reuse, &fdf0);
+  gsl_multifit_nlinear_workspace *w1 =
+    test_broyden_alloc(trs, solver, jac_reuse, &fdf1);
+  size_t iter, i;
+
+  for (iter = 0; iter < 10; ++iter)
+    {
+      int s0 = gsl_multifit_nlinear_iterate(w0);
+      int s1 = gsl_multifit_nlinear_iterate(w1);
+      gsl_vector *x0 = gsl_multifit_nlinear_position(w0);
+      gsl_vector *x1 = gsl_multifit_nlinear_position(w1);
+
+      gsl_test_int(s0, s1, "broyden trs=%s solver=%s iter=%zu status",
+                   trs->name, solver->name, iter);
+
+      for (i = 0; i < broyden_P; ++i)
+        {
+          gsl_test_rel(gsl_vector_get(x0, i), gsl_vector_get(x1, i), tol,
+                       "broyden trs=%s solver=%s iter=%zu x[%zu]",
+                       trs->name, solver->name, iter, i);
+        }
+    }
+
+  gsl_test(fdf0.nevaldf != fdf1.nevaldf,
+           "broyden trs=%s solver=%s nevaldf %zu/%zu",
+           trs->name, solver->name, fdf0.nevaldf, fdf1.nevaldf);
+
+  gsl_multifit_nlinear_free(w0);
+  gsl_multifit_nlinear_free(w1);
+}
+
+/* compare solution with that obtained with exact Jacobians */
+static void
+test_broyden_solve(const gsl_multifit_nlinear_trs * trs,
+                   const gsl_multifit_nlinear_solver * solver,
+                   const size_t jac_reuse)
+{
+  const double xtol = 1.0e-12;
+  const double gtol = 1.0e-12;
+  const double ftol = 0.0;
+  const double tol = 1.0e-7;
+  gsl_multifit_nlinear_fdf fdf0, fdf1;
+  gsl_multifit_nlinear_workspace *w0 =
+    test_broyden_alloc(trs, solver, 0, &fdf0);
+  gsl_multifit_nlinear_workspace *w1 =
+    test_broyden_alloc(trs, solver, jac_reuse, &fdf1);
+  int info, status;
+  size_t i;
+
+  status = gsl_multifit_nlinear_driver(200, xtol, gtol, ftol,
+                                       NULL, NULL, &info, w0);
+  gsl_test(status, "broyden trs=%s solver=%s reference status=%s",
+           trs->name, solver->name, gsl_strerror(status));
+
+  status = gsl_multifit_nlinear_driver(200, xtol, gtol, ftol,
+                                       NULL, NULL, &info, w1);
+  gsl_test(status, "broyden trs=%s solver=%s jac_reuse=%zu status=%s",
+           trs->name, solver->name, jac_reuse, gsl_strerror(status));
+
+  for (i = 0; i < broyden_P; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(w1->x, i), gsl_vector_get(w0->x, i), tol,
+                   "broyden trs=%s solver=%s jac_reuse=%zu x[%zu]",
+                   trs->name, solver->name, jac_reuse, i);
+    }
+
+  gsl_test(fdf1.nevaldf >= fdf0.nevaldf,
+           "broyden trs=%s solver=%s jac_reuse=%zu nevaldf %zu/%zu",
+           trs->name, solver->name, jac_reuse, fdf1.nevaldf, fdf0.nevaldf);
+
+  gsl_multifit_nlinear_free(w0);
+  gsl_multifit_nlinear_free(w1);
+}
+
+static void
+test_broyden(void)
+{
+  test_broyden_iter(gsl_multifit_nlinear_trs_lm, gsl_multifit_nlinear_solver_qr);
+  test_broyden_iter(gsl_multifit_nlinear_trs_lm, gsl_multifit_nlinear_solver_svd);
+  test_broyden_iter(gsl_multifit_nlinear_trs_dogleg, gsl_multifit_nlinear_solver_qr);
+  test_broyden_iter(gsl_multifit_nlinear_trs_subspace2D, gsl_multifit_nlinear_solver_qr);
+
+  test_broyden_solve(gsl_multifit_nlinear_trs_lm, gsl_multifit_nlinear_solver_cholesky, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_lm, gsl_multifit_nlinear_solver_qr, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_lm, gsl_multifit_nlinear_solver_svd, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_lmaccel, gsl_multifit_nlinear_solver_qr, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_dogleg, gsl_multifit_nlinear_solver_cholesky, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_ddogleg, gsl_multifit_nlinear_solver_qr, 5);
+  test_broyden_solve(gsl_multifit_nlinear_trs_subspace2D, gsl_multifit_nlinear_solver_cholesky, 5);
+}
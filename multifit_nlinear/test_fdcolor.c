@@ -0,0 +1,183 @@
+/* multifit_nlinear/test_fdcolor.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Broyden tridiagonal function with additional rows, whose Jacobian
+ * is tridiagonal in the first p rows and has one nonzero per row in
+ * the rest:
+ *
+ * f_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1, i < p
+ * f_{p+i} = 0.1 (x_i - 1),                        i < p
+ */
+
+static int
+fdcolor_f(const gsl_vector * x, void *params, gsl_vector * f)
+{
+  const size_t p = x->size;
+  size_t i;
+
+  (void) params;
+
+  for (i = 0; i < p; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+      double xm = (i > 0) ? gsl_vector_get(x, i - 1) : 0.0;
+      double xp = (i + 1 < p) ? gsl_vector_get(x, i + 1) : 0.0;
+
+      gsl_vector_set(f, i, (3.0 - 2.0 * xi) * xi - xm - 2.0 * xp + 1.0);
+      gsl_vector_set(f, p + i, 0.1 * (xi - 1.0));
+    }
+
+  return GSL_SUCCESS;
+}
+
+static size_t fdcolor_nbatch = 0;
+
+static int
+fdcolor_fbatch(const gsl_matrix * X, void *params, gsl_matrix * F)
+{
+  size_t m;
+
+  ++fdcolor_nbatch;
+
+  for (m = 0; m < X->size1; ++m)
+    {
+      gsl_vector_const_view xm = gsl_matrix_const_row(X, m);
+      gsl_vector_view fm = gsl_matrix_row(F, m);
+
+      fdcolor_f(&xm.vector, params, &fm.vector);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+test_fdcolor1(const gsl_multifit_nlinear_fdtype fdtype, const int batch,
+              const int sptype, const gsl_vector * wts)
+{
+  const size_t p = 30;
+  const size_t n = 2 * p;
+  const size_t ncolor = 3;
+  const double tol = 1.0e-12;
+  gsl_multifit_nlinear_parameters params = gsl_multifit_nlinear_default_parameters();
+  gsl_multifit_nlinear_workspace *w0, *w1;
+  gsl_multifit_nlinear_fdf fdf0, fdf1;
+  gsl_spmatrix *S = gsl_spmatrix_alloc(n, p);
+  gsl_spmatrix *Sc = NULL;
+  gsl_vector *x0 = gsl_vector_alloc(p);
+  gsl_matrix *J0, *J1;
+  const char *desc = (fdtype == GSL_MULTIFIT_NLINEAR_FWDIFF) ? "forward" : "centered";
+  size_t i, j, neval;
+  int info;
+
+  for (i = 0; i < p; ++i)
+    {
+      gsl_vector_set(x0, i, -1.0 + 0.01 * i);
+
+      if (i > 0)
+        gsl_spmatrix_set(S, i, i - 1, 1.0);
+      gsl_spmatrix_set(S, i, i, 1.0);
+      if (i + 1 < p)
+        gsl_spmatrix_set(S, i, i + 1, 1.0);
+
+      gsl_spmatrix_set(S, p + i, i, 1.0);
+    }
+
+  if (sptype == GSL_SPMATRIX_CCS)
+    Sc = gsl_spmatrix_ccs(S);
+  else if (sptype == GSL_SPMATRIX_CRS)
+    Sc = gsl_spmatrix_crs(S);
+
+  fdf0.f = fdcolor_f;
+  fdf0.df = NULL;
+  fdf0.fvv = NULL;
+  fdf0.n = n;
+  fdf0.p = p;
+  fdf0.params = NULL;
+  fdf1 = fdf0;
+
+  params.fdtype = fdtype;
+  w0 = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, n, p);
+
+  params.jac_pattern = Sc ? Sc : S;
+  params.fbatch = batch ? fdcolor_fbatch : NULL;
+  w1 = gsl_multifit_nlinear_alloc(gsl_multifit_nlinear_trust, &params, n, p);
+
+  /* compare Jacobians at x0 */
+  gsl_multifit_nlinear_winit(x0, wts, &fdf0, w0);
+  fdcolor_nbatch = 0;
+  gsl_multifit_nlinear_winit(x0, wts, &fdf1, w1);
+
+  J0 = gsl_multifit_nlinear_jac(w0);
+  J1 = gsl_multifit_nlinear_jac(w1);
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < p; ++j)
+        {
+          gsl_test_abs(gsl_matrix_get(J1, i, j), gsl_matrix_get(J0, i, j), tol,
+                       "fdcolor %s batch=%d sptype=%d weighted=%d J(%zu,%zu)",
+                       desc, batch, sptype, wts != NULL, i, j);
+        }
+    }
+
+  /* one evaluation of f at x0, then one per color per side */
+  neval = 1 + ncolor * ((fdtype == GSL_MULTIFIT_NLINEAR_CTRDIFF) ? 2 : 1);
+  gsl_test_int((int) fdf1.nevalf, (int) neval,
+               "fdcolor %s batch=%d sptype=%d nevalf", desc, batch, sptype);
+
+  if (batch)
+    gsl_test_int((int) fdcolor_nbatch, 1, "fdcolor %s sptype=%d fbatch calls",
+                 desc, sptype);
+
+  /* solve and compare */
+  gsl_multifit_nlinear_driver(100, 1.0e-12, 1.0e-12, 1.0e-12, NULL, NULL, &info, w0);
+  gsl_multifit_nlinear_driver(100, 1.0e-12, 1.0e-12, 1.0e-12, NULL, NULL, &info, w1);
+
+  for (j = 0; j < p; ++j)
+    {
+      gsl_test_rel(gsl_vector_get(w1->x, j), gsl_vector_get(w0->x, j), 1.0e-8,
+                   "fdcolor %s batch=%d sptype=%d weighted=%d x[%zu]",
+                   desc, batch, sptype, wts != NULL, j);
+    }
+
+  gsl_multifit_nlinear_free(w0);
+  gsl_multifit_nlinear_free(w1);
+  gsl_spmatrix_free(S);
+  if (Sc)
+    gsl_spmatrix_free(Sc);
+  gsl_vector_free(x0);
+}
+
+static void
+test_fdcolor(void)
+{
+  const size_t n = 60;
+  gsl_vector *wts = gsl_vector_alloc(n);
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    gsl_vector_set(wts, i, 1.0 + 0.1 * (i % 7));
+
+  test_fdcolor1(GSL_MULTIFIT_NLINEAR_FWDIFF, 0, GSL_SPMATRIX_TRIPLET, NULL);
+  test_fdcolor1(GSL_MULTIFIT_NLINEAR_FWDIFF, 1, GSL_SPMATRIX_CCS, NULL);
+  test_fdcolor1(GSL_MULTIFIT_NLINEAR_CTRDIFF, 0, GSL_SPMATRIX_CRS, NULL);
+  test_fdcolor1(GSL_MULTIFIT_NLINEAR_CTRDIFF, 1, GSL_SPMATRIX_TRIPLET, wts);
+  test_fdcolor1(GSL_MULTIFIT_NLINEAR_FWDIFF, 1, GSL_SPMATRIX_TRIPLET, wts);
+
+  gsl_vector_free(wts);
+}
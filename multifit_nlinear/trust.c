@@ -26,9 +26,11 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
 
 #include "common.c"
 #include "nielsen.c"
+#include "fdcolor.c"
 
 /*
  * This module contains a high level driver for a general trust
@@ -40,6 +42,17 @@
  * Jacobian matrix: J_k = J(x_k)
  * gradient vector: g_k = J_k^T f_k
  * scaling matrix:  D_k
+ *
+ * If params->jac_reuse > 0, the Jacobian is not recomputed after
+ * every accepted step. Instead, while the quadratic model predicts
+ * the reduction in the cost function well (rho >= 1/4), up to
+ * jac_reuse consecutive Broyden rank-1 updates
+ *
+ * J_{k+1} = J_k + (y_k - J_k dx_k) dx_k^T / (dx_k^T dx_k)
+ *
+ * with y_k = f_{k+1} - f_k are applied. The Jacobian is recomputed
+ * after a poorly predicted step, after jac_reuse updates, and when
+ * a step is rejected while J_k is a Broyden approximation.
  */
 
 typedef struct
@@ -57,8 +70,10 @@ typedef struct
 
   void *trs_state;           /* workspace for trust region subproblem */
   void *solver_state;        /* workspace for linear least squares solver */
+  fdcolor_state_t *fdcolor;  /* batched/colored finite differences, or NULL */
 
   double avratio;            /* current |a| / |v| */
+  size_t nbroyden;           /* Broyden updates since last Jacobian evaluation */
 
   /* tunable parameters */
   gsl_multifit_nlinear_parameters params;
@@ -85,6 +100,15 @@ static int trust_eval_step(const gsl_vector * f, const gsl_vector * f_trial,
                            const gsl_vector * g, const gsl_matrix * J,
                            const gsl_vector * dx, double * rho, trust_state_t * state);
 static double trust_scaled_norm(const gsl_vector *D, const gsl_vector *a);
+static int trust_eval_df(const gsl_vector * x, const gsl_vector * f,
+                         const gsl_vector * swts, gsl_multifit_nlinear_fdf * fdf,
+                         gsl_matrix * J, trust_state_t * state);
+static int trust_broyden(const gsl_vector * f, const gsl_vector * f_trial,
+                         const gsl_vector * dx, gsl_matrix * J,
+                         trust_state_t * state);
+static int trust_update_df(const gsl_vector * u, const gsl_vector * v,
+                           const gsl_multifit_nlinear_trust_state * trust_state,
+                           trust_state_t * state);
 
 static void *
 trust_alloc (const gsl_multifit_nlinear_parameters * params,
@@ -140,6 +164,15 @@ trust_alloc (const gsl_multifit_nlinear_parameters * params,
       GSL_ERROR_NULL ("failed to allocate space for solver state", GSL_ENOMEM);
     }
 
+  if (params->fbatch != NULL || params->jac_pattern != NULL)
+    {
+      state->fdcolor = fdcolor_alloc(params, n, p);
+      if (state->fdcolor == NULL)
+        {
+          GSL_ERROR_NULL ("failed to allocate space for fdcolor state", GSL_ENOMEM);
+        }
+    }
+
   state->n = n;
   state->p = p;
   state->delta = 0.0;
@@ -175,6 +208,9 @@ trust_free(void *vstate)
   if (state->solver_state)
     (params->solver->free)(state->solver_state);
 
+  if (state->fdcolor)
+    fdcolor_free(state->fdcolor);
+
   free(state);
 }
 
@@ -208,8 +244,7 @@ trust_init(void *vstate, const gsl_vector *swts,
   if (status)
    return status;
 
-  status = gsl_multifit_nlinear_eval_df(x, f, swts, params->h_df,
-                                        params->fdtype, fdf, J, state->workn);
+  status = trust_eval_df(x, f, swts, fdf, J, state);
   if (status)
     return status;
 
@@ -244,6 +279,11 @@ trust_init(void *vstate, const gsl_vector *swts,
     trust_state.fdf = fdf;
     trust_state.avratio = &(state->avratio);
 
+    /* notify linear solver of new Jacobian */
+    status = trust_update_df(NULL, NULL, &trust_state, state);
+    if (status)
+      return status;
+
     status = (params->trs->init)(&trust_state, state->trs_state);
 
     if (status)
@@ -253,6 +293,7 @@ trust_init(void *vstate, const gsl_vector *swts,
   /* set default parameters */
 
   state->avratio = 0.0;
+  state->nbroyden = 0;
 
   return GSL_SUCCESS;
 }
@@ -370,12 +411,32 @@ trust_iterate(void *vstate, const gsl_vector *swts,
         {
           /* step was accepted */
 
-          /* compute J <- J(x + dx) */
-          status = gsl_multifit_nlinear_eval_df(x_trial, f_trial, swts,
-                                                params->h_df, params->fdtype,
-                                                fdf, J, state->workn);
-          if (status)
-            return status;
+          if (state->nbroyden < params->jac_reuse && rho >= 0.25)
+            {
+              /* model is accurate, update J <- J + u dx^T */
+              status = trust_broyden(f, f_trial, dx, J, state);
+              if (status)
+                return status;
+
+              ++(state->nbroyden);
+
+              status = trust_update_df(state->workn, dx, &trust_state, state);
+              if (status)
+                return status;
+            }
+          else
+            {
+              /* compute J <- J(x + dx) */
+              status = trust_eval_df(x_trial, f_trial, swts, fdf, J, state);
+              if (status)
+                return status;
+
+              state->nbroyden = 0;
+
+              status = trust_update_df(NULL, NULL, &trust_state, state);
+              if (status)
+                return status;
+            }
 
           /* update x <- x + dx */
           gsl_vector_memcpy(x, x_trial);
@@ -408,6 +469,31 @@ trust_iterate(void *vstate, const gsl_vector *swts,
               /* if more than 15 consecutive rejected steps, report no progress */
               return GSL_ENOPROG;
             }
+
+          if (state->nbroyden > 0)
+            {
+              /*
+               * J is a Broyden approximation, which may be the reason
+               * the step was rejected; recompute J(x) and restart the
+               * trust region subproblem with it
+               */
+              status = trust_eval_df(x, f, swts, fdf, J, state);
+              if (status)
+                return status;
+
+              state->nbroyden = 0;
+
+              gsl_blas_dgemv(CblasTrans, 1.0, J, f, 0.0, g);
+              (params->scale->update)(J, diag);
+
+              status = trust_update_df(NULL, NULL, &trust_state, state);
+              if (status)
+                return status;
+
+              status = (trs->preloop)(&trust_state, state->trs_state);
+              if (status)
+                return status;
+            }
         }
     }
 
@@ -574,6 +660,105 @@ trust_scaled_norm(const gsl_vector *D, const gsl_vector *a)
   return sqrt (e2);
 }
 
+/*
+trust_eval_df()
+  Compute Jacobian J(x), with the user function if given,
+otherwise by finite differences
+
+Inputs: x     - parameter vector
+        f     - f(x), weighted
+        swts  - sqrt(W) vector, or NULL
+        fdf   - user callback functions
+        J     - (output) J(x), weighted
+        state - workspace
+
+Return: success/error
+*/
+
+static int
+trust_eval_df(const gsl_vector * x, const gsl_vector * f,
+              const gsl_vector * swts, gsl_multifit_nlinear_fdf * fdf,
+              gsl_matrix * J, trust_state_t * state)
+{
+  const gsl_multifit_nlinear_parameters *params = &(state->params);
+
+  if (fdf->df == NULL && state->fdcolor != NULL)
+    {
+      /* batched or colored finite differences */
+      return fdcolor_jac(params->h_df, params->fdtype, params->fbatch,
+                         x, swts, fdf, f, J, state->fdcolor);
+    }
+  else
+    {
+      return gsl_multifit_nlinear_eval_df(x, f, swts, params->h_df,
+                                          params->fdtype, fdf, J, state->workn);
+    }
+}
+
+/*
+trust_broyden()
+  Apply a Broyden rank-1 update to the Jacobian after
+an accepted step dx,
+
+J <- J + u dx^T, u = (f_trial - f - J dx) / (dx^T dx)
+
+Inputs: f       - f(x)
+        f_trial - f(x + dx)
+        dx      - accepted step
+        J       - on input, J(x) or an approximation
+                  on output, updated Jacobian
+        state   - workspace
+
+Notes:
+1) On output, state->workn contains u
+*/
+
+static int
+trust_broyden(const gsl_vector * f, const gsl_vector * f_trial,
+              const gsl_vector * dx, gsl_matrix * J,
+              trust_state_t * state)
+{
+  gsl_vector *u = state->workn;
+  double dxnorm = gsl_blas_dnrm2(dx);
+
+  if (dxnorm == 0.0)
+    {
+      gsl_vector_set_zero(u);
+      return GSL_SUCCESS;
+    }
+
+  /* u = f_trial - f - J dx */
+  gsl_vector_memcpy(u, f_trial);
+  gsl_vector_sub(u, f);
+  gsl_blas_dgemv(CblasNoTrans, -1.0, J, dx, 1.0, u);
+
+  gsl_vector_scale(u, 1.0 / (dxnorm * dxnorm));
+
+  gsl_blas_dger(1.0, u, dx, J);
+
+  return GSL_SUCCESS;
+}
+
+/*
+trust_update_df()
+  Notify the linear solver that the Jacobian has changed,
+either by a rank-1 update J <- J + u v^T, or by a
+recomputation (u = v = NULL)
+*/
+
+static int
+trust_update_df(const gsl_vector * u, const gsl_vector * v,
+                const gsl_multifit_nlinear_trust_state * trust_state,
+                trust_state_t * state)
+{
+  const gsl_multifit_nlinear_solver *solver = state->params.solver;
+
+  if (solver->update == NULL)
+    return GSL_SUCCESS;
+
+  return (solver->update)(u, v, trust_state, state->solver_state);
+}
+
 static const gsl_multifit_nlinear_type trust_type =
 {
   "trust-region",
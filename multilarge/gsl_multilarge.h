@@ -20,6 +20,7 @@
 #ifndef __GSL_MULTILARGE_H__
 #define __GSL_MULTILARGE_H__
 
+#include <stdio.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
@@ -45,6 +46,7 @@ typedef struct
   int (*reset) (void *);
   int (*accumulate) (gsl_matrix * X, gsl_vector * y,
                      void *);
+  int (*merge) (const void * src, void *);
   int (*solve) (const double lambda, gsl_vector * c,
                 double * rnorm, double * snorm, void *);
   int (*rcond) (double * rcond, void *);
@@ -81,6 +83,13 @@ int gsl_multilarge_linear_accumulate(gsl_matrix * X,
                                      gsl_vector * y,
                                      gsl_multilarge_linear_workspace * w);
 
+int gsl_multilarge_linear_merge(const gsl_multilarge_linear_workspace * src,
+                                gsl_multilarge_linear_workspace * w);
+
+int gsl_multilarge_linear_accumulate_fread(FILE * stream, const size_t n,
+                                           const size_t nblock,
+                                           gsl_multilarge_linear_workspace * w);
+
 int gsl_multilarge_linear_solve(const double lambda, gsl_vector * c,
                                 double * rnorm, double * snorm,
                                 gsl_multilarge_linear_workspace * w);
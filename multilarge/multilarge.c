@@ -89,6 +89,101 @@ gsl_multilarge_linear_accumulate(gsl_matrix * X, gsl_vector * y,
   return status;
 }
 
+/*
+gsl_multilarge_linear_merge()
+  Merge the system accumulated in src into w. Separate workspaces
+may accumulate disjoint blocks of rows, for example in different
+threads, and be combined pairwise afterwards.
+
+Inputs: src - workspace to merge, unchanged on output
+        w   - workspace
+*/
+
+int
+gsl_multilarge_linear_merge(const gsl_multilarge_linear_workspace * src,
+                            gsl_multilarge_linear_workspace * w)
+{
+  if (src->type != w->type)
+    {
+      GSL_ERROR("workspaces have different types", GSL_EINVAL);
+    }
+  else if (src->p != w->p)
+    {
+      GSL_ERROR("workspaces have different numbers of columns", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = w->type->merge(src->state, w->state);
+      return status;
+    }
+}
+
+/*
+gsl_multilarge_linear_accumulate_fread()
+  Accumulate rows read from a binary stream, in blocks
+
+Inputs: stream - binary stream containing n rows [ x_i^T y_i ] of
+                 p + 1 doubles in native format, as written by
+                 gsl_matrix_fwrite() for the n-by-(p+1) matrix [ X y ]
+        n      - number of rows to read
+        nblock - number of rows per block
+        w      - workspace
+
+Return: success/error
+*/
+
+int
+gsl_multilarge_linear_accumulate_fread(FILE * stream, const size_t n,
+                                       const size_t nblock,
+                                       gsl_multilarge_linear_workspace * w)
+{
+  if (nblock == 0)
+    {
+      GSL_ERROR("block size must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t p = w->p;
+      const size_t nb = GSL_MIN(n, nblock);
+      gsl_matrix *B;
+      size_t rowidx = 0;
+      int status = GSL_SUCCESS;
+
+      if (n == 0)
+        return GSL_SUCCESS;
+
+      B = gsl_matrix_alloc(nb, p + 1);
+      if (B == NULL)
+        {
+          GSL_ERROR("failed to allocate space for block", GSL_ENOMEM);
+        }
+
+      while (rowidx < n)
+        {
+          const size_t nr = GSL_MIN(nb, n - rowidx);
+          gsl_matrix_view X = gsl_matrix_submatrix(B, 0, 0, nr, p);
+          gsl_vector_view y = gsl_matrix_subcolumn(B, p, 0, nr);
+          size_t items = fread(B->data, sizeof(double), nr * (p + 1), stream);
+
+          if (items != nr * (p + 1))
+            {
+              gsl_matrix_free(B);
+              GSL_ERROR("fread failed", GSL_EFAILED);
+            }
+
+          status = gsl_multilarge_linear_accumulate(&X.matrix, &y.vector, w);
+          if (status)
+            break;
+
+          rowidx += nr;
+        }
+
+      gsl_matrix_free(B);
+
+      return status;
+    }
+}
+
 int
 gsl_multilarge_linear_solve(const double lambda, gsl_vector * c,
                             double * rnorm, double * snorm,
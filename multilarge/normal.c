@@ -52,6 +52,7 @@ static void normal_free(void *vstate);
 static int normal_reset(void *vstate);
 static int normal_accumulate(gsl_matrix * A, gsl_vector * b,
                              void * vstate);
+static int normal_merge(const void * vsrc, void * vstate);
 static int normal_solve(const double lambda, gsl_vector * x,
                         double * rnorm, double * snorm,
                         void * vstate);
@@ -259,6 +260,42 @@ normal_accumulate(gsl_matrix * A, gsl_vector * b, void * vstate)
     }
 }
 
+/*
+normal_merge()
+  Add the normal equations of another workspace, accumulated
+from a disjoint set of rows, to this one
+
+Inputs: vsrc   - workspace to merge
+        vstate - workspace
+
+Return: success/error
+*/
+
+static int
+normal_merge(const void * vsrc, void * vstate)
+{
+  const normal_state_t *src = (const normal_state_t *) vsrc;
+  normal_state_t *state = (normal_state_t *) vstate;
+  size_t j;
+
+  /* ATA += ATA_src, lower half only */
+  for (j = 0; j < state->p; ++j)
+    {
+      gsl_vector_const_view a = gsl_matrix_const_subcolumn(src->ATA, j, j, state->p - j);
+      gsl_vector_view b = gsl_matrix_subcolumn(state->ATA, j, j, state->p - j);
+
+      gsl_vector_add(&b.vector, &a.vector);
+    }
+
+  /* ATb += ATb_src */
+  gsl_vector_add(state->ATb, src->ATb);
+
+  state->normb = gsl_hypot(state->normb, src->normb);
+  state->eigen = 0;
+
+  return GSL_SUCCESS;
+}
+
 /*
 normal_solve()
   Solve normal equations system:
@@ -503,6 +540,7 @@ static const gsl_multilarge_linear_type normal_type =
   normal_alloc,
   normal_reset,
   normal_accumulate,
+  normal_merge,
   normal_solve,
   normal_rcond,
   normal_lcurve,
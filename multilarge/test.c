@@ -484,6 +484,130 @@ test_random(const gsl_multilarge_linear_type * T,
   gsl_vector_free(c1);
 }
 
+/* test merging of workspaces and accumulation from a stream against
+ * accumulating all rows in one workspace */
+static void
+test_merge(const gsl_multilarge_linear_type * T,
+           const size_t n, const size_t p,
+           const double tol, const gsl_rng * r)
+{
+  const double lambda = 1.0e-2;
+  const size_t nw = 4;
+  gsl_matrix *X = gsl_matrix_alloc(n, p);
+  gsl_vector *y = gsl_vector_alloc(n);
+  gsl_matrix *Xy = gsl_matrix_alloc(n, p + 1);
+  gsl_vector *c0 = gsl_vector_alloc(p);
+  gsl_vector *c1 = gsl_vector_alloc(p);
+  gsl_multilarge_linear_workspace *w0 = gsl_multilarge_linear_alloc(T, p);
+  gsl_multilarge_linear_workspace *w[4];
+  gsl_multilarge_linear_workspace *wempty = gsl_multilarge_linear_alloc(T, p);
+  double rnorm0, snorm0, rnorm1, snorm1;
+  char str[2048];
+  size_t i;
+
+  test_random_matrix(X, r, -1.0, 1.0);
+  test_random_vector(y, r, -1.0, 1.0);
+
+  {
+    gsl_matrix_view Xv = gsl_matrix_submatrix(Xy, 0, 0, n, p);
+    gsl_vector_view yv = gsl_matrix_column(Xy, p);
+
+    gsl_matrix_memcpy(&Xv.matrix, X);
+    gsl_vector_memcpy(&yv.vector, y);
+  }
+
+  /* all rows in w0 */
+  {
+    gsl_matrix *Xs = gsl_matrix_alloc(n, p);
+    gsl_vector *ys = gsl_vector_alloc(n);
+
+    gsl_matrix_memcpy(Xs, X);
+    gsl_vector_memcpy(ys, y);
+    gsl_multilarge_linear_accumulate(Xs, ys, w0);
+    gsl_multilarge_linear_solve(lambda, c0, &rnorm0, &snorm0, w0);
+
+    gsl_matrix_free(Xs);
+    gsl_vector_free(ys);
+  }
+
+  /* disjoint, unequal row blocks in w[i], merged as a tree */
+  for (i = 0; i < nw; ++i)
+    {
+      const size_t i0 = (i * i * n) / (nw * nw);
+      const size_t i1 = ((i + 1) * (i + 1) * n) / (nw * nw);
+      gsl_matrix *Xs = gsl_matrix_alloc(i1 - i0, p);
+      gsl_vector *ys = gsl_vector_alloc(i1 - i0);
+      gsl_matrix_view Xv = gsl_matrix_submatrix(X, i0, 0, i1 - i0, p);
+      gsl_vector_view yv = gsl_vector_subvector(y, i0, i1 - i0);
+
+      w[i] = gsl_multilarge_linear_alloc(T, p);
+
+      gsl_matrix_memcpy(Xs, &Xv.matrix);
+      gsl_vector_memcpy(ys, &yv.vector);
+      gsl_multilarge_linear_accumulate(Xs, ys, w[i]);
+
+      gsl_matrix_free(Xs);
+      gsl_vector_free(ys);
+    }
+
+  gsl_multilarge_linear_merge(w[1], w[0]);
+  gsl_multilarge_linear_merge(w[3], w[2]);
+  gsl_multilarge_linear_merge(wempty, w[2]);
+  gsl_multilarge_linear_merge(w[2], w[0]);
+
+  gsl_multilarge_linear_solve(lambda, c1, &rnorm1, &snorm1, w[0]);
+
+  sprintf(str, "merge %s n=%zu p=%zu", T->name, n, p);
+  test_compare_vectors(tol, c0, c1, str);
+  gsl_test_rel(rnorm1, rnorm0, tol, "rnorm %s", str);
+  gsl_test_rel(snorm1, snorm0, tol, "snorm %s", str);
+
+  /* merge into an empty workspace */
+  gsl_multilarge_linear_merge(w[0], wempty);
+  gsl_multilarge_linear_solve(lambda, c1, &rnorm1, &snorm1, wempty);
+
+  sprintf(str, "merge empty %s n=%zu p=%zu", T->name, n, p);
+  test_compare_vectors(tol, c0, c1, str);
+  gsl_test_rel(rnorm1, rnorm0, tol, "rnorm %s", str);
+  gsl_test_rel(snorm1, snorm0, tol, "snorm %s", str);
+
+  /* rows read from a binary stream */
+  {
+    FILE *f = tmpfile();
+
+    if (f)
+      {
+        gsl_multilarge_linear_workspace *wf = gsl_multilarge_linear_alloc(T, p);
+
+        gsl_matrix_fwrite(f, Xy);
+        rewind(f);
+
+        gsl_test(gsl_multilarge_linear_accumulate_fread(f, n, 7, wf),
+                 "fread %s status", T->name);
+        gsl_multilarge_linear_solve(lambda, c1, &rnorm1, &snorm1, wf);
+
+        sprintf(str, "fread %s n=%zu p=%zu", T->name, n, p);
+        test_compare_vectors(tol, c0, c1, str);
+        gsl_test_rel(rnorm1, rnorm0, tol, "rnorm %s", str);
+        gsl_test_rel(snorm1, snorm0, tol, "snorm %s", str);
+
+        gsl_multilarge_linear_free(wf);
+        fclose(f);
+      }
+  }
+
+  for (i = 0; i < nw; ++i)
+    gsl_multilarge_linear_free(w[i]);
+
+  gsl_multilarge_linear_free(w0);
+  gsl_multilarge_linear_free(wempty);
+  gsl_matrix_free(X);
+  gsl_vector_free(y);
+  gsl_matrix_free(Xy);
+  gsl_vector_free(c0);
+  gsl_vector_free(c1);
+}
+
 int
 main (void)
 {
@@ -509,6 +633,10 @@ main (void)
       }
   }
 
+  test_merge(gsl_multilarge_linear_normal, 200, 10, 1.0e-10, r);
+  test_merge(gsl_multilarge_linear_tsqr, 200, 10, 1.0e-10, r);
+  test_merge(gsl_multilarge_linear_tsqr, 30, 20, 1.0e-10, r);
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary ());
@@ -46,6 +46,10 @@
  *
  * Step 2(a) is optimized to take advantage
  * of the sparse structure of the matrix
+ *
+ * Two workspaces accumulated from disjoint sets of rows are merged
+ * by applying step 2 with A_i = R and b_i = Q^T b of the second,
+ * so that separate workspaces may be combined by a reduction tree.
  */
 
 #include <config.h>
@@ -77,6 +81,7 @@ static void tsqr_free(void *vstate);
 static int tsqr_reset(void *vstate);
 static int tsqr_accumulate(gsl_matrix * A, gsl_vector * b,
                            void * vstate);
+static int tsqr_merge(const void * vsrc, void * vstate);
 static int tsqr_solve(const double lambda, gsl_vector * x,
                       double * rnorm, double * snorm,
                       void * vstate);
@@ -286,6 +291,66 @@ tsqr_accumulate(gsl_matrix * A, gsl_vector * b, void * vstate)
     }
 }
 
+/*
+tsqr_merge()
+  Merge the QR factorization of another workspace, accumulated
+from a disjoint set of rows, into this one
+
+Inputs: vsrc   - workspace to merge
+        vstate - workspace
+
+Return: success/error
+*/
+
+static int
+tsqr_merge(const void * vsrc, void * vstate)
+{
+  const tsqr_state_t *src = (const tsqr_state_t *) vsrc;
+  tsqr_state_t *state = (tsqr_state_t *) vstate;
+
+  if (src->init == 0)
+    {
+      /* nothing accumulated in src */
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t p = state->p;
+      const double normb = state->normb;
+      gsl_matrix *A = gsl_matrix_calloc(p, p);
+      gsl_vector *b = gsl_vector_alloc(p);
+      int status;
+
+      if (A == NULL || b == NULL)
+        {
+          if (A)
+            gsl_matrix_free(A);
+          if (b)
+            gsl_vector_free(b);
+
+          GSL_ERROR("failed to allocate space for merge", GSL_ENOMEM);
+        }
+
+      /* [ R ; R_src ] and [ Q^T b ; Q_src^T b_src ] */
+      gsl_matrix_tricpy('U', 1, A, src->R);
+      gsl_vector_memcpy(b, src->QTb);
+
+      status = tsqr_accumulate(A, b, state);
+
+      /* accumulate sets ||b|| from Q_src^T b_src, but the full ||b_src||
+       * is needed for the residual norm */
+      if (status == GSL_SUCCESS)
+        state->normb = gsl_hypot(normb, src->normb);
+
+      state->svd = 0;
+
+      gsl_matrix_free(A);
+      gsl_vector_free(b);
+
+      return status;
+    }
+}
+
 /*
 tsqr_solve()
   Solve the least squares system:
@@ -695,6 +760,7 @@ static const gsl_multilarge_linear_type tsqr_type =
   tsqr_alloc,
   tsqr_reset,
   tsqr_accumulate,
+  tsqr_merge,
   tsqr_solve,
   tsqr_rcond,
   tsqr_lcurve,
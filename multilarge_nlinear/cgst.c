@@ -201,12 +201,7 @@ cgst_step(const void * vtrust_state, const double delta,
   const gsl_multilarge_nlinear_trust_state *trust_state =
     (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
   cgst_state_t *state = (cgst_state_t *) vstate;
-  const gsl_vector * x = trust_state->x;
-  const gsl_vector * f = trust_state->f;
-  const gsl_vector * swts = trust_state->sqrt_wts;
   const gsl_vector * diag = trust_state->diag;
-  const gsl_multilarge_nlinear_parameters * params = trust_state->params;
-  gsl_multilarge_nlinear_fdf * fdf = trust_state->fdf;
   double alpha, beta, u;
   double norm_Jd;   /* || J D^{-1} d_i || */
   double norm_r;    /* || r_i || */
@@ -241,9 +236,8 @@ cgst_step(const void * vtrust_state, const double delta,
       gsl_vector_div(state->workp, trust_state->diag);
 
       /* workn := J D^{-1} d_i */
-      status = gsl_multilarge_nlinear_eval_df(CblasNoTrans, x, f, state->workp,
-                                              swts, params->h_df, params->fdtype,
-                                              fdf, state->workn, NULL, NULL);
+      status = jacobian_vector(CblasNoTrans, state->workp, state->workn,
+                               trust_state);
       if (status)
         return status;
 
@@ -290,9 +284,8 @@ cgst_step(const void * vtrust_state, const double delta,
 
       /* compute: workp := alpha B d_i = alpha D^{-1} J^T J D^{-1} d_i,
        * where J D^{-1} d_i is already stored in workn */
-      status = gsl_multilarge_nlinear_eval_df(CblasTrans, x, f, state->workn,
-                                              swts, params->h_df, params->fdtype,
-                                              fdf, state->workp, NULL, NULL);
+      status = jacobian_vector(CblasTrans, state->workn, state->workp,
+                               trust_state);
       if (status)
         return status;
 
@@ -17,12 +17,17 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <gsl/gsl_spblas.h>
+
 static double scaled_enorm (const gsl_vector * d, const gsl_vector * f);
 static void scaled_addition (const double alpha, const gsl_vector * x,
                              const double beta, const gsl_vector * y,
                              gsl_vector * z);
 static double quadratic_preduction(const gsl_multilarge_nlinear_trust_state * trust_state,
                                    const gsl_vector * dx, gsl_vector * work);
+static int jacobian_vector(const CBLAS_TRANSPOSE_t TransJ, const gsl_vector * u,
+                           gsl_vector * v,
+                           const gsl_multilarge_nlinear_trust_state * trust_state);
 
 /* compute || diag(d) f || */
 static double
@@ -109,13 +114,9 @@ quadratic_preduction(const gsl_multilarge_nlinear_trust_state * trust_state,
   else
     {
       int status;
-      const gsl_vector * x = trust_state->x;
-      const gsl_vector * swts = trust_state->sqrt_wts;
 
       /* compute work = J*dx */
-      status = gsl_multilarge_nlinear_eval_df(CblasNoTrans, x, f, dx,
-                                              swts, params->h_df, params->fdtype,
-                                              fdf, work, NULL, NULL);
+      status = jacobian_vector(CblasNoTrans, dx, work, trust_state);
       if (status)
         {
           GSL_ERROR_VAL("error computing preduction", status, 0.0);
@@ -129,3 +130,35 @@ quadratic_preduction(const gsl_multilarge_nlinear_trust_state * trust_state,
 
   return pred_reduction;
 }
+
+/*
+jacobian_vector()
+  Compute v = J u or v = J^T u, using the sparse Jacobian
+if one is available and the user callback otherwise
+
+Inputs: TransJ      - use J or J^T
+        u           - input vector
+        v           - (output) J u or J^T u
+        trust_state - trust state
+*/
+
+static int
+jacobian_vector(const CBLAS_TRANSPOSE_t TransJ, const gsl_vector * u,
+                gsl_vector * v,
+                const gsl_multilarge_nlinear_trust_state * trust_state)
+{
+  const gsl_multilarge_nlinear_parameters * params = trust_state->params;
+
+  if (trust_state->Jsp != NULL)
+    {
+      return gsl_spblas_dgemv(TransJ, 1.0, trust_state->Jsp, u, 0.0, v);
+    }
+  else
+    {
+      return gsl_multilarge_nlinear_eval_df(TransJ, trust_state->x,
+                                            trust_state->f, u,
+                                            trust_state->sqrt_wts,
+                                            params->h_df, params->fdtype,
+                                            trust_state->fdf, v, NULL, NULL);
+    }
+}
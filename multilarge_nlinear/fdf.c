@@ -51,12 +51,36 @@ gsl_multilarge_nlinear_alloc (const gsl_multilarge_nlinear_type * T,
   w->niter = 0;
   w->params = *params;
 
-  /* the cgst method uses its own built-in linear solver */
-  if (w->params.trs == gsl_multilarge_nlinear_trs_cgst)
+  /* the cgst and pcg methods use their own built-in linear solver */
+  if (w->params.trs == gsl_multilarge_nlinear_trs_cgst ||
+      w->params.trs == gsl_multilarge_nlinear_trs_pcg)
     {
       w->params.solver = gsl_multilarge_nlinear_solver_none;
     }
 
+  if (w->params.df_sparse != NULL)
+    {
+      /* the dogleg and subspace methods require a dense J^T J */
+      if (w->params.trs == gsl_multilarge_nlinear_trs_dogleg ||
+          w->params.trs == gsl_multilarge_nlinear_trs_ddogleg ||
+          w->params.trs == gsl_multilarge_nlinear_trs_subspace2D)
+        {
+          gsl_multilarge_nlinear_free (w);
+          GSL_ERROR_VAL ("sparse Jacobian requires the lm, lmaccel, cgst or pcg method",
+                         GSL_EINVAL, 0);
+        }
+
+      /* a sparse J^T J is factored with the sparse Cholesky solver */
+      if (w->params.solver == gsl_multilarge_nlinear_solver_cholesky)
+        w->params.solver = gsl_multilarge_nlinear_solver_spcholesky;
+    }
+  else if (w->params.solver == gsl_multilarge_nlinear_solver_spcholesky)
+    {
+      gsl_multilarge_nlinear_free (w);
+      GSL_ERROR_VAL ("sparse Cholesky solver requires a sparse Jacobian",
+                     GSL_EINVAL, 0);
+    }
+
   w->x = gsl_vector_calloc (p);
   if (w->x == 0) 
     {
@@ -85,7 +109,10 @@ gsl_multilarge_nlinear_alloc (const gsl_multilarge_nlinear_type * T,
       GSL_ERROR_VAL ("failed to allocate space for g", GSL_ENOMEM, 0);
     }
 
-  if (w->params.solver == gsl_multilarge_nlinear_solver_cholesky)
+  /* the pcg method builds its preconditioner from J^T J */
+  if (w->params.solver == gsl_multilarge_nlinear_solver_cholesky ||
+      (w->params.trs == gsl_multilarge_nlinear_trs_pcg &&
+       w->params.df_sparse == NULL))
     {
       w->JTJ = gsl_matrix_alloc (p, p);
       if (w->JTJ == 0) 
@@ -157,6 +184,8 @@ gsl_multilarge_nlinear_default_parameters(void)
   params.h_fvv = 0.01;
   params.max_iter = 0;
   params.tol = 1.0e-6;
+  params.block_size = 1;
+  params.df_sparse = NULL;
 
   return params;
 }
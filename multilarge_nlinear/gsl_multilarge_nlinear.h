@@ -27,6 +27,7 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_permutation.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -126,6 +127,9 @@ typedef struct
   double h_fvv;                                /* step size for finite difference fvv */
   size_t max_iter;                             /* maximum iterations for trs method */
   double tol;                                  /* tolerance for solving trs */
+  size_t block_size;                           /* block size for pcg preconditioner */
+  int (* df_sparse) (const gsl_vector * x, void * params,
+                     gsl_spmatrix * J);        /* sparse Jacobian J, or NULL */
 } gsl_multilarge_nlinear_parameters;
 
 typedef struct
@@ -160,6 +164,8 @@ typedef struct
   void *solver_state;               /* workspace for direct least squares solver */
   gsl_multilarge_nlinear_fdf * fdf;
   double *avratio;                  /* |a| / |v| */
+  const gsl_spmatrix * Jsp;         /* sparse Jacobian sqrt(W) J, or NULL */
+  const gsl_spmatrix * JTJsp;       /* sparse matrix J^T J, or NULL */
 } gsl_multilarge_nlinear_trust_state;
 
 typedef struct
@@ -298,6 +304,7 @@ GSL_VAR const gsl_multilarge_nlinear_trs * gsl_multilarge_nlinear_trs_dogleg;
 GSL_VAR const gsl_multilarge_nlinear_trs * gsl_multilarge_nlinear_trs_ddogleg;
 GSL_VAR const gsl_multilarge_nlinear_trs * gsl_multilarge_nlinear_trs_subspace2D;
 GSL_VAR const gsl_multilarge_nlinear_trs * gsl_multilarge_nlinear_trs_cgst;
+GSL_VAR const gsl_multilarge_nlinear_trs * gsl_multilarge_nlinear_trs_pcg;
 
 /* scaling matrix strategies */
 GSL_VAR const gsl_multilarge_nlinear_scale * gsl_multilarge_nlinear_scale_levenberg;
@@ -306,6 +313,7 @@ GSL_VAR const gsl_multilarge_nlinear_scale * gsl_multilarge_nlinear_scale_more;
 
 /* linear solvers */
 GSL_VAR const gsl_multilarge_nlinear_solver * gsl_multilarge_nlinear_solver_cholesky;
+GSL_VAR const gsl_multilarge_nlinear_solver * gsl_multilarge_nlinear_solver_spcholesky;
 GSL_VAR const gsl_multilarge_nlinear_solver * gsl_multilarge_nlinear_solver_none;
 
 __END_DECLS
@@ -264,17 +264,8 @@ lm_step(const void * vtrust_state, const double delta,
         return status;
 
       /* compute J^T fvv */
-      status = gsl_multilarge_nlinear_eval_df(CblasTrans,
-                                              trust_state->x,
-                                              trust_state->f,
-                                              state->fvv,
-                                              trust_state->sqrt_wts,
-                                              params->h_df,
-                                              params->fdtype,
-                                              trust_state->fdf,
-                                              state->JTfvv,
-                                              NULL,
-                                              state->workn);
+      status = jacobian_vector(CblasTrans, state->fvv, state->JTfvv,
+                               trust_state);
       if (status)
         return status;
 
@@ -320,11 +311,27 @@ lm_preduction(const void * vtrust_state, const gsl_vector * dx,
 
   (void)dx;
 
-  /* compute workp = J^T J p */
-  gsl_blas_dsymv(CblasLower, 1.0, trust_state->JTJ, p, 0.0, state->workp);
+  if (trust_state->JTJ != NULL)
+    {
+      /* compute workp = J^T J p */
+      gsl_blas_dsymv(CblasLower, 1.0, trust_state->JTJ, p, 0.0, state->workp);
+
+      /* compute u = p^T J^T J p = ||J p||^2 */
+      gsl_blas_ddot(state->workp, p, &u);
+    }
+  else
+    {
+      int status;
 
-  /* compute u = p^T J^T J p = ||J p||^2 */
-  gsl_blas_ddot(state->workp, p, &u);
+      /* compute workn = J p */
+      status = jacobian_vector(CblasNoTrans, p, state->workn, trust_state);
+      if (status)
+        return status;
+
+      /* compute u = ||J p||^2 */
+      u = gsl_blas_dnrm2(state->workn);
+      u *= u;
+    }
 
   /* compute u = ||J p||^2 / ||f||^2 */
   u /= normf * normf;
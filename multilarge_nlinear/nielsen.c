@@ -42,13 +42,14 @@
 
 #define LM_ONE_THIRD         (0.333333333333333)
 
-static int nielsen_init(const gsl_matrix * JTJ, const gsl_vector * diag,
+static int nielsen_init(const gsl_vector * JTJdiag, const gsl_vector * diag,
                         double * mu, long * nu);
 static int nielsen_accept(const double rho, double * mu, long * nu);
 static int nielsen_reject(double * mu, long * nu);
 
+/* JTJdiag is the diagonal of J^T J, or NULL if J^T J is not available */
 static int
-nielsen_init(const gsl_matrix * JTJ, const gsl_vector * diag,
+nielsen_init(const gsl_vector * JTJdiag, const gsl_vector * diag,
              double * mu, long * nu)
 {
   const double mu0 = 1.0e-3;
@@ -57,7 +58,7 @@ nielsen_init(const gsl_matrix * JTJ, const gsl_vector * diag,
 
   *nu = 2;
 
-  if (JTJ == NULL)
+  if (JTJdiag == NULL)
     {
       /* not using cholesky solver */
       *mu = mu0;
@@ -66,9 +67,9 @@ nielsen_init(const gsl_matrix * JTJ, const gsl_vector * diag,
 
   /* set mu = mu0 * max(diag(J~^T J~)), with J~ = J D^{-1} */
 
-  for (i = 0; i < JTJ->size1; ++i)
+  for (i = 0; i < JTJdiag->size; ++i)
     {
-      double JTJi = gsl_matrix_get(JTJ, i, i);
+      double JTJi = gsl_vector_get(JTJdiag, i);
       double di = gsl_vector_get(diag, i);
       double val = JTJi / (di * di);
       max = GSL_MAX(max, val);
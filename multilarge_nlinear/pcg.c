@@ -0,0 +1,528 @@
+/* multilarge_nlinear/pcg.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_multilarge_nlinear.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * This module contains a preconditioned version of the Steihaug-Toint
+ * conjugate gradient method (cgst.c),
+ *
+ * [1] T. Steihaug, The conjugate gradient method and trust regions
+ *     in large scale optimization, SIAM J. Num. Anal., 20(3) 1983.
+ *
+ * As in cgst.c, the Gauss-Newton system is solved in the scaled
+ * variables z = D dx,
+ *
+ * B z = -g~, B = D^{-1} J^T J D^{-1}, g~ = D^{-1} g
+ *
+ * with the block Jacobi preconditioner M = blockdiag(B), whose
+ * diagonal blocks of size params->block_size are taken from the
+ * dense or sparse J^T J and factored with Cholesky once per
+ * Jacobian. Each CG iteration then costs two Jacobian-vector
+ * products and one solve with M. The iteration stops when
+ * ||z|| reaches the trust region radius, when negative curvature
+ * is detected, or when the residual has been reduced by params->tol.
+ */
+
+typedef struct
+{
+  size_t n;                  /* number of observations */
+  size_t p;                  /* number of parameters */
+  size_t nblock;             /* block size of preconditioner */
+  gsl_matrix *M;             /* Cholesky factors of diagonal blocks, p-by-nblock */
+  gsl_vector *z;             /* Gauss-Newton step, size p */
+  gsl_vector *r;             /* residual, size p */
+  gsl_vector *y;             /* preconditioned residual M^{-1} r, size p */
+  gsl_vector *d;             /* search direction, size p */
+  gsl_vector *workp;         /* workspace, length p */
+  gsl_vector *workn;         /* workspace, length n */
+
+  double cgtol;              /* tolerance for CG solution */
+  size_t cgmaxit;            /* maximum CG iterations */
+} pcg_state_t;
+
+#include "common.c"
+
+static void * pcg_alloc (const void * params, const size_t n, const size_t p);
+static void pcg_free(void *vstate);
+static int pcg_init(const void *vtrust_state, void *vstate);
+static int pcg_preloop(const void * vtrust_state, void * vstate);
+static int pcg_step(const void * vtrust_state, const double delta,
+                    gsl_vector * dx, void * vstate);
+static int pcg_preduction(const void * vtrust_state, const gsl_vector * dx,
+                          double * pred, void * vstate);
+static void pcg_precond(const gsl_vector * r, gsl_vector * y, pcg_state_t * state);
+static double pcg_calc_tau(const gsl_vector * z, const gsl_vector * d,
+                           const double delta);
+
+static void *
+pcg_alloc (const void * params, const size_t n, const size_t p)
+{
+  const gsl_multilarge_nlinear_parameters *par = (const gsl_multilarge_nlinear_parameters *) params;
+  pcg_state_t *state;
+
+  state = calloc(1, sizeof(pcg_state_t));
+  if (state == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate pcg state", GSL_ENOMEM);
+    }
+
+  state->nblock = GSL_MIN(GSL_MAX(par->block_size, 1), p);
+
+  state->M = gsl_matrix_alloc(p, state->nblock);
+  if (state->M == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for M", GSL_ENOMEM);
+    }
+
+  state->z = gsl_vector_alloc(p);
+  if (state->z == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for z", GSL_ENOMEM);
+    }
+
+  state->r = gsl_vector_alloc(p);
+  if (state->r == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for r", GSL_ENOMEM);
+    }
+
+  state->y = gsl_vector_alloc(p);
+  if (state->y == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for y", GSL_ENOMEM);
+    }
+
+  state->d = gsl_vector_alloc(p);
+  if (state->d == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for d", GSL_ENOMEM);
+    }
+
+  state->workp = gsl_vector_alloc(p);
+  if (state->workp == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workp", GSL_ENOMEM);
+    }
+
+  state->workn = gsl_vector_alloc(n);
+  if (state->workn == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workn", GSL_ENOMEM);
+    }
+
+  state->n = n;
+  state->p = p;
+
+  state->cgmaxit = par->max_iter;
+  if (state->cgmaxit == 0)
+    state->cgmaxit = p;
+
+  state->cgtol = par->tol;
+
+  return state;
+}
+
+static void
+pcg_free(void *vstate)
+{
+  pcg_state_t *state = (pcg_state_t *) vstate;
+
+  if (state->M)
+    gsl_matrix_free(state->M);
+
+  if (state->z)
+    gsl_vector_free(state->z);
+
+  if (state->r)
+    gsl_vector_free(state->r);
+
+  if (state->y)
+    gsl_vector_free(state->y);
+
+  if (state->d)
+    gsl_vector_free(state->d);
+
+  if (state->workp)
+    gsl_vector_free(state->workp);
+
+  if (state->workn)
+    gsl_vector_free(state->workn);
+
+  free(state);
+}
+
+static int
+pcg_init(const void *vtrust_state, void *vstate)
+{
+  /* nothing to do */
+
+  (void)vtrust_state;
+  (void)vstate;
+
+  return GSL_SUCCESS;
+}
+
+/*
+pcg_preloop()
+  Form and factor the diagonal blocks of B = D^{-1} J^T J D^{-1}
+for the new Jacobian. Row i of M holds row i of the factor of
+the block containing i, in the columns 0..i-i0 where i0 is the
+first index of the block. A block which is not numerically
+positive definite is replaced by its diagonal.
+*/
+
+static int
+pcg_preloop(const void * vtrust_state, void * vstate)
+{
+  const gsl_multilarge_nlinear_trust_state *trust_state =
+    (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
+  pcg_state_t *state = (pcg_state_t *) vstate;
+  const gsl_vector *diag = trust_state->diag;
+  const size_t p = state->p;
+  const size_t nb = state->nblock;
+  gsl_matrix *M = state->M;
+  size_t i0;
+
+  gsl_matrix_set_zero(M);
+
+  /* lower triangle of the diagonal blocks of J^T J */
+  if (trust_state->JTJsp != NULL)
+    {
+      const gsl_spmatrix *A = trust_state->JTJsp;
+      size_t j, k;
+
+      for (j = 0; j < p; ++j)
+        {
+          const size_t j0 = (j / nb) * nb;
+
+          for (k = A->p[j]; k < A->p[j + 1]; ++k)
+            {
+              size_t i = A->i[k];
+
+              if (i >= j && i < j0 + nb)
+                gsl_matrix_set(M, i, j - j0, A->data[k]);
+            }
+        }
+    }
+  else if (trust_state->JTJ != NULL)
+    {
+      size_t i, j;
+
+      for (i = 0; i < p; ++i)
+        {
+          const size_t j0 = (i / nb) * nb;
+
+          for (j = j0; j <= i; ++j)
+            gsl_matrix_set(M, i, j - j0, gsl_matrix_get(trust_state->JTJ, i, j));
+        }
+    }
+  else
+    {
+      /* no J^T J available, use M = I */
+      gsl_matrix_set_all(M, 0.0);
+
+      for (i0 = 0; i0 < p; ++i0)
+        gsl_matrix_set(M, i0, i0 % nb, 1.0);
+
+      return GSL_SUCCESS;
+    }
+
+  for (i0 = 0; i0 < p; i0 += nb)
+    {
+      const size_t m = GSL_MIN(nb, p - i0);
+      gsl_matrix_view Mb = gsl_matrix_submatrix(M, i0, 0, m, m);
+      int posdef = 1;
+      size_t i, j;
+
+      /* scale: B_ij = (J^T J)_ij / (d_i d_j) */
+      for (i = 0; i < m; ++i)
+        {
+          double di = gsl_vector_get(diag, i0 + i);
+
+          for (j = 0; j <= i; ++j)
+            {
+              double dj = gsl_vector_get(diag, i0 + j);
+              double *Bij = gsl_matrix_ptr(&Mb.matrix, i, j);
+
+              *Bij /= di * dj;
+            }
+        }
+
+      /* Cholesky factorization of the lower triangle */
+      for (j = 0; j < m && posdef; ++j)
+        {
+          double ajj = gsl_matrix_get(&Mb.matrix, j, j);
+          size_t k;
+
+          for (k = 0; k < j; ++k)
+            {
+              double ljk = gsl_matrix_get(&Mb.matrix, j, k);
+              ajj -= ljk * ljk;
+            }
+
+          if (ajj <= 0.0)
+            {
+              posdef = 0;
+              break;
+            }
+
+          ajj = sqrt(ajj);
+          gsl_matrix_set(&Mb.matrix, j, j, ajj);
+
+          for (i = j + 1; i < m; ++i)
+            {
+              double aij = gsl_matrix_get(&Mb.matrix, i, j);
+
+              for (k = 0; k < j; ++k)
+                aij -= gsl_matrix_get(&Mb.matrix, i, k) * gsl_matrix_get(&Mb.matrix, j, k);
+
+              gsl_matrix_set(&Mb.matrix, i, j, aij / ajj);
+            }
+        }
+
+      if (!posdef)
+        {
+          /* Jacobi preconditioner for this block, from the
+           * original diagonal of B */
+          for (i = 0; i < m; ++i)
+            {
+              double di = gsl_vector_get(diag, i0 + i);
+              double Bii;
+
+              if (trust_state->JTJsp != NULL)
+                Bii = gsl_spmatrix_get(trust_state->JTJsp, i0 + i, i0 + i);
+              else
+                Bii = gsl_matrix_get(trust_state->JTJ, i0 + i, i0 + i);
+
+              Bii /= di * di;
+
+              for (j = 0; j < i; ++j)
+                gsl_matrix_set(&Mb.matrix, i, j, 0.0);
+
+              gsl_matrix_set(&Mb.matrix, i, i, (Bii > 0.0) ? sqrt(Bii) : 1.0);
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+pcg_step()
+  Calculate a new step vector
+
+Return:
+GSL_SUCCESS if CG solution found
+GSL_EMAXITER if no solution found
+*/
+
+static int
+pcg_step(const void * vtrust_state, const double delta,
+         gsl_vector * dx, void * vstate)
+{
+  int status;
+  const gsl_multilarge_nlinear_trust_state *trust_state =
+    (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
+  pcg_state_t *state = (pcg_state_t *) vstate;
+  const gsl_vector * diag = trust_state->diag;
+  double alpha, beta, u;
+  double norm_Jd;   /* || J D^{-1} d_i || */
+  double rTy;       /* r_i^T y_i */
+  double norm_r0;   /* || r_0 || */
+  size_t i;
+
+  /* z_0 = 0, r_0 = -g~ */
+  gsl_vector_set_zero(state->z);
+  gsl_vector_memcpy(state->r, trust_state->g);
+  gsl_vector_div(state->r, diag);
+  gsl_vector_scale(state->r, -1.0);
+
+  norm_r0 = gsl_blas_dnrm2(state->r);
+  if (norm_r0 == 0.0)
+    {
+      gsl_vector_set_zero(dx);
+      return GSL_SUCCESS;
+    }
+
+  /* y_0 = M^{-1} r_0, d_0 = y_0 */
+  pcg_precond(state->r, state->y, state);
+  gsl_vector_memcpy(state->d, state->y);
+  gsl_blas_ddot(state->r, state->y, &rTy);
+
+  for (i = 0; i < state->cgmaxit; ++i)
+    {
+      /* workp := D^{-1} d_i */
+      gsl_vector_memcpy(state->workp, state->d);
+      gsl_vector_div(state->workp, diag);
+
+      /* workn := J D^{-1} d_i */
+      status = jacobian_vector(CblasNoTrans, state->workp, state->workn,
+                               trust_state);
+      if (status)
+        return status;
+
+      /* compute || J D^{-1} d_i || */
+      norm_Jd = gsl_blas_dnrm2(state->workn);
+
+      if (norm_Jd == 0.0)
+        {
+          /* zero curvature, go to the boundary */
+          double tau = pcg_calc_tau(state->z, state->d, delta);
+
+          scaled_addition(1.0, state->z, tau, state->d, dx);
+          gsl_vector_div(dx, diag);
+
+          return GSL_SUCCESS;
+        }
+
+      alpha = rTy / (norm_Jd * norm_Jd);
+
+      /* workp := z_{i+1} = z_i + alpha*d_i */
+      scaled_addition(1.0, state->z, alpha, state->d, state->workp);
+
+      u = gsl_blas_dnrm2(state->workp);
+      if (u >= delta)
+        {
+          double tau = pcg_calc_tau(state->z, state->d, delta);
+
+          scaled_addition(1.0, state->z, tau, state->d, dx);
+          gsl_vector_div(dx, diag);
+
+          return GSL_SUCCESS;
+        }
+
+      gsl_vector_memcpy(state->z, state->workp);
+
+      /* workp := B d_i = D^{-1} J^T J D^{-1} d_i */
+      status = jacobian_vector(CblasTrans, state->workn, state->workp,
+                               trust_state);
+      if (status)
+        return status;
+
+      gsl_vector_div(state->workp, diag);
+
+      /* r_{i+1} = r_i - alpha*B*d_i */
+      gsl_blas_daxpy(-alpha, state->workp, state->r);
+
+      u = gsl_blas_dnrm2(state->r) / norm_r0;
+      if (u < state->cgtol)
+        {
+          gsl_vector_memcpy(dx, state->z);
+          gsl_vector_div(dx, diag);
+          return GSL_SUCCESS;
+        }
+
+      /* y_{i+1} = M^{-1} r_{i+1} */
+      pcg_precond(state->r, state->y, state);
+
+      u = rTy;
+      gsl_blas_ddot(state->r, state->y, &rTy);
+      beta = rTy / u;
+
+      /* d_{i+1} = y_{i+1} + beta*d_i */
+      scaled_addition(1.0, state->y, beta, state->d, state->d);
+    }
+
+  /* failed to converge, return current estimate */
+  gsl_vector_memcpy(dx, state->z);
+  gsl_vector_div(dx, diag);
+
+  return GSL_EMAXITER;
+}
+
+static int
+pcg_preduction(const void * vtrust_state, const gsl_vector * dx,
+               double * pred, void * vstate)
+{
+  const gsl_multilarge_nlinear_trust_state *trust_state =
+    (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
+  pcg_state_t *state = (pcg_state_t *) vstate;
+
+  *pred = quadratic_preduction(trust_state, dx, state->workn);
+
+  return GSL_SUCCESS;
+}
+
+/* y = M^{-1} r, with M = L L^T block diagonal */
+static void
+pcg_precond(const gsl_vector * r, gsl_vector * y, pcg_state_t * state)
+{
+  const size_t p = state->p;
+  const size_t nb = state->nblock;
+  size_t i0;
+
+  gsl_vector_memcpy(y, r);
+
+  for (i0 = 0; i0 < p; i0 += nb)
+    {
+      const size_t m = GSL_MIN(nb, p - i0);
+      gsl_matrix_const_view L = gsl_matrix_const_submatrix(state->M, i0, 0, m, m);
+      gsl_vector_view yb = gsl_vector_subvector(y, i0, m);
+
+      gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, &L.matrix, &yb.vector);
+      gsl_blas_dtrsv(CblasLower, CblasTrans, CblasNonUnit, &L.matrix, &yb.vector);
+    }
+}
+
+/*
+pcg_calc_tau()
+  Compute tau > 0 such that:
+
+|| z + tau*d || = delta
+*/
+
+static double
+pcg_calc_tau(const gsl_vector * z, const gsl_vector * d,
+             const double delta)
+{
+  double norm_z, norm_d, u;
+  double t1, t2, tau;
+
+  norm_z = gsl_blas_dnrm2(z);
+  norm_d = gsl_blas_dnrm2(d);
+
+  /* compute (z, d) */
+  gsl_blas_ddot(z, d, &u);
+
+  t1 = u / (norm_d * norm_d);
+  t2 = t1*u + (delta + norm_z) * (delta - norm_z);
+  tau = -t1 + sqrt(t2) / norm_d;
+
+  return tau;
+}
+
+static const gsl_multilarge_nlinear_trs pcg_type =
+{
+  "pcg-steihaug",
+  pcg_alloc,
+  pcg_init,
+  pcg_preloop,
+  pcg_step,
+  pcg_preduction,
+  pcg_free
+};
+
+const gsl_multilarge_nlinear_trs *gsl_multilarge_nlinear_trs_pcg = &pcg_type;
@@ -0,0 +1,758 @@
+/* multilarge_nlinear/spcholesky.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This module calculates the solution of the normal equations least squares
+ * system:
+ *
+ * [ J^T J + mu D^T D ] p = -J^T f
+ *
+ * when J^T J is stored as a sparse matrix, using a sparse Cholesky
+ * decomposition P (J^T J + mu D^T D) P^T = L L^T. The algorithm is the
+ * up-looking method of
+ *
+ * [1] T. A. Davis, Direct Methods for Sparse Linear Systems, SIAM, 2006,
+ *     sections 4.1 - 4.7.
+ *
+ * The symbolic analysis (ordering, elimination tree and column counts
+ * of L) is computed only when the sparsity pattern of J^T J differs
+ * from the one seen by the previous analysis, and the numerical
+ * factorization for each new value of mu. The permutation P is a
+ * static ordering of the parameters by increasing degree in the graph
+ * of J^T J; unlike a true minimum degree ordering the degrees are not
+ * updated as parameters are eliminated. This is enough, for example,
+ * to eliminate the point parameters before the camera parameters in
+ * bundle adjustment problems.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_multilarge_nlinear.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+
+typedef struct
+{
+  size_t p;                  /* number of parameters */
+  const gsl_spmatrix *JTJ;   /* J^T J in CCS, owned by the trust state */
+  size_t *Ap;                /* column pointers of the analyzed pattern, size p+1 */
+  size_t *Ai;                /* row indices of the analyzed pattern, size Anzmax */
+  size_t Anzmax;
+  int analyzed;              /* Ap, Ai hold the pattern of the analysis */
+  size_t *perm;              /* row k of P A P^T is row perm[k] of A, size p */
+  size_t *pinv;              /* inverse permutation, size p */
+  size_t *parent;            /* elimination tree, size p */
+  size_t *Cp;                /* upper triangle of P A P^T in CCS, size p+1 */
+  size_t *Ci;                /* row indices of C, size Cnzmax */
+  size_t *Cmap;              /* C entry k is JTJ->data[Cmap[k]], size Cnzmax */
+  size_t Cnzmax;
+  size_t *Lp;                /* Cholesky factor L in CCS, size p+1 */
+  size_t *Li;                /* row indices of L, size Lnzmax */
+  double *Lx;                /* entries of L, size Lnzmax */
+  size_t Lnzmax;
+  size_t *next;              /* next free slot in each column of L, size p */
+  size_t *stack;             /* nonzero pattern of a row of L, size p */
+  size_t *mark;              /* workspace, size p */
+  double *x;                 /* workspace, size p */
+  gsl_vector *workp;         /* workspace, size p */
+  gsl_vector *work3p;        /* workspace, size 3*p */
+  int factored;              /* L holds a valid factorization */
+} spcholesky_state_t;
+
+static void *spcholesky_alloc (const size_t n, const size_t p);
+static void spcholesky_free(void *vstate);
+static int spcholesky_init(const void * vtrust_state, void * vstate);
+static int spcholesky_presolve(const double mu, const void * vtrust_state, void * vstate);
+static int spcholesky_solve(const gsl_vector * g, gsl_vector *x,
+                            const void * vtrust_state, void *vstate);
+static int spcholesky_rcond(double * rcond, const gsl_matrix * JTJ, void * vstate);
+static int spcholesky_covar(const gsl_matrix * JTJ, gsl_matrix * covar, void * vstate);
+static int spcholesky_symbolic(spcholesky_state_t * state);
+static int spcholesky_analyze(spcholesky_state_t * state);
+static int spcholesky_factor(const double mu, const gsl_vector * diag,
+                             spcholesky_state_t * state);
+static size_t spcholesky_ereach(const size_t k, spcholesky_state_t * state);
+static void spcholesky_solve_rhs(gsl_vector * b, spcholesky_state_t * state);
+static int spcholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
+
+static void *
+spcholesky_alloc (const size_t n, const size_t p)
+{
+  spcholesky_state_t *state;
+
+  (void) n;
+
+  state = calloc(1, sizeof(spcholesky_state_t));
+  if (state == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate spcholesky state", GSL_ENOMEM);
+    }
+
+  state->Ap = malloc((p + 1) * sizeof(size_t));
+  state->perm = malloc(p * sizeof(size_t));
+  state->pinv = malloc(p * sizeof(size_t));
+  state->parent = malloc(p * sizeof(size_t));
+  state->Cp = malloc((p + 1) * sizeof(size_t));
+  state->Lp = malloc((p + 1) * sizeof(size_t));
+  state->next = malloc(p * sizeof(size_t));
+  state->stack = malloc(p * sizeof(size_t));
+  state->mark = malloc(p * sizeof(size_t));
+  state->x = malloc(p * sizeof(double));
+
+  if (state->Ap == NULL || state->perm == NULL || state->pinv == NULL || state->parent == NULL ||
+      state->Cp == NULL || state->Lp == NULL || state->next == NULL ||
+      state->stack == NULL || state->mark == NULL || state->x == NULL)
+    {
+      spcholesky_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for spcholesky workspace",
+                      GSL_ENOMEM);
+    }
+
+  state->workp = gsl_vector_alloc(p);
+  if (state->workp == NULL)
+    {
+      spcholesky_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for workp", GSL_ENOMEM);
+    }
+
+  state->work3p = gsl_vector_alloc(3 * p);
+  if (state->work3p == NULL)
+    {
+      spcholesky_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for work3p", GSL_ENOMEM);
+    }
+
+  state->p = p;
+
+  return state;
+}
+
+static void
+spcholesky_free(void *vstate)
+{
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+
+  free(state->Ap);
+  free(state->Ai);
+  free(state->perm);
+  free(state->pinv);
+  free(state->parent);
+  free(state->Cp);
+  free(state->Ci);
+  free(state->Cmap);
+  free(state->Lp);
+  free(state->Li);
+  free(state->Lx);
+  free(state->next);
+  free(state->stack);
+  free(state->mark);
+  free(state->x);
+
+  if (state->workp)
+    gsl_vector_free(state->workp);
+
+  if (state->work3p)
+    gsl_vector_free(state->work3p);
+
+  free(state);
+}
+
+/* store the sparse J^T J and update its symbolic factorization */
+static int
+spcholesky_init(const void * vtrust_state, void * vstate)
+{
+  const gsl_multilarge_nlinear_trust_state *trust_state =
+    (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+
+  if (trust_state->JTJsp == NULL)
+    {
+      GSL_ERROR ("sparse Cholesky solver requires a sparse Jacobian",
+                 GSL_EINVAL);
+    }
+
+  state->JTJ = trust_state->JTJsp;
+
+  return spcholesky_symbolic(state);
+}
+
+/*
+spcholesky_presolve()
+  Compute the sparse Cholesky decomposition of J^T J + mu D^T D.
+If the matrix is not positive definite, GSL_EDOM is returned
+without calling the error handler, so that the trust region
+method can reject the step and increase mu.
+*/
+
+static int
+spcholesky_presolve(const double mu, const void * vtrust_state, void * vstate)
+{
+  const gsl_multilarge_nlinear_trust_state *trust_state =
+    (const gsl_multilarge_nlinear_trust_state *) vtrust_state;
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+
+  return spcholesky_factor(mu, trust_state->diag, state);
+}
+
+/*
+spcholesky_solve()
+  Compute (J^T J + mu D^T D) x = -g
+
+where g = J^T f
+*/
+
+static int
+spcholesky_solve(const gsl_vector * g, gsl_vector *x,
+                 const void * vtrust_state, void *vstate)
+{
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+
+  (void) vtrust_state;
+
+  if (!state->factored)
+    {
+      GSL_ERROR ("matrix has not been factored", GSL_EFAILED);
+    }
+
+  gsl_vector_memcpy(x, g);
+  spcholesky_solve_rhs(x, state);
+
+  /* reverse direction to go downhill */
+  gsl_vector_scale(x, -1.0);
+
+  return GSL_SUCCESS;
+}
+
+static int
+spcholesky_rcond(double * rcond, const gsl_matrix * JTJ, void * vstate)
+{
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+  const gsl_spmatrix *A = state->JTJ;
+  double Anorm = 0.0, Ainvnorm;
+  size_t j, k;
+  int status;
+
+  (void) JTJ;
+
+  *rcond = 0.0;
+
+  if (A == NULL)
+    {
+      GSL_ERROR ("sparse Cholesky solver requires a sparse Jacobian",
+                 GSL_EINVAL);
+    }
+
+  /* the current factorization may be from the previous iteration, with
+   * mu > 0, so factor J^T J again */
+  status = spcholesky_symbolic(state);
+  if (status)
+    return status;
+
+  status = spcholesky_factor(0.0, NULL, state);
+  if (status == GSL_EDOM)
+    return GSL_SUCCESS; /* J^T J is singular */
+  else if (status)
+    return status;
+
+  /* ||J^T J||_1 */
+  for (j = 0; j < A->size2; ++j)
+    {
+      double sum = 0.0;
+
+      for (k = A->p[j]; k < A->p[j + 1]; ++k)
+        sum += fabs(A->data[k]);
+
+      Anorm = GSL_MAX(Anorm, sum);
+    }
+
+  if (Anorm == 0.0)
+    return GSL_SUCCESS;
+
+  status = gsl_linalg_invnorm1(state->p, spcholesky_Ainv, state,
+                               &Ainvnorm, state->work3p);
+  if (status)
+    return status;
+
+  if (Ainvnorm != 0.0)
+    *rcond = sqrt((1.0 / Anorm) / Ainvnorm);
+
+  return GSL_SUCCESS;
+}
+
+static int
+spcholesky_covar(const gsl_matrix * JTJ, gsl_matrix * covar, void * vstate)
+{
+  spcholesky_state_t *state = (spcholesky_state_t *) vstate;
+  size_t j;
+  int status;
+
+  (void) JTJ;
+
+  if (state->JTJ == NULL)
+    {
+      GSL_ERROR ("sparse Cholesky solver requires a sparse Jacobian",
+                 GSL_EINVAL);
+    }
+
+  status = spcholesky_symbolic(state);
+  if (status)
+    return status;
+
+  status = spcholesky_factor(0.0, NULL, state);
+  if (status)
+    {
+      GSL_ERROR ("J^T J is singular", status);
+    }
+
+  /* column j of (J^T J)^{-1} */
+  for (j = 0; j < state->p; ++j)
+    {
+      gsl_vector_view c = gsl_matrix_column(covar, j);
+
+      gsl_vector_set_basis(&c.vector, j);
+      spcholesky_solve_rhs(&c.vector, state);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+spcholesky_symbolic()
+  Compute the symbolic factorization of A = J^T J, unless the
+sparsity pattern of A is the same as in the previous analysis.
+The entries of C are addressed through offsets into A->data, so
+they remain valid as long as the pattern is unchanged.
+*/
+
+static int
+spcholesky_symbolic(spcholesky_state_t * state)
+{
+  const gsl_spmatrix *A = state->JTJ;
+  const size_t p = state->p;
+  const size_t nz = A->p[p];
+  int status;
+
+  state->factored = 0;
+
+  if (state->analyzed &&
+      memcmp(state->Ap, A->p, (p + 1) * sizeof(size_t)) == 0 &&
+      (nz == 0 || memcmp(state->Ai, A->i, nz * sizeof(size_t)) == 0))
+    return GSL_SUCCESS;
+
+  state->analyzed = 0;
+
+  status = spcholesky_analyze(state);
+  if (status)
+    return status;
+
+  if (nz > state->Anzmax)
+    {
+      void *ptr = realloc(state->Ai, nz * sizeof(size_t));
+
+      if (ptr == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for pattern", GSL_ENOMEM);
+        }
+
+      state->Ai = ptr;
+      state->Anzmax = nz;
+    }
+
+  memcpy(state->Ap, A->p, (p + 1) * sizeof(size_t));
+  if (nz > 0)
+    memcpy(state->Ai, A->i, nz * sizeof(size_t));
+  state->analyzed = 1;
+
+  return GSL_SUCCESS;
+}
+
+/*
+spcholesky_analyze()
+  Symbolic factorization of A = J^T J:
+
+1. order the parameters by increasing degree in the graph of A
+   (a one-time sort by initial degree, not minimum degree)
+2. store the upper triangle of C = P A P^T
+3. compute the elimination tree of C
+4. compute the column counts of L, from the nonzero pattern
+   of each row of L, and allocate L
+*/
+
+static int
+spcholesky_analyze(spcholesky_state_t * state)
+{
+  const gsl_spmatrix *A = state->JTJ;
+  const size_t p = state->p;
+  size_t *deg = state->next;
+  size_t *count = state->mark;
+  size_t *Cp = state->Cp;
+  size_t *Lp = state->Lp;
+  size_t *ancestor = state->stack;
+  size_t j, k, nz;
+
+  state->factored = 0;
+
+  /* degree of each parameter, counting sort by degree */
+  for (j = 0; j <= p; ++j)
+    Cp[j] = 0;
+
+  for (j = 0; j < p; ++j)
+    {
+      deg[j] = 0;
+
+      for (k = A->p[j]; k < A->p[j + 1]; ++k)
+        {
+          if (A->i[k] != j)
+            deg[j]++;
+        }
+
+      Cp[deg[j]]++;
+    }
+
+  gsl_spmatrix_cumsum(p, Cp);
+
+  for (j = 0; j < p; ++j)
+    {
+      size_t idx = Cp[deg[j]]++;
+      state->perm[idx] = j;
+      state->pinv[j] = idx;
+    }
+
+  /* C = upper triangle of P A P^T in CCS */
+  for (j = 0; j <= p; ++j)
+    Cp[j] = 0;
+
+  for (j = 0; j < p; ++j)
+    {
+      const size_t j2 = state->pinv[j];
+
+      for (k = A->p[j]; k < A->p[j + 1]; ++k)
+        {
+          if (state->pinv[A->i[k]] <= j2)
+            Cp[j2]++;
+        }
+    }
+
+  gsl_spmatrix_cumsum(p, Cp);
+  nz = Cp[p];
+
+  if (nz > state->Cnzmax)
+    {
+      void *ptr;
+
+      ptr = realloc(state->Ci, nz * sizeof(size_t));
+      if (ptr == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for C", GSL_ENOMEM);
+        }
+      state->Ci = ptr;
+
+      ptr = realloc(state->Cmap, nz * sizeof(size_t));
+      if (ptr == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for C", GSL_ENOMEM);
+        }
+      state->Cmap = ptr;
+
+      state->Cnzmax = nz;
+    }
+
+  for (j = 0; j < p; ++j)
+    count[j] = Cp[j];
+
+  for (j = 0; j < p; ++j)
+    {
+      const size_t j2 = state->pinv[j];
+
+      for (k = A->p[j]; k < A->p[j + 1]; ++k)
+        {
+          const size_t i2 = state->pinv[A->i[k]];
+
+          if (i2 <= j2)
+            {
+              size_t idx = count[j2]++;
+              state->Ci[idx] = i2;
+              state->Cmap[idx] = k;
+            }
+        }
+    }
+
+  /* elimination tree of C, algorithm 4.1 of [1], using p as the
+   * null node */
+  for (k = 0; k < p; ++k)
+    {
+      state->parent[k] = p;
+      ancestor[k] = p;
+
+      for (j = Cp[k]; j < Cp[k + 1]; ++j)
+        {
+          size_t i = state->Ci[j];
+
+          while (i != p && i < k)
+            {
+              size_t inext = ancestor[i];
+
+              ancestor[i] = k;
+
+              if (inext == p)
+                state->parent[i] = k;
+
+              i = inext;
+            }
+        }
+    }
+
+  /* column counts of L: each row k of L has a nonzero in the
+   * columns given by the row subtree of k */
+  for (j = 0; j < p; ++j)
+    {
+      Lp[j] = 1; /* diagonal element */
+      state->mark[j] = p;
+    }
+
+  for (k = 0; k < p; ++k)
+    {
+      size_t top = spcholesky_ereach(k, state);
+
+      for (; top < p; ++top)
+        Lp[state->stack[top]]++;
+    }
+
+  gsl_spmatrix_cumsum(p, Lp);
+  nz = Lp[p];
+
+  if (nz > state->Lnzmax)
+    {
+      void *ptr;
+
+      ptr = realloc(state->Li, nz * sizeof(size_t));
+      if (ptr == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for L", GSL_ENOMEM);
+        }
+      state->Li = ptr;
+
+      ptr = realloc(state->Lx, nz * sizeof(double));
+      if (ptr == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for L", GSL_ENOMEM);
+        }
+      state->Lx = ptr;
+
+      state->Lnzmax = nz;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+spcholesky_factor()
+  Numerical factorization P (A + mu D^T D) P^T = L L^T, by
+the up-looking algorithm 4.2 of [1]
+
+Inputs: mu    - LM parameter
+        diag  - scaling matrix D, or NULL if mu = 0
+        state - workspace, with symbolic factorization
+
+Return: GSL_SUCCESS, or GSL_EDOM if the matrix is not positive definite
+*/
+
+static int
+spcholesky_factor(const double mu, const gsl_vector * diag,
+                  spcholesky_state_t * state)
+{
+  const size_t p = state->p;
+  const double *Ad = state->JTJ->data;
+  const size_t *Lp = state->Lp;
+  size_t *Li = state->Li;
+  double *Lx = state->Lx;
+  double *x = state->x;
+  size_t j, k;
+
+  state->factored = 0;
+
+  for (j = 0; j < p; ++j)
+    {
+      state->next[j] = Lp[j];
+      state->mark[j] = p;
+      x[j] = 0.0;
+    }
+
+  for (k = 0; k < p; ++k)
+    {
+      size_t top = spcholesky_ereach(k, state);
+      double d;
+
+      /* x = C(0:k,k) + mu D_k^2 e_k */
+      for (j = state->Cp[k]; j < state->Cp[k + 1]; ++j)
+        x[state->Ci[j]] += Ad[state->Cmap[j]];
+
+      if (mu != 0.0)
+        {
+          double dk = gsl_vector_get(diag, state->perm[k]);
+          x[k] += mu * dk * dk;
+        }
+
+      d = x[k];
+      x[k] = 0.0;
+
+      /* solve L(0:k-1,0:k-1) y = x for the nonzero pattern of row k */
+      for (; top < p; ++top)
+        {
+          size_t i = state->stack[top];
+          double lki = x[i] / Lx[Lp[i]];
+          size_t q;
+
+          x[i] = 0.0;
+
+          for (q = Lp[i] + 1; q < state->next[i]; ++q)
+            x[Li[q]] -= Lx[q] * lki;
+
+          d -= lki * lki;
+
+          q = state->next[i]++;
+          Li[q] = k;
+          Lx[q] = lki;
+        }
+
+      if (d <= 0.0)
+        return GSL_EDOM;
+
+      j = state->next[k]++;
+      Li[j] = k;
+      Lx[j] = sqrt(d);
+    }
+
+  state->factored = 1;
+
+  return GSL_SUCCESS;
+}
+
+/*
+spcholesky_ereach()
+  Compute the nonzero pattern of row k of L, which is the set of
+nodes reachable in the elimination tree from the nonzeros in
+column k of C. The pattern is stored in stack[top..p-1] in
+topological order, and top is returned. Nodes are marked by
+setting mark[i] = k, so mark must be initialized to p.
+*/
+
+static size_t
+spcholesky_ereach(const size_t k, spcholesky_state_t * state)
+{
+  const size_t p = state->p;
+  size_t *stack = state->stack;
+  size_t *mark = state->mark;
+  size_t top = p;
+  size_t j;
+
+  mark[k] = k;
+
+  for (j = state->Cp[k]; j < state->Cp[k + 1]; ++j)
+    {
+      size_t i = state->Ci[j];
+      size_t len = 0;
+
+      if (i > k)
+        continue;
+
+      /* traverse up the elimination tree until reaching a marked node */
+      while (mark[i] != k)
+        {
+          stack[len++] = i;
+          mark[i] = k;
+          i = state->parent[i];
+        }
+
+      /* push the path onto the stack */
+      while (len > 0)
+        stack[--top] = stack[--len];
+    }
+
+  return top;
+}
+
+/* solve (A + mu D^T D) x = b in place using the factorization */
+static void
+spcholesky_solve_rhs(gsl_vector * b, spcholesky_state_t * state)
+{
+  const size_t p = state->p;
+  const size_t *Lp = state->Lp;
+  const size_t *Li = state->Li;
+  const double *Lx = state->Lx;
+  double *y = state->x;
+  size_t j, k;
+
+  /* y = P b */
+  for (k = 0; k < p; ++k)
+    y[k] = gsl_vector_get(b, state->perm[k]);
+
+  /* y = L^{-1} y */
+  for (j = 0; j < p; ++j)
+    {
+      y[j] /= Lx[Lp[j]];
+
+      for (k = Lp[j] + 1; k < Lp[j + 1]; ++k)
+        y[Li[k]] -= Lx[k] * y[j];
+    }
+
+  /* y = L^{-T} y */
+  for (j = p; j-- > 0; )
+    {
+      for (k = Lp[j] + 1; k < Lp[j + 1]; ++k)
+        y[j] -= Lx[k] * y[Li[k]];
+
+      y[j] /= Lx[Lp[j]];
+    }
+
+  /* b = P^T y */
+  for (k = 0; k < p; ++k)
+    gsl_vector_set(b, state->perm[k], y[k]);
+}
+
+/* x := A^{-1} x, for gsl_linalg_invnorm1; A is symmetric */
+static int
+spcholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params)
+{
+  spcholesky_state_t *state = (spcholesky_state_t *) params;
+
+  (void) TransA;
+
+  spcholesky_solve_rhs(x, state);
+
+  return GSL_SUCCESS;
+}
+
+static const gsl_multilarge_nlinear_solver spcholesky_type =
+{
+  "spcholesky",
+  spcholesky_alloc,
+  spcholesky_init,
+  spcholesky_presolve,
+  spcholesky_solve,
+  spcholesky_rcond,
+  spcholesky_covar,
+  spcholesky_free
+};
+
+const gsl_multilarge_nlinear_solver *gsl_multilarge_nlinear_solver_spcholesky = &spcholesky_type;
@@ -0,0 +1,271 @@
+/* multilarge_nlinear/spjac.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This module handles a sparse Jacobian supplied through the
+ * df_sparse parameter. The user fills J in triplet format, and
+ * the weighted Jacobian J~ = sqrt(W) J, its transpose, the gradient
+ * g = J~^T f and the normal equations matrix J~^T J~ are then formed
+ * in compressed column storage, so that the memory required is
+ * proportional to the number of nonzero elements rather than p^2.
+ */
+
+typedef struct
+{
+  gsl_spmatrix *J;           /* user Jacobian, triplet format, n-by-p */
+  gsl_spmatrix *Jc;          /* sqrt(W) J in CCS, n-by-p */
+  gsl_spmatrix *JT;          /* (sqrt(W) J)^T in CCS, p-by-n */
+  gsl_spmatrix *JTJ;         /* J^T J in CCS, p-by-p */
+  gsl_vector *JTJdiag;       /* diag(J^T J), size p */
+} spjac_state_t;
+
+static void spjac_free(spjac_state_t *state);
+
+static spjac_state_t *
+spjac_alloc(const size_t n, const size_t p)
+{
+  spjac_state_t *state;
+
+  state = calloc(1, sizeof(spjac_state_t));
+  if (state == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate sparse Jacobian state", GSL_ENOMEM);
+    }
+
+  state->J = gsl_spmatrix_alloc(n, p);
+  if (state->J == NULL)
+    {
+      spjac_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for J", GSL_ENOMEM);
+    }
+
+  state->Jc = gsl_spmatrix_alloc_nzmax(n, p, 1, GSL_SPMATRIX_CCS);
+  if (state->Jc == NULL)
+    {
+      spjac_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for Jc", GSL_ENOMEM);
+    }
+
+  state->JT = gsl_spmatrix_alloc_nzmax(p, n, 1, GSL_SPMATRIX_CCS);
+  if (state->JT == NULL)
+    {
+      spjac_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for JT", GSL_ENOMEM);
+    }
+
+  state->JTJ = gsl_spmatrix_alloc_nzmax(p, p, 1, GSL_SPMATRIX_CCS);
+  if (state->JTJ == NULL)
+    {
+      spjac_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for JTJ", GSL_ENOMEM);
+    }
+
+  state->JTJdiag = gsl_vector_alloc(p);
+  if (state->JTJdiag == NULL)
+    {
+      spjac_free(state);
+      GSL_ERROR_NULL ("failed to allocate space for JTJdiag", GSL_ENOMEM);
+    }
+
+  return state;
+}
+
+static void
+spjac_free(spjac_state_t *state)
+{
+  if (state->J)
+    gsl_spmatrix_free(state->J);
+
+  if (state->Jc)
+    gsl_spmatrix_free(state->Jc);
+
+  if (state->JT)
+    gsl_spmatrix_free(state->JT);
+
+  if (state->JTJ)
+    gsl_spmatrix_free(state->JTJ);
+
+  if (state->JTJdiag)
+    gsl_vector_free(state->JTJdiag);
+
+  free(state);
+}
+
+/*
+spjac_compress()
+  Convert the triplet matrix T to compressed column storage
+in the existing matrix C, scaling row i by swts_i
+
+Inputs: T     - n-by-p triplet matrix
+        swts  - row scale factors, or NULL
+        trans - 0: C = diag(swts) T, C is n-by-p
+                1: C = T^T diag(swts), C is p-by-n
+        C     - (output) matrix in CCS
+*/
+
+static int
+spjac_compress(const gsl_spmatrix *T, const gsl_vector *swts,
+               const int trans, gsl_spmatrix *C)
+{
+  const size_t *Tj = trans ? T->i : T->p; /* column indices in C */
+  const size_t *Ti = trans ? T->p : T->i; /* row indices in C */
+  size_t *Cp, *w;
+  size_t k;
+
+  if (C->nzmax < T->nz)
+    {
+      int status = gsl_spmatrix_realloc(T->nz, C);
+      if (status)
+        return status;
+    }
+
+  Cp = C->p;
+  w = C->work_sze;
+
+  for (k = 0; k <= C->size2; ++k)
+    Cp[k] = 0;
+
+  for (k = 0; k < T->nz; ++k)
+    Cp[Tj[k]]++;
+
+  gsl_spmatrix_cumsum(C->size2, Cp);
+
+  for (k = 0; k < C->size2; ++k)
+    w[k] = Cp[k];
+
+  for (k = 0; k < T->nz; ++k)
+    {
+      size_t idx = w[Tj[k]]++;
+      double Tk = T->data[k];
+
+      if (swts)
+        Tk *= gsl_vector_get(swts, T->i[k]);
+
+      C->i[idx] = Ti[k];
+      C->data[idx] = Tk;
+    }
+
+  C->nz = T->nz;
+
+  return GSL_SUCCESS;
+}
+
+/*
+spjac_eval()
+  Evaluate the sparse Jacobian at x with the user callback
+and form g = J^T f and J^T J
+
+Inputs: x      - parameter vector
+        f      - weighted residual vector f(x)
+        swts   - sqrt(W) vector, or NULL
+        fdf    - user callback functions
+        params - parameters, with df_sparse set
+        g      - (output) J^T f
+        state  - workspace
+*/
+
+static int
+spjac_eval(const gsl_vector *x, const gsl_vector *f,
+           const gsl_vector *swts, gsl_multilarge_nlinear_fdf *fdf,
+           const gsl_multilarge_nlinear_parameters *params,
+           gsl_vector *g, spjac_state_t *state)
+{
+  const gsl_spmatrix *JTJ = state->JTJ;
+  int status;
+  size_t j, k;
+
+  gsl_spmatrix_set_zero(state->J);
+
+  status = (params->df_sparse)(x, fdf->params, state->J);
+  ++(fdf->nevaldf2);
+  if (status)
+    return status;
+
+  if (!GSL_SPMATRIX_ISTRIPLET(state->J))
+    {
+      GSL_ERROR ("sparse Jacobian must be in triplet format", GSL_EINVAL);
+    }
+
+  status = spjac_compress(state->J, swts, 0, state->Jc);
+  if (status)
+    return status;
+
+  status = spjac_compress(state->J, swts, 1, state->JT);
+  if (status)
+    return status;
+
+  /* g = J^T f */
+  status = gsl_spblas_dgemv(CblasTrans, 1.0, state->Jc, f, 0.0, g);
+  if (status)
+    return status;
+
+  /* J^T J */
+  status = gsl_spblas_dgemm(1.0, state->JT, state->Jc, state->JTJ);
+  if (status)
+    return status;
+
+  gsl_vector_set_zero(state->JTJdiag);
+
+  for (j = 0; j < JTJ->size2; ++j)
+    {
+      for (k = JTJ->p[j]; k < JTJ->p[j + 1]; ++k)
+        {
+          if (JTJ->i[k] == j)
+            gsl_vector_set(state->JTJdiag, j, JTJ->data[k]);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+spjac_scale()
+  Initialize or update the scaling matrix D from diag(J^T J),
+following the same rules as the scaling methods in scaling.c,
+which require a dense J^T J
+*/
+
+static void
+spjac_scale(const int init, const gsl_multilarge_nlinear_scale *scale,
+            const spjac_state_t *state, gsl_vector *diag)
+{
+  const size_t p = diag->size;
+  size_t j;
+
+  if (scale == gsl_multilarge_nlinear_scale_levenberg)
+    {
+      if (init)
+        gsl_vector_set_all(diag, 1.0);
+
+      return;
+    }
+
+  if (init)
+    gsl_vector_set_zero(diag);
+
+  for (j = 0; j < p; ++j)
+    {
+      double Jjj = gsl_vector_get(state->JTJdiag, j);
+      double *diagj = gsl_vector_ptr(diag, j);
+      double norm = (Jjj <= 0.0) ? 1.0 : sqrt(Jjj);
+
+      if (scale == gsl_multilarge_nlinear_scale_marquardt)
+        *diagj = norm;
+      else
+        *diagj = GSL_MAX(*diagj, norm);
+    }
+}
@@ -31,6 +31,7 @@
 #include <gsl/gsl_ieee_utils.h>
 
 #include "test_fdf.c"
+#include "test_sparse.c"
 
 static void
 test_proc(const gsl_multilarge_nlinear_trs *trs,
@@ -91,5 +92,7 @@ main (void)
         }
     }
 
+  test_sparse();
+
   exit (gsl_test_summary ());
 }
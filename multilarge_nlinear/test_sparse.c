@@ -0,0 +1,310 @@
+/* multilarge_nlinear/test_sparse.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Broyden tridiagonal function with additional rows, whose Jacobian
+ * is tridiagonal in the first p rows and diagonal in the rest:
+ *
+ * f_i = (3 - 2 x_i) x_i - x_{i-1} - 2 x_{i+1} + 1, i < p
+ * f_{p+i} = 0.1 (x_i - 1),                        i < p
+ *
+ * The sparse methods are tested against the dense Cholesky solver.
+ * Since the dense df callback does not see the weights, the dense
+ * reference applies them internally, with params pointing to the
+ * vector sqrt(W).
+ */
+
+#define sparse_P         40
+#define sparse_N         (2 * sparse_P)
+
+static double sparse_J[sparse_N * sparse_P];
+
+static int
+sparse_f (const gsl_vector * x, void *params, gsl_vector * f)
+{
+  size_t i;
+
+  for (i = 0; i < sparse_P; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+      double xm = (i > 0) ? gsl_vector_get(x, i - 1) : 0.0;
+      double xp = (i + 1 < sparse_P) ? gsl_vector_get(x, i + 1) : 0.0;
+
+      gsl_vector_set(f, i, (3.0 - 2.0 * xi) * xi - xm - 2.0 * xp + 1.0);
+      gsl_vector_set(f, sparse_P + i, 0.1 * (xi - 1.0));
+    }
+
+  if (params)
+    gsl_vector_mul(f, (const gsl_vector *) params);
+
+  return GSL_SUCCESS;
+}
+
+static int
+sparse_df_sp (const gsl_vector * x, void * params, gsl_spmatrix * J)
+{
+  size_t i;
+
+  for (i = 0; i < sparse_P; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+
+      if (i > 0)
+        gsl_spmatrix_set(J, i, i - 1, -1.0);
+
+      gsl_spmatrix_set(J, i, i, 3.0 - 4.0 * xi);
+
+      if (i + 1 < sparse_P)
+        gsl_spmatrix_set(J, i, i + 1, -2.0);
+
+      gsl_spmatrix_set(J, sparse_P + i, i, 0.1);
+    }
+
+  (void)params; /* avoid unused parameter warning */
+
+  return GSL_SUCCESS;
+}
+
+static int
+sparse_df (CBLAS_TRANSPOSE_t TransJ, const gsl_vector * x,
+           const gsl_vector * u, void * params, gsl_vector * v,
+           gsl_matrix * JTJ)
+{
+  gsl_matrix_view J = gsl_matrix_view_array(sparse_J, sparse_N, sparse_P);
+  gsl_spmatrix *S = gsl_spmatrix_alloc(sparse_N, sparse_P);
+
+  sparse_df_sp(x, NULL, S);
+  gsl_spmatrix_sp2d(&J.matrix, S);
+  gsl_spmatrix_free(S);
+
+  if (params)
+    {
+      const gsl_vector *swts = (const gsl_vector *) params;
+      size_t i;
+
+      for (i = 0; i < sparse_N; ++i)
+        {
+          gsl_vector_view Ji = gsl_matrix_row(&J.matrix, i);
+          gsl_vector_scale(&Ji.vector, gsl_vector_get(swts, i));
+        }
+    }
+
+  if (v)
+    gsl_blas_dgemv(TransJ, 1.0, &J.matrix, u, 0.0, v);
+
+  if (JTJ)
+    gsl_blas_dsyrk(CblasLower, CblasTrans, 1.0, &J.matrix, 0.0, JTJ);
+
+  return GSL_SUCCESS;
+}
+
+static int
+sparse_fvv (const gsl_vector * x, const gsl_vector * v,
+            void *params, gsl_vector * fvv)
+{
+  size_t i;
+
+  gsl_vector_set_zero(fvv);
+
+  for (i = 0; i < sparse_P; ++i)
+    {
+      double vi = gsl_vector_get(v, i);
+      gsl_vector_set(fvv, i, -4.0 * vi * vi);
+    }
+
+  (void)x;      /* avoid unused parameter warning */
+  (void)params; /* avoid unused parameter warning */
+
+  return GSL_SUCCESS;
+}
+
+/* solve the problem and store the solution, covariance and rcond */
+static void
+test_sparse_solve(const gsl_multilarge_nlinear_parameters * params,
+                  const int sparse, const gsl_vector * wts,
+                  gsl_vector * x, gsl_matrix * covar, double * rcond)
+{
+  const size_t max_iter = 500;
+  const double xtol = 1.0e-12;
+  const double gtol = 1.0e-12;
+  const double ftol = 0.0;
+  gsl_multilarge_nlinear_parameters par = *params;
+  gsl_multilarge_nlinear_fdf fdf;
+  gsl_multilarge_nlinear_workspace *w;
+  gsl_vector *x0 = gsl_vector_alloc(sparse_P);
+  gsl_vector *swts = NULL;
+  int status, info;
+
+  fdf.f = sparse_f;
+  fdf.df = sparse ? NULL : sparse_df;
+  fdf.fvv = sparse_fvv;
+  fdf.n = sparse_N;
+  fdf.p = sparse_P;
+  fdf.params = NULL;
+
+  if (wts != NULL && !sparse)
+    {
+      size_t i;
+
+      swts = gsl_vector_alloc(sparse_N);
+
+      for (i = 0; i < sparse_N; ++i)
+        gsl_vector_set(swts, i, sqrt(gsl_vector_get(wts, i)));
+
+      fdf.params = swts;
+    }
+
+  par.df_sparse = sparse ? sparse_df_sp : NULL;
+
+  w = gsl_multilarge_nlinear_alloc(gsl_multilarge_nlinear_trust, &par,
+                                   sparse_N, sparse_P);
+
+  gsl_vector_set_all(x0, -1.0);
+
+  gsl_multilarge_nlinear_winit(x0, sparse ? wts : NULL, &fdf, w);
+
+  status = gsl_multilarge_nlinear_driver(max_iter, xtol, gtol, ftol,
+                                         NULL, NULL, &info, w);
+  gsl_test(status, "sparse trs=%s solver=%s sparse=%d weighted=%d did not converge, status=%s",
+           par.trs->name, w->params.solver->name, sparse, wts != NULL,
+           gsl_strerror(status));
+
+  gsl_vector_memcpy(x, gsl_multilarge_nlinear_position(w));
+
+  if (covar)
+    gsl_multilarge_nlinear_covar(covar, w);
+
+  if (rcond)
+    gsl_multilarge_nlinear_rcond(rcond, w);
+
+  gsl_multilarge_nlinear_free(w);
+  gsl_vector_free(x0);
+
+  if (swts)
+    gsl_vector_free(swts);
+}
+
+static void
+test_sparse1(const gsl_multilarge_nlinear_trs * trs, const size_t block_size,
+             const gsl_vector * wts)
+{
+  const double tol = 1.0e-8;
+  gsl_multilarge_nlinear_parameters params =
+    gsl_multilarge_nlinear_default_parameters();
+  const int direct = (trs == gsl_multilarge_nlinear_trs_lm ||
+                      trs == gsl_multilarge_nlinear_trs_lmaccel);
+  gsl_vector *x0 = gsl_vector_alloc(sparse_P);
+  gsl_vector *x1 = gsl_vector_alloc(sparse_P);
+  gsl_matrix *covar0 = gsl_matrix_alloc(sparse_P, sparse_P);
+  gsl_matrix *covar1 = gsl_matrix_alloc(sparse_P, sparse_P);
+  double rcond0, rcond1;
+  size_t i, j;
+
+  /* dense reference solution */
+  test_sparse_solve(&params, 0, wts, x0, covar0, &rcond0);
+
+  params.trs = trs;
+  params.block_size = block_size;
+  params.tol = 1.0e-10;
+
+  test_sparse_solve(&params, 1, wts, x1, direct ? covar1 : NULL,
+                    direct ? &rcond1 : NULL);
+
+  for (i = 0; i < sparse_P; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(x1, i), gsl_vector_get(x0, i), tol,
+                   "sparse trs=%s block=%zu weighted=%d x[%zu]",
+                   trs->name, block_size, wts != NULL, i);
+    }
+
+  if (direct)
+    {
+      gsl_test_rel(rcond1, rcond0, 1.0e-6, "sparse trs=%s weighted=%d rcond",
+                   trs->name, wts != NULL);
+
+      for (i = 0; i < sparse_P; ++i)
+        {
+          for (j = 0; j < sparse_P; ++j)
+            {
+              gsl_test_abs(gsl_matrix_get(covar1, i, j),
+                           gsl_matrix_get(covar0, i, j), 1.0e-8,
+                           "sparse trs=%s weighted=%d covar(%zu,%zu)",
+                           trs->name, wts != NULL, i, j);
+            }
+        }
+    }
+
+  /* the pcg method with a dense J^T J */
+  if (trs == gsl_multilarge_nlinear_trs_pcg)
+    {
+      test_sparse_solve(&params, 0, wts, x1, NULL, NULL);
+
+      for (i = 0; i < sparse_P; ++i)
+        {
+          gsl_test_rel(gsl_vector_get(x1, i), gsl_vector_get(x0, i), tol,
+                       "sparse trs=%s block=%zu weighted=%d dense x[%zu]",
+                       trs->name, block_size, wts != NULL, i);
+        }
+    }
+
+  gsl_vector_free(x0);
+  gsl_vector_free(x1);
+  gsl_matrix_free(covar0);
+  gsl_matrix_free(covar1);
+}
+
+static void
+test_sparse(void)
+{
+  gsl_vector *wts = gsl_vector_alloc(sparse_N);
+  size_t i;
+
+  for (i = 0; i < sparse_N; ++i)
+    gsl_vector_set(wts, i, 1.0 + 0.1 * (i % 5));
+
+  test_sparse1(gsl_multilarge_nlinear_trs_lm, 1, NULL);
+  test_sparse1(gsl_multilarge_nlinear_trs_lm, 1, wts);
+  test_sparse1(gsl_multilarge_nlinear_trs_lmaccel, 1, NULL);
+  test_sparse1(gsl_multilarge_nlinear_trs_cgst, 1, NULL);
+  test_sparse1(gsl_multilarge_nlinear_trs_pcg, 1, NULL);
+  test_sparse1(gsl_multilarge_nlinear_trs_pcg, 3, NULL);
+  test_sparse1(gsl_multilarge_nlinear_trs_pcg, 4, wts);
+
+  /* invalid combinations */
+  {
+    gsl_error_handler_t *err_handler = gsl_set_error_handler_off();
+    gsl_multilarge_nlinear_parameters params =
+      gsl_multilarge_nlinear_default_parameters();
+    gsl_multilarge_nlinear_workspace *w;
+
+    params.solver = gsl_multilarge_nlinear_solver_spcholesky;
+    w = gsl_multilarge_nlinear_alloc(gsl_multilarge_nlinear_trust, &params,
+                                     sparse_N, sparse_P);
+    gsl_test(w != NULL, "sparse spcholesky without sparse Jacobian");
+
+    params = gsl_multilarge_nlinear_default_parameters();
+    params.trs = gsl_multilarge_nlinear_trs_dogleg;
+    params.df_sparse = sparse_df_sp;
+    w = gsl_multilarge_nlinear_alloc(gsl_multilarge_nlinear_trust, &params,
+                                     sparse_N, sparse_P);
+    gsl_test(w != NULL, "sparse dogleg with sparse Jacobian");
+
+    gsl_set_error_handler(err_handler);
+  }
+
+  gsl_vector_free(wts);
+}
@@ -26,9 +26,12 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
 
 #include "common.c"
 #include "nielsen.c"
+#include "spjac.c"
 
 /*
  * This module contains a high level driver for a general trust
@@ -40,6 +43,10 @@
  * Jacobian matrix: J_k = J(x_k)
  * gradient vector: g_k = J_k^T f_k
  * scaling matrix:  D_k
+ *
+ * If the user supplies a sparse Jacobian through the df_sparse
+ * parameter, J_k^T J_k is stored as a sparse matrix (spjac.c)
+ * instead of a dense p-by-p matrix.
  */
 
 typedef struct
@@ -56,6 +63,7 @@ typedef struct
 
   void *trs_state;           /* workspace for trust region subproblem */
   void *solver_state;        /* workspace for linear least squares solver */
+  spjac_state_t *spjac;      /* sparse Jacobian workspace, or NULL */
 
   double avratio;            /* current |a| / |v| */
 
@@ -85,6 +93,17 @@ static int trust_eval_step(const gsl_multilarge_nlinear_trust_state * trust_stat
                            const gsl_vector * f_trial, const gsl_vector * dx,
                            double * rho, trust_state_t * state);
 static double trust_scaled_norm(const gsl_vector *D, const gsl_vector *a);
+static int trust_eval_df(const gsl_vector *x, const gsl_vector *f,
+                         const gsl_vector *swts,
+                         gsl_multilarge_nlinear_fdf *fdf,
+                         gsl_vector *g, gsl_matrix *JTJ,
+                         trust_state_t *state);
+static void trust_set_state(gsl_multilarge_nlinear_trust_state *trust_state,
+                            const gsl_vector *x, const gsl_vector *f,
+                            const gsl_vector *g, const gsl_matrix *JTJ,
+                            const gsl_vector *swts,
+                            gsl_multilarge_nlinear_fdf *fdf,
+                            trust_state_t *state);
 
 static void *
 trust_alloc (const gsl_multilarge_nlinear_parameters * params,
@@ -137,6 +156,15 @@ trust_alloc (const gsl_multilarge_nlinear_parameters * params,
         }
     }
 
+  if (params->df_sparse != NULL)
+    {
+      state->spjac = spjac_alloc(n, p);
+      if (state->spjac == NULL)
+        {
+          GSL_ERROR_NULL ("failed to allocate space for sparse Jacobian", GSL_ENOMEM);
+        }
+    }
+
   state->n = n;
   state->p = p;
   state->delta = 0.0;
@@ -169,6 +197,9 @@ trust_free(void *vstate)
   if (state->solver_state)
     (params->solver->free)(state->solver_state);
 
+  if (state->spjac)
+    spjac_free(state->spjac);
+
   free(state);
 }
 
@@ -202,15 +233,15 @@ trust_init(void *vstate, const gsl_vector *swts,
    return status;
 
   /* compute g = J^T f and J^T J */
-  status = gsl_multilarge_nlinear_eval_df(CblasTrans, x, f, f,
-                                          swts, params->h_df, params->fdtype,
-                                          fdf, g, JTJ, state->workn);
+  status = trust_eval_df(x, f, swts, fdf, g, JTJ, state);
   if (status)
     return status;
 
   /* initialize diagonal scaling matrix D */
   if (JTJ != NULL)
     (params->scale->init)(JTJ, state->diag);
+  else if (state->spjac != NULL)
+    spjac_scale(1, params->scale, state->spjac, state->diag);
   else
     gsl_vector_set_all(state->diag, 1.0);
 
@@ -219,28 +250,34 @@ trust_init(void *vstate, const gsl_vector *swts,
   state->delta = 0.3 * GSL_MAX(1.0, Dx);
 
   /* initialize LM parameter */
-  nielsen_init(JTJ, state->diag, &(state->mu), &(state->nu));
+  if (JTJ != NULL)
+    {
+      gsl_vector_const_view JTJdiag = gsl_matrix_const_diagonal(JTJ);
+      nielsen_init(&JTJdiag.vector, state->diag, &(state->mu), &(state->nu));
+    }
+  else if (state->spjac != NULL)
+    nielsen_init(state->spjac->JTJdiag, state->diag, &(state->mu), &(state->nu));
+  else
+    nielsen_init(NULL, state->diag, &(state->mu), &(state->nu));
 
   /* initialize trust region method solver */
   {
     gsl_multilarge_nlinear_trust_state trust_state;
 
-    trust_state.x = x;
-    trust_state.f = f;
-    trust_state.g = g;
-    trust_state.JTJ = JTJ;
-    trust_state.diag = state->diag;
-    trust_state.sqrt_wts = swts;
-    trust_state.mu = &(state->mu);
-    trust_state.params = params;
-    trust_state.solver_state = state->solver_state;
-    trust_state.fdf = fdf;
-    trust_state.avratio = &(state->avratio);
+    trust_set_state(&trust_state, x, f, g, JTJ, swts, fdf, state);
 
     status = (params->trs->init)(&trust_state, state->trs_state);
-
     if (status)
       return status;
+
+    /* give the linear solver the sparse J^T J, so that the condition
+     * number and covariance matrix are available before iterating */
+    if (state->spjac != NULL && state->solver_state != NULL)
+      {
+        status = (params->solver->init)(&trust_state, state->solver_state);
+        if (status)
+          return status;
+      }
   }
 
   /* set default parameters */
@@ -298,17 +335,7 @@ trust_iterate(void *vstate, const gsl_vector *swts,
   int bad_steps = 0;                          /* consecutive rejected steps */
 
   /* store all state parameters needed by low level methods */
-  trust_state.x = x;
-  trust_state.f = f;
-  trust_state.g = g;
-  trust_state.JTJ = JTJ;
-  trust_state.diag = state->diag;
-  trust_state.sqrt_wts = swts;
-  trust_state.mu = &(state->mu);
-  trust_state.params = params;
-  trust_state.solver_state = state->solver_state;
-  trust_state.fdf = fdf;
-  trust_state.avratio = &(state->avratio);
+  trust_set_state(&trust_state, x, f, g, JTJ, swts, fdf, state);
 
   /* initialize trust region subproblem with this Jacobian */
   status = (trs->preloop)(&trust_state, state->trs_state);
@@ -381,15 +408,15 @@ trust_iterate(void *vstate, const gsl_vector *swts,
           gsl_vector_memcpy(f, f_trial);
 
           /* compute new g = J^T f and J^T J */
-          status = gsl_multilarge_nlinear_eval_df(CblasTrans, x, f, f,
-                                                  swts, params->h_df, params->fdtype,
-                                                  fdf, g, JTJ, state->workn);
+          status = trust_eval_df(x, f, swts, fdf, g, JTJ, state);
           if (status)
             return status;
 
           /* update scaling matrix D */
           if (JTJ != NULL)
             (params->scale->update)(JTJ, state->diag);
+          else if (state->spjac != NULL)
+            spjac_scale(0, params->scale, state->spjac, state->diag);
 
           /* step accepted, decrease LM parameter */
           nielsen_accept(rho, &(state->mu), &(state->nu));
@@ -550,6 +577,49 @@ trust_eval_step(const gsl_multilarge_nlinear_trust_state * trust_state,
   return status;
 }
 
+/* compute g = J^T f and J^T J, with the sparse Jacobian if available */
+static int
+trust_eval_df(const gsl_vector *x, const gsl_vector *f,
+              const gsl_vector *swts, gsl_multilarge_nlinear_fdf *fdf,
+              gsl_vector *g, gsl_matrix *JTJ, trust_state_t *state)
+{
+  const gsl_multilarge_nlinear_parameters *params = &(state->params);
+
+  if (state->spjac != NULL)
+    {
+      return spjac_eval(x, f, swts, fdf, params, g, state->spjac);
+    }
+  else
+    {
+      return gsl_multilarge_nlinear_eval_df(CblasTrans, x, f, f,
+                                            swts, params->h_df, params->fdtype,
+                                            fdf, g, JTJ, state->workn);
+    }
+}
+
+/* store all state parameters needed by low level methods */
+static void
+trust_set_state(gsl_multilarge_nlinear_trust_state *trust_state,
+                const gsl_vector *x, const gsl_vector *f,
+                const gsl_vector *g, const gsl_matrix *JTJ,
+                const gsl_vector *swts, gsl_multilarge_nlinear_fdf *fdf,
+                trust_state_t *state)
+{
+  trust_state->x = x;
+  trust_state->f = f;
+  trust_state->g = g;
+  trust_state->JTJ = JTJ;
+  trust_state->diag = state->diag;
+  trust_state->sqrt_wts = swts;
+  trust_state->mu = &(state->mu);
+  trust_state->params = &(state->params);
+  trust_state->solver_state = state->solver_state;
+  trust_state->fdf = fdf;
+  trust_state->avratio = &(state->avratio);
+  trust_state->Jsp = state->spjac ? state->spjac->Jc : NULL;
+  trust_state->JTJsp = state->spjac ? state->spjac->JTJ : NULL;
+}
+
 /* compute || diag(D) a || */
 static double
 trust_scaled_norm(const gsl_vector *D, const gsl_vector *a)
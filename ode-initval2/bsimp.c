@@ -565,7 +565,8 @@ static const gsl_odeiv2_step_type bsimp_type = {
   &stepper_set_driver_null,
   &bsimp_reset,
   &bsimp_order,
-  &bsimp_free
+  &bsimp_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_bsimp = &bsimp_type;
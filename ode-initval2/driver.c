@@ -24,10 +24,14 @@
 
 #include <config.h>
 #include <math.h>
+#include <string.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_odeiv2.h>
 #include <gsl/gsl_machine.h>
 
+#include "odeiv_util.h"
+
 static gsl_odeiv2_driver *
 driver_alloc (const gsl_odeiv2_system * sys, const double hstart,
               const gsl_odeiv2_step_type * T)
@@ -98,6 +102,7 @@ driver_alloc (const gsl_odeiv2_system * sys, const double hstart,
   state->nmax = 0;
   state->n = 0;
   state->c = NULL;
+  state->ievent = -1;
 
   return state;
 }
@@ -152,6 +157,167 @@ gsl_odeiv2_driver_set_nmax (gsl_odeiv2_driver * d,
   return GSL_SUCCESS;
 }
 
+static int
+driver_jacobian_storage (const gsl_odeiv2_driver * d)
+{
+  /* Steppers whose Newton iteration matrix is the one of
+     itermatrix.c, which can use other storage of the Jacobian */
+
+  const gsl_odeiv2_step_type *T = d->s->type;
+
+  return (T == gsl_odeiv2_step_msbdf || T == gsl_odeiv2_step_rk1imp
+          || T == gsl_odeiv2_step_rk2imp);
+}
+
+int
+gsl_odeiv2_driver_set_jacobian_banded (gsl_odeiv2_driver * d,
+                                       const size_t kl, const size_t ku)
+{
+  /* Selects banded storage of the Jacobian, with kl subdiagonals and
+     ku superdiagonals, for the implicit stepper of the driver */
+
+  const size_t dim = d->sys->dimension;
+
+  if (!driver_jacobian_storage (d))
+    {
+      GSL_ERROR ("banded Jacobian is only supported by msbdf, rk1imp and rk2imp",
+                 GSL_EINVAL);
+    }
+
+  if (kl >= dim || ku >= dim)
+    {
+      GSL_ERROR ("bandwidth must be less than dimension", GSL_EINVAL);
+    }
+
+  d->jac_type = GSL_ODEIV2_JAC_BANDED;
+  d->kl = kl;
+  d->ku = ku;
+  d->jacobian_sparse = NULL;
+  d->jacobian_block = NULL;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_odeiv2_driver_set_jacobian_block (gsl_odeiv2_driver * d,
+                                      const size_t nblock,
+                                      int (*jacobian) (double t,
+                                                       const double y[],
+                                                       double *dfdy,
+                                                       double dfdt[],
+                                                       void *params))
+{
+  /* Selects a block diagonal approximation of the Jacobian, where the
+     given function sets only the first of nblock equal blocks, of
+     size dim / nblock, instead of the jacobian function of the
+     system setting the whole Jacobian */
+
+  const size_t dim = d->sys->dimension;
+
+  if (!driver_jacobian_storage (d))
+    {
+      GSL_ERROR ("block Jacobian is only supported by msbdf, rk1imp and rk2imp",
+                 GSL_EINVAL);
+    }
+
+  if (nblock == 0 || dim % nblock != 0)
+    {
+      GSL_ERROR ("dimension must be a multiple of the number of blocks",
+                 GSL_EINVAL);
+    }
+
+  if (jacobian == NULL)
+    {
+      GSL_ERROR ("block Jacobian function is NULL", GSL_EFAULT);
+    }
+
+  d->jac_type = GSL_ODEIV2_JAC_BLOCK;
+  d->kl = 0;
+  d->ku = 0;
+  d->nblock = nblock;
+  d->jacobian_sparse = NULL;
+  d->jacobian_block = jacobian;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_odeiv2_driver_set_jacobian_sparse (gsl_odeiv2_driver * d,
+                                       int (*jacobian) (double t,
+                                                        const double y[],
+                                                        gsl_spmatrix * dfdy,
+                                                        double dfdt[],
+                                                        void *params))
+{
+  /* Selects a sparse Jacobian, evaluated by the given function instead
+     of the jacobian function of the system */
+
+  if (!driver_jacobian_storage (d))
+    {
+      GSL_ERROR ("sparse Jacobian is only supported by msbdf, rk1imp and rk2imp",
+                 GSL_EINVAL);
+    }
+
+  if (jacobian == NULL)
+    {
+      GSL_ERROR ("sparse Jacobian function is NULL", GSL_EFAULT);
+    }
+
+  d->jac_type = GSL_ODEIV2_JAC_SPARSE;
+  d->kl = 0;
+  d->ku = 0;
+  d->jacobian_sparse = jacobian;
+  d->jacobian_block = NULL;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_odeiv2_driver_set_events (gsl_odeiv2_driver * d,
+                              const gsl_odeiv2_event * ev)
+{
+  /* Sets event functions, which are checked for sign changes after
+     every step of gsl_odeiv2_driver_apply. NULL removes the events. */
+
+  const size_t dim = d->sys->dimension;
+
+  if (d->evwork != NULL)
+    {
+      free (d->evwork);
+      d->evwork = NULL;
+    }
+
+  d->ev = NULL;
+  d->pending = 0;
+  d->ievent = -1;
+
+  if (ev == NULL)
+    {
+      return GSL_SUCCESS;
+    }
+
+  if (ev->function == NULL || ev->nevents == 0)
+    {
+      GSL_ERROR ("event function must be given", GSL_EINVAL);
+    }
+
+  /* g at both ends of a segment, g for root finding and close to the
+     start of a segment, y at the event, y for root finding and y
+     returned at the event */
+
+  d->evwork = (double *) malloc ((4 * ev->nevents + 3 * dim)
+                                 * sizeof (double));
+
+  if (d->evwork == NULL)
+    {
+      GSL_ERROR ("failed to allocate space for events", GSL_ENOMEM);
+    }
+
+  d->ev = ev;
+
+  return GSL_SUCCESS;
+}
+
 gsl_odeiv2_driver *
 gsl_odeiv2_driver_alloc_y_new (const gsl_odeiv2_system * sys,
                                const gsl_odeiv2_step_type * T,
@@ -322,6 +488,391 @@ gsl_odeiv2_driver_alloc_scaled_new (const gsl_odeiv2_system * sys,
   return state;
 }
 
+/* Event location. The event functions are evaluated on the dense
+   output of the last step (gsl_odeiv2_evolve_interp), so locating an
+   event needs no evaluations of the system function and does not
+   disturb the state of the stepper. */
+
+static int
+driver_event_eval (gsl_odeiv2_driver * d, const double t, double y[],
+                   double g[])
+{
+  int s = gsl_odeiv2_evolve_interp (d->e, d->s, t, y);
+
+  if (s != GSL_SUCCESS)
+    {
+      return s;
+    }
+
+  return d->ev->function (t, y, g, d->ev->params);
+}
+
+static int
+driver_event_crossed (const gsl_odeiv2_event * ev, const size_t i,
+                      const double ga, const double gb)
+{
+  const int dir = (ev->direction != NULL) ? ev->direction[i] : 0;
+
+  if (ga < 0.0 && gb >= 0.0)
+    {
+      return dir >= 0;
+    }
+  else if (ga > 0.0 && gb <= 0.0)
+    {
+      return dir <= 0;
+    }
+
+  return 0;
+}
+
+static int
+driver_event_locate (gsl_odeiv2_driver * d, const double ta,
+                     const double tb, int *found, double *te, size_t *ie)
+{
+  /* Finds the first event in (ta, tb], given the event functions g0
+     at ta and g1 at tb. Each root is located by the Illinois variant
+     of regula falsi, and te is the end of the final bracket on the
+     far side of the root, so that the event is not found again in the
+     next segment. If an event is found g1 and ytmp hold the values
+     at te. */
+
+  const gsl_odeiv2_event *ev = d->ev;
+  const size_t nev = ev->nevents;
+  const size_t dim = d->sys->dimension;
+  double *g0 = d->evwork;
+  double *g1 = g0 + nev;
+  double *gtmp = g1 + nev;
+  double *ytmp = gtmp + 2 * nev;
+  double *ytmp2 = ytmp + dim;
+  const double tol =
+    GSL_DBL_EPSILON * (2.0 * (fabs (ta) + fabs (tb)) + fabs (tb - ta));
+  const size_t max_iter = 100;
+  double tc = ta;
+  double *gc = g0;
+  size_t i;
+
+  *found = 0;
+
+  /* A function which is zero at ta, e.g. at an event where the
+     integration was restarted, takes its sign from a point close to
+     ta */
+
+  for (i = 0; i < nev; i++)
+    {
+      if (g0[i] == 0.0)
+        {
+          const double dt =
+            100.0 * GSL_DBL_EPSILON * (fabs (ta) + fabs (tb - ta));
+          int s;
+
+          if (fabs (tb - ta) <= 2.0 * dt)
+            {
+              break;
+            }
+
+          tc = (tb > ta) ? ta + dt : ta - dt;
+          gc = gtmp + nev;
+
+          s = driver_event_eval (d, tc, ytmp2, gc);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+
+          break;
+        }
+    }
+
+  for (i = 0; i < nev; i++)
+    {
+      const int zero = (g0[i] == 0.0 && gc != g0);
+      double a = zero ? tc : ta, b = tb;
+      double fa = zero ? gc[i] : g0[i], fb = g1[i];
+      int side = 0;
+      size_t iter;
+
+      if (!driver_event_crossed (ev, i, fa, fb))
+        {
+          continue;
+        }
+
+      for (iter = 0; iter < max_iter && fb != 0.0 && fabs (b - a) > tol;
+           iter++)
+        {
+          double c = (a * fb - b * fa) / (fb - fa);
+          int s;
+
+          if (!((c > a && c < b) || (c < a && c > b)))
+            {
+              c = 0.5 * (a + b);
+            }
+
+          s = driver_event_eval (d, c, ytmp2, gtmp);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+
+          if (gtmp[i] == 0.0 || (gtmp[i] > 0.0) == (fb > 0.0))
+            {
+              b = c;
+              fb = gtmp[i];
+
+              if (side == 1)
+                {
+                  fa *= 0.5;
+                }
+
+              side = 1;
+            }
+          else
+            {
+              a = c;
+              fa = gtmp[i];
+
+              if (side == -1)
+                {
+                  fb *= 0.5;
+                }
+
+              side = -1;
+            }
+        }
+
+      if (!*found || (tb > ta ? b < *te : b > *te))
+        {
+          *found = 1;
+          *te = b;
+          *ie = i;
+        }
+    }
+
+  if (*found)
+    {
+      return driver_event_eval (d, *te, ytmp, g1);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+driver_apply_events (gsl_odeiv2_driver * d, double *t, const double t1,
+                     double y[], const int sign)
+{
+  /* Evolution loop of gsl_odeiv2_driver_apply with event detection.
+     Steps are taken as without events, and each step is searched for
+     events afterwards. If the integration is stopped at an event, or
+     t1 is reached within a resumed step, t and y are interpolated
+     values and the stepper stays at the end of the step. The next
+     call resumes from there if t and y have not been modified.
+   */
+
+  const gsl_odeiv2_event *ev = d->ev;
+  const size_t nev = ev->nevents;
+  const size_t dim = d->sys->dimension;
+  double *g0 = d->evwork;
+  double *g1 = g0 + nev;
+  double *ytmp = g1 + 3 * nev;
+  double *yev = ytmp + 2 * dim;
+  int resume = 0;
+  int s;
+
+  d->ievent = -1;
+
+  if (d->pending)
+    {
+      d->pending = 0;
+
+      if (*t == d->tev && memcmp (y, yev, dim * sizeof (double)) == 0)
+        {
+          resume = 1;
+        }
+      else
+        {
+          /* y was modified, the stepper can not continue */
+
+          s = gsl_odeiv2_driver_reset (d);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+        }
+    }
+
+  if (!resume)
+    {
+      s = ev->function (*t, y, g0, ev->params);
+
+      if (s != GSL_SUCCESS)
+        {
+          return s;
+        }
+    }
+
+  while (resume || sign * (t1 - *t) > 0.0)
+    {
+      double ta = *t, tb, tend;
+      int restart = 0;
+
+      if (resume)
+        {
+          tend = d->e->thist[d->e->nhist - 1];
+          resume = 0;
+        }
+      else
+        {
+          s = gsl_odeiv2_evolve_apply (d->e, d->c, d->s, d->sys,
+                                       t, t1, &(d->h), y);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+
+          tend = *t;
+
+          /* Check for maximum allowed steps */
+
+          if ((d->nmax > 0) && (d->n > d->nmax))
+            {
+              return GSL_EMAXITER;
+            }
+
+          /* Set step size if maximum size is exceeded */
+
+          if (fabs (d->h) > d->hmax)
+            {
+              d->h = sign * d->hmax;
+            }
+
+          /* Check for too small step size */
+
+          if (fabs (d->h) < d->hmin)
+            {
+              return GSL_ENOPROG;
+            }
+
+          d->n++;
+        }
+
+      /* A resumed step may extend beyond t1 */
+
+      tb = (sign * (tend - t1) > 0.0) ? t1 : tend;
+
+      s = driver_event_eval (d, tb, ytmp, g1);
+
+      if (s != GSL_SUCCESS)
+        {
+          return s;
+        }
+
+      /* Search the step for events, until a terminal one */
+
+      while (sign * (tb - ta) > 0.0)
+        {
+          int found, action;
+          double te = tb;
+          size_t ie = 0;
+
+          s = driver_event_locate (d, ta, tb, &found, &te, &ie);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+
+          if (!found)
+            {
+              break;
+            }
+
+          action = (ev->action != NULL) ?
+            ev->action (te, ytmp, ie, ev->params) : GSL_ODEIV2_EVENT_STOP;
+
+          if (action == GSL_ODEIV2_EVENT_CONTINUE)
+            {
+              DBL_MEMCPY (g0, g1, nev);
+              ta = te;
+
+              s = driver_event_eval (d, tb, ytmp, g1);
+
+              if (s != GSL_SUCCESS)
+                {
+                  return s;
+                }
+            }
+          else if (action == GSL_ODEIV2_EVENT_STOP)
+            {
+              *t = te;
+              DBL_MEMCPY (y, ytmp, dim);
+              DBL_MEMCPY (yev, ytmp, dim);
+              DBL_MEMCPY (g0, g1, nev);
+              d->tev = te;
+              d->ievent = (int) ie;
+              d->pending = 1;
+
+              return GSL_SUCCESS;
+            }
+          else if (action == GSL_ODEIV2_EVENT_RESTART)
+            {
+              /* y was changed discontinuously, start again at te */
+
+              *t = te;
+              DBL_MEMCPY (y, ytmp, dim);
+
+              s = gsl_odeiv2_driver_reset (d);
+
+              if (s != GSL_SUCCESS)
+                {
+                  return s;
+                }
+
+              s = ev->function (*t, y, g0, ev->params);
+
+              if (s != GSL_SUCCESS)
+                {
+                  return s;
+                }
+
+              restart = 1;
+              break;
+            }
+          else
+            {
+              return action;
+            }
+        }
+
+      if (restart)
+        {
+          continue;
+        }
+
+      DBL_MEMCPY (g0, g1, nev);
+
+      if (tb != tend)
+        {
+          /* t1 is inside of the resumed step */
+
+          *t = tb;
+          DBL_MEMCPY (y, ytmp, dim);
+          DBL_MEMCPY (yev, ytmp, dim);
+          d->tev = tb;
+          d->pending = 1;
+
+          return GSL_SUCCESS;
+        }
+
+      *t = tend;
+      DBL_MEMCPY (y, d->e->yhist + (d->e->nhist - 1) * dim, dim);
+    }
+
+  return GSL_SUCCESS;
+}
+
 int
 gsl_odeiv2_driver_apply (gsl_odeiv2_driver * d, double *t,
                          const double t1, double y[])
@@ -356,6 +907,11 @@ gsl_odeiv2_driver_apply (gsl_odeiv2_driver * d, double *t,
          GSL_EINVAL);
     }
 
+  if (d->ev != NULL)
+    {
+      return driver_apply_events (d, t, t1, y, sign);
+    }
+
   /* Evolution loop */
 
   while (sign * (t1 - *t) > 0.0)
@@ -395,6 +951,114 @@ gsl_odeiv2_driver_apply (gsl_odeiv2_driver * d, double *t,
   return GSL_SUCCESS;
 }
 
+int
+gsl_odeiv2_driver_apply_dense (gsl_odeiv2_driver * d, double *t,
+                               const size_t n, const double tout[],
+                               double yout[], double y[])
+{
+  /* Evolves the system from t to tout[n-1] with steps chosen by the
+     control object only, and stores the solution at the output points
+     tout[i] in yout[i*dim], using the interpolant of the step which
+     contains each point. The output points must be ordered in the
+     direction of integration. On return y and t contain the values at
+     tout[n-1], or after the last successful step in case of an
+     error.
+   */
+
+  const size_t dim = d->sys->dimension;
+  const double t1 = (n > 0) ? tout[n - 1] : *t;
+  size_t i = 0;
+  int sign = 0;
+  d->n = 0;
+
+  /* Determine integration direction sign */
+
+  if (d->h > 0.0)
+    {
+      sign = 1;
+    }
+  else
+    {
+      sign = -1;
+    }
+
+  /* Check that t, output points and step direction are sensible */
+
+  if (n > 0 && sign * (tout[0] - *t) < 0.0)
+    {
+      GSL_ERROR ("integration limits and/or step direction not consistent",
+                 GSL_EINVAL);
+    }
+
+  for (i = 1; i < n; i++)
+    {
+      if (sign * (tout[i] - tout[i - 1]) < 0.0)
+        {
+          GSL_ERROR ("output points must be ordered in direction of "
+                     "integration", GSL_EINVAL);
+        }
+    }
+
+  /* Output points at the initial point */
+
+  for (i = 0; i < n && tout[i] == *t; i++)
+    {
+      DBL_MEMCPY (&yout[i * dim], y, dim);
+    }
+
+  /* Evolution loop */
+
+  while (sign * (t1 - *t) > 0.0)
+    {
+      int s = gsl_odeiv2_evolve_apply (d->e, d->c, d->s, d->sys,
+                                       t, t1, &(d->h), y);
+
+      if (s != GSL_SUCCESS)
+        {
+          return s;
+        }
+
+      /* Interpolate output points within the step */
+
+      while (i < n && sign * (tout[i] - *t) <= 0.0)
+        {
+          s = gsl_odeiv2_evolve_interp (d->e, d->s, tout[i], &yout[i * dim]);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+
+          i++;
+        }
+
+      /* Check for maximum allowed steps */
+
+      if ((d->nmax > 0) && (d->n > d->nmax))
+        {
+          return GSL_EMAXITER;
+        }
+
+      /* Set step size if maximum size is exceeded */
+
+      if (fabs (d->h) > d->hmax)
+        {
+          d->h = sign * d->hmax;
+        }
+
+      /* Check for too small step size */
+
+      if (fabs (d->h) < d->hmin)
+        {
+          return GSL_ENOPROG;
+        }
+
+      d->n++;
+    }
+
+  return GSL_SUCCESS;
+}
+
 int
 gsl_odeiv2_driver_apply_fixed_step (gsl_odeiv2_driver * d, double *t,
                                     const double h, const unsigned long int n,
@@ -433,6 +1097,8 @@ gsl_odeiv2_driver_reset (gsl_odeiv2_driver * d)
 {
   /* Reset the driver. Resets evolve and step objects. */
 
+  d->pending = 0;
+
   {
     int s = gsl_odeiv2_evolve_reset (d->e);
 
@@ -490,5 +1156,8 @@ gsl_odeiv2_driver_free (gsl_odeiv2_driver * state)
   if (state->s)
     gsl_odeiv2_step_free (state->s);
 
+  if (state->evwork)
+    free (state->evwork);
+
   free (state);
 }
@@ -0,0 +1,617 @@
+/* ode-initval2/ensemble.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Ensemble driver for many independent systems of the same
+   dimension. The state of the ensemble is stored component-major,
+   y[i * nsys + k] being component i of system k, so that every
+   stage of the explicit Runge-Kutta method is a loop over the
+   systems which the compiler can vectorize. Each system has its own
+   time and step size, controlled as in gsl_odeiv2_control_y_new.
+   Systems which have reached t1, or which have failed, are masked
+   by giving them a zero step.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_machine.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_odeiv2.h>
+
+/* Butcher tableau of an embedded explicit Runge-Kutta method. The
+   matrix a is stored by rows without the zero diagonal and upper
+   triangle, row s having s entries. b gives the solution which is
+   propagated and e the difference between b and the embedded
+   weights, for the error estimate. */
+
+typedef struct
+{
+  const gsl_odeiv2_step_type **type;
+  size_t stages;
+  unsigned int order;
+  const double *c;
+  const double *a;
+  const double *b;
+  const double *e;
+}
+ensemble_tableau;
+
+/* Runge-Kutta-Fehlberg 4(5), as in rkf45.c */
+
+static const double rkf45_c[] =
+  { 0.0, 1.0 / 4.0, 3.0 / 8.0, 12.0 / 13.0, 1.0, 1.0 / 2.0 };
+
+static const double rkf45_a[] = {
+  1.0 / 4.0,
+  3.0 / 32.0, 9.0 / 32.0,
+  1932.0 / 2197.0, -7200.0 / 2197.0, 7296.0 / 2197.0,
+  8341.0 / 4104.0, -32832.0 / 4104.0, 29440.0 / 4104.0, -845.0 / 4104.0,
+  -6080.0 / 20520.0, 41040.0 / 20520.0, -28352.0 / 20520.0,
+  9295.0 / 20520.0, -5643.0 / 20520.0
+};
+
+static const double rkf45_b[] = {
+  902880.0 / 7618050.0, 0.0, 3953664.0 / 7618050.0,
+  3855735.0 / 7618050.0, -1371249.0 / 7618050.0, 277020.0 / 7618050.0
+};
+
+static const double rkf45_e[] = {
+  1.0 / 360.0, 0.0, -128.0 / 4275.0, -2197.0 / 75240.0,
+  1.0 / 50.0, 2.0 / 55.0
+};
+
+/* Cash-Karp 4(5), as in rkck.c */
+
+static const double rkck_c[] =
+  { 0.0, 1.0 / 5.0, 0.3, 3.0 / 5.0, 1.0, 7.0 / 8.0 };
+
+static const double rkck_a[] = {
+  1.0 / 5.0,
+  3.0 / 40.0, 9.0 / 40.0,
+  0.3, -0.9, 1.2,
+  -11.0 / 54.0, 2.5, -70.0 / 27.0, 35.0 / 27.0,
+  1631.0 / 55296.0, 175.0 / 512.0, 575.0 / 13824.0, 44275.0 / 110592.0,
+  253.0 / 4096.0
+};
+
+static const double rkck_b[] = {
+  37.0 / 378.0, 0.0, 250.0 / 621.0, 125.0 / 594.0, 0.0, 512.0 / 1771.0
+};
+
+static const double rkck_e[] = {
+  37.0 / 378.0 - 2825.0 / 27648.0,
+  0.0,
+  250.0 / 621.0 - 18575.0 / 48384.0,
+  125.0 / 594.0 - 13525.0 / 55296.0,
+  -277.0 / 14336.0,
+  512.0 / 1771.0 - 0.25
+};
+
+/* Prince-Dormand 8(9), as in rk8pd.c */
+
+static const double rk8pd_c[] = {
+  0.0,
+  1.0 / 18.0,
+  1.0 / 12.0,
+  1.0 / 8.0,
+  5.0 / 16.0,
+  3.0 / 8.0,
+  59.0 / 400.0,
+  93.0 / 200.0,
+  5490023248.0 / 9719169821.0,
+  13.0 / 20.0,
+  1201146811.0 / 1299019798.0,
+  1.0,
+  1.0
+};
+
+static const double rk8pd_a[] = {
+  1.0 / 18.0,
+  1.0 / 48.0, 1.0 / 16.0,
+  1.0 / 32.0, 0.0, 3.0 / 32.0,
+  5.0 / 16.0, 0.0, -75.0 / 64.0, 75.0 / 64.0,
+  3.0 / 80.0, 0.0, 0.0, 3.0 / 16.0, 3.0 / 20.0,
+  29443841.0 / 614563906.0, 0.0, 0.0, 77736538.0 / 692538347.0,
+  -28693883.0 / 1125000000.0, 23124283.0 / 1800000000.0,
+  16016141.0 / 946692911.0, 0.0, 0.0, 61564180.0 / 158732637.0,
+  22789713.0 / 633445777.0, 545815736.0 / 2771057229.0,
+  -180193667.0 / 1043307555.0,
+  39632708.0 / 573591083.0, 0.0, 0.0, -433636366.0 / 683701615.0,
+  -421739975.0 / 2616292301.0, 100302831.0 / 723423059.0,
+  790204164.0 / 839813087.0, 800635310.0 / 3783071287.0,
+  246121993.0 / 1340847787.0, 0.0, 0.0, -37695042795.0 / 15268766246.0,
+  -309121744.0 / 1061227803.0, -12992083.0 / 490766935.0,
+  6005943493.0 / 2108947869.0, 393006217.0 / 1396673457.0,
+  123872331.0 / 1001029789.0,
+  -1028468189.0 / 846180014.0, 0.0, 0.0, 8478235783.0 / 508512852.0,
+  1311729495.0 / 1432422823.0, -10304129995.0 / 1701304382.0,
+  -48777925059.0 / 3047939560.0, 15336726248.0 / 1032824649.0,
+  -45442868181.0 / 3398467696.0, 3065993473.0 / 597172653.0,
+  185892177.0 / 718116043.0, 0.0, 0.0, -3185094517.0 / 667107341.0,
+  -477755414.0 / 1098053517.0, -703635378.0 / 230739211.0,
+  5731566787.0 / 1027545527.0, 5232866602.0 / 850066563.0,
+  -4093664535.0 / 808688257.0, 3962137247.0 / 1805957418.0,
+  65686358.0 / 487910083.0,
+  403863854.0 / 491063109.0, 0.0, 0.0, -5068492393.0 / 434740067.0,
+  -411421997.0 / 543043805.0, 652783627.0 / 914296604.0,
+  11173962825.0 / 925320556.0, -13158990841.0 / 6184727034.0,
+  3936647629.0 / 1978049680.0, -160528059.0 / 685178525.0,
+  248638103.0 / 1413531060.0, 0.0
+};
+
+static const double rk8pd_b[] = {
+  14005451.0 / 335480064.0, 0.0, 0.0, 0.0, 0.0,
+  -59238493.0 / 1068277825.0,
+  181606767.0 / 758867731.0,
+  561292985.0 / 797845732.0,
+  -1041891430.0 / 1371343529.0,
+  760417239.0 / 1151165299.0,
+  118820643.0 / 751138087.0,
+  -528747749.0 / 2220607170.0,
+  1.0 / 4.0
+};
+
+static const double rk8pd_e[] = {
+  13451932.0 / 455176623.0 - 14005451.0 / 335480064.0, 0.0, 0.0, 0.0, 0.0,
+  -808719846.0 / 976000145.0 + 59238493.0 / 1068277825.0,
+  1757004468.0 / 5645159321.0 - 181606767.0 / 758867731.0,
+  656045339.0 / 265891186.0 - 561292985.0 / 797845732.0,
+  -3867574721.0 / 1518517206.0 + 1041891430.0 / 1371343529.0,
+  465885868.0 / 322736535.0 - 760417239.0 / 1151165299.0,
+  53011238.0 / 667516719.0 - 118820643.0 / 751138087.0,
+  2.0 / 45.0 + 528747749.0 / 2220607170.0,
+  -1.0 / 4.0
+};
+
+/* the orders match those reported by the single system steppers,
+   which are used by the standard control */
+
+static const ensemble_tableau ensemble_tableaux[] = {
+  {&gsl_odeiv2_step_rkf45, 6, 5, rkf45_c, rkf45_a, rkf45_b, rkf45_e},
+  {&gsl_odeiv2_step_rkck, 6, 5, rkck_c, rkck_a, rkck_b, rkck_e},
+  {&gsl_odeiv2_step_rk8pd, 13, 8, rk8pd_c, rk8pd_a, rk8pd_b, rk8pd_e},
+  {0, 0, 0, 0, 0, 0, 0}
+};
+
+static int ensemble_step (gsl_odeiv2_ensemble * e, const double t[],
+                          const double y[]);
+
+gsl_odeiv2_ensemble *
+gsl_odeiv2_ensemble_alloc (const gsl_odeiv2_ensemble_system * sys,
+                           const gsl_odeiv2_step_type * T,
+                           const double hstart, const double epsabs,
+                           const double epsrel)
+{
+  /* Allocates an ensemble driver for sys->nsys systems of dimension
+     sys->dimension, using the explicit stepper T */
+
+  gsl_odeiv2_ensemble *e;
+  const ensemble_tableau *tab = 0;
+  size_t i, n;
+
+  if (sys == NULL)
+    {
+      GSL_ERROR_NULL ("gsl_odeiv2_ensemble_system must be defined",
+                      GSL_EINVAL);
+    }
+
+  if (sys->dimension == 0 || sys->nsys == 0)
+    {
+      GSL_ERROR_NULL ("dimension and nsys must be positive", GSL_EINVAL);
+    }
+
+  if (epsabs < 0.0 || epsrel < 0.0 || (epsabs == 0.0 && epsrel == 0.0))
+    {
+      GSL_ERROR_NULL ("epsabs and epsrel must be non-negative and not both zero",
+                      GSL_EINVAL);
+    }
+
+  if (hstart == 0.0)
+    {
+      GSL_ERROR_NULL ("hstart must be non-zero", GSL_EINVAL);
+    }
+
+  for (i = 0; ensemble_tableaux[i].type != 0; i++)
+    {
+      if (*ensemble_tableaux[i].type == T)
+        {
+          tab = &ensemble_tableaux[i];
+          break;
+        }
+    }
+
+  if (tab == 0)
+    {
+      GSL_ERROR_NULL ("ensemble driver supports rkf45, rkck and rk8pd only",
+                      GSL_EINVAL);
+    }
+
+  e = (gsl_odeiv2_ensemble *) calloc (1, sizeof (gsl_odeiv2_ensemble));
+
+  if (e == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for ensemble struct",
+                      GSL_ENOMEM);
+    }
+
+  n = sys->dimension * sys->nsys;
+
+  e->sys = sys;
+  e->type = T;
+  e->tableau = tab;
+  e->epsabs = epsabs;
+  e->epsrel = epsrel;
+  e->k = (double *) malloc (tab->stages * n * sizeof (double));
+  e->ytmp = (double *) malloc (n * sizeof (double));
+  e->ts = (double *) malloc (sys->nsys * sizeof (double));
+  e->h = (double *) malloc (sys->nsys * sizeof (double));
+  e->hs = (double *) malloc (sys->nsys * sizeof (double));
+  e->rmax = (double *) malloc (sys->nsys * sizeof (double));
+  e->status = (int *) malloc (sys->nsys * sizeof (int));
+
+  if (e->k == NULL || e->ytmp == NULL || e->ts == NULL || e->h == NULL
+      || e->hs == NULL || e->rmax == NULL || e->status == NULL)
+    {
+      gsl_odeiv2_ensemble_free (e);
+      GSL_ERROR_NULL ("failed to allocate space for ensemble", GSL_ENOMEM);
+    }
+
+  gsl_odeiv2_ensemble_reset_hstart (e, hstart);
+  e->nmax = 0;
+
+  return e;
+}
+
+int
+gsl_odeiv2_ensemble_set_nmax (gsl_odeiv2_ensemble * e,
+                              const unsigned long int nmax)
+{
+  /* Sets maximum number of ensemble steps allowed in one call to
+     gsl_odeiv2_ensemble_apply. A value of zero means no limit. */
+
+  e->nmax = nmax;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_odeiv2_ensemble_reset_hstart (gsl_odeiv2_ensemble * e,
+                                  const double hstart)
+{
+  /* Resets the step size of every system to hstart, which also sets
+     the direction of integration */
+
+  size_t k;
+
+  if (hstart == 0.0)
+    {
+      GSL_ERROR ("hstart must be non-zero", GSL_EINVAL);
+    }
+
+  for (k = 0; k < e->sys->nsys; k++)
+    {
+      e->h[k] = hstart;
+      e->status[k] = GSL_SUCCESS;
+    }
+
+  e->n = 0;
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_odeiv2_ensemble_apply (gsl_odeiv2_ensemble * e, double t[],
+                           const double t1, double y[])
+{
+  /* Evolves every system of the ensemble from t[k] to t1. The step
+     of each system is controlled separately, and a system drops out
+     of the computation when it reaches t1. If a system fails to
+     reach the required accuracy with the smallest representable step
+     its status is set to GSL_FAILURE, its t[k] and y values are
+     those after its last successful step, and the remaining systems
+     continue. The first such error, or GSL_EMAXITER if the ensemble
+     exceeds nmax steps, is returned. An error from the user function
+     is returned immediately, with all systems at their last
+     successful step. */
+
+  const size_t dim = e->sys->dimension;
+  const size_t nsys = e->sys->nsys;
+  const double *ytmp = e->ytmp;
+  const double S = 0.9;
+  const ensemble_tableau *tab = (const ensemble_tableau *) e->tableau;
+  const unsigned int ord = tab->order;
+  int status = GSL_SUCCESS;
+  size_t active = 0;
+  size_t i, k;
+
+  e->n = 0;
+
+  for (k = 0; k < nsys; k++)
+    {
+      const double sign = (e->h[k] > 0.0) ? 1.0 : -1.0;
+
+      if (sign * (t1 - t[k]) < 0.0)
+        {
+          GSL_ERROR ("integration limits and/or step direction not consistent",
+                     GSL_EINVAL);
+        }
+
+      e->status[k] = GSL_SUCCESS;
+
+      if (t[k] != t1)
+        active++;
+    }
+
+  while (active > 0)
+    {
+      int s;
+
+      if ((e->nmax > 0) && (e->n >= e->nmax))
+        {
+          return GSL_EMAXITER;
+        }
+
+      /* Choose the step of each system, not going past t1. Masked
+         systems take a zero step. */
+
+      for (k = 0; k < nsys; k++)
+        {
+          const double dt = t1 - t[k];
+          double hk = e->h[k];
+
+          if (t[k] == t1 || e->status[k] != GSL_SUCCESS)
+            hk = 0.0;
+          else if ((dt >= 0.0 && hk > dt) || (dt < 0.0 && hk < dt))
+            hk = dt;
+
+          e->hs[k] = hk;
+        }
+
+      s = ensemble_step (e, t, y);
+
+      if (s != GSL_SUCCESS)
+        {
+          return s;
+        }
+
+      for (k = 0; k < nsys; k++)
+        {
+          const double h0 = e->hs[k];
+          const double rmax = e->rmax[k];
+
+          if (h0 == 0.0)
+            continue;
+
+          if (rmax > 1.1)
+            {
+              /* decrease step, no more than factor of 5, and try
+                 again if that changes t by at least 1 ulp */
+
+              double r = S / pow (rmax, 1.0 / ord);
+              double hnew, t_next;
+
+              if (r < 0.2)
+                r = 0.2;
+
+              hnew = r * h0;
+              t_next = GSL_COERCE_DBL (t[k] + hnew);
+
+              if (fabs (hnew) < fabs (h0) && t_next != t[k])
+                {
+                  e->h[k] = hnew;
+                }
+              else
+                {
+                  e->h[k] = hnew;
+                  e->status[k] = GSL_FAILURE;
+                  active--;
+
+                  if (status == GSL_SUCCESS)
+                    status = GSL_FAILURE;
+                }
+
+              continue;
+            }
+
+          /* accept the step */
+
+          for (i = 0; i < dim; i++)
+            y[i * nsys + k] = ytmp[i * nsys + k];
+
+          if (h0 == t1 - t[k])
+            {
+              /* final step; the suggested step is kept for a later
+                 call, as in gsl_odeiv2_evolve_apply */
+
+              t[k] = t1;
+              active--;
+            }
+          else
+            {
+              t[k] += h0;
+
+              if (rmax < 0.5)
+                {
+                  /* increase step, no more than factor of 5 */
+
+                  double r = S / pow (rmax, 1.0 / (ord + 1.0));
+
+                  if (r > 5.0)
+                    r = 5.0;
+
+                  if (r < 1.0)
+                    r = 1.0;
+
+                  e->h[k] = r * h0;
+                }
+              else
+                {
+                  e->h[k] = h0;
+                }
+            }
+        }
+
+      e->n++;
+    }
+
+  return status;
+}
+
+void
+gsl_odeiv2_ensemble_free (gsl_odeiv2_ensemble * e)
+{
+  RETURN_IF_NULL (e);
+
+  if (e->k)
+    free (e->k);
+
+  if (e->ytmp)
+    free (e->ytmp);
+
+  if (e->ts)
+    free (e->ts);
+
+  if (e->h)
+    free (e->h);
+
+  if (e->hs)
+    free (e->hs);
+
+  if (e->rmax)
+    free (e->rmax);
+
+  if (e->status)
+    free (e->status);
+
+  free (e);
+}
+
+/* ensemble_step()
+     Take one step of size e->hs[k] for every system, storing the
+   new values in e->ytmp and the scaled error of each system in
+   e->rmax. The input y is not modified. */
+
+static int
+ensemble_step (gsl_odeiv2_ensemble * e, const double t[], const double y[])
+{
+  const ensemble_tableau *tab = (const ensemble_tableau *) e->tableau;
+  const size_t nsys = e->sys->nsys;
+  const size_t n = e->sys->dimension * nsys;
+  const double *hs = e->hs;
+  double *ytmp = e->ytmp;
+  double *ts = e->ts;
+  const double *a = tab->a;
+  size_t i, j, k, s;
+
+  for (s = 0; s < tab->stages; s++)
+    {
+      double *ks = e->k + s * n;
+      int status;
+
+      if (s == 0)
+        {
+          status = (*e->sys->function) (nsys, t, y, ks, e->sys->params);
+        }
+      else
+        {
+          /* ytmp = y + h sum_j a_sj k_j, one component at a time */
+
+          for (i = 0; i < n; i += nsys)
+            {
+              double *yi = ytmp + i;
+
+              for (k = 0; k < nsys; k++)
+                yi[k] = 0.0;
+
+              for (j = 0; j < s; j++)
+                {
+                  const double *kj = e->k + j * n + i;
+                  const double asj = a[j];
+
+                  if (asj == 0.0)
+                    continue;
+
+                  for (k = 0; k < nsys; k++)
+                    yi[k] += asj * kj[k];
+                }
+
+              for (k = 0; k < nsys; k++)
+                yi[k] = y[i + k] + hs[k] * yi[k];
+            }
+
+          for (k = 0; k < nsys; k++)
+            ts[k] = t[k] + tab->c[s] * hs[k];
+
+          status = (*e->sys->function) (nsys, ts, ytmp, ks, e->sys->params);
+
+          a += s;
+        }
+
+      if (status != GSL_SUCCESS)
+        {
+          return status;
+        }
+    }
+
+  /* new solution in ytmp, and the maximum over the components of
+     |yerr| / (epsabs + epsrel |y|) for each system in rmax, with
+     the error of the current component accumulated in ts */
+
+  for (k = 0; k < nsys; k++)
+    e->rmax[k] = DBL_MIN;
+
+  for (i = 0; i < n; i += nsys)
+    {
+      double *yi = ytmp + i;
+
+      for (k = 0; k < nsys; k++)
+        {
+          yi[k] = 0.0;
+          ts[k] = 0.0;
+        }
+
+      for (j = 0; j < tab->stages; j++)
+        {
+          const double *kj = e->k + j * n + i;
+          const double bj = tab->b[j];
+          const double ej = tab->e[j];
+
+          for (k = 0; k < nsys; k++)
+            {
+              yi[k] += bj * kj[k];
+              ts[k] += ej * kj[k];
+            }
+        }
+
+      for (k = 0; k < nsys; k++)
+        {
+          double D0, r;
+
+          yi[k] = y[i + k] + hs[k] * yi[k];
+
+          D0 = e->epsrel * fabs (yi[k]) + e->epsabs;
+          r = fabs (hs[k] * ts[k]) / D0;
+
+          if (r > e->rmax[k])
+            e->rmax[k] = r;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
@@ -28,6 +28,9 @@
 
 #include "odeiv_util.h"
 
+/* Number of step end points kept for interpolation */
+#define EVOLVE_NHIST 5
+
 gsl_odeiv2_evolve *
 gsl_odeiv2_evolve_alloc (size_t dim)
 {
@@ -78,10 +81,29 @@ gsl_odeiv2_evolve_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for dydt_out", GSL_ENOMEM);
     }
 
+  e->thist = (double *) malloc (EVOLVE_NHIST * sizeof (double));
+  e->yhist = (double *) malloc (EVOLVE_NHIST * dim * sizeof (double));
+  e->dydthist = (double *) malloc (EVOLVE_NHIST * dim * sizeof (double));
+
+  if (e->thist == 0 || e->yhist == 0 || e->dydthist == 0)
+    {
+      free (e->dydthist);
+      free (e->yhist);
+      free (e->thist);
+      free (e->dydt_out);
+      free (e->dydt_in);
+      free (e->yerr);
+      free (e->y0);
+      free (e);
+      GSL_ERROR_NULL ("failed to allocate space for step history",
+                      GSL_ENOMEM);
+    }
+
   e->dimension = dim;
   e->count = 0;
   e->failed_steps = 0;
   e->last_step = 0.0;
+  e->nhist = 0;
   e->driver = NULL;
 
   return e;
@@ -93,6 +115,7 @@ gsl_odeiv2_evolve_reset (gsl_odeiv2_evolve * e)
   e->count = 0;
   e->failed_steps = 0;
   e->last_step = 0.0;
+  e->nhist = 0;
   return GSL_SUCCESS;
 }
 
@@ -100,6 +123,9 @@ void
 gsl_odeiv2_evolve_free (gsl_odeiv2_evolve * e)
 {
   RETURN_IF_NULL (e);
+  free (e->dydthist);
+  free (e->yhist);
+  free (e->thist);
   free (e->dydt_out);
   free (e->dydt_in);
   free (e->yerr);
@@ -107,6 +133,51 @@ gsl_odeiv2_evolve_free (gsl_odeiv2_evolve * e)
   free (e);
 }
 
+/* Appends the end point t1 of an accepted step from t0 to the step
+   history. The history is restarted if the step does not continue
+   from the last saved point, e.g. after y has been modified. */
+
+static void
+evolve_save (gsl_odeiv2_evolve * e, const double t0, const double t1,
+             const double y[])
+{
+  const size_t dim = e->dimension;
+  size_t n = e->nhist;
+
+  if (n > 0)
+    {
+      const double *ylast = e->yhist + (n - 1) * dim;
+
+      if (e->thist[n - 1] != t0
+          || memcmp (ylast, e->y0, dim * sizeof (double)) != 0)
+        {
+          n = 0;
+        }
+    }
+
+  if (n == 0)
+    {
+      e->thist[0] = t0;
+      DBL_MEMCPY (e->yhist, e->y0, dim);
+      DBL_MEMCPY (e->dydthist, e->dydt_in, dim);
+      n = 1;
+    }
+
+  if (n == EVOLVE_NHIST)
+    {
+      memmove (e->thist, e->thist + 1, (n - 1) * sizeof (double));
+      memmove (e->yhist, e->yhist + dim, (n - 1) * dim * sizeof (double));
+      memmove (e->dydthist, e->dydthist + dim,
+               (n - 1) * dim * sizeof (double));
+      n--;
+    }
+
+  e->thist[n] = t1;
+  DBL_MEMCPY (e->yhist + n * dim, y, dim);
+  DBL_MEMCPY (e->dydthist + n * dim, e->dydt_out, dim);
+  e->nhist = n + 1;
+}
+
 /* Evolution framework method.
  *
  * Uses an adaptive step control object
@@ -284,6 +355,10 @@ try_step:
         }
     }
 
+  /* Save the end point of the accepted step for interpolation */
+
+  evolve_save (e, t0, *t, y);
+
   /* Suggest step size for next time-step. Change of step size is not
      suggested in the final step, because that step can be very
      small compared to previous step, to reach t1. 
@@ -376,9 +451,125 @@ gsl_odeiv2_evolve_apply_fixed_step (gsl_odeiv2_evolve * e,
   e->last_step = h;
   *t = t0 + h;
 
+  evolve_save (e, t0, *t, y);
+
   return GSL_SUCCESS;
 }
 
+/* Evaluates the solution at t within the last step taken by
+   gsl_odeiv2_evolve_apply, without evaluating the system function.
+   Steppers which keep a solution polynomial (e.g. Nordsieck history)
+   provide their own interpolant. For others the Hermite polynomial
+   matching y and dydt at the end points of the last steps is used,
+   with as many points as needed to match the order of the stepper,
+   i.e. the cubic Hermite polynomial over the last step for low order
+   methods.
+*/
+
+int
+gsl_odeiv2_evolve_interp (const gsl_odeiv2_evolve * e,
+                          const gsl_odeiv2_step * step, const double t,
+                          double y[])
+{
+  const size_t dim = e->dimension;
+  const size_t n = e->nhist;
+  double ta, tb;
+
+  if (n < 2)
+    {
+      GSL_ERROR ("no step has been taken", GSL_EFAILED);
+    }
+
+  if (step->dimension != dim)
+    {
+      GSL_ERROR ("step dimension must match evolution size", GSL_EINVAL);
+    }
+
+  ta = e->thist[n - 2];
+  tb = e->thist[n - 1];
+
+  if ((tb > ta && (t < ta || t > tb)) || (tb < ta && (t > ta || t < tb)))
+    {
+      GSL_ERROR ("t is outside of the last step", GSL_EDOM);
+    }
+
+  if (t == tb)
+    {
+      DBL_MEMCPY (y, e->yhist + (n - 1) * dim, dim);
+      return GSL_SUCCESS;
+    }
+
+  if (step->type->interp != NULL)
+    {
+      return step->type->interp (step->state, dim, t - tb, y);
+    }
+  else if (!step->type->can_use_dydt_in || !step->type->gives_exact_dydt_out)
+    {
+      GSL_ERROR ("stepper does not provide derivatives for interpolation",
+                 GSL_EUNIMPL);
+    }
+  else
+    {
+      /* Newton form of the Hermite polynomial with the double nodes
+         tb, tb, ta, ta, ... from the most recent point backwards */
+
+      const size_t ord = gsl_odeiv2_step_order (step);
+      const size_t nz = 2 * GSL_MAX (GSL_MIN (n, ord / 2 + 1), 2);
+      double z[2 * EVOLVE_NHIST], c[2 * EVOLVE_NHIST];
+      size_t i, j, l;
+
+      for (j = 0; j < nz; j++)
+        {
+          z[j] = e->thist[n - 1 - j / 2];
+        }
+
+      for (i = 0; i < dim; i++)
+        {
+          double sum;
+
+          /* first divided differences, dydt at the double nodes */
+
+          c[0] = e->yhist[(n - 1) * dim + i];
+
+          for (j = 1; j < nz; j++)
+            {
+              const size_t p = n - 1 - j / 2;
+
+              if (j % 2 == 1)
+                {
+                  c[j] = e->dydthist[p * dim + i];
+                }
+              else
+                {
+                  c[j] = (e->yhist[p * dim + i] - e->yhist[(p + 1) * dim + i])
+                    / (z[j] - z[j - 1]);
+                }
+            }
+
+          /* higher divided differences */
+
+          for (l = 2; l < nz; l++)
+            {
+              for (j = nz - 1; j >= l; j--)
+                {
+                  c[j] = (c[j] - c[j - 1]) / (z[j] - z[j - l]);
+                }
+            }
+
+          sum = c[nz - 1];
+
+          for (j = nz - 1; j-- > 0;)
+            {
+              sum = sum * (t - z[j]) + c[j];
+            }
+
+          y[i] = sum;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
 int
 gsl_odeiv2_evolve_set_driver (gsl_odeiv2_evolve * e,
                               const gsl_odeiv2_driver * d)
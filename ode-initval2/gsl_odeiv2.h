@@ -95,6 +95,7 @@ typedef struct
   int (*reset) (void *state, size_t dim);
   unsigned int (*order) (void *state);
   void (*free) (void *state);
+  int (*interp) (void *state, size_t dim, double s, double y[]);
 }
 gsl_odeiv2_step_type;
 
@@ -240,6 +241,10 @@ struct gsl_odeiv2_evolve_struct
   unsigned long int count;
   unsigned long int failed_steps;
   const gsl_odeiv2_driver *driver;
+  double *thist;                /* end points of the last steps */
+  double *yhist;                /* y at the end points */
+  double *dydthist;             /* dydt at the end points */
+  size_t nhist;                 /* number of saved end points */
 };
 
 /* Evolution object methods */
@@ -255,17 +260,47 @@ int gsl_odeiv2_evolve_apply_fixed_step (gsl_odeiv2_evolve * e,
                                         const gsl_odeiv2_system * dydt,
                                         double *t, const double h0,
                                         double y[]);
+int gsl_odeiv2_evolve_interp (const gsl_odeiv2_evolve * e,
+                              const gsl_odeiv2_step * step, const double t,
+                              double y[]);
 int gsl_odeiv2_evolve_reset (gsl_odeiv2_evolve * e);
 void gsl_odeiv2_evolve_free (gsl_odeiv2_evolve * e);
 int gsl_odeiv2_evolve_set_driver (gsl_odeiv2_evolve * e,
                                   const gsl_odeiv2_driver * d);
 
+/* Event functions
+ *
+ * An event occurs when one of the nevents functions g[i](t,y)
+ * computed by function changes sign, in the given direction (+1
+ * increasing, -1 decreasing, 0 either, all 0 if direction is NULL).
+ * The action is called at the located event time and returns one of
+ * the GSL_ODEIV2_EVENT_xxx values below. A NULL action stops the
+ * integration at every event.
+ */
+
+typedef struct
+{
+  int (*function) (double t, const double y[], double g[], void *params);
+  int (*action) (double t, double y[], size_t i, void *params);
+  size_t nevents;
+  const int *direction;
+  void *params;
+}
+gsl_odeiv2_event;
+
+#define GSL_ODEIV2_EVENT_CONTINUE 0     /* continue, y is not changed */
+#define GSL_ODEIV2_EVENT_STOP     1     /* return at the event */
+#define GSL_ODEIV2_EVENT_RESTART  2     /* y was changed, restart there */
+
 /* Driver object
  *
  * This is a high level wrapper for step, control and
  * evolve objects. 
  */
 
+/* gsl_spmatrix, declared here without including gsl_spmatrix.h */
+struct gsl_spmatrix_struct;
+
 struct gsl_odeiv2_driver_struct
 {
   const gsl_odeiv2_system *sys; /* ODE system */
@@ -277,8 +312,39 @@ struct gsl_odeiv2_driver_struct
   double hmax;                  /* maximum step size allowed */
   unsigned long int n;          /* number of steps taken */
   unsigned long int nmax;       /* Maximum number of steps allowed */
+  int jac_type;                 /* storage of the Jacobian, GSL_ODEIV2_JAC_xxx */
+  size_t kl;                    /* lower bandwidth of banded Jacobian */
+  size_t ku;                    /* upper bandwidth of banded Jacobian */
+  size_t nblock;                /* number of blocks of block Jacobian */
+  int (*jacobian_sparse) (double t, const double y[],
+                          struct gsl_spmatrix_struct * dfdy,
+                          double dfdt[], void *params);
+  int (*jacobian_block) (double t, const double y[], double *dfdy,
+                         double dfdt[], void *params);
+  const gsl_odeiv2_event *ev;   /* event functions */
+  double *evwork;               /* workspace for event location */
+  double tev;                   /* time returned at the last event */
+  int ievent;                   /* event which stopped the last apply */
+  int pending;                  /* returned t is inside the last step */
 };
 
+/* Storage of the Jacobian used by implicit steppers
+ *
+ * DENSE:  dfdy is a dim-by-dim matrix in row-order (default)
+ * BANDED: dfdy has kl + ku + 1 values per row, element (i,j) of the
+ *         Jacobian is stored in dfdy[i * (kl + ku + 1) + j - i + kl]
+ * SPARSE: the Jacobian is set in a gsl_spmatrix in triplet format
+ * BLOCK:  the system consists of nblock blocks of equal size, and the
+ *         block Jacobian function sets the Jacobian of the first block
+ *         only, which approximates the diagonal blocks of the whole
+ *         Jacobian
+ */
+
+#define GSL_ODEIV2_JAC_DENSE  0
+#define GSL_ODEIV2_JAC_BANDED 1
+#define GSL_ODEIV2_JAC_SPARSE 2
+#define GSL_ODEIV2_JAC_BLOCK  3
+
 /* Driver object methods */
 
 gsl_odeiv2_driver *gsl_odeiv2_driver_alloc_y_new (const gsl_odeiv2_system *
@@ -319,8 +385,30 @@ int gsl_odeiv2_driver_set_hmin (gsl_odeiv2_driver * d, const double hmin);
 int gsl_odeiv2_driver_set_hmax (gsl_odeiv2_driver * d, const double hmax);
 int gsl_odeiv2_driver_set_nmax (gsl_odeiv2_driver * d,
                                 const unsigned long int nmax);
+int gsl_odeiv2_driver_set_jacobian_banded (gsl_odeiv2_driver * d,
+                                           const size_t kl, const size_t ku);
+int gsl_odeiv2_driver_set_jacobian_block (gsl_odeiv2_driver * d,
+                                          const size_t nblock,
+                                          int (*jacobian) (double t,
+                                                           const double y[],
+                                                           double *dfdy,
+                                                           double dfdt[],
+                                                           void *params));
+int gsl_odeiv2_driver_set_jacobian_sparse (gsl_odeiv2_driver * d,
+                                           int (*jacobian) (double t,
+                                                            const double y[],
+                                                            struct
+                                                            gsl_spmatrix_struct
+                                                            * dfdy,
+                                                            double dfdt[],
+                                                            void *params));
+int gsl_odeiv2_driver_set_events (gsl_odeiv2_driver * d,
+                                  const gsl_odeiv2_event * ev);
 int gsl_odeiv2_driver_apply (gsl_odeiv2_driver * d, double *t,
                              const double t1, double y[]);
+int gsl_odeiv2_driver_apply_dense (gsl_odeiv2_driver * d, double *t,
+                                   const size_t n, const double tout[],
+                                   double yout[], double y[]);
 int gsl_odeiv2_driver_apply_fixed_step (gsl_odeiv2_driver * d, double *t,
                                         const double h,
                                         const unsigned long int n,
@@ -329,5 +417,134 @@ int gsl_odeiv2_driver_reset (gsl_odeiv2_driver * d);
 int gsl_odeiv2_driver_reset_hstart (gsl_odeiv2_driver * d, const double hstart);
 void gsl_odeiv2_driver_free (gsl_odeiv2_driver * state);
 
+/* Ensemble of independent systems of ODEs
+ *
+ * nsys systems of the same dimension, stored component-major so that
+ * y[i * nsys + k] is component i of system k. The function computes
+ * the derivatives of all the systems at once, system k at time t[k].
+ */
+
+typedef struct
+{
+  int (*function) (size_t nsys, const double t[], const double y[],
+                   double dydt[], void *params);
+  size_t dimension;
+  size_t nsys;
+  void *params;
+}
+gsl_odeiv2_ensemble_system;
+
+/* Ensemble driver object
+ *
+ * Integrates the systems of an ensemble with an explicit embedded
+ * Runge-Kutta method, with a separate step size for each system.
+ */
+
+typedef struct
+{
+  const gsl_odeiv2_ensemble_system *sys; /* ODE systems */
+  const gsl_odeiv2_step_type *type;      /* stepper type */
+  const void *tableau;          /* Runge-Kutta coefficients */
+  double epsabs;                /* absolute error tolerance */
+  double epsrel;                /* relative error tolerance */
+  double *k;                    /* stage derivatives */
+  double *ytmp;                 /* stage values and new solution */
+  double *ts;                   /* stage times, nsys */
+  double *h;                    /* step size of each system, nsys */
+  double *hs;                   /* step being taken, nsys */
+  double *rmax;                 /* scaled error of each system, nsys */
+  int *status;                  /* status of each system, nsys */
+  unsigned long int n;          /* number of ensemble steps taken */
+  unsigned long int nmax;       /* Maximum number of steps allowed */
+}
+gsl_odeiv2_ensemble;
+
+gsl_odeiv2_ensemble *gsl_odeiv2_ensemble_alloc (const
+                                                gsl_odeiv2_ensemble_system *
+                                                sys,
+                                                const gsl_odeiv2_step_type *
+                                                T, const double hstart,
+                                                const double epsabs,
+                                                const double epsrel);
+int gsl_odeiv2_ensemble_set_nmax (gsl_odeiv2_ensemble * e,
+                                  const unsigned long int nmax);
+int gsl_odeiv2_ensemble_apply (gsl_odeiv2_ensemble * e, double t[],
+                               const double t1, double y[]);
+int gsl_odeiv2_ensemble_reset_hstart (gsl_odeiv2_ensemble * e,
+                                      const double hstart);
+void gsl_odeiv2_ensemble_free (gsl_odeiv2_ensemble * e);
+
+/* System with parameters for sensitivity analysis
+ *
+ * As gsl_odeiv2_system, with the derivatives dfdp of f with respect
+ * to the nparams parameters, a dimension-by-nparams matrix in
+ * row-order. The jacobian function is required.
+ */
+
+typedef struct
+{
+  int (*function) (double t, const double y[], double dydt[], void *params);
+  int (*jacobian) (double t, const double y[], double *dfdy, double dfdt[],
+                   void *params);
+  int (*dfdp) (double t, const double y[], double *dfdp, void *params);
+  size_t dimension;
+  size_t nparams;
+  void *params;
+}
+gsl_odeiv2_sens_system;
+
+/* Sensitivity object
+ *
+ * Forward sensitivities are integrated together with the state, with
+ * the sensitivities to parameter k stored after the state as block
+ * k + 1. Adjoint sensitivities are integrated backwards, with the
+ * state recomputed from checkpoints saved in a forward pass.
+ */
+
+typedef struct
+{
+  const gsl_odeiv2_sens_system *sys;    /* ODE system */
+  const gsl_odeiv2_step_type *type;     /* stepper type */
+  double hstart;                /* initial step size */
+  gsl_odeiv2_system ysys;       /* state */
+  gsl_odeiv2_system fsys;       /* state and forward sensitivities */
+  gsl_odeiv2_system asys;       /* adjoint and parameter gradient */
+  gsl_odeiv2_driver *ydriver;   /* driver of state */
+  gsl_odeiv2_driver *fdriver;   /* driver of forward sensitivities */
+  gsl_odeiv2_driver *adriver;   /* driver of adjoint */
+  double *yf;                   /* state and forward sensitivities */
+  double *J;                    /* Jacobian dfdy */
+  double *fp;                   /* derivatives dfdp */
+  double *dfdt;                 /* time derivative of f */
+  double *y;                    /* interpolated state */
+  size_t interval;              /* steps between checkpoints */
+  size_t nsteps;                /* number of forward steps */
+  size_t nalloc;                /* allocated forward steps */
+  double *tstep;                /* end points of forward steps */
+  double *ycheck;               /* checkpoints */
+  size_t nreplay;               /* number of points of replayed steps */
+  size_t nralloc;               /* allocated replayed points */
+  double *treplay;              /* end points of replayed steps */
+  double *yreplay;              /* y at treplay */
+  double *freplay;              /* dydt at treplay */
+}
+gsl_odeiv2_sens;
+
+gsl_odeiv2_sens *gsl_odeiv2_sens_alloc (const gsl_odeiv2_sens_system * sys,
+                                        const gsl_odeiv2_step_type * T,
+                                        const double hstart,
+                                        const double epsabs,
+                                        const double epsrel);
+int gsl_odeiv2_sens_apply (gsl_odeiv2_sens * s, double *t, const double t1,
+                           double y[], double S[]);
+int gsl_odeiv2_sens_reset (gsl_odeiv2_sens * s);
+int gsl_odeiv2_sens_set_checkpoint (gsl_odeiv2_sens * s,
+                                    const size_t interval);
+int gsl_odeiv2_sens_adjoint (gsl_odeiv2_sens * s, const double t0,
+                             const double y0[], const double t1,
+                             const double lambda1[], double y1[],
+                             double lambda0[], double grad[]);
+void gsl_odeiv2_sens_free (gsl_odeiv2_sens * s);
+
 __END_DECLS
 #endif /* __GSL_ODEIV2_H__ */
@@ -0,0 +1,526 @@
+/* ode-initval2/itermatrix.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Newton iteration matrix M = I - gamma * J for implicit steppers,
+   with the Jacobian J stored as selected in the driver:
+
+   GSL_ODEIV2_JAC_DENSE:  dim-by-dim matrix, M is factored by
+                          gsl_linalg_LU_decomp
+
+   GSL_ODEIV2_JAC_BANDED: row i holds J(i,j) for j = i-kl..i+ku at
+                          offset j - i + kl, M is factored by banded
+                          Gaussian elimination with partial pivoting,
+                          which needs kl extra superdiagonals for the
+                          fill
+
+   GSL_ODEIV2_JAC_SPARSE: J is filled by the sparse Jacobian function
+                          of the driver, and M x = b is solved by GMRES
+                          after scaling the rows of M by the inverse
+                          of its diagonal
+
+   GSL_ODEIV2_JAC_BLOCK:  the system consists of nblock blocks of equal
+                          size, J of the first block is filled by the
+                          block Jacobian function of the driver, and M
+                          is approximated by the iteration matrix of
+                          the first block, repeated on the diagonal,
+                          which is factored by gsl_linalg_LU_decomp
+*/
+
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/* relative tolerance and maximum number of restarts of GMRES */
+#define ITERMATRIX_GMRES_TOL 1.0e-10
+#define ITERMATRIX_GMRES_MAXRESTART 20
+
+typedef struct
+{
+  int type;                     /* GSL_ODEIV2_JAC_xxx */
+  size_t dim;
+  size_t kl;                    /* lower bandwidth */
+  size_t ku;                    /* upper bandwidth */
+  size_t nblock;                /* number of diagonal blocks */
+  gsl_matrix *dfdy;             /* dense or banded Jacobian */
+  gsl_matrix *M;                /* dense or banded LU of M */
+  gsl_permutation *p;           /* permutation of dense LU */
+  size_t *ipiv;                 /* row interchanges of banded LU */
+  gsl_spmatrix *J;              /* sparse Jacobian, triplet */
+  gsl_spmatrix *Ms;             /* scaled sparse M, compressed row */
+  double *Jval;                 /* J in the pattern of Ms */
+  size_t *diag;                 /* positions of diagonal in Ms */
+  gsl_vector *dinv;             /* inverse of diagonal of M */
+  gsl_vector *b;                /* scaled right hand side */
+  gsl_splinalg_itersolve *solver;
+}
+itermatrix_t;
+
+static void
+itermatrix_free (itermatrix_t * m)
+{
+  if (m->dfdy)
+    gsl_matrix_free (m->dfdy);
+
+  if (m->M)
+    gsl_matrix_free (m->M);
+
+  if (m->p)
+    gsl_permutation_free (m->p);
+
+  if (m->ipiv)
+    free (m->ipiv);
+
+  if (m->J)
+    gsl_spmatrix_free (m->J);
+
+  if (m->Ms)
+    gsl_spmatrix_free (m->Ms);
+
+  if (m->Jval)
+    free (m->Jval);
+
+  if (m->diag)
+    free (m->diag);
+
+  if (m->dinv)
+    gsl_vector_free (m->dinv);
+
+  if (m->b)
+    gsl_vector_free (m->b);
+
+  if (m->solver)
+    gsl_splinalg_itersolve_free (m->solver);
+
+  free (m);
+}
+
+static itermatrix_t *
+itermatrix_alloc (const size_t dim, const int type, const size_t kl,
+                  const size_t ku, const size_t nblock)
+{
+  itermatrix_t *m = (itermatrix_t *) calloc (1, sizeof (itermatrix_t));
+
+  if (m == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for iteration matrix",
+                      GSL_ENOMEM);
+    }
+
+  m->type = type;
+  m->dim = dim;
+  m->kl = kl;
+  m->ku = ku;
+
+  if (type == GSL_ODEIV2_JAC_BANDED)
+    {
+      m->dfdy = gsl_matrix_alloc (dim, kl + ku + 1);
+      m->M = gsl_matrix_alloc (dim, 2 * kl + ku + 1);
+      m->ipiv = (size_t *) malloc (dim * sizeof (size_t));
+
+      if (m->dfdy == 0 || m->M == 0 || m->ipiv == 0)
+        {
+          itermatrix_free (m);
+          GSL_ERROR_NULL ("failed to allocate space for banded matrices",
+                          GSL_ENOMEM);
+        }
+    }
+  else if (type == GSL_ODEIV2_JAC_SPARSE)
+    {
+      m->J = gsl_spmatrix_alloc (dim, dim);
+      m->dinv = gsl_vector_alloc (dim);
+      m->b = gsl_vector_alloc (dim);
+      m->diag = (size_t *) malloc (dim * sizeof (size_t));
+      m->solver = gsl_splinalg_itersolve_alloc (gsl_splinalg_itersolve_gmres,
+                                                dim, 0);
+
+      if (m->J == 0 || m->dinv == 0 || m->b == 0 || m->diag == 0
+          || m->solver == 0)
+        {
+          itermatrix_free (m);
+          GSL_ERROR_NULL ("failed to allocate space for sparse matrices",
+                          GSL_ENOMEM);
+        }
+    }
+  else
+    {
+      const size_t nb = (type == GSL_ODEIV2_JAC_BLOCK) ? dim / nblock : dim;
+
+      m->nblock = (type == GSL_ODEIV2_JAC_BLOCK) ? nblock : 1;
+      m->dfdy = gsl_matrix_alloc (nb, nb);
+      m->M = gsl_matrix_alloc (nb, nb);
+      m->p = gsl_permutation_alloc (nb);
+
+      if (m->dfdy == 0 || m->M == 0 || m->p == 0)
+        {
+          itermatrix_free (m);
+          GSL_ERROR_NULL ("failed to allocate space for dense matrices",
+                          GSL_ENOMEM);
+        }
+    }
+
+  return m;
+}
+
+/* itermatrix_sparse_pattern()
+     Build Ms, in compressed row format, with the pattern of the
+   sparse Jacobian and the whole diagonal, and store the Jacobian
+   values in that pattern in Jval */
+
+static int
+itermatrix_sparse_pattern (itermatrix_t * m)
+{
+  const size_t dim = m->dim;
+  gsl_spmatrix *Jr = gsl_spmatrix_crs (m->J);
+  size_t i, k, q, nnz;
+
+  if (Jr == 0)
+    {
+      GSL_ERROR ("failed to compress Jacobian", GSL_ENOMEM);
+    }
+
+  /* count the entries, adding missing diagonal elements */
+
+  nnz = Jr->p[dim];
+
+  for (i = 0; i < dim; i++)
+    {
+      int found = 0;
+
+      for (k = Jr->p[i]; k < Jr->p[i + 1]; k++)
+        {
+          if (Jr->i[k] == i)
+            found = 1;
+        }
+
+      if (!found)
+        nnz++;
+    }
+
+  if (m->Ms == 0 || m->Ms->nzmax < nnz)
+    {
+      if (m->Ms)
+        gsl_spmatrix_free (m->Ms);
+
+      if (m->Jval)
+        free (m->Jval);
+
+      m->Ms = gsl_spmatrix_alloc_nzmax (dim, dim, nnz, GSL_SPMATRIX_CRS);
+      m->Jval = (double *) malloc (nnz * sizeof (double));
+
+      if (m->Ms == 0 || m->Jval == 0)
+        {
+          gsl_spmatrix_free (Jr);
+          GSL_ERROR ("failed to allocate space for iteration matrix",
+                     GSL_ENOMEM);
+        }
+    }
+
+  /* copy the rows, appending the diagonal where it is missing */
+
+  q = 0;
+
+  for (i = 0; i < dim; i++)
+    {
+      int found = 0;
+
+      m->Ms->p[i] = q;
+
+      for (k = Jr->p[i]; k < Jr->p[i + 1]; k++)
+        {
+          const size_t j = Jr->i[k];
+
+          if (j == i)
+            {
+              m->diag[i] = q;
+              found = 1;
+            }
+
+          m->Ms->i[q] = j;
+          m->Jval[q] = Jr->data[k];
+          q++;
+        }
+
+      if (!found)
+        {
+          m->Ms->i[q] = i;
+          m->Jval[q] = 0.0;
+          m->diag[i] = q++;
+        }
+    }
+
+  m->Ms->p[dim] = q;
+  m->Ms->nz = q;
+
+  gsl_spmatrix_free (Jr);
+
+  return GSL_SUCCESS;
+}
+
+/* itermatrix_jac()
+     Evaluate the Jacobian at (t,y) */
+
+static int
+itermatrix_jac (itermatrix_t * m, const gsl_odeiv2_system * sys,
+                const gsl_odeiv2_driver * d, const double t,
+                const double y[], double dfdt[])
+{
+  int s;
+
+  if (m->type == GSL_ODEIV2_JAC_SPARSE)
+    {
+      gsl_spmatrix_set_zero (m->J);
+
+      s = d->jacobian_sparse (t, y, m->J, dfdt, sys->params);
+
+      if (s == GSL_SUCCESS)
+        s = itermatrix_sparse_pattern (m);
+    }
+  else if (m->type == GSL_ODEIV2_JAC_BLOCK)
+    {
+      s = d->jacobian_block (t, y, m->dfdy->data, dfdt, sys->params);
+    }
+  else
+    {
+      /* entries of the band outside the matrix are not set by the
+         user, so start from zero */
+
+      if (m->type == GSL_ODEIV2_JAC_BANDED)
+        gsl_matrix_set_zero (m->dfdy);
+
+      s = GSL_ODEIV_JA_EVAL (sys, t, y, m->dfdy->data, dfdt);
+    }
+
+  return s;
+}
+
+/* itermatrix_update()
+     Form M = I - gamma * J and factor it */
+
+static int
+itermatrix_update (itermatrix_t * m, const double gamma)
+{
+  const size_t dim = m->dim;
+  size_t i, j, k;
+
+  if (m->type == GSL_ODEIV2_JAC_DENSE || m->type == GSL_ODEIV2_JAC_BLOCK)
+    {
+      int signum;
+
+      gsl_matrix_memcpy (m->M, m->dfdy);
+      gsl_matrix_scale (m->M, -gamma);
+
+      for (i = 0; i < m->M->size1; i++)
+        {
+          gsl_matrix_set (m->M, i, i, gsl_matrix_get (m->M, i, i) + 1.0);
+        }
+
+      return gsl_linalg_LU_decomp (m->M, m->p, &signum);
+    }
+  else if (m->type == GSL_ODEIV2_JAC_BANDED)
+    {
+      const size_t kl = m->kl;
+      const size_t ku = m->ku;
+      const size_t wj = kl + ku + 1;
+      const size_t w = 2 * kl + ku + 1;
+      double *B = m->M->data;
+
+      /* B(i,j) = B[i * w + j - i + kl] for i - kl <= j <= i + ku + kl */
+
+      for (i = 0; i < dim; i++)
+        {
+          for (k = 0; k < w; k++)
+            B[i * w + k] = (k < wj) ? -gamma * m->dfdy->data[i * wj + k] : 0.0;
+
+          B[i * w + kl] += 1.0;
+        }
+
+      for (k = 0; k < dim; k++)
+        {
+          const size_t rmax = GSL_MIN (k + kl, dim - 1);
+          const size_t jmax = GSL_MIN (k + ku + kl, dim - 1);
+          size_t piv = k;
+          double amax = fabs (B[k * w + kl]);
+
+          for (i = k + 1; i <= rmax; i++)
+            {
+              const double a = fabs (B[i * w + k - i + kl]);
+
+              if (a > amax)
+                {
+                  amax = a;
+                  piv = i;
+                }
+            }
+
+          m->ipiv[k] = piv;
+
+          /* singular, let the caller reduce the step size */
+
+          if (amax == 0.0)
+            {
+              return GSL_EDOM;
+            }
+
+          if (piv != k)
+            {
+              for (j = k; j <= jmax; j++)
+                {
+                  const double tmp = B[k * w + j - k + kl];
+                  B[k * w + j - k + kl] = B[piv * w + j - piv + kl];
+                  B[piv * w + j - piv + kl] = tmp;
+                }
+            }
+
+          for (i = k + 1; i <= rmax; i++)
+            {
+              const double lik = B[i * w + k - i + kl] / B[k * w + kl];
+
+              B[i * w + k - i + kl] = lik;
+
+              for (j = k + 1; j <= jmax; j++)
+                B[i * w + j - i + kl] -= lik * B[k * w + j - k + kl];
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      double *Md = m->Ms->data;
+
+      for (k = 0; k < m->Ms->nz; k++)
+        Md[k] = -gamma * m->Jval[k];
+
+      for (i = 0; i < dim; i++)
+        {
+          const double mii = Md[m->diag[i]] + 1.0;
+          const double di = (mii != 0.0) ? 1.0 / mii : 1.0;
+
+          Md[m->diag[i]] = mii;
+          gsl_vector_set (m->dinv, i, di);
+
+          for (k = m->Ms->p[i]; k < m->Ms->p[i + 1]; k++)
+            Md[k] *= di;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* itermatrix_solve()
+     Solve M x = b using the factorization from itermatrix_update */
+
+static int
+itermatrix_solve (itermatrix_t * m, const gsl_vector * b, gsl_vector * x)
+{
+  const size_t dim = m->dim;
+  size_t i, k;
+
+  if (m->type == GSL_ODEIV2_JAC_DENSE)
+    {
+      return gsl_linalg_LU_solve (m->M, m->p, b, x);
+    }
+  else if (m->type == GSL_ODEIV2_JAC_BLOCK)
+    {
+      const size_t nb = m->M->size1;
+
+      for (k = 0; k < m->nblock; k++)
+        {
+          gsl_vector_const_view bk = gsl_vector_const_subvector (b, k * nb, nb);
+          gsl_vector_view xk = gsl_vector_subvector (x, k * nb, nb);
+          int s = gsl_linalg_LU_solve (m->M, m->p, &bk.vector, &xk.vector);
+
+          if (s != GSL_SUCCESS)
+            {
+              return s;
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+  else if (m->type == GSL_ODEIV2_JAC_BANDED)
+    {
+      const size_t kl = m->kl;
+      const size_t ku = m->ku;
+      const size_t w = 2 * kl + ku + 1;
+      const double *B = m->M->data;
+      double *xd = x->data;
+      const size_t stride = x->stride;
+
+      gsl_vector_memcpy (x, b);
+
+      /* apply the row interchanges and L */
+
+      for (k = 0; k < dim; k++)
+        {
+          const size_t piv = m->ipiv[k];
+          const size_t rmax = GSL_MIN (k + kl, dim - 1);
+          double xk;
+
+          if (piv != k)
+            {
+              const double tmp = xd[k * stride];
+              xd[k * stride] = xd[piv * stride];
+              xd[piv * stride] = tmp;
+            }
+
+          xk = xd[k * stride];
+
+          for (i = k + 1; i <= rmax; i++)
+            xd[i * stride] -= B[i * w + k - i + kl] * xk;
+        }
+
+      /* back substitution with U, which has kl + ku superdiagonals */
+
+      for (i = dim; i-- > 0;)
+        {
+          const size_t jmax = GSL_MIN (i + ku + kl, dim - 1);
+          double sum = xd[i * stride];
+          size_t j;
+
+          for (j = i + 1; j <= jmax; j++)
+            sum -= B[i * w + j - i + kl] * xd[j * stride];
+
+          xd[i * stride] = sum / B[i * w + kl];
+        }
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      int status;
+      size_t iter = 0;
+
+      gsl_vector_memcpy (m->b, b);
+      gsl_vector_mul (m->b, m->dinv);
+      gsl_vector_set_zero (x);
+
+      do
+        {
+          status = gsl_splinalg_itersolve_iterate (m->Ms, m->b,
+                                                   ITERMATRIX_GMRES_TOL, x,
+                                                   m->solver);
+        }
+      while (status == GSL_CONTINUE && ++iter < ITERMATRIX_GMRES_MAXRESTART);
+
+      if (status != GSL_SUCCESS)
+        {
+          return GSL_FAILURE;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
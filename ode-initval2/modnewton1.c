@@ -19,6 +19,11 @@
 
 /* A modified Newton iteration method for solving non-linear 
    equations in implicit Runge-Kutta methods.
+
+   For one-stage methods the iteration matrix I - h a J is the one of
+   itermatrix.c, so the Jacobian can be stored as selected in the
+   driver. Methods with more stages couple the stages through A, and
+   use a dense Jacobian.
 */
 
 /* References: 
@@ -42,12 +47,19 @@
 #include <gsl/gsl_blas.h>
 
 #include "odeiv_util.h"
+#include "itermatrix.c"
 
 typedef struct
 {
-  /* iteration matrix I - h A (*) J */
+  /* number of stages of the method */
+  size_t stage;
+
+  /* iteration matrix I - h A (*) J, for more than one stage */
   gsl_matrix *IhAJ;
 
+  /* Jacobian and iteration matrix, for one stage */
+  itermatrix_t *im;
+
   /* permutation for LU-decomposition */
   gsl_permutation *p;
 
@@ -83,21 +95,32 @@ modnewton1_alloc (size_t dim, size_t stage)
                       GSL_ENOMEM);
     }
 
-  state->IhAJ = gsl_matrix_alloc (dim * stage, dim * stage);
+  state->stage = stage;
+  state->IhAJ = NULL;
+  state->p = NULL;
+  state->im = NULL;
 
-  if (state->IhAJ == 0)
+  /* the iteration matrix of a one-stage method is allocated when the
+     Jacobian is first evaluated, with the storage selected then */
+
+  if (stage > 1)
     {
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for IhAJ", GSL_ENOMEM);
-    }
+      state->IhAJ = gsl_matrix_alloc (dim * stage, dim * stage);
 
-  state->p = gsl_permutation_alloc (dim * stage);
+      if (state->IhAJ == 0)
+        {
+          free (state);
+          GSL_ERROR_NULL ("failed to allocate space for IhAJ", GSL_ENOMEM);
+        }
 
-  if (state->p == 0)
-    {
-      gsl_matrix_free (state->IhAJ);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for p", GSL_ENOMEM);
+      state->p = gsl_permutation_alloc (dim * stage);
+
+      if (state->p == 0)
+        {
+          gsl_matrix_free (state->IhAJ);
+          free (state);
+          GSL_ERROR_NULL ("failed to allocate space for p", GSL_ENOMEM);
+        }
     }
 
   state->dYk = gsl_vector_alloc (dim * stage);
@@ -165,13 +188,59 @@ modnewton1_alloc (size_t dim, size_t stage)
   return state;
 }
 
+static int
+modnewton1_jac (void *vstate, const gsl_odeiv2_system * sys,
+                const gsl_odeiv2_driver * d, const double t,
+                const double y[], gsl_matrix * dfdy, double dfdt[])
+{
+  /* Evaluates the Jacobian at (t,y). For a one-stage method it is
+     stored in the iteration matrix object, in the storage selected by
+     the driver d (dense if d is NULL), otherwise in dfdy.
+   */
+
+  modnewton1_state_t *state = (modnewton1_state_t *) vstate;
+
+  if (state->stage > 1)
+    {
+      return GSL_ODEIV_JA_EVAL (sys, t, y, dfdy->data, dfdt);
+    }
+
+  {
+    const int type = (d != NULL) ? d->jac_type : GSL_ODEIV2_JAC_DENSE;
+    const size_t kl = (d != NULL) ? d->kl : 0;
+    const size_t ku = (d != NULL) ? d->ku : 0;
+    const size_t nblock = (d != NULL) ? d->nblock : 1;
+    itermatrix_t *im = state->im;
+
+    if (im == NULL || im->type != type || im->kl != kl || im->ku != ku ||
+        (type == GSL_ODEIV2_JAC_BLOCK && im->nblock != nblock))
+      {
+        if (im != NULL)
+          {
+            itermatrix_free (im);
+          }
+
+        state->im = itermatrix_alloc (sys->dimension, type, kl, ku, nblock);
+
+        if (state->im == NULL)
+          {
+            return GSL_ENOMEM;
+          }
+      }
+  }
+
+  return itermatrix_jac (state->im, sys, d, t, y, dfdt);
+}
+
 static int
 modnewton1_init (void *vstate, const gsl_matrix * A,
                  const double h, const gsl_matrix * dfdy,
                  const gsl_odeiv2_system * sys)
 {
   /* Initializes the method by forming the iteration matrix IhAJ
-     and generating its LU-decomposition
+     and generating its LU-decomposition. The Jacobian dfdy is not
+     used by one-stage methods, whose Jacobian was stored by
+     modnewton1_jac.
    */
 
   modnewton1_state_t *state = (modnewton1_state_t *) vstate;
@@ -184,6 +253,19 @@ modnewton1_init (void *vstate, const gsl_matrix * A,
 
   state->eeta_prev = GSL_DBL_MAX;
 
+  if (state->im != NULL)
+    {
+      /* singular, let the caller reduce the step size */
+
+      if (itermatrix_update (state->im, h * gsl_matrix_get (A, 0, 0))
+          != GSL_SUCCESS)
+        {
+          return GSL_FAILURE;
+        }
+
+      return GSL_SUCCESS;
+    }
+
   /* Generate IhAJ */
 
   {
@@ -327,7 +409,9 @@ modnewton1_solve (void *vstate, const gsl_matrix * A,
         /* Solve dYk */
 
         {
-          int s = gsl_linalg_LU_solve (IhAJ, p, rhs, dYk);
+          int s = (state->im != NULL) ?
+            itermatrix_solve (state->im, rhs, dYk) :
+            gsl_linalg_LU_solve (IhAJ, p, rhs, dYk);
 
           if (s != GSL_SUCCESS)
             {
@@ -422,5 +506,9 @@ modnewton1_free (void *vstate)
   gsl_vector_free (state->dYk);
   gsl_permutation_free (state->p);
   gsl_matrix_free (state->IhAJ);
+
+  if (state->im != NULL)
+    itermatrix_free (state->im);
+
   free (state);
 }
@@ -1312,6 +1312,40 @@ msadams_free (void *vstate)
   free (state);
 }
 
+static int
+msadams_interp (void *vstate, size_t dim, double s, double y[])
+{
+  /* Evaluates the Nordsieck polynomial of the last accepted step at
+     t + s, where t is the end point of the step and s is between -h
+     and 0. No function evaluations are needed.
+   */
+
+  msadams_state_t *state = (msadams_state_t *) vstate;
+  const double *const z = state->z;
+  const size_t ord = state->ordprev;
+  const double theta = s / state->hprev[0];
+  size_t i, j;
+
+  if (state->ni == 0)
+    {
+      GSL_ERROR ("no accepted step to interpolate", GSL_EFAILED);
+    }
+
+  for (i = 0; i < dim; i++)
+    {
+      double sum = z[ord * dim + i];
+
+      for (j = ord; j-- > 0;)
+        {
+          sum = sum * theta + z[j * dim + i];
+        }
+
+      y[i] = sum;
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_odeiv2_step_type msadams_type = {
   "msadams",                    /* name */
   1,                            /* can use dydt_in? */
@@ -1321,7 +1355,8 @@ static const gsl_odeiv2_step_type msadams_type = {
   &msadams_set_driver,
   &msadams_reset,
   &msadams_order,
-  &msadams_free
+  &msadams_free,
+  &msadams_interp
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_msadams = &msadams_type;
@@ -53,6 +53,7 @@
 #include <gsl/gsl_linalg.h>
 
 #include "odeiv_util.h"
+#include "itermatrix.c"
 
 /* Maximum order of BDF methods */
 #define MSBDF_MAX_ORD 5
@@ -87,10 +88,8 @@ typedef struct
   gsl_vector *svec;             /* saved abscor & work area */
   gsl_vector *tempvec;          /* work area */
   const gsl_odeiv2_driver *driver;      /* pointer to gsl_odeiv2_driver object */
-  gsl_matrix *dfdy;             /* Jacobian */
+  itermatrix_t *im;             /* Jacobian and Newton iteration matrix */
   double *dfdt;                 /* storage for time derivative of f */
-  gsl_matrix *M;                /* Newton iteration matrix */
-  gsl_permutation *p;           /* permutation for LU decomposition of M */
   gsl_vector *rhs;              /* right hand side equations (-G) */
   long int ni;                  /* stepper call counter */
   size_t ord;                   /* current order of method */
@@ -326,33 +325,10 @@ msbdf_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for tempvec", GSL_ENOMEM);
     }
 
-  state->dfdy = gsl_matrix_alloc (dim, dim);
-
-  if (state->dfdy == 0)
-    {
-      gsl_vector_free (state->tempvec);
-      gsl_vector_free (state->svec);
-      gsl_vector_free (state->relcor);
-      gsl_vector_free (state->abscor);
-      free (state->errlev);
-      free (state->ordprevbackup);
-      free (state->ordprev);
-      free (state->hprevbackup);
-      free (state->hprev);
-      free (state->l);
-      free (state->ytmp2);
-      free (state->ytmp);
-      free (state->zbackup);
-      free (state->z);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for dfdy", GSL_ENOMEM);
-    }
-
   state->dfdt = (double *) malloc (dim * sizeof (double));
 
   if (state->dfdt == 0)
     {
-      gsl_matrix_free (state->dfdy);
       gsl_vector_free (state->tempvec);
       gsl_vector_free (state->svec);
       gsl_vector_free (state->relcor);
@@ -371,63 +347,11 @@ msbdf_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for dfdt", GSL_ENOMEM);
     }
 
-  state->M = gsl_matrix_alloc (dim, dim);
-
-  if (state->M == 0)
-    {
-      free (state->dfdt);
-      gsl_matrix_free (state->dfdy);
-      gsl_vector_free (state->tempvec);
-      gsl_vector_free (state->svec);
-      gsl_vector_free (state->relcor);
-      gsl_vector_free (state->abscor);
-      free (state->errlev);
-      free (state->ordprevbackup);
-      free (state->ordprev);
-      free (state->hprevbackup);
-      free (state->hprev);
-      free (state->l);
-      free (state->ytmp2);
-      free (state->ytmp);
-      free (state->zbackup);
-      free (state->z);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for M", GSL_ENOMEM);
-    }
-
-  state->p = gsl_permutation_alloc (dim);
-
-  if (state->p == 0)
-    {
-      gsl_matrix_free (state->M);
-      free (state->dfdt);
-      gsl_matrix_free (state->dfdy);
-      gsl_vector_free (state->tempvec);
-      gsl_vector_free (state->svec);
-      gsl_vector_free (state->relcor);
-      gsl_vector_free (state->abscor);
-      free (state->errlev);
-      free (state->ordprevbackup);
-      free (state->ordprev);
-      free (state->hprevbackup);
-      free (state->hprev);
-      free (state->l);
-      free (state->ytmp2);
-      free (state->ytmp);
-      free (state->zbackup);
-      free (state->z);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for p", GSL_ENOMEM);
-    }
-
   state->rhs = gsl_vector_alloc (dim);
 
   if (state->rhs == 0)
     {
-      gsl_permutation_free (state->p);
-      gsl_matrix_free (state->M);
       free (state->dfdt);
-      gsl_matrix_free (state->dfdy);
       gsl_vector_free (state->tempvec);
       gsl_vector_free (state->svec);
       gsl_vector_free (state->relcor);
@@ -451,10 +375,7 @@ msbdf_alloc (size_t dim)
   if (state->abscorscaled == 0)
     {
       gsl_vector_free (state->rhs); 
-      gsl_permutation_free (state->p);
-      gsl_matrix_free (state->M);
       free (state->dfdt);
-      gsl_matrix_free (state->dfdy);
       gsl_vector_free (state->tempvec);
       gsl_vector_free (state->svec);
       gsl_vector_free (state->relcor);
@@ -473,6 +394,8 @@ msbdf_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for abscorscaled", GSL_ENOMEM);
     }
 
+  state->im = NULL;
+
   msbdf_reset ((void *) state, dim);
 
   state->driver = NULL;
@@ -642,9 +565,8 @@ msbdf_calccoeffs (const size_t ord, const size_t ordwait,
 }
 
 static int
-msbdf_update (void *vstate, const size_t dim, gsl_matrix * dfdy, double *dfdt,
+msbdf_update (void *vstate, const size_t dim, double *dfdt,
               const double t, const double *y, const gsl_odeiv2_system * sys,
-              gsl_matrix * M, gsl_permutation * p,
               const size_t iter, size_t * nJ, size_t * nM,
               const double tprev, const double failt,
               const double gamma, const double gammaprev, const double hratio)
@@ -661,16 +583,48 @@ msbdf_update (void *vstate, const size_t dim, gsl_matrix * dfdy, double *dfdt,
      --- convergence failure resulted in step size decrease
    */
 
+  msbdf_state_t *state = (msbdf_state_t *) vstate;
   const double c = 0.2;
   const double gammarel = fabs (gamma / gammaprev - 1.0);
 
+  /* Storage of the Jacobian is selected by the driver, dense by
+     default. (Re)allocate it if the selection has changed. */
+
+  {
+    const gsl_odeiv2_driver *d = state->driver;
+    const int type = (d != NULL) ? d->jac_type : GSL_ODEIV2_JAC_DENSE;
+    const size_t kl = (d != NULL) ? d->kl : 0;
+    const size_t ku = (d != NULL) ? d->ku : 0;
+    const size_t nblock = (d != NULL) ? d->nblock : 1;
+
+    if (state->im == NULL || state->im->type != type ||
+        state->im->kl != kl || state->im->ku != ku ||
+        (type == GSL_ODEIV2_JAC_BLOCK && state->im->nblock != nblock))
+      {
+        if (state->im != NULL)
+          {
+            itermatrix_free (state->im);
+          }
+
+        state->im = itermatrix_alloc (dim, type, kl, ku, nblock);
+
+        if (state->im == NULL)
+          {
+            return GSL_ENOMEM;
+          }
+
+        *nJ = 0;
+        *nM = 0;
+      }
+  }
+
   if (*nJ == 0 || *nJ > MSBDF_JAC_WAIT ||
       (t == failt && (gammarel < c || hratio < 1.0)))
     {
 #ifdef DEBUG
       printf ("-- evaluate jacobian\n");
 #endif
-      int s = GSL_ODEIV_JA_EVAL (sys, t, y, dfdy->data, dfdt);
+      int s = itermatrix_jac (state->im, sys, state->driver, t, y, dfdt);
 
       if (s == GSL_EBADFUNC)
         {
@@ -704,19 +658,9 @@ msbdf_update (void *vstate, const size_t dim, gsl_matrix * dfdy, double *dfdt,
 #ifdef DEBUG
       printf ("-- update M, gamma=%.5e\n", gamma);
 #endif
-      size_t i;
-      gsl_matrix_memcpy (M, dfdy);
-      gsl_matrix_scale (M, -gamma);
-
-      for (i = 0; i < dim; i++)
-        {
-          gsl_matrix_set (M, i, i, gsl_matrix_get (M, i, i) + 1.0);
-        }
-
       {
-        int signum;
-        int s = gsl_linalg_LU_decomp (M, p, &signum);
-        
+        int s = itermatrix_update (state->im, gamma);
+
         if (s != GSL_SUCCESS)
           {
             return GSL_FAILURE;
@@ -738,8 +682,7 @@ msbdf_corrector (void *vstate, const gsl_odeiv2_system * sys,
                  const double l[], const double errcoeff,
                  gsl_vector * abscor, gsl_vector * relcor,
                  double ytmp[], double ytmp2[],
-                 gsl_matrix * dfdy, double dfdt[], gsl_matrix * M,
-                 gsl_permutation * p, gsl_vector * rhs,
+                 double dfdt[], gsl_vector * rhs,
                  size_t * nJ, size_t * nM,
                  const double tprev, const double failt,
                  const double gamma, const double gammaprev,
@@ -789,8 +732,8 @@ msbdf_corrector (void *vstate, const gsl_odeiv2_system * sys,
 
       if (mi == 0)
         {
-          int s = msbdf_update (vstate, dim, dfdy, dfdt, t + h, z,
-                                sys, M, p, mi,
+          int s = msbdf_update (vstate, dim, dfdt, t + h, z,
+                                sys, mi,
                                 nJ, nM, tprev, failt,
                                 gamma, gammaprev,
                                 h / hprev0);
@@ -814,7 +757,8 @@ msbdf_corrector (void *vstate, const gsl_odeiv2_system * sys,
       /* Solve system of equations */
 
       {
-        int s = gsl_linalg_LU_solve (M, p, rhs, relcor);
+        msbdf_state_t *state = (msbdf_state_t *) vstate;
+        int s = itermatrix_solve (state->im, rhs, relcor);
         
         if (s != GSL_SUCCESS)
           {
@@ -1526,8 +1470,7 @@ msbdf_apply (void *vstate, size_t dim, double t, double h,
     int s;
     s = msbdf_corrector (vstate, sys, t, h, dim, z, errlev, l, errcoeff,
                          abscor, relcor, ytmp, ytmp2,
-                         state->dfdy, state->dfdt, state->M,
-                         state->p, state->rhs,
+                         state->dfdt, state->rhs,
                          &(state->nJ), &(state->nM),
                          state->tprev, state->failt, gamma,
                          state->gammaprev, hprev[0]);
@@ -1771,10 +1714,12 @@ msbdf_free (void *vstate)
   msbdf_state_t *state = (msbdf_state_t *) vstate;
 
   gsl_vector_free (state->rhs);
-  gsl_permutation_free (state->p);
-  gsl_matrix_free (state->M);
+  if (state->im != NULL)
+    {
+      itermatrix_free (state->im);
+    }
+
   free (state->dfdt);
-  gsl_matrix_free (state->dfdy);
   gsl_vector_free (state->tempvec);
   gsl_vector_free (state->svec);
   gsl_vector_free (state->relcor);
@@ -1793,6 +1738,40 @@ msbdf_free (void *vstate)
   free (state);
 }
 
+static int
+msbdf_interp (void *vstate, size_t dim, double s, double y[])
+{
+  /* Evaluates the Nordsieck polynomial of the last accepted step at
+     t + s, where t is the end point of the step and s is between -h
+     and 0. No function evaluations are needed.
+   */
+
+  msbdf_state_t *state = (msbdf_state_t *) vstate;
+  const double *const z = state->z;
+  const size_t ord = state->ordprev[0];
+  const double theta = s / state->hprev[0];
+  size_t i, j;
+
+  if (state->ni == 0)
+    {
+      GSL_ERROR ("no accepted step to interpolate", GSL_EFAILED);
+    }
+
+  for (i = 0; i < dim; i++)
+    {
+      double sum = z[ord * dim + i];
+
+      for (j = ord; j-- > 0;)
+        {
+          sum = sum * theta + z[j * dim + i];
+        }
+
+      y[i] = sum;
+    }
+
+  return GSL_SUCCESS;
+}
+
 static const gsl_odeiv2_step_type msbdf_type = {
   "msbdf",                      /* name */
   1,                            /* can use dydt_in? */
@@ -1802,7 +1781,8 @@ static const gsl_odeiv2_step_type msbdf_type = {
   &msbdf_set_driver,
   &msbdf_reset,
   &msbdf_order,
-  &msbdf_free
+  &msbdf_free,
+  &msbdf_interp
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_msbdf = &msbdf_type;
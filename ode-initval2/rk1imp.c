@@ -47,7 +47,6 @@ typedef struct
   double *y_save;               /* Backup space */
   double *YZ;                   /* Runge-Kutta points */
   double *fYZ;                  /* Derivatives at YZ */
-  gsl_matrix *dfdy;             /* Jacobian matrix */
   double *dfdt;                 /* time derivative of f */
   modnewton1_state_t *esol;     /* nonlinear equation solver */
   double *errlev;               /* desired error level of y */
@@ -158,27 +157,10 @@ rk1imp_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for dfdt", GSL_ENOMEM);
     }
 
-  state->dfdy = gsl_matrix_alloc (dim, dim);
-
-  if (state->dfdy == 0)
-    {
-      free (state->dfdt);
-      free (state->fYZ);
-      free (state->YZ);
-      free (state->y_save);
-      free (state->ytmp);
-      free (state->y_twostep);
-      free (state->y_onestep);
-      gsl_matrix_free (state->A);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for dfdy", GSL_ENOMEM);
-    }
-
   state->esol = modnewton1_alloc (dim, RK1IMP_STAGE);
 
   if (state->esol == 0)
     {
-      gsl_matrix_free (state->dfdy);
       free (state->dfdt);
       free (state->fYZ);
       free (state->YZ);
@@ -196,7 +178,6 @@ rk1imp_alloc (size_t dim)
   if (state->errlev == 0)
     {
       modnewton1_free (state->esol);
-      gsl_matrix_free (state->dfdy);
       free (state->dfdt);
       free (state->fYZ);
       free (state->YZ);
@@ -232,7 +213,6 @@ rk1imp_apply (void *vstate, size_t dim, double t, double h,
   double *const y_save = state->y_save;
   double *const YZ = state->YZ;
   double *const fYZ = state->fYZ;
-  gsl_matrix *const dfdy = state->dfdy;
   double *const dfdt = state->dfdt;
   double *const errlev = state->errlev;
 
@@ -280,7 +260,8 @@ rk1imp_apply (void *vstate, size_t dim, double t, double h,
   /* Evaluate Jacobian for modnewton1 */
 
   {
-    int s = GSL_ODEIV_JA_EVAL (sys, t, y, dfdy->data, dfdt);
+    int s = modnewton1_jac ((void *) esol, sys, state->driver, t, y,
+                            NULL, dfdt);
 
     if (s != GSL_SUCCESS)
       {
@@ -291,7 +272,7 @@ rk1imp_apply (void *vstate, size_t dim, double t, double h,
   /* Calculate a single step with size h */
 
   {
-    int s = modnewton1_init ((void *) esol, A, h, dfdy, sys);
+    int s = modnewton1_init ((void *) esol, A, h, NULL, sys);
 
     if (s != GSL_SUCCESS)
       {
@@ -328,7 +309,7 @@ rk1imp_apply (void *vstate, size_t dim, double t, double h,
   /* Error estimation by step doubling */
 
   {
-    int s = modnewton1_init ((void *) esol, A, h / 2.0, dfdy, sys);
+    int s = modnewton1_init ((void *) esol, A, h / 2.0, NULL, sys);
 
     if (s != GSL_SUCCESS)
       {
@@ -472,7 +453,6 @@ rk1imp_free (void *vstate)
 
   free (state->errlev);
   modnewton1_free (state->esol);
-  gsl_matrix_free (state->dfdy);
   free (state->dfdt);
   free (state->fYZ);
   free (state->YZ);
@@ -493,7 +473,8 @@ static const gsl_odeiv2_step_type rk1imp_type = {
   &rk1imp_set_driver,
   &rk1imp_reset,
   &rk1imp_order,
-  &rk1imp_free
+  &rk1imp_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk1imp = &rk1imp_type;
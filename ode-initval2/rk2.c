@@ -245,7 +245,8 @@ static const gsl_odeiv2_step_type rk2_type = { "rk2",   /* name */
   &stepper_set_driver_null,
   &rk2_reset,
   &rk2_order,
-  &rk2_free
+  &rk2_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk2 = &rk2_type;
@@ -52,7 +52,6 @@ typedef struct
   double *y_save;               /* Backup space */
   double *YZ;                   /* Runge-Kutta points */
   double *fYZ;                  /* Derivatives at YZ */
-  gsl_matrix *dfdy;             /* Jacobian matrix */
   double *dfdt;                 /* time derivative of f */
   modnewton1_state_t *esol;     /* nonlinear equation solver */
   double *errlev;               /* desired error level of y */
@@ -163,27 +162,10 @@ rk2imp_alloc (size_t dim)
       GSL_ERROR_NULL ("failed to allocate space for dfdt", GSL_ENOMEM);
     }
 
-  state->dfdy = gsl_matrix_alloc (dim, dim);
-
-  if (state->dfdy == 0)
-    {
-      free (state->dfdt);
-      free (state->fYZ);
-      free (state->YZ);
-      free (state->y_save);
-      free (state->ytmp);
-      free (state->y_twostep);
-      free (state->y_onestep);
-      gsl_matrix_free (state->A);
-      free (state);
-      GSL_ERROR_NULL ("failed to allocate space for dfdy", GSL_ENOMEM);
-    }
-
   state->esol = modnewton1_alloc (dim, RK2IMP_STAGE);
 
   if (state->esol == 0)
     {
-      gsl_matrix_free (state->dfdy);
       free (state->dfdt);
       free (state->fYZ);
       free (state->YZ);
@@ -201,7 +183,6 @@ rk2imp_alloc (size_t dim)
   if (state->errlev == 0)
     {
       modnewton1_free (state->esol);
-      gsl_matrix_free (state->dfdy);
       free (state->dfdt);
       free (state->fYZ);
       free (state->YZ);
@@ -237,7 +218,6 @@ rk2imp_apply (void *vstate, size_t dim, double t, double h,
   double *const y_save = state->y_save;
   double *const YZ = state->YZ;
   double *const fYZ = state->fYZ;
-  gsl_matrix *const dfdy = state->dfdy;
   double *const dfdt = state->dfdt;
   double *const errlev = state->errlev;
 
@@ -301,7 +281,8 @@ rk2imp_apply (void *vstate, size_t dim, double t, double h,
 #ifdef DEBUG
     printf ("-- evaluate jacobian\n");
 #endif
-    int s = GSL_ODEIV_JA_EVAL (sys, t, y, dfdy->data, dfdt);
+    int s = modnewton1_jac ((void *) esol, sys, state->driver, t, y,
+                            NULL, dfdt);
 
     if (s != GSL_SUCCESS)
       {
@@ -310,60 +291,17 @@ rk2imp_apply (void *vstate, size_t dim, double t, double h,
 #endif
         return s;
       }
-#ifdef DEBUG
-    size_t M;
-    size_t N;
-    size_t i;
-    size_t j;
-
-    M = dfdy->size1;
-    N = dfdy->size2;
-    
-    for(i=0; i<M; i++) {
-      for(j=0; j<N; j++) {
-    	double aij = gsl_matrix_get(dfdy, i, j);
-    	printf("(%3lu,%3lu)[%lu,%lu]: %22.18g\n", M, N, i,j, aij);
-    	}
-    }
-#endif
   }
 
   /* Calculate a single step with size h */
 
   {
-    int s = modnewton1_init ((void *) esol, A, h, dfdy, sys);
+    int s = modnewton1_init ((void *) esol, A, h, NULL, sys);
 
     if (s != GSL_SUCCESS)
       {
         return s;
       }
-#ifdef DEBUG
-    size_t M;
-    size_t N;
-    size_t i;
-    size_t j;
-
-    printf ("-- modnewton1_init IhAJ:\n");
-
-    M = esol->IhAJ->size1;
-    N = esol->IhAJ->size2;
-    
-    for(i=0; i<M; i++) {
-      for(j=0; j<N; j++) {
-    	double aij = gsl_matrix_get(esol->IhAJ, i, j);
-    	printf("(%3lu,%3lu)[%lu,%lu]: %22.18g\n", M, N, i,j, aij);
-    	}
-    }
-
-    printf ("-- modnewton1_init p:\n");
-
-    M = esol->p->size;
-    
-    for(i=0; i<M; i++) {
-    	double pi = gsl_permutation_get(esol->p, i);
-    	printf("(%3lu)[%lu]: %22.18g\n", M, i, pi);
-    }
-#endif
   }
 
   {
@@ -427,7 +365,7 @@ rk2imp_apply (void *vstate, size_t dim, double t, double h,
   /* Error estimation by step doubling */
 
   {
-    int s = modnewton1_init ((void *) esol, A, h / 2.0, dfdy, sys);
+    int s = modnewton1_init ((void *) esol, A, h / 2.0, NULL, sys);
 
     if (s != GSL_SUCCESS)
       {
@@ -585,7 +523,6 @@ rk2imp_free (void *vstate)
 
   free (state->errlev);
   modnewton1_free (state->esol);
-  gsl_matrix_free (state->dfdy);
   free (state->dfdt);
   free (state->fYZ);
   free (state->YZ);
@@ -606,7 +543,8 @@ static const gsl_odeiv2_step_type rk2imp_type = {
   &rk2imp_set_driver,
   &rk2imp_reset,
   &rk2imp_order,
-  &rk2imp_free
+  &rk2imp_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk2imp = &rk2imp_type;
@@ -354,7 +354,8 @@ static const gsl_odeiv2_step_type rk4_type = { "rk4",   /* name */
   &stepper_set_driver_null,
   &rk4_reset,
   &rk4_order,
-  &rk4_free
+  &rk4_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk4 = &rk4_type;
@@ -526,7 +526,8 @@ static const gsl_odeiv2_step_type rk4imp_type = {
   &rk4imp_set_driver,
   &rk4imp_reset,
   &rk4imp_order,
-  &rk4imp_free
+  &rk4imp_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk4imp = &rk4imp_type;
@@ -540,7 +540,8 @@ static const gsl_odeiv2_step_type rk8pd_type = { "rk8pd",       /* name */
   &stepper_set_driver_null,
   &rk8pd_reset,
   &rk8pd_order,
-  &rk8pd_free
+  &rk8pd_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rk8pd = &rk8pd_type;
@@ -371,7 +371,8 @@ static const gsl_odeiv2_step_type rkck_type = { "rkck", /* name */
   &stepper_set_driver_null,
   &rkck_reset,
   &rkck_order,
-  &rkck_free
+  &rkck_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rkck = &rkck_type;
@@ -375,7 +375,8 @@ static const gsl_odeiv2_step_type rkf45_type = { "rkf45",       /* name */
   &stepper_set_driver_null,
   &rkf45_reset,
   &rkf45_order,
-  &rkf45_free
+  &rkf45_free,
+  NULL                          /* interp */
 };
 
 const gsl_odeiv2_step_type *gsl_odeiv2_step_rkf45 = &rkf45_type;
@@ -0,0 +1,775 @@
+/* ode-initval2/sens.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Sensitivity analysis of y' = f(t,y,p) with respect to the
+   parameters p.
+
+   Forward: the sensitivities s_k = dy/dp_k satisfy
+
+     s_k' = J s_k + df/dp_k,   J = df/dy
+
+   and are integrated with the state as one system, so that they
+   are included in the error control. For implicit steppers the
+   Jacobian of the combined system is approximated by J on each
+   diagonal block, neglecting the derivatives of J s_k with respect
+   to y. With msbdf the Newton iteration matrix of the state is then
+   shared by all the blocks (GSL_ODEIV2_JAC_BLOCK), which corresponds
+   to the simultaneous corrector of CVODES with a block diagonal
+   iteration matrix.
+
+   Adjoint: for a function g(y(t1)), with lambda(t1) = dg/dy(t1),
+
+     lambda' = -J^T lambda,   mu' = -(df/dp)^T lambda,   mu(t1) = 0
+
+   are integrated from t1 back to t0, and give dg/dp = mu(t0) +
+   lambda(t0)^T dy(t0)/dp. The state is needed in the backward
+   integration. It is saved at every interval-th step of a forward
+   pass, and each interval between these checkpoints is integrated
+   again before it is used, storing y and dydt at every step for
+   Hermite interpolation. The memory needed is proportional to the
+   number of checkpoints plus the steps of one interval, and the
+   cost is independent of the number of parameters.
+*/
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_odeiv2.h>
+
+#include "odeiv_util.h"
+
+/* Default number of steps between checkpoints */
+#define SENS_INTERVAL 50
+
+/* Maximum number of points of the Hermite interpolant of the state */
+#define SENS_NHERMITE 5
+
+/* Minimum length of a replayed step relative to the previous one */
+#define SENS_TMIN 0.1
+
+static int
+sens_grow (double **p, const size_t n)
+{
+  double *q = (double *) realloc (*p, n * sizeof (double));
+
+  if (q == NULL)
+    {
+      GSL_ERROR ("failed to allocate space for sensitivity history",
+                 GSL_ENOMEM);
+    }
+
+  *p = q;
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_forward_function (double t, const double yf[], double f[],
+                       void *params)
+{
+  gsl_odeiv2_sens *s = (gsl_odeiv2_sens *) params;
+  const gsl_odeiv2_sens_system *sys = s->sys;
+  const size_t n = sys->dimension;
+  const size_t np = sys->nparams;
+  size_t i, j, k;
+  int status;
+
+  status = sys->function (t, yf, f, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  status = sys->jacobian (t, yf, s->J, s->dfdt, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  status = sys->dfdp (t, yf, s->fp, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  for (k = 0; k < np; k++)
+    {
+      const double *sk = yf + (k + 1) * n;
+      double *fk = f + (k + 1) * n;
+
+      for (i = 0; i < n; i++)
+        {
+          double sum = s->fp[i * np + k];
+
+          for (j = 0; j < n; j++)
+            {
+              sum += s->J[i * n + j] * sk[j];
+            }
+
+          fk[i] = sum;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_forward_jacobian (double t, const double yf[], double *dfdy,
+                       double dfdt[], void *params)
+{
+  /* Block diagonal approximation of the Jacobian */
+
+  gsl_odeiv2_sens *s = (gsl_odeiv2_sens *) params;
+  const gsl_odeiv2_sens_system *sys = s->sys;
+  const size_t n = sys->dimension;
+  const size_t na = n * (sys->nparams + 1);
+  size_t i, j, k;
+  int status;
+
+  status = sys->jacobian (t, yf, s->J, dfdt, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  DBL_ZERO_MEMSET (dfdt + n, na - n);
+  DBL_ZERO_MEMSET (dfdy, na * na);
+
+  for (k = 0; k <= sys->nparams; k++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          for (j = 0; j < n; j++)
+            {
+              dfdy[(k * n + i) * na + k * n + j] = s->J[i * n + j];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_forward_jacobian_block (double t, const double yf[], double *dfdy,
+                             double dfdt[], void *params)
+{
+  /* Jacobian of the first block only, which msbdf uses for all the
+     blocks */
+
+  gsl_odeiv2_sens *s = (gsl_odeiv2_sens *) params;
+  const gsl_odeiv2_sens_system *sys = s->sys;
+  const size_t n = sys->dimension;
+  const size_t na = n * (sys->nparams + 1);
+  int status;
+
+  status = sys->jacobian (t, yf, dfdy, dfdt, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  DBL_ZERO_MEMSET (dfdt + n, na - n);
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_replay_eval (const gsl_odeiv2_sens * s, const double t, double y[])
+{
+  /* Newton form of the Hermite polynomial matching y and dydt at the
+     replayed points around t, with as many points as needed to match
+     the order of the stepper as in gsl_odeiv2_evolve_interp */
+
+  const size_t n = s->sys->dimension;
+  const size_t nr = s->nreplay;
+  const size_t ord = gsl_odeiv2_step_order (s->ydriver->s);
+  const size_t m = GSL_MAX (GSL_MIN (GSL_MIN (nr, ord / 2 + 1),
+                                     SENS_NHERMITE), 2);
+  const double *tr = s->treplay;
+  const int up = (tr[nr - 1] > tr[0]);
+  double z[2 * SENS_NHERMITE], c[2 * SENS_NHERMITE];
+  size_t lo = 0, hi = nr - 1;
+  size_t i, j, l, p0;
+
+  while (hi - lo > 1)
+    {
+      const size_t mid = (lo + hi) / 2;
+
+      if (up ? (t >= tr[mid]) : (t <= tr[mid]))
+        {
+          lo = mid;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+
+  /* first point of the window of m points centred on the step */
+
+  p0 = (lo > (m - 2) / 2) ? lo - (m - 2) / 2 : 0;
+  p0 = GSL_MIN (p0, nr - m);
+
+  for (j = 0; j < 2 * m; j++)
+    {
+      z[j] = tr[p0 + j / 2];
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      double sum;
+
+      c[0] = s->yreplay[p0 * n + i];
+
+      for (j = 1; j < 2 * m; j++)
+        {
+          const size_t p = p0 + j / 2;
+
+          if (j % 2 == 1)
+            {
+              c[j] = s->freplay[p * n + i];
+            }
+          else
+            {
+              c[j] = (s->yreplay[p * n + i] - s->yreplay[(p - 1) * n + i])
+                / (z[j] - z[j - 1]);
+            }
+        }
+
+      for (l = 2; l < 2 * m; l++)
+        {
+          for (j = 2 * m - 1; j >= l; j--)
+            {
+              c[j] = (c[j] - c[j - 1]) / (z[j] - z[j - l]);
+            }
+        }
+
+      sum = c[2 * m - 1];
+
+      for (j = 2 * m - 1; j-- > 0;)
+        {
+          sum = sum * (t - z[j]) + c[j];
+        }
+
+      y[i] = sum;
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_adjoint_function (double t, const double z[], double f[], void *params)
+{
+  gsl_odeiv2_sens *s = (gsl_odeiv2_sens *) params;
+  const gsl_odeiv2_sens_system *sys = s->sys;
+  const size_t n = sys->dimension;
+  const size_t np = sys->nparams;
+  size_t i, j, k;
+  int status;
+
+  sens_replay_eval (s, t, s->y);
+
+  status = sys->jacobian (t, s->y, s->J, s->dfdt, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  status = sys->dfdp (t, s->y, s->fp, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  for (j = 0; j < n; j++)
+    {
+      double sum = 0.0;
+
+      for (i = 0; i < n; i++)
+        {
+          sum -= s->J[i * n + j] * z[i];
+        }
+
+      f[j] = sum;
+    }
+
+  for (k = 0; k < np; k++)
+    {
+      double sum = 0.0;
+
+      for (i = 0; i < n; i++)
+        {
+          sum -= s->fp[i * np + k] * z[i];
+        }
+
+      f[n + k] = sum;
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_adjoint_jacobian (double t, const double z[], double *dfdy,
+                       double dfdt[], void *params)
+{
+  gsl_odeiv2_sens *s = (gsl_odeiv2_sens *) params;
+  const gsl_odeiv2_sens_system *sys = s->sys;
+  const size_t n = sys->dimension;
+  const size_t np = sys->nparams;
+  const size_t na = n + np;
+  size_t i, j, k;
+  int status;
+
+  sens_replay_eval (s, t, s->y);
+
+  status = sys->jacobian (t, s->y, s->J, s->dfdt, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  status = sys->dfdp (t, s->y, s->fp, sys->params);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  DBL_ZERO_MEMSET (dfdy, na * na);
+  DBL_ZERO_MEMSET (dfdt, na);
+
+  for (j = 0; j < n; j++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          dfdy[j * na + i] = -s->J[i * n + j];
+        }
+    }
+
+  for (k = 0; k < np; k++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          dfdy[(n + k) * na + i] = -s->fp[i * np + k];
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+gsl_odeiv2_sens *
+gsl_odeiv2_sens_alloc (const gsl_odeiv2_sens_system * sys,
+                       const gsl_odeiv2_step_type * T, const double hstart,
+                       const double epsabs, const double epsrel)
+{
+  const size_t n = sys->dimension;
+  const size_t np = sys->nparams;
+  gsl_odeiv2_sens *s;
+
+  if (n == 0 || np == 0)
+    {
+      GSL_ERROR_NULL ("dimension and number of parameters must be positive",
+                      GSL_EINVAL);
+    }
+
+  if (sys->jacobian == NULL || sys->dfdp == NULL)
+    {
+      GSL_ERROR_NULL ("jacobian and dfdp functions must be given",
+                      GSL_EINVAL);
+    }
+
+  s = (gsl_odeiv2_sens *) calloc (1, sizeof (gsl_odeiv2_sens));
+
+  if (s == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for sensitivity struct",
+                      GSL_ENOMEM);
+    }
+
+  s->sys = sys;
+  s->type = T;
+  s->hstart = fabs (hstart);
+  s->interval = SENS_INTERVAL;
+
+  s->ysys.function = sys->function;
+  s->ysys.jacobian = sys->jacobian;
+  s->ysys.dimension = n;
+  s->ysys.params = sys->params;
+
+  s->fsys.function = &sens_forward_function;
+  s->fsys.jacobian = &sens_forward_jacobian;
+  s->fsys.dimension = n * (np + 1);
+  s->fsys.params = s;
+
+  s->asys.function = &sens_adjoint_function;
+  s->asys.jacobian = &sens_adjoint_jacobian;
+  s->asys.dimension = n + np;
+  s->asys.params = s;
+
+  s->yf = (double *) malloc (n * (np + 1) * sizeof (double));
+  s->J = (double *) malloc (n * n * sizeof (double));
+  s->fp = (double *) malloc (n * np * sizeof (double));
+  s->dfdt = (double *) malloc (n * sizeof (double));
+  s->y = (double *) malloc (n * sizeof (double));
+
+  if (s->yf == NULL || s->J == NULL || s->fp == NULL || s->dfdt == NULL
+      || s->y == NULL)
+    {
+      gsl_odeiv2_sens_free (s);
+      GSL_ERROR_NULL ("failed to allocate space for sensitivity struct",
+                      GSL_ENOMEM);
+    }
+
+  s->ydriver = gsl_odeiv2_driver_alloc_y_new (&s->ysys, T, hstart,
+                                              epsabs, epsrel);
+  s->fdriver = gsl_odeiv2_driver_alloc_y_new (&s->fsys, T, hstart,
+                                              epsabs, epsrel);
+  s->adriver = gsl_odeiv2_driver_alloc_y_new (&s->asys, T, -hstart,
+                                              epsabs, epsrel);
+
+  if (s->ydriver == NULL || s->fdriver == NULL || s->adriver == NULL)
+    {
+      gsl_odeiv2_sens_free (s);
+      GSL_ERROR_NULL ("failed to allocate driver objects", GSL_ENOMEM);
+    }
+
+  if (T == gsl_odeiv2_step_msbdf)
+    {
+      gsl_odeiv2_driver_set_jacobian_block (s->fdriver, np + 1,
+                                            &sens_forward_jacobian_block);
+    }
+
+  return s;
+}
+
+int
+gsl_odeiv2_sens_apply (gsl_odeiv2_sens * s, double *t, const double t1,
+                       double y[], double S[])
+{
+  /* Evolves y and the sensitivities S[i * nparams + k] = dy_i/dp_k
+     from t to t1 */
+
+  const size_t n = s->sys->dimension;
+  const size_t np = s->sys->nparams;
+  size_t i, k;
+  int status;
+
+  DBL_MEMCPY (s->yf, y, n);
+
+  for (k = 0; k < np; k++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          s->yf[(k + 1) * n + i] = S[i * np + k];
+        }
+    }
+
+  status = gsl_odeiv2_driver_apply (s->fdriver, t, t1, s->yf);
+
+  DBL_MEMCPY (y, s->yf, n);
+
+  for (k = 0; k < np; k++)
+    {
+      for (i = 0; i < n; i++)
+        {
+          S[i * np + k] = s->yf[(k + 1) * n + i];
+        }
+    }
+
+  return status;
+}
+
+int
+gsl_odeiv2_sens_reset (gsl_odeiv2_sens * s)
+{
+  return gsl_odeiv2_driver_reset (s->fdriver);
+}
+
+int
+gsl_odeiv2_sens_set_checkpoint (gsl_odeiv2_sens * s, const size_t interval)
+{
+  if (interval == 0)
+    {
+      GSL_ERROR ("checkpoint interval must be positive", GSL_EINVAL);
+    }
+
+  s->interval = interval;
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_save_step (gsl_odeiv2_sens * s, const double t, const double y[])
+{
+  /* Saves the end point of a forward step, and y at checkpoints */
+
+  const size_t n = s->sys->dimension;
+
+  if (s->nsteps == s->nalloc)
+    {
+      const size_t nalloc = (s->nalloc > 0) ? 2 * s->nalloc : 64;
+      int status = sens_grow (&s->tstep, nalloc);
+
+      if (status == GSL_SUCCESS)
+        {
+          status = sens_grow (&s->ycheck, (nalloc / s->interval + 1) * n);
+        }
+
+      if (status != GSL_SUCCESS)
+        {
+          return status;
+        }
+
+      s->nalloc = nalloc;
+    }
+
+  s->tstep[s->nsteps] = t;
+
+  if (s->nsteps % s->interval == 0)
+    {
+      DBL_MEMCPY (s->ycheck + (s->nsteps / s->interval) * n, y, n);
+    }
+
+  s->nsteps++;
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_save_replay (gsl_odeiv2_sens * s, const double t, const double y[],
+                  const double dydt[])
+{
+  const size_t n = s->sys->dimension;
+
+  /* A very short last step, e.g. to reach the next checkpoint, would
+     make the divided differences of the interpolant ill-conditioned.
+     The point before it is dropped instead. */
+
+  if (s->nreplay >= 2)
+    {
+      const double *tr = s->treplay + s->nreplay - 2;
+
+      if (fabs (t - tr[1]) < SENS_TMIN * fabs (tr[1] - tr[0]))
+        {
+          s->nreplay--;
+        }
+    }
+
+  if (s->nreplay == s->nralloc)
+    {
+      const size_t nralloc = (s->nralloc > 0) ? 2 * s->nralloc : 64;
+      int status = sens_grow (&s->treplay, nralloc);
+
+      if (status == GSL_SUCCESS)
+        {
+          status = sens_grow (&s->yreplay, nralloc * n);
+        }
+
+      if (status == GSL_SUCCESS)
+        {
+          status = sens_grow (&s->freplay, nralloc * n);
+        }
+
+      if (status != GSL_SUCCESS)
+        {
+          return status;
+        }
+
+      s->nralloc = nralloc;
+    }
+
+  s->treplay[s->nreplay] = t;
+  DBL_MEMCPY (s->yreplay + s->nreplay * n, y, n);
+  DBL_MEMCPY (s->freplay + s->nreplay * n, dydt, n);
+  s->nreplay++;
+
+  return GSL_SUCCESS;
+}
+
+static int
+sens_replay (gsl_odeiv2_sens * s, const size_t c)
+{
+  /* Integrates the state again from checkpoint c to the next one,
+     saving every step */
+
+  gsl_odeiv2_driver *d = s->ydriver;
+  const size_t n = s->sys->dimension;
+  const size_t k0 = c * s->interval;
+  const size_t k1 = GSL_MIN (k0 + s->interval, s->nsteps - 1);
+  const double tb = s->tstep[k1];
+  const double sign = (tb > s->tstep[k0]) ? 1.0 : -1.0;
+  double t = s->tstep[k0];
+  double *y = s->y;
+  int status;
+
+  DBL_MEMCPY (y, s->ycheck + c * n, n);
+
+  status = gsl_odeiv2_driver_reset_hstart (d, s->tstep[k0 + 1] - t);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  s->nreplay = 0;
+
+  status = GSL_ODEIV_FN_EVAL (&s->ysys, t, y, s->dfdt);
+
+  if (status == GSL_SUCCESS)
+    {
+      status = sens_save_replay (s, t, y, s->dfdt);
+    }
+
+  while (status == GSL_SUCCESS && sign * (tb - t) > 0.0)
+    {
+      status = gsl_odeiv2_evolve_apply (d->e, d->c, d->s, d->sys,
+                                        &t, tb, &(d->h), y);
+
+      if (status == GSL_SUCCESS)
+        {
+          status = sens_save_replay (s, t, y, d->e->dydt_out);
+        }
+    }
+
+  return status;
+}
+
+int
+gsl_odeiv2_sens_adjoint (gsl_odeiv2_sens * s, const double t0,
+                         const double y0[], const double t1,
+                         const double lambda1[], double y1[],
+                         double lambda0[], double grad[])
+{
+  /* Evolves y0 from t0 to t1 saving checkpoints, and integrates the
+     adjoint from lambda1 at t1 back to t0. Returns the state at t1,
+     lambda at t0 and the integral of lambda^T df/dp from t0 to t1
+     in grad. */
+
+  const size_t n = s->sys->dimension;
+  const size_t np = s->sys->nparams;
+  const double sign = (t1 >= t0) ? 1.0 : -1.0;
+  gsl_odeiv2_driver *d = s->ydriver;
+  double *z = s->yf;
+  double t = t0;
+  size_t c, nint;
+  int status;
+
+  /* Forward pass */
+
+  status = gsl_odeiv2_driver_reset_hstart (d, sign * s->hstart);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  DBL_MEMCPY (y1, y0, n);
+
+  s->nsteps = 0;
+  status = sens_save_step (s, t, y1);
+
+  while (status == GSL_SUCCESS && sign * (t1 - t) > 0.0)
+    {
+      status = gsl_odeiv2_evolve_apply (d->e, d->c, d->s, d->sys,
+                                        &t, t1, &(d->h), y1);
+
+      if (status == GSL_SUCCESS)
+        {
+          status = sens_save_step (s, t, y1);
+        }
+    }
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  /* Backward pass over the checkpoint intervals */
+
+  DBL_MEMCPY (z, lambda1, n);
+  DBL_ZERO_MEMSET (z + n, np);
+
+  status = gsl_odeiv2_driver_reset_hstart (s->adriver, -sign * s->hstart);
+
+  if (status != GSL_SUCCESS)
+    {
+      return status;
+    }
+
+  nint = (s->nsteps + s->interval - 2) / s->interval;
+
+  for (c = nint; c-- > 0;)
+    {
+      status = sens_replay (s, c);
+
+      if (status != GSL_SUCCESS)
+        {
+          return status;
+        }
+
+      status = gsl_odeiv2_driver_apply (s->adriver, &t,
+                                        s->tstep[c * s->interval], z);
+
+      if (status != GSL_SUCCESS)
+        {
+          return status;
+        }
+    }
+
+  DBL_MEMCPY (lambda0, z, n);
+  DBL_MEMCPY (grad, z + n, np);
+
+  return GSL_SUCCESS;
+}
+
+void
+gsl_odeiv2_sens_free (gsl_odeiv2_sens * s)
+{
+  RETURN_IF_NULL (s);
+
+  if (s->adriver)
+    gsl_odeiv2_driver_free (s->adriver);
+
+  if (s->fdriver)
+    gsl_odeiv2_driver_free (s->fdriver);
+
+  if (s->ydriver)
+    gsl_odeiv2_driver_free (s->ydriver);
+
+  free (s->freplay);
+  free (s->yreplay);
+  free (s->treplay);
+  free (s->ycheck);
+  free (s->tstep);
+  free (s->y);
+  free (s->dfdt);
+  free (s->fp);
+  free (s->J);
+  free (s->yf);
+  free (s);
+}
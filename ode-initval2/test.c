@@ -29,6 +29,7 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_odeiv2.h>
 #include "odeiv_util.h"
@@ -1914,6 +1915,670 @@ test_stiff_problems (void)
     }
 }
 
+/* Ensemble of harmonic oscillators y0' = y1, y1' = -w_k^2 y0 */
+
+int
+rhs_ensemble_osc (size_t nsys, const double t[], const double y[],
+                  double f[], void *params)
+{
+  const double *w = (const double *) params;
+  size_t k;
+
+  extern int nfe;
+  nfe += 1;
+
+  for (k = 0; k < nsys; k++)
+    {
+      f[k] = y[nsys + k];
+      f[nsys + k] = -w[k] * w[k] * y[k];
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+rhs_osc (double t, const double y[], double f[], void *params)
+{
+  const double w = *(const double *) params;
+
+  extern int nfe;
+  nfe += 1;
+
+  f[0] = y[1];
+  f[1] = -w * w * y[0];
+
+  return GSL_SUCCESS;
+}
+
+int
+jac_osc (double t, const double y[], double *dfdy, double dfdt[],
+         void *params)
+{
+  const double w = *(const double *) params;
+
+  extern int nje;
+  nje += 1;
+
+  dfdy[0] = 0.0;
+  dfdy[1] = 1.0;
+  dfdy[2] = -w * w;
+  dfdy[3] = 0.0;
+  dfdt[0] = 0.0;
+  dfdt[1] = 0.0;
+
+  return GSL_SUCCESS;
+}
+
+void
+test_ensemble (const gsl_odeiv2_step_type * T)
+{
+  /* Tests for gsl_odeiv2_ensemble object. Each system must agree
+     with the single system driver, and systems which start at
+     different times, or already at t1, must be handled. */
+
+  const size_t nsys = 37;
+  const double tol = 1e-10;
+  const double t1 = 5.0;
+  double w[37], t[37], y[2 * 37];
+  gsl_odeiv2_ensemble_system sys;
+  gsl_odeiv2_ensemble *e;
+  const char *name = T->name;
+  size_t k;
+  int s;
+
+  sys.function = rhs_ensemble_osc;
+  sys.dimension = 2;
+  sys.nsys = nsys;
+  sys.params = w;
+
+  for (k = 0; k < nsys; k++)
+    {
+      w[k] = 1.0 + 0.1 * k;
+      t[k] = (k + 1 < nsys) ? 0.05 * k : t1;
+      y[k] = 1.0;
+      y[nsys + k] = 0.0;
+    }
+
+  e = gsl_odeiv2_ensemble_alloc (&sys, T, 1e-3, tol, 0.0);
+
+  s = gsl_odeiv2_ensemble_apply (e, t, t1, y);
+  gsl_test (s, "%s test_ensemble apply returned %d", name, s);
+
+  for (k = 0; k < nsys; k++)
+    {
+      const double t0 = (k + 1 < nsys) ? 0.05 * k : t1;
+      const double dt = t1 - t0;
+      double ts = t0, ys[2] = { 1.0, 0.0 };
+      gsl_odeiv2_system single = { rhs_osc, NULL, 2, NULL };
+      gsl_odeiv2_driver *d;
+
+      gsl_test_abs (t[k], t1, 0.0, "%s test_ensemble t[%d]", name, (int) k);
+
+      single.params = &w[k];
+      d = gsl_odeiv2_driver_alloc_y_new (&single, T, 1e-3, tol, 0.0);
+      s = gsl_odeiv2_driver_apply (d, &ts, t1, ys);
+      gsl_odeiv2_driver_free (d);
+
+      gsl_test_abs (y[k], cos (w[k] * dt), 1e3 * tol,
+                    "%s test_ensemble y0[%d]", name, (int) k);
+      gsl_test_abs (y[nsys + k], -w[k] * sin (w[k] * dt), 1e3 * w[k] * tol,
+                    "%s test_ensemble y1[%d]", name, (int) k);
+      gsl_test_abs (y[k], ys[0], tol,
+                    "%s test_ensemble y0[%d] vs driver", name, (int) k);
+      gsl_test_abs (y[nsys + k], ys[1], w[k] * tol,
+                    "%s test_ensemble y1[%d] vs driver", name, (int) k);
+    }
+
+  /* integrate back, with a limit on the number of steps */
+
+  gsl_odeiv2_ensemble_reset_hstart (e, -1e-3);
+  gsl_odeiv2_ensemble_set_nmax (e, 5);
+
+  s = gsl_odeiv2_ensemble_apply (e, t, 0.0, y);
+
+  if (s != GSL_EMAXITER)
+    {
+      gsl_test (1, "%s test_ensemble nmax returned %d", name, s);
+    }
+  else
+    {
+      gsl_test (0, "%s test_ensemble nmax", name);
+    }
+
+  gsl_odeiv2_ensemble_free (e);
+}
+
+/* Stiff reaction-diffusion chain, y_i' = D (y_{i-1} - 2 y_i + y_{i+1})
+   - y_i^3 with y_0 = y_{N+1} = 0, and its Jacobian in dense, banded
+   and sparse storage */
+
+#define NCHAIN 40
+#define DCHAIN 1.0e4
+
+int
+rhs_chain (double t, const double y[], double f[], void *params)
+{
+  size_t i;
+
+  extern int nfe;
+  nfe += 1;
+
+  for (i = 0; i < NCHAIN; i++)
+    {
+      const double yl = (i > 0) ? y[i - 1] : 0.0;
+      const double yr = (i + 1 < NCHAIN) ? y[i + 1] : 0.0;
+
+      f[i] = DCHAIN * (yl - 2.0 * y[i] + yr) - y[i] * y[i] * y[i];
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+jac_chain (double t, const double y[], double *dfdy, double dfdt[],
+           void *params)
+{
+  size_t i;
+
+  extern int nje;
+  nje += 1;
+
+  for (i = 0; i < NCHAIN * NCHAIN; i++)
+    dfdy[i] = 0.0;
+
+  for (i = 0; i < NCHAIN; i++)
+    {
+      dfdy[i * NCHAIN + i] = -2.0 * DCHAIN - 3.0 * y[i] * y[i];
+
+      if (i > 0)
+        dfdy[i * NCHAIN + i - 1] = DCHAIN;
+
+      if (i + 1 < NCHAIN)
+        dfdy[i * NCHAIN + i + 1] = DCHAIN;
+
+      dfdt[i] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+jac_chain_banded (double t, const double y[], double *dfdy, double dfdt[],
+                  void *params)
+{
+  /* kl = ku = 1, three values per row */
+
+  size_t i;
+
+  extern int nje;
+  nje += 1;
+
+  for (i = 0; i < NCHAIN; i++)
+    {
+      dfdy[3 * i + 1] = -2.0 * DCHAIN - 3.0 * y[i] * y[i];
+
+      if (i > 0)
+        dfdy[3 * i] = DCHAIN;
+
+      if (i + 1 < NCHAIN)
+        dfdy[3 * i + 2] = DCHAIN;
+
+      dfdt[i] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+jac_chain_sparse (double t, const double y[], gsl_spmatrix * dfdy,
+                  double dfdt[], void *params)
+{
+  size_t i;
+
+  extern int nje;
+  nje += 1;
+
+  for (i = 0; i < NCHAIN; i++)
+    {
+      gsl_spmatrix_set (dfdy, i, i, -2.0 * DCHAIN - 3.0 * y[i] * y[i]);
+
+      if (i > 0)
+        gsl_spmatrix_set (dfdy, i, i - 1, DCHAIN);
+
+      if (i + 1 < NCHAIN)
+        gsl_spmatrix_set (dfdy, i, i + 1, DCHAIN);
+
+      dfdt[i] = 0.0;
+    }
+
+  return GSL_SUCCESS;
+}
+
+void
+test_jacobian_storage (const gsl_odeiv2_step_type * T, const double tol)
+{
+  /* Tests banded, sparse and block Jacobian against the default
+     dense Jacobian on a stiff problem. A single block is the whole
+     Jacobian, set by the block Jacobian function. */
+
+  const double t1 = 0.1;
+  gsl_odeiv2_system sys_dense = { rhs_chain, jac_chain, NCHAIN, NULL };
+  gsl_odeiv2_system sys_banded = { rhs_chain, jac_chain_banded, NCHAIN, NULL };
+  gsl_odeiv2_system sys_sparse = { rhs_chain, NULL, NCHAIN, NULL };
+  double y[4][NCHAIN];
+  const char *desc[4] = { "dense", "banded", "sparse", "block" };
+  size_t i, k;
+
+  for (k = 0; k < 4; k++)
+    {
+      gsl_odeiv2_system *sys =
+        (k == 1) ? &sys_banded : (k == 2) ? &sys_sparse : &sys_dense;
+      gsl_odeiv2_driver *d =
+        gsl_odeiv2_driver_alloc_y_new (sys, T, 1e-6, tol, tol);
+      double t = 0.0;
+      int s;
+
+      if (k == 1)
+        s = gsl_odeiv2_driver_set_jacobian_banded (d, 1, 1);
+      else if (k == 2)
+        s = gsl_odeiv2_driver_set_jacobian_sparse (d, jac_chain_sparse);
+      else if (k == 3)
+        s = gsl_odeiv2_driver_set_jacobian_block (d, 1, jac_chain);
+      else
+        s = GSL_SUCCESS;
+
+      gsl_test (s, "%s %s Jacobian set returned %d", T->name, desc[k], s);
+
+      for (i = 0; i < NCHAIN; i++)
+        y[k][i] = sin (M_PI * (i + 1.0) / (NCHAIN + 1.0))
+          + 0.5 * sin (5.0 * M_PI * (i + 1.0) / (NCHAIN + 1.0));
+
+      s = gsl_odeiv2_driver_apply (d, &t, t1, y[k]);
+      gsl_test (s, "%s %s Jacobian apply returned %d", T->name, desc[k], s);
+
+      gsl_odeiv2_driver_free (d);
+    }
+
+  for (k = 1; k < 4; k++)
+    {
+      for (i = 0; i < NCHAIN; i++)
+        {
+          gsl_test_abs (y[k][i], y[0][i], 1e2 * tol,
+                        "%s %s Jacobian y[%d]", T->name, desc[k], (int) i);
+        }
+    }
+}
+
+void
+test_dense_output (const gsl_odeiv2_step_type * T, const double tol)
+{
+  /* Tests gsl_odeiv2_driver_apply_dense against the exact solution
+     of a harmonic oscillator at many output points, and checks that
+     it uses fewer function evaluations than gsl_odeiv2_driver_apply
+     between the output points. */
+
+  const size_t n = 1000;
+  const double eps = 1e-10;
+  double w = 1.0;
+  double tout[1000], yout[2 * 1000];
+  double t = 0.0, y[2] = { 1.0, 0.0 };
+  gsl_odeiv2_system sys = { rhs_osc, jac_osc, 2, &w };
+  gsl_odeiv2_driver *d;
+  const char *name = T->name;
+  int nfe_dense, s;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    tout[i] = 10.0 * (i + 1.0) / n;
+
+  d = gsl_odeiv2_driver_alloc_y_new (&sys, T, 1e-3, eps, eps);
+
+  nfe = 0;
+  s = gsl_odeiv2_driver_apply_dense (d, &t, n, tout, yout, y);
+  nfe_dense = nfe;
+  gsl_test (s, "%s test_dense_output apply returned %d", name, s);
+
+  gsl_test_abs (t, tout[n - 1], 0.0, "%s test_dense_output t", name);
+  gsl_test_abs (y[0], yout[2 * (n - 1)], 0.0, "%s test_dense_output y",
+                name);
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_test_abs (yout[2 * i], cos (tout[i]), tol,
+                    "%s test_dense_output y0(%g)", name, tout[i]);
+      gsl_test_abs (yout[2 * i + 1], -sin (tout[i]), tol,
+                    "%s test_dense_output y1(%g)", name, tout[i]);
+    }
+
+  /* step to each output point */
+
+  gsl_odeiv2_driver_reset_hstart (d, 1e-3);
+  t = 0.0;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  nfe = 0;
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_odeiv2_driver_apply (d, &t, tout[i], y);
+    }
+
+  gsl_test (nfe_dense >= nfe,
+            "%s test_dense_output function evaluations %d vs %d",
+            name, nfe_dense, nfe);
+
+  gsl_odeiv2_driver_free (d);
+}
+
+/* Event functions for test_events */
+
+struct event_record
+{
+  size_t n;
+  double t[8];
+};
+
+int
+event_osc (double t, const double y[], double g[], void *params)
+{
+  g[0] = y[0];
+  return GSL_SUCCESS;
+}
+
+int
+event_osc_record (double t, double y[], size_t i, void *params)
+{
+  struct event_record *r = (struct event_record *) params;
+
+  if (r->n < 8)
+    r->t[r->n++] = t;
+
+  return GSL_ODEIV2_EVENT_CONTINUE;
+}
+
+int
+rhs_ball (double t, const double y[], double f[], void *params)
+{
+  extern int nfe;
+  nfe += 1;
+
+  f[0] = y[1];
+  f[1] = -1.0;
+
+  return GSL_SUCCESS;
+}
+
+int
+event_ball (double t, const double y[], double g[], void *params)
+{
+  g[0] = y[0];
+  return GSL_SUCCESS;
+}
+
+int
+event_ball_bounce (double t, double y[], size_t i, void *params)
+{
+  struct event_record *r = (struct event_record *) params;
+
+  if (r->n < 8)
+    r->t[r->n++] = t;
+
+  y[1] = -0.5 * y[1];
+
+  return GSL_ODEIV2_EVENT_RESTART;
+}
+
+void
+test_events (const gsl_odeiv2_step_type * T, const double tol)
+{
+  /* Tests event location with gsl_odeiv2_driver_apply. Events of a
+     harmonic oscillator must be found without changing the steps
+     taken, both with a non-terminal action and when the integration
+     stops at the events and is resumed. */
+
+  const double eps = 1e-10;
+  const double t1 = 10.0;
+  double w = 1.0;
+  gsl_odeiv2_system sys = { rhs_osc, jac_osc, 2, &w };
+  struct event_record rec;
+  gsl_odeiv2_event ev;
+  const int down = -1;
+  gsl_odeiv2_driver *d;
+  const char *name = T->name;
+  double t, y[2];
+  int nfe_plain, s;
+  size_t i;
+
+  d = gsl_odeiv2_driver_alloc_y_new (&sys, T, 1e-3, eps, eps);
+
+  t = 0.0;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  nfe = 0;
+  gsl_odeiv2_driver_apply (d, &t, t1, y);
+  nfe_plain = nfe;
+
+  /* non-terminal events at zeros of cos(t) */
+
+  ev.function = event_osc;
+  ev.action = event_osc_record;
+  ev.nevents = 1;
+  ev.direction = NULL;
+  ev.params = &rec;
+
+  gsl_odeiv2_driver_set_events (d, &ev);
+  gsl_odeiv2_driver_reset_hstart (d, 1e-3);
+
+  rec.n = 0;
+  t = 0.0;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  nfe = 0;
+
+  s = gsl_odeiv2_driver_apply (d, &t, t1, y);
+  gsl_test (s, "%s test_events apply returned %d", name, s);
+  gsl_test (nfe != nfe_plain,
+            "%s test_events function evaluations %d vs %d", name, nfe,
+            nfe_plain);
+  gsl_test_abs (y[0], cos (t1), tol, "%s test_events y0(t1)", name);
+  gsl_test (rec.n != 3, "%s test_events number of events %d", name,
+            (int) rec.n);
+
+  for (i = 0; i < rec.n; i++)
+    {
+      gsl_test_abs (rec.t[i], M_PI * (i + 0.5), tol,
+                    "%s test_events event %d", name, (int) i);
+    }
+
+  /* terminal events at decreasing zeros, resumed */
+
+  ev.action = NULL;
+  ev.direction = &down;
+
+  gsl_odeiv2_driver_set_events (d, &ev);
+  gsl_odeiv2_driver_reset_hstart (d, 1e-3);
+
+  t = 0.0;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  nfe = 0;
+
+  for (i = 0; i < 2; i++)
+    {
+      s = gsl_odeiv2_driver_apply (d, &t, t1, y);
+      gsl_test (s, "%s test_events stop %d returned %d", name, (int) i, s);
+      gsl_test (d->ievent != 0, "%s test_events stop %d index", name,
+                (int) i);
+      gsl_test_abs (t, M_PI * (2 * i + 0.5), tol,
+                    "%s test_events stop %d t", name, (int) i);
+      gsl_test_abs (y[0], 0.0, tol, "%s test_events stop %d y0", name,
+                    (int) i);
+    }
+
+  s = gsl_odeiv2_driver_apply (d, &t, t1, y);
+  gsl_test (s, "%s test_events resume returned %d", name, s);
+  gsl_test (d->ievent != -1, "%s test_events resume index", name);
+  gsl_test_abs (t, t1, 0.0, "%s test_events resume t", name);
+  gsl_test_abs (y[0], cos (t1), tol, "%s test_events resume y0", name);
+  gsl_test (nfe != nfe_plain,
+            "%s test_events resumed function evaluations %d vs %d", name,
+            nfe, nfe_plain);
+
+  gsl_odeiv2_driver_free (d);
+}
+
+void
+test_events_restart (void)
+{
+  /* Bouncing ball, the action reverses the velocity at each impact
+     and the integration is restarted. The impacts are at
+     t_k = sqrt(2) (1 + 2 sum_{j=1}^{k-1} 0.5^j). */
+
+  gsl_odeiv2_system sys = { rhs_ball, NULL, 2, NULL };
+  struct event_record rec;
+  const int down = -1;
+  gsl_odeiv2_event ev = { event_ball, event_ball_bounce, 1, NULL, NULL };
+  gsl_odeiv2_driver *d;
+  double t = 0.0, y[2] = { 1.0, 0.0 };
+  double tk = M_SQRT2, dt = M_SQRT2;
+  size_t i;
+  int s;
+
+  ev.direction = &down;
+  ev.params = &rec;
+  rec.n = 0;
+
+  d = gsl_odeiv2_driver_alloc_y_new (&sys, gsl_odeiv2_step_rkf45, 1e-3,
+                                     1e-10, 0.0);
+  gsl_odeiv2_driver_set_events (d, &ev);
+
+  s = gsl_odeiv2_driver_apply (d, &t, 3.8, y);
+  gsl_test (s, "test_events_restart returned %d", s);
+  gsl_test (rec.n != 3, "test_events_restart number of events %d",
+            (int) rec.n);
+
+  for (i = 0; i < rec.n; i++)
+    {
+      gsl_test_abs (rec.t[i], tk, 1e-10, "test_events_restart impact %d",
+                    (int) i);
+      tk += dt;
+      dt *= 0.5;
+    }
+
+  gsl_odeiv2_driver_free (d);
+}
+
+/* Damped oscillator y0' = y1, y1' = -p0 y0 - p1 y1 for sensitivity
+   tests */
+
+int
+rhs_damped (double t, const double y[], double f[], void *params)
+{
+  const double *p = (const double *) params;
+
+  f[0] = y[1];
+  f[1] = -p[0] * y[0] - p[1] * y[1];
+
+  return GSL_SUCCESS;
+}
+
+int
+jac_damped (double t, const double y[], double *dfdy, double dfdt[],
+            void *params)
+{
+  const double *p = (const double *) params;
+
+  dfdy[0] = 0.0;
+  dfdy[1] = 1.0;
+  dfdy[2] = -p[0];
+  dfdy[3] = -p[1];
+
+  dfdt[0] = 0.0;
+  dfdt[1] = 0.0;
+
+  return GSL_SUCCESS;
+}
+
+int
+dfdp_damped (double t, const double y[], double dfdp[], void *params)
+{
+  dfdp[0] = 0.0;
+  dfdp[1] = 0.0;
+  dfdp[2] = -y[0];
+  dfdp[3] = -y[1];
+
+  return GSL_SUCCESS;
+}
+
+void
+test_sens (const gsl_odeiv2_step_type * T, const double tol)
+{
+  /* Compares forward sensitivities with central differences of the
+     solution, and the adjoint gradient of y0(t1) with the forward
+     sensitivities */
+
+  const double t1 = 5.0, dp = 1e-4;
+  double p[2] = { 4.0, 0.3 };
+  gsl_odeiv2_sens_system sys =
+    { rhs_damped, jac_damped, dfdp_damped, 2, 2, p };
+  gsl_odeiv2_system psys = { rhs_damped, jac_damped, 2, p };
+  gsl_odeiv2_sens *s = gsl_odeiv2_sens_alloc (&sys, T, 1e-3, 1e-10, 1e-10);
+  double y[2] = { 1.0, 0.0 }, S[4] = { 0.0, 0.0, 0.0, 0.0 };
+  double y1[2], lambda1[2] = { 1.0, 0.0 }, lambda0[2], grad[2];
+  double t = 0.0;
+  size_t i, k;
+  int status;
+
+  status = gsl_odeiv2_sens_apply (s, &t, t1, y, S);
+  gsl_test (status, "%s test_sens forward returned %d", T->name, status);
+
+  for (k = 0; k < 2; k++)
+    {
+      double yp[2], ym[2];
+      double h = dp * p[k];
+      double pk = p[k];
+
+      for (i = 0; i < 2; i++)
+        {
+          double *yd = (i == 0) ? yp : ym;
+          gsl_odeiv2_driver *d =
+            gsl_odeiv2_driver_alloc_y_new (&psys, T, 1e-3, 1e-12, 1e-12);
+          double td = 0.0;
+
+          p[k] = (i == 0) ? pk + h : pk - h;
+          yd[0] = 1.0;
+          yd[1] = 0.0;
+          gsl_odeiv2_driver_apply (d, &td, t1, yd);
+          gsl_odeiv2_driver_free (d);
+        }
+
+      p[k] = pk;
+
+      for (i = 0; i < 2; i++)
+        {
+          gsl_test_abs (S[i * 2 + k], (yp[i] - ym[i]) / (2.0 * h), tol,
+                        "%s test_sens forward S[%d,%d]", T->name,
+                        (int) i, (int) k);
+        }
+    }
+
+  y[0] = 1.0;
+  y[1] = 0.0;
+  gsl_odeiv2_sens_set_checkpoint (s, 5);
+
+  status = gsl_odeiv2_sens_adjoint (s, 0.0, y, t1, lambda1, y1, lambda0,
+                                    grad);
+  gsl_test (status, "%s test_sens adjoint returned %d", T->name, status);
+
+  for (k = 0; k < 2; k++)
+    {
+      gsl_test_abs (grad[k], S[k], tol, "%s test_sens adjoint grad[%d]",
+                    T->name, (int) k);
+    }
+
+  gsl_odeiv2_sens_free (s);
+}
+
 void
 test_extreme_problems (void)
 {
@@ -2524,6 +3189,41 @@ main (void)
       test_stepfn2 (explicit_stepper[i].type);
     }
 
+  /* Ensemble driver */
+
+  test_ensemble (gsl_odeiv2_step_rkf45);
+  test_ensemble (gsl_odeiv2_step_rkck);
+  test_ensemble (gsl_odeiv2_step_rk8pd);
+
+  /* Dense output */
+
+  test_dense_output (gsl_odeiv2_step_rkf45, 1e-8);
+  test_dense_output (gsl_odeiv2_step_rkck, 1e-8);
+  test_dense_output (gsl_odeiv2_step_rk8pd, 1e-7);
+  test_dense_output (gsl_odeiv2_step_msadams, 1e-7);
+  test_dense_output (gsl_odeiv2_step_msbdf, 1e-6);
+
+  /* Event location */
+
+  test_events (gsl_odeiv2_step_rkf45, 1e-8);
+  test_events (gsl_odeiv2_step_rk8pd, 1e-7);
+  test_events (gsl_odeiv2_step_msadams, 1e-7);
+  test_events (gsl_odeiv2_step_msbdf, 1e-6);
+  test_events_restart ();
+
+  /* Sensitivity analysis */
+
+  test_sens (gsl_odeiv2_step_rkf45, 1e-5);
+  test_sens (gsl_odeiv2_step_rk8pd, 1e-5);
+  test_sens (gsl_odeiv2_step_msadams, 1e-5);
+  test_sens (gsl_odeiv2_step_msbdf, 1e-4);
+
+  /* Banded and sparse Jacobian */
+
+  test_jacobian_storage (gsl_odeiv2_step_msbdf, 1e-8);
+  test_jacobian_storage (gsl_odeiv2_step_rk2imp, 1e-6);
+  test_jacobian_storage (gsl_odeiv2_step_rk1imp, 1e-4);
+
   /* Special tests */
 
   test_nonstiff_problems ();
@@ -28,6 +28,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -230,3 +231,74 @@ double gsl_sf_bessel_I0(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_I0_e(x, &result); ) 
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double bessel_I0_scaled_val(const double x, gsl_mode_t mode)
+{
+  double y = fabs(x);
+
+  if(y < 2.0 * GSL_SQRT_DBL_EPSILON) {
+    return 1.0 - y;
+  }
+  else if(y <= 3.0) {
+    const double ey = exp(-y);
+    return ey * (2.75 + cheb_eval_mode(&bi0_cs, y*y/4.5-1.0, mode));
+  }
+  else if(y <= 8.0) {
+    const double sy = sqrt(y);
+    return (0.375 + cheb_eval_mode(&ai0_cs, (48.0/y-11.0)/5.0, mode)) / sy;
+  }
+  else {
+    const double sy = sqrt(y);
+    return (0.375 + cheb_eval_mode(&ai02_cs, 16.0/y-1.0, mode)) / sy;
+  }
+}
+
+static double bessel_I0_val(const double x, gsl_mode_t mode)
+{
+  double y = fabs(x);
+
+  if(y < 2.0 * GSL_SQRT_DBL_EPSILON) {
+    return 1.0;
+  }
+  else if(y <= 3.0) {
+    return 2.75 + cheb_eval_mode(&bi0_cs, y*y/4.5-1.0, mode);
+  }
+  else if(y < GSL_LOG_DBL_MAX - 1.0) {
+    const double ey = exp(y);
+    return ey * bessel_I0_scaled_val(x, mode);
+  }
+  else {
+    return GSL_POSINF;
+  }
+}
+
+int gsl_sf_bessel_I0_scaled_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_I0_scaled_val, n, x, result);
+}
+
+int gsl_sf_bessel_I0_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_I0_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_I0_scaled_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_I0_scaled_val(x, mode);
+}
+
+double gsl_sf_bessel_I0_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_I0_val(x, mode);
+}
@@ -28,6 +28,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 #define ROOT_EIGHT (2.0*M_SQRT2)
 
@@ -256,3 +257,88 @@ double gsl_sf_bessel_I1(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_I1_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double bessel_I1_scaled_val(const double x, gsl_mode_t mode)
+{
+  const double xmin    = 2.0 * GSL_DBL_MIN;
+  const double x_small = ROOT_EIGHT * GSL_SQRT_DBL_EPSILON;
+  const double y = fabs(x);
+
+  if(y < xmin) {
+    return 0.0;
+  }
+  else if(y < x_small) {
+    return 0.5*x;
+  }
+  else if(y <= 3.0) {
+    const double ey = exp(-y);
+    return x * ey * (0.875 + cheb_eval_mode(&bi1_cs, y*y/4.5-1.0, mode));
+  }
+  else if(y <= 8.0) {
+    const double sy = sqrt(y);
+    const double b = (0.375 + cheb_eval_mode(&ai1_cs, (48.0/y-11.0)/5.0, mode)) / sy;
+    const double s = (x > 0.0 ? 1.0 : -1.0);
+    return s * b;
+  }
+  else {
+    const double sy = sqrt(y);
+    const double b = (0.375 + cheb_eval_mode(&ai12_cs, 16.0/y-1.0, mode)) / sy;
+    const double s = (x > 0.0 ? 1.0 : -1.0);
+    return s * b;
+  }
+}
+
+static double bessel_I1_val(const double x, gsl_mode_t mode)
+{
+  const double xmin    = 2.0 * GSL_DBL_MIN;
+  const double x_small = ROOT_EIGHT * GSL_SQRT_DBL_EPSILON;
+  const double y = fabs(x);
+
+  if(y < xmin) {
+    return 0.0;
+  }
+  else if(y < x_small) {
+    return 0.5*x;
+  }
+  else if(y <= 3.0) {
+    return x * (0.875 + cheb_eval_mode(&bi1_cs, y*y/4.5-1.0, mode));
+  }
+  else if(y < GSL_LOG_DBL_MAX) {
+    const double ey = exp(y);
+    return ey * bessel_I1_scaled_val(x, mode);
+  }
+  else {
+    return GSL_POSINF;
+  }
+}
+
+int gsl_sf_bessel_I1_scaled_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_I1_scaled_val, n, x, result);
+}
+
+int gsl_sf_bessel_I1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_I1_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_I1_scaled_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_I1_scaled_val(x, mode);
+}
+
+double gsl_sf_bessel_I1_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_I1_val(x, mode);
+}
@@ -29,6 +29,7 @@
 #include <gsl/gsl_sf_bessel.h>
 
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -109,3 +110,47 @@ double gsl_sf_bessel_J0(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_J0_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of gsl_sf_bessel_J0_e. This performs the same
+ * arithmetic without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+static double bessel_J0_val(const double x, gsl_mode_t mode)
+{
+  double y = fabs(x);
+
+  if(y < 2.0*GSL_SQRT_DBL_EPSILON) {
+    return 1.0;
+  }
+  else if(y <= 4.0) {
+    return cheb_eval_mode(&bj0_cs, 0.125*y*y - 1.0, mode);
+  }
+  else {
+    const double z = 32.0/(y*y) - 1.0;
+    const double ca = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bm0_cs,  z, mode);
+    const double ct = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bth0_cs, z, mode);
+    gsl_sf_result cp;
+    gsl_sf_bessel_cos_pi4_e(y, ct/y, &cp);
+    {
+      const double sqrty = sqrt(y);
+      const double ampl  = (0.75 + ca) / sqrty;
+      return ampl * cp.val;
+    }
+  }
+}
+
+int gsl_sf_bessel_J0_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_J0_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_J0_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_J0_val(x, mode);
+}
@@ -30,6 +30,7 @@
 #include "bessel.h"
 #include "bessel_amp_phase.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 #define ROOT_EIGHT (2.0*M_SQRT2)
 
@@ -126,3 +127,53 @@ double gsl_sf_bessel_J1(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_J1_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of gsl_sf_bessel_J1_e. This performs the same
+ * arithmetic without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+static double bessel_J1_val(const double x, gsl_mode_t mode)
+{
+  double y = fabs(x);
+
+  if(y == 0.0) {
+    return 0.0;
+  }
+  else if(y < 2.0*GSL_DBL_MIN) {
+    return 0.0;
+  }
+  else if(y < ROOT_EIGHT * GSL_SQRT_DBL_EPSILON) {
+    return 0.5*x;
+  }
+  else if(y < 4.0) {
+    return x * (0.25 + cheb_eval_mode(&bj1_cs, 0.125*y*y-1.0, mode));
+  }
+  else {
+    const double z  = 32.0/(y*y) - 1.0;
+    const double ca = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bm1_cs,  z, mode);
+    const double ct = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bth1_cs, z, mode);
+    gsl_sf_result sp;
+    gsl_sf_bessel_sin_pi4_e(y, ct/y, &sp);
+    {
+      const double sqrty = sqrt(y);
+      const double ampl  = (0.75 + ca) / sqrty;
+      return (x < 0.0 ? -ampl : ampl) * sp.val;
+    }
+  }
+}
+
+int gsl_sf_bessel_J1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_J1_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_J1_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_J1_val(x, mode);
+}
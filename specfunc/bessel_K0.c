@@ -31,6 +31,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -205,3 +206,70 @@ double gsl_sf_bessel_K0(const double x)
   EVAL_RESULT(gsl_sf_bessel_K0_e(x, &result));
 }
 
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double bessel_K0_scaled_val(const double x, gsl_mode_t mode)
+{
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 1.0) {
+    const double lx = log(x);
+    const double ex = exp(x);
+    const double x2 = x*x;
+    return ex * (gsl_poly_eval(k0_poly,8,x2)-lx*(1.0+0.25*x2*gsl_poly_eval(i0_poly,7,0.25*x2)));
+  }
+  else if(x <= 8.0) {
+    const double sx = sqrt(x);
+    return (1.203125 + cheb_eval_mode(&ak0_cs, (16.0/x-9.0)/7.0, mode)) / sx;
+  }
+  else {
+    const double sx = sqrt(x);
+    return (1.25 + cheb_eval_mode(&ak02_cs, 16.0/x-1.0, mode)) / sx;
+  } 
+}
+
+static double bessel_K0_val(const double x, gsl_mode_t mode)
+{
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 1.0) {
+    const double lx = log(x);
+    const double x2 = x*x;
+    return gsl_poly_eval(k0_poly,8,x2)-lx*(1.0+0.25*x2*gsl_poly_eval(i0_poly,7,0.25*x2));
+  }
+  else {
+    return exp_mult_val(-x, bessel_K0_scaled_val(x, mode));
+  }
+}
+
+int gsl_sf_bessel_K0_scaled_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_K0_scaled_val, n, x, result);
+}
+
+int gsl_sf_bessel_K0_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_K0_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_K0_scaled_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_K0_scaled_val(x, mode);
+}
+
+double gsl_sf_bessel_K0_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_K0_val(x, mode);
+}
@@ -31,6 +31,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -215,3 +216,80 @@ double gsl_sf_bessel_K1(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_K1_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double bessel_K1_scaled_val(const double x, gsl_mode_t mode)
+{
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 2.0*GSL_DBL_MIN) {
+    return GSL_POSINF;
+  }
+  else if(x < 1.0) {
+    const double lx = log(x);
+    const double ex = exp(x);
+    const double x2 = x*x;
+    const double t  = 0.25*x2;    
+    const double i1 = 0.5 * x * (1.0 + t * (0.5 + t * gsl_poly_eval(i1_poly,6,t)));
+    return ex * (x2 * gsl_poly_eval(k1_poly,9,x2) + x * lx * i1 + 1) / x;
+  }
+  else if(x <= 8.0) {
+    const double sx = sqrt(x);
+    return (1.375 + cheb_eval_mode(&ak1_cs, (16.0/x-9.0)/7.0, mode)) / sx;
+  }
+  else {
+    const double sx = sqrt(x);
+    return (1.25 + cheb_eval_mode(&ak12_cs, 16.0/x-1.0, mode)) / sx;
+  }
+}
+
+static double bessel_K1_val(const double x, gsl_mode_t mode)
+{
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 2.0*GSL_DBL_MIN) {
+    return GSL_POSINF;
+  }
+  else if(x < 1.0) {
+    const double lx = log(x);
+    const double x2 = x*x;
+    const double t  = 0.25*x2;    
+    const double i1 = 0.5 * x * (1.0 + t * (0.5 + t * gsl_poly_eval(i1_poly,6,t)));
+    return (x2 * gsl_poly_eval(k1_poly,9,x2) + x * lx * i1 + 1) / x;
+  }
+  else {
+    return exp_mult_val(-x, bessel_K1_scaled_val(x, mode));
+  }
+}
+
+int gsl_sf_bessel_K1_scaled_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_K1_scaled_val, n, x, result);
+}
+
+int gsl_sf_bessel_K1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_K1_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_K1_scaled_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_K1_scaled_val(x, mode);
+}
+
+double gsl_sf_bessel_K1_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_K1_val(x, mode);
+}
@@ -30,6 +30,7 @@
 #include "bessel.h"
 #include "bessel_amp_phase.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -120,3 +121,52 @@ double gsl_sf_bessel_Y0(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_Y0_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of gsl_sf_bessel_Y0_e. This performs the same
+ * arithmetic without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+static double bessel_Y0_val(const double x, gsl_mode_t mode)
+{
+  const double two_over_pi = 2.0/M_PI;
+  const double xmax        = 1.0/GSL_DBL_EPSILON;
+
+  if (x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 4.0) {
+    const double J0 = gsl_sf_bessel_J0_fast(x, mode);
+    return two_over_pi*(-M_LN2 + log(x))*J0 + 0.375 + cheb_eval_mode(&by0_cs, 0.125*x*x-1.0, mode);
+  }
+  else if(x < xmax) {
+    const double z  = 32.0/(x*x) - 1.0;
+    const double c1 = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bm0_cs,  z, mode);
+    const double c2 = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bth0_cs, z, mode);
+    gsl_sf_result sp;
+    gsl_sf_bessel_sin_pi4_e(x, c2/x, &sp);
+    {
+      const double sqrtx = sqrt(x);
+      const double ampl  = (0.75 + c1) / sqrtx;
+      return ampl * sp.val;
+    }
+  }
+  else {
+    return 0.0;
+  }
+}
+
+int gsl_sf_bessel_Y0_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_Y0_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_Y0_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_Y0_val(x, mode);
+}
@@ -30,6 +30,7 @@
 #include "bessel.h"
 #include "bessel_amp_phase.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -135,3 +136,65 @@ double gsl_sf_bessel_Y1(const double x)
 {
   EVAL_RESULT(gsl_sf_bessel_Y1_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of gsl_sf_bessel_Y1_e. This performs the same
+ * arithmetic without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+static double bessel_Y1_val(const double x, gsl_mode_t mode)
+{
+  const double two_over_pi = 2.0/M_PI;
+  const double xmin = 1.571*GSL_DBL_MIN;
+  const double x_small = 2.0 * GSL_SQRT_DBL_EPSILON;
+  const double xmax    = 1.0/GSL_DBL_EPSILON;
+
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < xmin) {
+    return GSL_POSINF;
+  }
+  else if(x < 4.0) {
+    const double lnterm = log(0.5*x);
+    const double c = cheb_eval_mode(&by1_cs, (x < x_small) ? -1.0 : 0.125*x*x-1.0, mode);
+    double J1;
+    if(x < 2.0*GSL_DBL_MIN) {
+      J1 = 0.0; /* J1 underflows */
+    }
+    else {
+      J1 = gsl_sf_bessel_J1_fast(x, mode);
+    }
+    return two_over_pi * lnterm * J1 + (0.5 + c)/x;
+  }
+  else if(x < xmax) {
+    const double z = 32.0/(x*x) - 1.0;
+    const double ca = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bm1_cs,  z, mode);
+    const double ct = cheb_eval_mode(&_gsl_sf_bessel_amp_phase_bth1_cs, z, mode);
+    gsl_sf_result cp;
+    gsl_sf_bessel_cos_pi4_e(x, ct/x, &cp);
+    {
+      const double sqrtx = sqrt(x);
+      const double ampl  = (0.75 + ca) / sqrtx;
+      return -ampl * cp.val;
+    }
+  }
+  else {
+    return 0.0;
+  }
+}
+
+int gsl_sf_bessel_Y1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(bessel_Y1_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_bessel_Y1_fast(const double x, gsl_mode_t mode)
+{
+  return bessel_Y1_val(x, mode);
+}
@@ -28,3 +28,18 @@ cheb_eval_mode_e(const cheb_series * cs,
   result->err = GSL_DBL_EPSILON * fabs(result->val) + fabs(cs->c[eval_order]);
   return GSL_SUCCESS;
 }
+
+
+
+/* As cheb_eval_mode_e, returning only the value. The error estimate
+ * is discarded, and is not computed once this is inlined.
+ */
+static inline double
+cheb_eval_mode(const cheb_series * cs,
+               const double x,
+               gsl_mode_t mode)
+{
+  gsl_sf_result result;
+  cheb_eval_mode_e(cs, x, mode, &result);
+  return result.val;
+}
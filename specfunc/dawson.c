@@ -27,6 +27,7 @@
 #include "error.h"
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /* Based on ddaws.f, Fullerton, W., (LANL) */
 
@@ -279,3 +280,52 @@ double gsl_sf_dawson(double x)
 {
   EVAL_RESULT(gsl_sf_dawson_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of gsl_sf_dawson_e(). This performs the
+ * same arithmetic, without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double dawson_val(const double x, gsl_mode_t mode)
+{
+  const double xsml = 1.225 * GSL_SQRT_DBL_EPSILON;
+  const double xbig = 1.0/(M_SQRT2*GSL_SQRT_DBL_EPSILON);
+  const double xmax = 0.1 * GSL_DBL_MAX;
+
+  const double y = fabs(x);
+
+  if(y < xsml) {
+    return x;
+  }
+  else if(y < 1.0) {
+    return x * (0.75 + cheb_eval_mode(&daw_cs, 2.0*y*y - 1.0, mode));
+  }
+  else if(y < 4.0) {
+    return x * (0.25 + cheb_eval_mode(&daw2_cs, 0.125*y*y - 1.0, mode));
+  }
+  else if(y < xbig) {
+    return (0.5 + cheb_eval_mode(&dawa_cs, 32.0/(y*y) - 1.0, mode)) / x;
+  }
+  else if(y < xmax) {
+    return 0.5/x;
+  }
+  else {
+    return 0.0;
+  }
+}
+
+int gsl_sf_dawson_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(dawson_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_dawson_fast(const double x, gsl_mode_t mode)
+{
+  return dawson_val(x, mode);
+}
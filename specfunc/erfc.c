@@ -36,6 +36,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 #define LogRootPi_  0.57236494292470008706
 
@@ -463,3 +464,161 @@ double gsl_sf_hazard(double x)
   EVAL_RESULT(gsl_sf_hazard_e(x, &result));
 }
 
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double erfseries_val(double x)
+{
+  double coef = x;
+  double e    = coef;
+  int k;
+  for (k=1; k<30; ++k) {
+    coef *= -x*x/k;
+    e += coef/(2.0*k+1.0);
+  }
+  return 2.0 / M_SQRTPI * e;
+}
+
+static double erfc_val(double x, gsl_mode_t mode)
+{
+  const double ax = fabs(x);
+  double e_val;
+
+  if(ax <= 1.0) {
+    double t = 2.0*ax - 1.0;
+    e_val = cheb_eval_mode(&erfc_xlt1_cs, t, mode);
+  }
+  else if(ax <= 5.0) {
+    double ex2 = exp(-x*x);
+    double t = 0.5*(ax-3.0);
+    e_val = ex2 * cheb_eval_mode(&erfc_x15_cs, t, mode);
+  }
+  else if(ax < 10.0) {
+    double exterm = exp(-x*x) / ax;
+    double t = (2.0*ax - 15.0)/5.0;
+    e_val = exterm * cheb_eval_mode(&erfc_x510_cs, t, mode);
+  }
+  else {
+    e_val = erfc8(ax);
+  }
+
+  return (x < 0.0) ? 2.0 - e_val : e_val;
+}
+
+static double log_erfc_val(double x, gsl_mode_t mode)
+{
+  if(x*x < 10.0*GSL_ROOT6_DBL_EPSILON) {
+    gsl_sf_result result;
+    gsl_sf_log_erfc_e(x, &result);
+    return result.val;
+  }
+  else if(x > 8.0) {
+    return log_erfc8(x);
+  }
+  else {
+    return log(erfc_val(x, mode));
+  }
+}
+
+static double erf_val(double x, gsl_mode_t mode)
+{
+  if(fabs(x) < 1.0) {
+    return erfseries_val(x);
+  }
+  else {
+    return 1.0 - erfc_val(x, mode);
+  }
+}
+
+static double erf_Z_val(double x)
+{
+  const double ex2 = exp(-x*x/2.0);
+  return ex2 / (M_SQRT2 * M_SQRTPI);
+}
+
+static double erf_Q_val(double x, gsl_mode_t mode)
+{
+  return 0.5 * erfc_val(x/M_SQRT2, mode);
+}
+
+static double hazard_val(double x, gsl_mode_t mode)
+{
+  if(x < 25.0)
+  {
+    const double lnc = -0.22579135264472743236; /* ln(sqrt(2/pi)) */
+    const double arg = lnc - 0.5*x*x - log_erfc_val(x/M_SQRT2, mode);
+    return (arg < GSL_LOG_DBL_MIN) ? 0.0 : exp(arg);
+  }
+  else
+  {
+    const double ix2 = 1.0/(x*x);
+    const double corrB = 1.0 - 9.0*ix2 * (1.0 - 11.0*ix2);
+    const double corrM = 1.0 - 5.0*ix2 * (1.0 - 7.0*ix2 * corrB);
+    const double corrT = 1.0 - ix2 * (1.0 - 3.0*ix2*corrM);
+    return x / corrT;
+  }
+}
+
+int gsl_sf_erfc_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(erfc_val, n, x, result);
+}
+
+int gsl_sf_log_erfc_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(log_erfc_val, n, x, result);
+}
+
+int gsl_sf_erf_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(erf_val, n, x, result);
+}
+
+int gsl_sf_erf_Z_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(erf_Z_val, n, x, result);
+}
+
+int gsl_sf_erf_Q_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(erf_Q_val, n, x, result);
+}
+
+int gsl_sf_hazard_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(hazard_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_erfc_fast(const double x, gsl_mode_t mode)
+{
+  return erfc_val(x, mode);
+}
+
+double gsl_sf_log_erfc_fast(const double x, gsl_mode_t mode)
+{
+  return log_erfc_val(x, mode);
+}
+
+double gsl_sf_erf_fast(const double x, gsl_mode_t mode)
+{
+  return erf_val(x, mode);
+}
+
+double gsl_sf_erf_Q_fast(const double x, gsl_mode_t mode)
+{
+  return erf_Q_val(x, mode);
+}
+
+double gsl_sf_hazard_fast(const double x, gsl_mode_t mode)
+{
+  return hazard_val(x, mode);
+}
@@ -15,3 +15,98 @@
    } ; \
    return result;
 
+
+/* status of the values computed for an array of arguments: GSL_EDOM
+   if an argument which is not a nan gave a nan, otherwise GSL_EOVRFLW
+   if a finite argument gave an infinite result */
+
+static inline int
+eval_array_status(const size_t n, const double x[], const double result[])
+{
+  int status = GSL_SUCCESS;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    const double r_i = result[i];
+    const double x_i = x[i];
+    if (r_i != r_i && x_i == x_i) {
+      return GSL_EDOM;
+    }
+    else if (fabs(r_i) > GSL_DBL_MAX && fabs(x_i) <= GSL_DBL_MAX) {
+      status = GSL_EOVRFLW;
+    }
+  }
+
+  return status;
+}
+
+
+/* evaluate a value-only function on each element of an array. The
+   error handler is called once for the whole array, with the status
+   given by eval_array_status(). */
+
+#define EVAL_ARRAY(fn, n, x, result) \
+   size_t i; \
+   int status; \
+   for (i = 0; i < (n); i++) { \
+     (result)[i] = fn((x)[i]); \
+   } \
+   status = eval_array_status((n), (x), (result)); \
+   if (status != GSL_SUCCESS) { \
+     GSL_ERROR(status == GSL_EDOM ? "domain error" : "overflow", status); \
+   } ; \
+   return GSL_SUCCESS;
+
+/* as EVAL_ARRAY, for a value-only function fn(x, mode) which is
+   evaluated at full precision */
+
+#define EVAL_ARRAY_MODE(fn, n, x, result) \
+   size_t i; \
+   int status; \
+   for (i = 0; i < (n); i++) { \
+     (result)[i] = fn((x)[i], GSL_PREC_DOUBLE); \
+   } \
+   status = eval_array_status((n), (x), (result)); \
+   if (status != GSL_SUCCESS) { \
+     GSL_ERROR(status == GSL_EDOM ? "domain error" : "overflow", status); \
+   } ; \
+   return GSL_SUCCESS;
+
+/* the value of gsl_sf_exp_mult_err_e(x, dx, y, dy, result), computed
+   in the same way, with zero on underflow and +inf on overflow */
+
+static inline double
+exp_mult_val(const double x, const double y)
+{
+  const double ay = fabs(y);
+
+  if(y == 0.0) {
+    return 0.0;
+  }
+  else if(   ( x < 0.5*GSL_LOG_DBL_MAX   &&   x > 0.5*GSL_LOG_DBL_MIN)
+          && (ay < 0.8*GSL_SQRT_DBL_MAX  &&  ay > 1.2*GSL_SQRT_DBL_MIN)
+    ) {
+    return y * exp(x);
+  }
+  else {
+    const double ly  = log(ay);
+    const double lnr = x + ly;
+
+    if(lnr > GSL_LOG_DBL_MAX - 0.01) {
+      return GSL_POSINF;
+    }
+    else if(lnr < GSL_LOG_DBL_MIN + 0.01) {
+      return 0.0;
+    }
+    else {
+      const double sy  = GSL_SIGN(y);
+      const double M   = floor(x);
+      const double N   = floor(ly);
+      const double a   = x  - M;
+      const double b   = ly - N;
+      const double eMN = exp(M+N);
+      const double eab = exp(a+b);
+      return sy * eMN * eab;
+    }
+  }
+}
@@ -612,3 +612,81 @@ double gsl_sf_exprel_n(const int n, const double x)
 {
   EVAL_RESULT(gsl_sf_exprel_n_e(n, x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ */
+
+static double exp_val(const double x)
+{
+  if(x > GSL_LOG_DBL_MAX) {
+    return GSL_POSINF;
+  }
+  else if(x < GSL_LOG_DBL_MIN) {
+    return 0.0;
+  }
+  else {
+    return exp(x);
+  }
+}
+
+static double expm1_val(const double x)
+{
+  const double cut = 0.002;
+
+  if(x < GSL_LOG_DBL_MIN) {
+    return -1.0;
+  }
+  else if(x < -cut) {
+    return exp(x) - 1.0;
+  }
+  else if(x < cut) {
+    return x * (1.0 + 0.5*x*(1.0 + x/3.0*(1.0 + 0.25*x*(1.0 + 0.2*x))));
+  } 
+  else if(x < GSL_LOG_DBL_MAX) {
+    return exp(x) - 1.0;
+  }
+  else {
+    return GSL_POSINF;
+  }
+}
+
+static double exprel_val(const double x)
+{
+  const double cut = 0.002;
+
+  if(x < GSL_LOG_DBL_MIN) {
+    return -1.0/x;
+  }
+  else if(x < -cut) {
+    return (exp(x) - 1.0)/x;
+  }
+  else if(x < cut) {
+    return (1.0 + 0.5*x*(1.0 + x/3.0*(1.0 + 0.25*x*(1.0 + 0.2*x))));
+  } 
+  else if(x < GSL_LOG_DBL_MAX) {
+    return (exp(x) - 1.0)/x;
+  }
+  else {
+    return GSL_POSINF;
+  }
+}
+
+int gsl_sf_exp_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(exp_val, n, x, result);
+}
+
+int gsl_sf_expm1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(expm1_val, n, x, result);
+}
+
+int gsl_sf_exprel_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(exprel_val, n, x, result);
+}
+
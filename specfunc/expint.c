@@ -31,6 +31,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -579,3 +580,101 @@ double gsl_sf_expint_Ei_scaled(const double x)
 {
   EVAL_RESULT(gsl_sf_expint_Ei_scaled_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of expint_E1_impl(). This performs the
+ * same arithmetic, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double expint_E1_val(const double x, const int scale, gsl_mode_t mode)
+{
+  const double xmaxt = -GSL_LOG_DBL_MIN;
+  const double xmax  = xmaxt - log(xmaxt);
+
+  if(x < -xmax && !scale) {
+    return GSL_POSINF;
+  }
+  else if(x <= -10.0) {
+    const double s = 1.0/x * ( scale ? 1.0 : exp(-x) );
+    return s * (1.0 + cheb_eval_mode(&AE11_cs, 20.0/x+1.0, mode));
+  }
+  else if(x <= -4.0) {
+    const double s = 1.0/x * ( scale ? 1.0 : exp(-x) );
+    return s * (1.0 + cheb_eval_mode(&AE12_cs, (40.0/x+7.0)/3.0, mode));
+  }
+  else if(x <= -1.0) {
+    const double ln_term = -log(fabs(x));
+    const double scale_factor = ( scale ? exp(x) : 1.0 );
+    return scale_factor * (ln_term + cheb_eval_mode(&E11_cs, (2.0*x+5.0)/3.0, mode));
+  }
+  else if(x == 0.0) {
+    return GSL_NAN;
+  }
+  else if(x <= 1.0) {
+    const double ln_term = -log(fabs(x));
+    const double scale_factor = ( scale ? exp(x) : 1.0 );
+    return scale_factor * (ln_term - 0.6875 + x + cheb_eval_mode(&E12_cs, x, mode));
+  }
+  else if(x <= 4.0) {
+    const double s = 1.0/x * ( scale ? 1.0 : exp(-x) );
+    return s * (1.0 + cheb_eval_mode(&AE13_cs, (8.0/x-5.0)/3.0, mode));
+  }
+  else if(x <= xmax || scale) {
+    const double s = 1.0/x * ( scale ? 1.0 : exp(-x) );
+    return s * (1.0 + cheb_eval_mode(&AE14_cs, 8.0/x-1.0, mode));
+  }
+  else {
+    return 0.0;
+  }
+}
+
+static double expint_E1_unscaled_val(const double x, gsl_mode_t mode)
+{
+  return expint_E1_val(x, 0, mode);
+}
+
+static double expint_E1_scaled_val(const double x, gsl_mode_t mode)
+{
+  return expint_E1_val(x, 1, mode);
+}
+
+static double expint_Ei_val(const double x, gsl_mode_t mode)
+{
+  return -expint_E1_val(-x, 0, mode);
+}
+
+int gsl_sf_expint_E1_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(expint_E1_unscaled_val, n, x, result);
+}
+
+int gsl_sf_expint_E1_scaled_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(expint_E1_scaled_val, n, x, result);
+}
+
+int gsl_sf_expint_Ei_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(expint_Ei_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_expint_E1_fast(const double x, gsl_mode_t mode)
+{
+  return expint_E1_unscaled_val(x, mode);
+}
+
+double gsl_sf_expint_E1_scaled_fast(const double x, gsl_mode_t mode)
+{
+  return expint_E1_scaled_val(x, mode);
+}
+
+double gsl_sf_expint_Ei_fast(const double x, gsl_mode_t mode)
+{
+  return expint_Ei_val(x, mode);
+}
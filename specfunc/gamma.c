@@ -33,6 +33,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 #define LogRootTwoPi_  0.9189385332046727418
 
@@ -1683,3 +1684,328 @@ double gsl_sf_lnchoose(unsigned int n, unsigned int m)
 {
   EVAL_RESULT(gsl_sf_lnchoose_e(n, m, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * Where the _e functions report a loss of precision the value is
+ * a nan.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double
+lngamma_lanczos_val(double x)
+{
+  int k;
+  double Ag;
+  double term1, term2;
+
+  x -= 1.0; /* Lanczos writes z! instead of Gamma(z) */
+
+  Ag = lanczos_7_c[0];
+  for(k=1; k<=8; k++) { Ag += lanczos_7_c[k]/(x+k); }
+
+  term1 = (x+0.5)*log((x+7.5)/M_E);
+  term2 = LogRootTwoPi_ + log(Ag);
+  return term1 + (term2 - 7.0);
+}
+
+static double
+gammastar_ser_val(const double x)
+{
+  const double y = 1.0/(x*x);
+  const double c0 =  1.0/12.0;
+  const double c1 = -1.0/360.0;
+  const double c2 =  1.0/1260.0;
+  const double c3 = -1.0/1680.0;
+  const double c4 =  1.0/1188.0;
+  const double c5 = -691.0/360360.0;
+  const double c6 =  1.0/156.0;
+  const double c7 = -3617.0/122400.0;
+  const double ser = c0 + y*(c1 + y*(c2 + y*(c3 + y*(c4 + y*(c5 + y*(c6 + y*c7))))));
+  return exp(ser/x);
+}
+
+static double
+gamma_xgthalf_val(const double x, gsl_mode_t mode)
+{
+  if(x == 0.5) {
+    return 1.77245385090551602729817;
+  } else if (x <= (GSL_SF_FACT_NMAX + 1.0) && x == floor(x)) {
+    int n = (int) floor (x);
+    return fact_table[n - 1].f;
+  }    
+  else if(fabs(x - 1.0) < 0.01) {
+    const double eps = x - 1.0;
+    const double c1 =  0.4227843350984671394;
+    const double c2 = -0.01094400467202744461;
+    const double c3 =  0.09252092391911371098;
+    const double c4 = -0.018271913165599812664;
+    const double c5 =  0.018004931096854797895;
+    const double c6 = -0.006850885378723806846;
+    const double c7 =  0.003998239557568466030;
+    return 1.0/x + eps*(c1+eps*(c2+eps*(c3+eps*(c4+eps*(c5+eps*(c6+eps*c7))))));
+  }
+  else if(fabs(x - 2.0) < 0.01) {
+    const double eps = x - 2.0;
+    const double c1 =  0.4227843350984671394;
+    const double c2 =  0.4118403304264396948;
+    const double c3 =  0.08157691924708626638;
+    const double c4 =  0.07424901075351389832;
+    const double c5 = -0.00026698206874501476832;
+    const double c6 =  0.011154045718130991049;
+    const double c7 = -0.002852645821155340816;
+    const double c8 =  0.0021039333406973880085;
+    return 1.0 + eps*(c1+eps*(c2+eps*(c3+eps*(c4+eps*(c5+eps*(c6+eps*(c7+eps*c8)))))));
+  }
+  else if(x < 5.0) {
+    return exp(lngamma_lanczos_val(x));
+  }
+  else if(x < 10.0) {
+    const double gamma_8 = 5040.0;
+    const double t = (2.0*x - 15.0)/5.0;
+    return exp(cheb_eval_mode(&gamma_5_10_cs, t, mode)) * gamma_8;
+  }
+  else if(x < GSL_SF_GAMMA_XMAX) {
+    double p = pow(x, 0.5*x);
+    double e = exp(-x);
+    double q = (p * e) * p;
+    double pre = M_SQRT2 * M_SQRTPI * q/sqrt(x);
+    return pre * gammastar_ser_val(x);
+  }
+  else {
+    return GSL_POSINF;
+  }
+}
+
+static double
+lngamma_val(double x)
+{
+  gsl_sf_result r;
+  double sgn;
+
+  if(fabs(x - 1.0) < 0.01) {
+    lngamma_1_pade(x - 1.0, &r);
+    return r.val;
+  }
+  else if(fabs(x - 2.0) < 0.01) {
+    lngamma_2_pade(x - 2.0, &r);
+    return r.val;
+  }
+  else if(x >= 0.5) {
+    return lngamma_lanczos_val(x);
+  }
+  else if(x == 0.0) {
+    return GSL_NAN;
+  }
+  else if(fabs(x) < 0.02) {
+    lngamma_sgn_0(x, &r, &sgn);
+    return r.val;
+  }
+  else if(x > -0.5/(GSL_DBL_EPSILON*M_PI)) {
+    double z  = 1.0 - x;
+    double s  = sin(M_PI*z);
+    double as = fabs(s);
+    if(s == 0.0) {
+      return GSL_NAN;
+    }
+    else if(as < M_PI*0.015) {
+      if(x < INT_MIN + 2.0) {
+        return GSL_NAN;
+      }
+      else {
+        int N = -(int)(x - 0.5);
+        double eps = x + N;
+        lngamma_sgn_sing(N, eps, &r, &sgn);
+        return r.val;
+      }
+    }
+    else {
+      return M_LNPI - (log(as) + lngamma_lanczos_val(z));
+    }
+  }
+  else {
+    return GSL_NAN;
+  }
+}
+
+/* as gsl_sf_lngamma_sgn_e, with sgn = 0 where that reports an error */
+static double
+lngamma_sgn_val(double x, double * sgn)
+{
+  gsl_sf_result r;
+
+  if(fabs(x - 1.0) < 0.01) {
+    lngamma_1_pade(x - 1.0, &r);
+    *sgn = 1.0;
+    return r.val;
+  }
+  else if(fabs(x - 2.0) < 0.01) {
+    lngamma_2_pade(x - 2.0, &r);
+    *sgn = 1.0;
+    return r.val;
+  }
+  else if(x >= 0.5) {
+    *sgn = 1.0;
+    return lngamma_lanczos_val(x);
+  }
+  else if(x == 0.0) {
+    *sgn = 0.0;
+    return GSL_NAN;
+  }
+  else if(fabs(x) < 0.02) {
+    lngamma_sgn_0(x, &r, sgn);
+    return r.val;
+  }
+  else if(x > -0.5/(GSL_DBL_EPSILON*M_PI)) {
+    double z = 1.0 - x;
+    double s = sin(M_PI*x);
+    double as = fabs(s);
+    if(s == 0.0) {
+      *sgn = 0.0;
+      return GSL_NAN;
+    }
+    else if(as < M_PI*0.015) {
+      if(x < INT_MIN + 2.0) {
+        *sgn = 0.0;
+        return GSL_NAN;
+      }
+      else {
+        int N = -(int)(x - 0.5);
+        double eps = x + N;
+        lngamma_sgn_sing(N, eps, &r, sgn);
+        return r.val;
+      }
+    }
+    else {
+      *sgn = (s > 0.0 ? 1.0 : -1.0);
+      return M_LNPI - (log(as) + lngamma_lanczos_val(z));
+    }
+  }
+  else {
+    *sgn = 0.0;
+    return GSL_NAN;
+  }
+}
+
+static double
+gamma_val(const double x, gsl_mode_t mode)
+{
+  if(x < 0.5) {
+    int rint_x = (int)floor(x+0.5);
+    double f_x = x - rint_x;
+    double sgn_gamma = ( GSL_IS_EVEN(rint_x) ? 1.0 : -1.0 );
+    double sin_term = sgn_gamma * sin(M_PI * f_x) / M_PI;
+
+    if(sin_term == 0.0) {
+      return GSL_NAN;
+    }
+    else if(x > -169.0) {
+      const double g = gamma_xgthalf_val(1.0-x, mode);
+      if(fabs(sin_term) * g * GSL_DBL_MIN < 1.0) {
+        return 1.0/(sin_term * g);
+      }
+      else {
+        return 0.0;
+      }
+    }
+    else {
+      double sgn;
+      const double lng = lngamma_sgn_val(x, &sgn);
+      return (sgn == 0.0) ? GSL_NAN : exp_mult_val(lng, sgn);
+    }
+  }
+  else {
+    return gamma_xgthalf_val(x, mode);
+  }
+}
+
+static double
+gammastar_val(const double x, gsl_mode_t mode)
+{
+  if(x <= 0.0) {
+    return GSL_NAN;
+  }
+  else if(x < 0.5) {
+    const double lg = lngamma_val(x);
+    const double lx = log(x);
+    const double c  = 0.5*(M_LN2+M_LNPI);
+    const double lnr_val = lg - (x-0.5)*lx + x - c;
+    return exp(lnr_val);
+  }
+  else if(x < 2.0) {
+    const double t = 4.0/3.0*(x-0.5) - 1.0;
+    return cheb_eval_mode(&gstar_a_cs, t, mode);
+  }
+  else if(x < 10.0) {
+    const double t = 0.25*(x-2.0) - 1.0;
+    const double c = cheb_eval_mode(&gstar_b_cs, t, mode);
+    return c/(x*x) + 1.0 + 1.0/(12.0*x);
+  }
+  else if(x < 1.0/GSL_ROOT4_DBL_EPSILON) {
+    return gammastar_ser_val(x);
+  }
+  else if(x < 1.0/GSL_DBL_EPSILON) {
+    const double xi = 1.0/x;
+    return 1.0 + xi/12.0*(1.0 + xi/24.0*(1.0 - xi*(139.0/180.0 + 571.0/8640.0*xi)));
+  }
+  else {
+    return 1.0;
+  }
+}
+
+static double
+gammainv_val(const double x, gsl_mode_t mode)
+{
+  if (x <= 0.0 && x == floor(x)) {
+    return 0.0;
+  } else if(x < 0.5) {
+    double sgn;
+    const double lng = lngamma_sgn_val(x, &sgn);
+    return (sgn == 0.0) ? 0.0 : exp_mult_val(-lng, sgn);
+  }
+  else {
+    const double g = gamma_xgthalf_val(x, mode);
+    return (g == GSL_POSINF) ? 0.0 : 1.0/g;
+  }
+}
+
+int gsl_sf_lngamma_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(lngamma_val, n, x, result);
+}
+
+int gsl_sf_gamma_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(gamma_val, n, x, result);
+}
+
+int gsl_sf_gammastar_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(gammastar_val, n, x, result);
+}
+
+int gsl_sf_gammainv_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(gammainv_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_gamma_fast(const double x, gsl_mode_t mode)
+{
+  return gamma_val(x, mode);
+}
+
+double gsl_sf_gammastar_fast(const double x, gsl_mode_t mode)
+{
+  return gammastar_val(x, mode);
+}
+
+double gsl_sf_gammainv_fast(const double x, gsl_mode_t mode)
+{
+  return gammainv_val(x, mode);
+}
@@ -46,6 +46,8 @@ __BEGIN_DECLS
  */
 int gsl_sf_bessel_J0_e(const double x,  gsl_sf_result * result);
 double gsl_sf_bessel_J0(const double x);
+int    gsl_sf_bessel_J0_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_J0_fast(const double x, gsl_mode_t mode);
 
 
 /* Regular Bessel Function J_1(x)
@@ -54,6 +56,8 @@ double gsl_sf_bessel_J0(const double x);
  */
 int gsl_sf_bessel_J1_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_J1(const double x);
+int    gsl_sf_bessel_J1_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_J1_fast(const double x, gsl_mode_t mode);
 
 
 /* Regular Bessel Function J_n(x)
@@ -78,6 +82,8 @@ int gsl_sf_bessel_Jn_array(int nmin, int nmax, double x, double * result_array);
  */
 int gsl_sf_bessel_Y0_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_Y0(const double x);
+int    gsl_sf_bessel_Y0_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_Y0_fast(const double x, gsl_mode_t mode);
 
 
 /* Irregular Bessel function Y_1(x)
@@ -87,6 +93,8 @@ double gsl_sf_bessel_Y0(const double x);
  */
 int gsl_sf_bessel_Y1_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_Y1(const double x);
+int    gsl_sf_bessel_Y1_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_Y1_fast(const double x, gsl_mode_t mode);
 
 
 /* Irregular Bessel function Y_n(x)
@@ -112,6 +120,8 @@ int gsl_sf_bessel_Yn_array(const int nmin, const int nmax, const double x, doubl
  */
 int gsl_sf_bessel_I0_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_I0(const double x);
+int    gsl_sf_bessel_I0_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_I0_fast(const double x, gsl_mode_t mode);
 
 
 /* Regular modified Bessel function I_1(x)
@@ -120,6 +130,8 @@ double gsl_sf_bessel_I0(const double x);
  */
 int gsl_sf_bessel_I1_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_I1(const double x);
+int    gsl_sf_bessel_I1_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_I1_fast(const double x, gsl_mode_t mode);
 
 
 /* Regular modified Bessel function I_n(x)
@@ -145,6 +157,8 @@ int gsl_sf_bessel_In_array(const int nmin, const int nmax, const double x, doubl
  */
 int gsl_sf_bessel_I0_scaled_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_I0_scaled(const double x);
+int    gsl_sf_bessel_I0_scaled_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_I0_scaled_fast(const double x, gsl_mode_t mode);
 
 
 /* Scaled regular modified Bessel function
@@ -154,6 +168,8 @@ double gsl_sf_bessel_I0_scaled(const double x);
  */
 int gsl_sf_bessel_I1_scaled_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_I1_scaled(const double x);
+int    gsl_sf_bessel_I1_scaled_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_I1_scaled_fast(const double x, gsl_mode_t mode);
 
 
 /* Scaled regular modified Bessel function
@@ -181,6 +197,8 @@ int gsl_sf_bessel_In_scaled_array(const int nmin, const int nmax, const double x
  */
 int gsl_sf_bessel_K0_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_K0(const double x);
+int    gsl_sf_bessel_K0_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_K0_fast(const double x, gsl_mode_t mode);
 
 
 /* Irregular modified Bessel function K_1(x)
@@ -190,6 +208,8 @@ double gsl_sf_bessel_K0(const double x);
  */
 int gsl_sf_bessel_K1_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_K1(const double x);
+int    gsl_sf_bessel_K1_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_K1_fast(const double x, gsl_mode_t mode);
 
 
 /* Irregular modified Bessel function K_n(x)
@@ -217,6 +237,8 @@ int gsl_sf_bessel_Kn_array(const int nmin, const int nmax, const double x, doubl
  */
 int gsl_sf_bessel_K0_scaled_e(const double x, gsl_sf_result * result);
 double gsl_sf_bessel_K0_scaled(const double x);
+int    gsl_sf_bessel_K0_scaled_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_K0_scaled_fast(const double x, gsl_mode_t mode);
 
 
 /* Scaled irregular modified Bessel function
@@ -227,6 +249,8 @@ double gsl_sf_bessel_K0_scaled(const double x);
  */
 int gsl_sf_bessel_K1_scaled_e(const double x, gsl_sf_result * result); 
 double gsl_sf_bessel_K1_scaled(const double x);
+int    gsl_sf_bessel_K1_scaled_array(const size_t n, const double x[], double result[]);
+double gsl_sf_bessel_K1_scaled_fast(const double x, gsl_mode_t mode);
 
 
 /* Scaled irregular modified Bessel function
@@ -22,6 +22,8 @@
 #ifndef __GSL_SF_DAWSON_H__
 #define __GSL_SF_DAWSON_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -45,6 +47,8 @@ __BEGIN_DECLS
  */
 int     gsl_sf_dawson_e(double x, gsl_sf_result * result);
 double     gsl_sf_dawson(double x);
+int        gsl_sf_dawson_array(const size_t n, const double x[], double result[]);
+double     gsl_sf_dawson_fast(const double x, gsl_mode_t mode);
 
 
 __END_DECLS
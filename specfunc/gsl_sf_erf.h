@@ -22,6 +22,8 @@
 #ifndef __GSL_SF_ERF_H__
 #define __GSL_SF_ERF_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -44,6 +46,8 @@ __BEGIN_DECLS
  */
 int gsl_sf_erfc_e(double x, gsl_sf_result * result);
 double gsl_sf_erfc(double x);
+int    gsl_sf_erfc_array(const size_t n, const double x[], double result[]);
+double gsl_sf_erfc_fast(const double x, gsl_mode_t mode);
 
 
 /* Log Complementary Error Function
@@ -52,6 +56,8 @@ double gsl_sf_erfc(double x);
  */
 int gsl_sf_log_erfc_e(double x, gsl_sf_result * result);
 double gsl_sf_log_erfc(double x);
+int    gsl_sf_log_erfc_array(const size_t n, const double x[], double result[]);
+double gsl_sf_log_erfc_fast(const double x, gsl_mode_t mode);
 
 
 /* Error Function
@@ -61,6 +67,8 @@ double gsl_sf_log_erfc(double x);
  */
 int gsl_sf_erf_e(double x, gsl_sf_result * result);
 double gsl_sf_erf(double x);
+int    gsl_sf_erf_array(const size_t n, const double x[], double result[]);
+double gsl_sf_erf_fast(const double x, gsl_mode_t mode);
 
 
 /* Probability functions:
@@ -72,7 +80,10 @@ double gsl_sf_erf(double x);
 int gsl_sf_erf_Z_e(double x, gsl_sf_result * result);
 int gsl_sf_erf_Q_e(double x, gsl_sf_result * result);
 double gsl_sf_erf_Z(double x);
+int    gsl_sf_erf_Z_array(const size_t n, const double x[], double result[]);
 double gsl_sf_erf_Q(double x);
+int    gsl_sf_erf_Q_array(const size_t n, const double x[], double result[]);
+double gsl_sf_erf_Q_fast(const double x, gsl_mode_t mode);
 
 
 /* Hazard function, also known as the inverse Mill's ratio.
@@ -84,6 +95,8 @@ double gsl_sf_erf_Q(double x);
  */
 int gsl_sf_hazard_e(double x, gsl_sf_result * result);
 double gsl_sf_hazard(double x);
+int    gsl_sf_hazard_array(const size_t n, const double x[], double result[]);
+double gsl_sf_hazard_fast(const double x, gsl_mode_t mode);
 
 
 __END_DECLS
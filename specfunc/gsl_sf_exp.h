@@ -22,6 +22,7 @@
 #ifndef __GSL_SF_EXP_H__
 #define __GSL_SF_EXP_H__
 
+#include <stdlib.h>
 #include <gsl/gsl_sf_result.h>
 #include <gsl/gsl_precision.h>
 
@@ -44,6 +45,7 @@ __BEGIN_DECLS
  */
 int gsl_sf_exp_e(const double x, gsl_sf_result * result);
 double gsl_sf_exp(const double x);
+int    gsl_sf_exp_array(const size_t n, const double x[], double result[]);
 
 
 /* Exp(x)
@@ -74,6 +76,7 @@ int gsl_sf_exp_mult_e10_e(const double x, const double y, gsl_sf_result_e10 * re
  */
 int gsl_sf_expm1_e(const double x, gsl_sf_result * result);
 double gsl_sf_expm1(const double x);
+int    gsl_sf_expm1_array(const size_t n, const double x[], double result[]);
 
 
 /* (exp(x)-1)/x = 1 + x/2 + x^2/(2*3) + x^3/(2*3*4) + ...
@@ -82,6 +85,7 @@ double gsl_sf_expm1(const double x);
  */
 int gsl_sf_exprel_e(const double x, gsl_sf_result * result);
 double gsl_sf_exprel(const double x);
+int    gsl_sf_exprel_array(const size_t n, const double x[], double result[]);
 
 
 /* 2(exp(x)-1-x)/x^2 = 1 + x/3 + x^2/(3*4) + x^3/(3*4*5) + ...
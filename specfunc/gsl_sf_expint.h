@@ -23,6 +23,8 @@
 #ifndef __GSL_SF_EXPINT_H__
 #define __GSL_SF_EXPINT_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -45,6 +47,8 @@ __BEGIN_DECLS
  */
 int     gsl_sf_expint_E1_e(const double x, gsl_sf_result * result);
 double  gsl_sf_expint_E1(const double x);
+int     gsl_sf_expint_E1_array(const size_t n, const double x[], double result[]);
+double  gsl_sf_expint_E1_fast(const double x, gsl_mode_t mode);
 
 
 /* E_2(x) := Re[ Integrate[ Exp[-xt]/t^2, {t,1,Infinity}] ]
@@ -72,6 +76,8 @@ double  gsl_sf_expint_En(const int n, const double x);
  */
 int     gsl_sf_expint_E1_scaled_e(const double x, gsl_sf_result * result);
 double  gsl_sf_expint_E1_scaled(const double x);
+int     gsl_sf_expint_E1_scaled_array(const size_t n, const double x[], double result[]);
+double  gsl_sf_expint_E1_scaled_fast(const double x, gsl_mode_t mode);
 
 
 /* E_2_scaled(x) := exp(x) E_2(x)
@@ -99,6 +105,8 @@ double  gsl_sf_expint_En_scaled(const int n, const double x);
  */
 int     gsl_sf_expint_Ei_e(const double x, gsl_sf_result * result);
 double  gsl_sf_expint_Ei(const double x);
+int     gsl_sf_expint_Ei_array(const size_t n, const double x[], double result[]);
+double  gsl_sf_expint_Ei_fast(const double x, gsl_mode_t mode);
 
 
 /* Ei_scaled(x) := exp(-x) Ei(x)
@@ -22,6 +22,8 @@
 #ifndef __GSL_SF_GAMMA_H__
 #define __GSL_SF_GAMMA_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -46,6 +48,7 @@ __BEGIN_DECLS
  */
 int gsl_sf_lngamma_e(double x, gsl_sf_result * result);
 double gsl_sf_lngamma(const double x);
+int    gsl_sf_lngamma_array(const size_t n, const double x[], double result[]);
 
 
 /* Log[Gamma(x)], x not a negative integer
@@ -65,6 +68,8 @@ int gsl_sf_lngamma_sgn_e(double x, gsl_sf_result * result_lg, double *sgn);
  */
 int gsl_sf_gamma_e(const double x, gsl_sf_result * result);
 double gsl_sf_gamma(const double x);
+int    gsl_sf_gamma_array(const size_t n, const double x[], double result[]);
+double gsl_sf_gamma_fast(const double x, gsl_mode_t mode);
 
 
 /* Regulated Gamma Function, x > 0
@@ -76,6 +81,8 @@ double gsl_sf_gamma(const double x);
  */
 int gsl_sf_gammastar_e(const double x, gsl_sf_result * result);
 double gsl_sf_gammastar(const double x);
+int    gsl_sf_gammastar_array(const size_t n, const double x[], double result[]);
+double gsl_sf_gammastar_fast(const double x, gsl_mode_t mode);
 
 
 /* 1/Gamma(x)
@@ -85,6 +92,8 @@ double gsl_sf_gammastar(const double x);
  */
 int gsl_sf_gammainv_e(const double x, gsl_sf_result * result);
 double gsl_sf_gammainv(const double x);
+int    gsl_sf_gammainv_array(const size_t n, const double x[], double result[]);
+double gsl_sf_gammainv_fast(const double x, gsl_mode_t mode);
 
 
 /* Log[Gamma(z)] for z complex, z not a negative integer
@@ -0,0 +1,76 @@
+/* specfunc/gsl_sf_legendre_sht.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_SF_LEGENDRE_SHT_H__
+#define __GSL_SF_LEGENDRE_SHT_H__
+
+#include <stdlib.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* spherical harmonic transform on a Gauss-Legendre grid */
+
+typedef struct
+{
+  size_t lmax;      /* maximum degree */
+  size_t nlat;      /* number of latitude rings */
+  size_t nlon;      /* number of points on each ring */
+  double *x;        /* cos(theta) of the rings, decreasing, nlat */
+  double *w;        /* Gauss-Legendre weights of the rings, nlat */
+  double *u;        /* sin(theta) of the rings, nlat */
+  double *a;        /* recurrence coefficients a_{lm}, nlm */
+  double *b;        /* recurrence coefficients b_{lm}, nlm */
+  double *ring;     /* Fourier coefficients of the rings, nlat-by-nlon */
+  double *pmm;      /* scaled P_{mm} for the northern rings */
+  int *kmm;         /* scale exponents of pmm */
+  double *p0;       /* recurrence state P_{l-1,m} */
+  double *p1;       /* recurrence state P_{lm} */
+  double *q0;       /* saved state P_{l0-1,m} */
+  double *q1;       /* saved state P_{l0,m} */
+  size_t *l0;       /* first degree above the underflow threshold */
+  size_t *head;     /* rings which become active at degree l, lmax + 2 */
+  size_t *next;     /* linked list of rings with the same l0 */
+  double *acc;      /* ring sums, 4 * nlat */
+  gsl_fft_real_wavetable *rtable;
+  gsl_fft_halfcomplex_wavetable *htable;
+  gsl_fft_real_workspace *fft_work;
+} gsl_sf_legendre_sht_workspace;
+
+gsl_sf_legendre_sht_workspace *
+gsl_sf_legendre_sht_alloc(const size_t lmax, const size_t nlat,
+                          const size_t nlon);
+void gsl_sf_legendre_sht_free(gsl_sf_legendre_sht_workspace * w);
+int gsl_sf_legendre_sht_synthesis(const double alm[], double f[],
+                                  gsl_sf_legendre_sht_workspace * w);
+int gsl_sf_legendre_sht_analysis(const double f[], double alm[],
+                                 gsl_sf_legendre_sht_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_SF_LEGENDRE_SHT_H__ */
@@ -22,6 +22,8 @@
 #ifndef __GSL_SF_LOG_H__
 #define __GSL_SF_LOG_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -43,6 +45,7 @@ __BEGIN_DECLS
  */
 int gsl_sf_log_e(const double x, gsl_sf_result * result);
 double gsl_sf_log(const double x);
+int    gsl_sf_log_array(const size_t n, const double x[], double result[]);
 
 
 /* Log(|x|)
@@ -68,6 +71,8 @@ int gsl_sf_complex_log_e(const double zr, const double zi, gsl_sf_result * lnr,
  */
 int gsl_sf_log_1plusx_e(const double x, gsl_sf_result * result);
 double gsl_sf_log_1plusx(const double x);
+int    gsl_sf_log_1plusx_array(const size_t n, const double x[], double result[]);
+double gsl_sf_log_1plusx_fast(const double x, gsl_mode_t mode);
 
 
 /* Log(1 + x) - x
@@ -76,6 +81,8 @@ double gsl_sf_log_1plusx(const double x);
  */
 int gsl_sf_log_1plusx_mx_e(const double x, gsl_sf_result * result);
 double gsl_sf_log_1plusx_mx(const double x);
+int    gsl_sf_log_1plusx_mx_array(const size_t n, const double x[], double result[]);
+double gsl_sf_log_1plusx_mx_fast(const double x, gsl_mode_t mode);
 
 __END_DECLS
 
@@ -22,6 +22,8 @@
 #ifndef __GSL_SF_PSI_H__
 #define __GSL_SF_PSI_H__
 
+#include <stdlib.h>
+#include <gsl/gsl_mode.h>
 #include <gsl/gsl_sf_result.h>
 
 #undef __BEGIN_DECLS
@@ -59,6 +61,8 @@ double  gsl_sf_psi_int(const int n);
  */
 int     gsl_sf_psi_e(const double x, gsl_sf_result * result);
 double  gsl_sf_psi(const double x);
+int     gsl_sf_psi_array(const size_t n, const double x[], double result[]);
+double  gsl_sf_psi_fast(const double x, gsl_mode_t mode);
 
 
 /* Di-Gamma Function Re[psi(1 + I y)]
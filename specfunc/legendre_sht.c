@@ -0,0 +1,710 @@
+/* specfunc/legendre_sht.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_sf_legendre.h>
+#include <gsl/gsl_sf_legendre_sht.h>
+
+/*
+ * This module computes spherical harmonic transforms of real functions
+ * sampled on a grid of nlat Gauss-Legendre latitude rings, each with
+ * nlon equally spaced points phi_k = 2 pi k / nlon,
+ *
+ * f(theta,phi) = sum_{l=0}^{lmax} [ a_{l0} Y_{l0} + 2 Re sum_{m=1}^l a_{lm} Y_{lm} ]
+ *
+ * with Y_{lm} = P_{lm}(cos(theta)) exp(i m phi) and P_{lm} normalized as
+ * for GSL_SF_LEGENDRE_SPHARM, without the Condon-Shortley phase. The
+ * coefficients a_{lm}, m >= 0, are stored as a packed complex array
+ * indexed by gsl_sf_legendre_array_index(l,m).
+ *
+ * The transform in longitude is a real FFT on each ring. In latitude,
+ * for each order m, the recurrence
+ *
+ * P_{lm} = a_{lm} (x P_{l-1,m} - b_{lm} P_{l-2,m})
+ *
+ * is run with precomputed coefficients over all rings of the northern
+ * hemisphere at once; the southern rings follow from the symmetry
+ * P_{lm}(-x) = (-1)^{l+m} P_{lm}(x). Near the poles P_{mm} = c_m u^m
+ * underflows for large m, so it is carried with a scale exponent and
+ * the recurrence for a ring enters the sums only from the degree at
+ * which its values become representable.
+ */
+
+/* scale factor for values of P_{lm} below the underflow threshold */
+#define SHT_SCALE_EXP 600
+
+static void sht_gauss(gsl_sf_legendre_sht_workspace * w);
+static int sht_start(const size_t m, gsl_sf_legendre_sht_workspace * w);
+static void sht_activate(const size_t l, size_t * jlo,
+                         gsl_sf_legendre_sht_workspace * w);
+
+/*
+gsl_sf_legendre_sht_alloc()
+  Allocate a workspace for spherical harmonic transforms
+
+Inputs: lmax - maximum degree
+        nlat - number of latitude rings, >= lmax + 1
+        nlon - number of points on each ring, >= 2*lmax + 1
+
+Notes: the nodes and weights of the Gauss-Legendre rings and the
+recurrence coefficients are computed here
+*/
+
+gsl_sf_legendre_sht_workspace *
+gsl_sf_legendre_sht_alloc(const size_t lmax, const size_t nlat,
+                          const size_t nlon)
+{
+  gsl_sf_legendre_sht_workspace *w;
+  const size_t nlm = gsl_sf_legendre_nlm(lmax);
+  size_t l, m;
+
+  if (nlat < lmax + 1)
+    {
+      GSL_ERROR_NULL("nlat must be at least lmax + 1", GSL_EINVAL);
+    }
+  else if (nlon < 2 * lmax + 1)
+    {
+      GSL_ERROR_NULL("nlon must be at least 2*lmax + 1", GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_sf_legendre_sht_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->lmax = lmax;
+  w->nlat = nlat;
+  w->nlon = nlon;
+
+  w->x = malloc(nlat * sizeof(double));
+  w->w = malloc(nlat * sizeof(double));
+  w->u = malloc(nlat * sizeof(double));
+  w->a = malloc(nlm * sizeof(double));
+  w->b = malloc(nlm * sizeof(double));
+  w->ring = malloc(nlat * nlon * sizeof(double));
+  w->pmm = malloc(nlat * sizeof(double));
+  w->kmm = malloc(nlat * sizeof(int));
+  w->p0 = malloc(nlat * sizeof(double));
+  w->p1 = malloc(nlat * sizeof(double));
+  w->q0 = malloc(nlat * sizeof(double));
+  w->q1 = malloc(nlat * sizeof(double));
+  w->l0 = malloc(nlat * sizeof(size_t));
+  w->head = malloc((lmax + 2) * sizeof(size_t));
+  w->next = malloc(nlat * sizeof(size_t));
+  w->acc = malloc(4 * nlat * sizeof(double));
+
+  if (w->x == 0 || w->w == 0 || w->u == 0 || w->a == 0 || w->b == 0 ||
+      w->ring == 0 || w->pmm == 0 || w->kmm == 0 || w->p0 == 0 ||
+      w->p1 == 0 || w->q0 == 0 || w->q1 == 0 || w->l0 == 0 ||
+      w->head == 0 || w->next == 0 || w->acc == 0)
+    {
+      gsl_sf_legendre_sht_free(w);
+      GSL_ERROR_NULL("failed to allocate space for arrays", GSL_ENOMEM);
+    }
+
+  w->rtable = gsl_fft_real_wavetable_alloc(nlon);
+  w->htable = gsl_fft_halfcomplex_wavetable_alloc(nlon);
+  w->fft_work = gsl_fft_real_workspace_alloc(nlon);
+  if (w->rtable == 0 || w->htable == 0 || w->fft_work == 0)
+    {
+      gsl_sf_legendre_sht_free(w);
+      GSL_ERROR_NULL("failed to allocate space for FFT", GSL_ENOMEM);
+    }
+
+  sht_gauss(w);
+
+  /* recurrence coefficients, P_{m+1,m} = a_{m+1,m} x P_{mm} */
+  for (m = 0; m <= lmax; ++m)
+    {
+      for (l = m + 1; l <= lmax; ++l)
+        {
+          const double dl = (double) l;
+          const double dm = (double) m;
+          const size_t idx = gsl_sf_legendre_array_index(l, m);
+
+          w->a[idx] = sqrt((4.0 * dl * dl - 1.0) / (dl * dl - dm * dm));
+          w->b[idx] = sqrt(((dl - 1.0) * (dl - 1.0) - dm * dm) /
+                           (4.0 * (dl - 1.0) * (dl - 1.0) - 1.0));
+        }
+    }
+
+  return w;
+}
+
+void
+gsl_sf_legendre_sht_free(gsl_sf_legendre_sht_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->x)
+    free(w->x);
+
+  if (w->w)
+    free(w->w);
+
+  if (w->u)
+    free(w->u);
+
+  if (w->a)
+    free(w->a);
+
+  if (w->b)
+    free(w->b);
+
+  if (w->ring)
+    free(w->ring);
+
+  if (w->pmm)
+    free(w->pmm);
+
+  if (w->kmm)
+    free(w->kmm);
+
+  if (w->p0)
+    free(w->p0);
+
+  if (w->p1)
+    free(w->p1);
+
+  if (w->q0)
+    free(w->q0);
+
+  if (w->q1)
+    free(w->q1);
+
+  if (w->l0)
+    free(w->l0);
+
+  if (w->head)
+    free(w->head);
+
+  if (w->next)
+    free(w->next);
+
+  if (w->acc)
+    free(w->acc);
+
+  if (w->rtable)
+    gsl_fft_real_wavetable_free(w->rtable);
+
+  if (w->htable)
+    gsl_fft_halfcomplex_wavetable_free(w->htable);
+
+  if (w->fft_work)
+    gsl_fft_real_workspace_free(w->fft_work);
+
+  free(w);
+}
+
+/*
+gsl_sf_legendre_sht_synthesis()
+  Evaluate a spherical harmonic expansion on the grid
+
+Inputs: alm - packed complex coefficients a_{lm}, length
+              2 * gsl_sf_legendre_nlm(lmax); the imaginary
+              parts of a_{l0} are ignored
+        f   - (output) function values, nlat-by-nlon, f[j*nlon + k]
+              at theta_j = acos(w->x[j]), phi_k = 2 pi k / nlon
+        w   - workspace
+*/
+
+int
+gsl_sf_legendre_sht_synthesis(const double alm[], double f[],
+                              gsl_sf_legendre_sht_workspace * w)
+{
+  const size_t lmax = w->lmax;
+  const size_t nlat = w->nlat;
+  const size_t nlon = w->nlon;
+  const size_t nh = (nlat + 1) / 2;
+  const double *x = w->x;
+  double *p0 = w->p0;
+  double *p1 = w->p1;
+  size_t j, l, m;
+
+  memset(f, 0, nlat * nlon * sizeof(double));
+
+  for (m = 0; m <= lmax; ++m)
+    {
+      size_t jlo = nh;
+
+      sht_start(m, w);
+
+      /* even (l+m) sums in acc[0..2nlat), odd in acc[2nlat..4nlat) */
+      memset(w->acc, 0, 4 * nlat * sizeof(double));
+
+      l = m;
+      while (l <= lmax)
+        {
+          const size_t idx = gsl_sf_legendre_array_index(l, m);
+          const double cr = alm[2 * idx];
+          const double ci = (m > 0) ? alm[2 * idx + 1] : 0.0;
+          double *sr = w->acc + 2 * ((l + m) & 1) * nlat;
+          double *si = sr + nlat;
+          double A = 0.0, B = 0.0;
+
+          sht_activate(l, &jlo, w);
+
+          if (l < lmax)
+            {
+              A = w->a[idx + l + 1];
+              B = w->b[idx + l + 1];
+            }
+
+          if (l < lmax && w->head[l + 1] == nh)
+            {
+              /* no rings start at l+1: take two degrees per sweep */
+              const size_t idx1 = idx + l + 1;
+              const double cr1 = alm[2 * idx1];
+              const double ci1 = (m > 0) ? alm[2 * idx1 + 1] : 0.0;
+              double *tr = w->acc + 2 * ((l + m + 1) & 1) * nlat;
+              double *ti = tr + nlat;
+              double A1 = 0.0, B1 = 0.0;
+
+              if (l + 1 < lmax)
+                {
+                  A1 = w->a[idx1 + l + 2];
+                  B1 = w->b[idx1 + l + 2];
+                }
+
+              for (j = jlo; j < nh; ++j)
+                {
+                  const double p = p1[j];
+                  const double q = A * (x[j] * p - B * p0[j]);
+
+                  sr[j] += p * cr;
+                  si[j] += p * ci;
+                  tr[j] += q * cr1;
+                  ti[j] += q * ci1;
+                  p1[j] = A1 * (x[j] * q - B1 * p);
+                  p0[j] = q;
+                }
+
+              l += 2;
+            }
+          else
+            {
+              for (j = jlo; j < nh; ++j)
+                {
+                  const double p = p1[j];
+
+                  sr[j] += p * cr;
+                  si[j] += p * ci;
+                  p1[j] = A * (x[j] * p - B * p0[j]);
+                  p0[j] = p;
+                }
+
+              ++l;
+            }
+        }
+
+      /* combine the symmetric and antisymmetric parts into the
+       * halfcomplex Fourier coefficients of each ring */
+      for (j = 0; j < nh; ++j)
+        {
+          const size_t jp = nlat - 1 - j;
+          const double er = w->acc[j], ei = w->acc[nlat + j];
+          const double dr = w->acc[2 * nlat + j], di = w->acc[3 * nlat + j];
+
+          if (m == 0)
+            {
+              f[j * nlon] = er + dr;
+              if (jp != j)
+                f[jp * nlon] = er - dr;
+            }
+          else
+            {
+              f[j * nlon + 2 * m - 1] = er + dr;
+              f[j * nlon + 2 * m] = ei + di;
+              if (jp != j)
+                {
+                  f[jp * nlon + 2 * m - 1] = er - dr;
+                  f[jp * nlon + 2 * m] = ei - di;
+                }
+            }
+        }
+    }
+
+  for (j = 0; j < nlat; ++j)
+    {
+      gsl_fft_halfcomplex_transform(f + j * nlon, 1, nlon, w->htable,
+                                    w->fft_work);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_sf_legendre_sht_analysis()
+  Compute the spherical harmonic coefficients of a function sampled
+on the grid
+
+Inputs: f   - function values, nlat-by-nlon, as for synthesis
+        alm - (output) packed complex coefficients a_{lm}
+        w   - workspace
+
+Notes: the result is exact, up to rounding, for functions with
+degree at most lmax
+*/
+
+int
+gsl_sf_legendre_sht_analysis(const double f[], double alm[],
+                             gsl_sf_legendre_sht_workspace * w)
+{
+  const size_t lmax = w->lmax;
+  const size_t nlat = w->nlat;
+  const size_t nlon = w->nlon;
+  const size_t nh = (nlat + 1) / 2;
+  const double *x = w->x;
+  const double dphi = 2.0 * M_PI / (double) nlon;
+  double *ring = w->ring;
+  double *p0 = w->p0;
+  double *p1 = w->p1;
+  size_t j, l, m;
+
+  memcpy(ring, f, nlat * nlon * sizeof(double));
+
+  for (j = 0; j < nlat; ++j)
+    {
+      gsl_fft_real_transform(ring + j * nlon, 1, nlon, w->rtable,
+                             w->fft_work);
+    }
+
+  for (m = 0; m <= lmax; ++m)
+    {
+      size_t jlo = nh;
+
+      sht_start(m, w);
+
+      /* weighted ring coefficients G(x) + G(-x) in acc[0..2nlat),
+       * G(x) - G(-x) in acc[2nlat..4nlat) */
+      for (j = 0; j < nh; ++j)
+        {
+          const size_t jp = nlat - 1 - j;
+          const double wj = w->w[j] * dphi;
+          double gr, gi, hr, hi;
+
+          if (m == 0)
+            {
+              gr = ring[j * nlon];
+              gi = 0.0;
+              hr = ring[jp * nlon];
+              hi = 0.0;
+            }
+          else
+            {
+              gr = ring[j * nlon + 2 * m - 1];
+              gi = ring[j * nlon + 2 * m];
+              hr = ring[jp * nlon + 2 * m - 1];
+              hi = ring[jp * nlon + 2 * m];
+            }
+
+          if (jp == j)
+            {
+              w->acc[j] = wj * gr;
+              w->acc[nlat + j] = wj * gi;
+              w->acc[2 * nlat + j] = 0.0;
+              w->acc[3 * nlat + j] = 0.0;
+            }
+          else
+            {
+              w->acc[j] = wj * (gr + hr);
+              w->acc[nlat + j] = wj * (gi + hi);
+              w->acc[2 * nlat + j] = wj * (gr - hr);
+              w->acc[3 * nlat + j] = wj * (gi - hi);
+            }
+        }
+
+      l = m;
+      while (l <= lmax)
+        {
+          const size_t idx = gsl_sf_legendre_array_index(l, m);
+          const double *gr = w->acc + 2 * ((l + m) & 1) * nlat;
+          const double *gi = gr + nlat;
+          double sr = 0.0, si = 0.0;
+          double A = 0.0, B = 0.0;
+
+          sht_activate(l, &jlo, w);
+
+          if (l < lmax)
+            {
+              A = w->a[idx + l + 1];
+              B = w->b[idx + l + 1];
+            }
+
+          if (l < lmax && w->head[l + 1] == nh)
+            {
+              /* no rings start at l+1: take two degrees per sweep */
+              const size_t idx1 = idx + l + 1;
+              const double *hr = w->acc + 2 * ((l + m + 1) & 1) * nlat;
+              const double *hi = hr + nlat;
+              double tr = 0.0, ti = 0.0;
+              double A1 = 0.0, B1 = 0.0;
+
+              if (l + 1 < lmax)
+                {
+                  A1 = w->a[idx1 + l + 2];
+                  B1 = w->b[idx1 + l + 2];
+                }
+
+              for (j = jlo; j < nh; ++j)
+                {
+                  const double p = p1[j];
+                  const double q = A * (x[j] * p - B * p0[j]);
+
+                  sr += p * gr[j];
+                  si += p * gi[j];
+                  tr += q * hr[j];
+                  ti += q * hi[j];
+                  p1[j] = A1 * (x[j] * q - B1 * p);
+                  p0[j] = q;
+                }
+
+              alm[2 * idx] = sr;
+              alm[2 * idx + 1] = si;
+              alm[2 * idx1] = tr;
+              alm[2 * idx1 + 1] = ti;
+              l += 2;
+            }
+          else
+            {
+              for (j = jlo; j < nh; ++j)
+                {
+                  const double p = p1[j];
+
+                  sr += p * gr[j];
+                  si += p * gi[j];
+                  p1[j] = A * (x[j] * p - B * p0[j]);
+                  p0[j] = p;
+                }
+
+              alm[2 * idx] = sr;
+              alm[2 * idx + 1] = si;
+              ++l;
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*********************************************************
+ *                 INTERNAL ROUTINES                     *
+ *********************************************************/
+
+/*
+sht_gauss()
+  Compute the Gauss-Legendre rings, ordered from the north pole
+
+Notes: the nodes are found by Newton iteration in theta, so that
+both x = cos(theta) and u = sin(theta) are accurate to rounding
+near the poles, and the weights are evaluated at the converged
+nodes
+*/
+
+static void
+sht_gauss(gsl_sf_legendre_sht_workspace * w)
+{
+  const size_t n = w->nlat;
+  const double dn = (double) n;
+  size_t i, k, iter;
+
+  for (i = 0; i < (n + 1) / 2; ++i)
+    {
+      double theta = M_PI * (i + 0.75) / (dn + 0.5);
+      double x, u, pn = 0.0, pn1 = 0.0;
+
+      if (2 * i + 1 == n)
+        theta = M_PI_2;
+
+      for (iter = 0; iter < 10; ++iter)
+        {
+          double p0 = 1.0, p1, dtheta;
+
+          x = cos(theta);
+          u = sin(theta);
+
+          /* P_n(x) and P_{n-1}(x) */
+          p1 = x;
+          for (k = 2; k <= n; ++k)
+            {
+              const double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+              p0 = p1;
+              p1 = p2;
+            }
+
+          pn = p1;
+          pn1 = p0;
+
+          if (2 * i + 1 == n)
+            break;
+
+          /* d/dtheta P_n(cos(theta)) = n (x P_n - P_{n-1}) / u */
+          dtheta = pn * u / (dn * (x * pn - pn1));
+          theta -= dtheta;
+
+          if (fabs(dtheta) < GSL_DBL_EPSILON * theta)
+            break;
+        }
+
+      x = (2 * i + 1 == n) ? 0.0 : cos(theta);
+      u = sin(theta);
+
+      w->x[n - 1 - i] = -x;
+      w->u[n - 1 - i] = u;
+      w->w[n - 1 - i] = 2.0 * u * u / (dn * dn * (x * pn - pn1) * (x * pn - pn1));
+
+      w->x[i] = x;
+      w->u[i] = u;
+      w->w[i] = w->w[n - 1 - i];
+    }
+}
+
+/*
+sht_start()
+  Prepare the recurrence in l for order m on the northern rings
+
+Notes:
+1) P_{mm} is updated from P_{m-1,m-1}, so this must be called
+for m = 0, 1, ..., lmax in turn
+
+2) for a ring where P_{mm} is below the underflow threshold, the
+recurrence is run with scaled values until it reaches a
+representable value at degree l0; the state there is saved in
+q0,q1 and the ring is linked into the list head[l0]
+*/
+
+static int
+sht_start(const size_t m, gsl_sf_legendre_sht_workspace * w)
+{
+  const size_t lmax = w->lmax;
+  const size_t nh = (w->nlat + 1) / 2;
+  const double big = ldexp(1.0, SHT_SCALE_EXP);
+  const double small = 1.0 / big;
+  int active = 1;
+  size_t j, l;
+
+  for (l = 0; l <= lmax + 1; ++l)
+    w->head[l] = nh;
+
+  /* work from the equator towards the pole: once a ring fails to
+   * reach a representable value by lmax, so do all rings nearer
+   * the pole */
+  for (j = nh; j-- > 0; )
+    {
+      double p, pprev;
+      size_t idx;
+      int k;
+
+      if (m == 0)
+        {
+          w->pmm[j] = 1.0 / sqrt(4.0 * M_PI);
+          w->kmm[j] = 0;
+        }
+      else
+        {
+          /* P_{mm} = sqrt((2m+1)/(2m)) u P_{m-1,m-1} */
+          w->pmm[j] *= sqrt((2.0 * m + 1.0) / (2.0 * m)) * w->u[j];
+          if (w->pmm[j] < small)
+            {
+              w->pmm[j] *= big;
+              w->kmm[j]++;
+            }
+        }
+
+      w->p0[j] = 0.0;
+      w->p1[j] = 0.0;
+      w->l0[j] = lmax + 1;
+
+      if (!active)
+        continue;
+
+      p = w->pmm[j];
+      pprev = 0.0;
+      k = w->kmm[j];
+      l = m;
+      idx = gsl_sf_legendre_array_index(m, m);
+
+      while (k > 0 && l < lmax)
+        {
+          double pnext;
+
+          /* index of (l+1,m) */
+          idx += l + 1;
+          pnext = w->a[idx] * (w->x[j] * p - w->b[idx] * pprev);
+
+          pprev = p;
+          p = pnext;
+          ++l;
+
+          if (fabs(p) > 1.0)
+            {
+              p *= small;
+              pprev *= small;
+              --k;
+            }
+        }
+
+      if (k == 0)
+        {
+          w->l0[j] = l;
+          w->q0[j] = pprev;
+          w->q1[j] = p;
+          w->next[j] = w->head[l];
+          w->head[l] = j;
+        }
+      else
+        {
+          active = 0;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+sht_activate()
+  Start the recurrence on the rings which reach representable
+values at degree l, and extend the range [jlo,nh) of rings to
+process. Rings inside the range which are not yet active have
+zero state and so do not contribute.
+*/
+
+static void
+sht_activate(const size_t l, size_t * jlo,
+             gsl_sf_legendre_sht_workspace * w)
+{
+  const size_t nh = (w->nlat + 1) / 2;
+  size_t j = w->head[l];
+
+  while (j != nh)
+    {
+      w->p0[j] = w->q0[j];
+      w->p1[j] = w->q1[j];
+
+      if (j < *jlo)
+        *jlo = j;
+
+      j = w->next[j];
+    }
+}
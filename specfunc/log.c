@@ -28,6 +28,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -264,3 +265,99 @@ double gsl_sf_log_1plusx_mx(const double x)
 {
   EVAL_RESULT(gsl_sf_log_1plusx_mx_e(x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only versions of the functions above. These perform the
+ * same arithmetic as the _e functions, without the error estimates.
+ * The Chebyshev series are truncated according to the mode.
+ */
+
+static double log_val(const double x)
+{
+  return (x <= 0.0) ? GSL_NAN : log(x);
+}
+
+static double log_1plusx_val(const double x, gsl_mode_t mode)
+{
+  if(x <= -1.0) {
+    return GSL_NAN;
+  }
+  else if(fabs(x) < GSL_ROOT6_DBL_EPSILON) {
+    const double c1 = -0.5;
+    const double c2 =  1.0/3.0;
+    const double c3 = -1.0/4.0;
+    const double c4 =  1.0/5.0;
+    const double c5 = -1.0/6.0;
+    const double c6 =  1.0/7.0;
+    const double c7 = -1.0/8.0;
+    const double c8 =  1.0/9.0;
+    const double c9 = -1.0/10.0;
+    const double t  =  c5 + x*(c6 + x*(c7 + x*(c8 + x*c9)));
+    return x * (1.0 + x*(c1 + x*(c2 + x*(c3 + x*(c4 + x*t)))));
+  }
+  else if(fabs(x) < 0.5) {
+    double t = 0.5*(8.0*x + 1.0)/(x+2.0);
+    return x * cheb_eval_mode(&lopx_cs, t, mode);
+  }
+  else {
+    return log(1.0 + x);
+  }
+}
+
+static double log_1plusx_mx_val(const double x, gsl_mode_t mode)
+{
+  if(x <= -1.0) {
+    return GSL_NAN;
+  }
+  else if(fabs(x) < GSL_ROOT5_DBL_EPSILON) {
+    const double c1 = -0.5;
+    const double c2 =  1.0/3.0;
+    const double c3 = -1.0/4.0;
+    const double c4 =  1.0/5.0;
+    const double c5 = -1.0/6.0;
+    const double c6 =  1.0/7.0;
+    const double c7 = -1.0/8.0;
+    const double c8 =  1.0/9.0;
+    const double c9 = -1.0/10.0;
+    const double t  =  c5 + x*(c6 + x*(c7 + x*(c8 + x*c9)));
+    return x*x * (c1 + x*(c2 + x*(c3 + x*(c4 + x*t))));
+  }
+  else if(fabs(x) < 0.5) {
+    double t = 0.5*(8.0*x + 1.0)/(x+2.0);
+    return x*x * cheb_eval_mode(&lopxmx_cs, t, mode);
+  }
+  else {
+    const double lterm = log(1.0 + x);
+    return lterm - x;
+  }
+}
+
+int gsl_sf_log_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY(log_val, n, x, result);
+}
+
+int gsl_sf_log_1plusx_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(log_1plusx_val, n, x, result);
+}
+
+int gsl_sf_log_1plusx_mx_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(log_1plusx_mx_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_log_1plusx_fast(const double x, gsl_mode_t mode)
+{
+  return log_1plusx_val(x, mode);
+}
+
+double gsl_sf_log_1plusx_mx_fast(const double x, gsl_mode_t mode)
+{
+  return log_1plusx_mx_val(x, mode);
+}
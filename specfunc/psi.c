@@ -35,6 +35,7 @@
 
 #include "chebyshev.h"
 #include "cheb_eval.c"
+#include "cheb_eval_mode.c"
 
 /*-*-*-*-*-*-*-*-*-*-*-* Private Section *-*-*-*-*-*-*-*-*-*-*-*/
 
@@ -864,3 +865,73 @@ double gsl_sf_psi_n(const int n, const double x)
 {
   EVAL_RESULT(gsl_sf_psi_n_e(n, x, &result));
 }
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Array Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+/* Value-only version of psi_x. This performs the same arithmetic
+ * without the error estimate.
+ * The Chebyshev series are truncated according to the mode.
+ */
+static double
+psi_x_val(const double x, gsl_mode_t mode)
+{
+  const double y = fabs(x);
+
+  if(x == 0.0 || x == -1.0 || x == -2.0) {
+    return GSL_NAN;
+  }
+  else if(y >= 2.0) {
+    const double t = 8.0/(y*y)-1.0;
+    const double c_val = cheb_eval_mode(&apsi_cs, t, mode);
+    if(x < 0.0) {
+      const double s = sin(M_PI*x);
+      const double c = cos(M_PI*x);
+      if(fabs(s) < 2.0*GSL_SQRT_DBL_MIN) {
+        return GSL_NAN;
+      }
+      else {
+        return log(y) - 0.5/x + c_val - M_PI * c/s;
+      }
+    }
+    else {
+      return log(y) - 0.5/x + c_val;
+    }
+  }
+  else { /* -2 < x < 2 */
+    if(x < -1.0) { /* x = -2 + v */
+      const double v  = x + 2.0;
+      const double t1 = 1.0/x;
+      const double t2 = 1.0/(x+1.0);
+      const double t3 = 1.0/v;
+      return -(t1 + t2 + t3) + cheb_eval_mode(&psi_cs, 2.0*v-1.0, mode);
+    }
+    else if(x < 0.0) { /* x = -1 + v */
+      const double v  = x + 1.0;
+      const double t1 = 1.0/x;
+      const double t2 = 1.0/v;
+      return -(t1 + t2) + cheb_eval_mode(&psi_cs, 2.0*v-1.0, mode);
+    }
+    else if(x < 1.0) { /* x = v */
+      const double t1 = 1.0/x;
+      return -t1 + cheb_eval_mode(&psi_cs, 2.0*x-1.0, mode);
+    }
+    else { /* x = 1 + v */
+      const double v = x - 1.0;
+      return cheb_eval_mode(&psi_cs, 2.0*v-1.0, mode);
+    }
+  }
+}
+
+int gsl_sf_psi_array(const size_t n, const double x[], double result[])
+{
+  EVAL_ARRAY_MODE(psi_x_val, n, x, result);
+}
+
+
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-* Fast Functions *-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+double gsl_sf_psi_fast(const double x, gsl_mode_t mode)
+{
+  return psi_x_val(x, mode);
+}
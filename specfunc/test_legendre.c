@@ -21,8 +21,11 @@
 /* Author:  G. Jungman */
 
 #include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_sf.h>
+#include <gsl/gsl_sf_legendre_sht.h>
 #include "test_sf.h"
 
 static double
@@ -530,6 +533,94 @@ test_legendre_all(const size_t lmax)
   return s;
 } /* test_legendre_all() */
 
+/*
+test_legendre_sht()
+  Check spherical harmonic synthesis against direct summation with
+gsl_sf_legendre_array() on a few rings, including the rings next to
+the poles, and check that analysis recovers the coefficients
+*/
+
+static int
+test_legendre_sht(const size_t lmax, const size_t nlat, const size_t nlon)
+{
+  int s = 0;
+  const size_t nlm = gsl_sf_legendre_nlm(lmax);
+  gsl_sf_legendre_sht_workspace *w =
+    gsl_sf_legendre_sht_alloc(lmax, nlat, nlon);
+  double *alm = malloc(2 * nlm * sizeof(double));
+  double *blm = malloc(2 * nlm * sizeof(double));
+  double *f = malloc(nlat * nlon * sizeof(double));
+  double *p = malloc(gsl_sf_legendre_array_n(lmax) * sizeof(double));
+  const size_t rings[3] = { 0, nlat / 2, nlat - 1 };
+  double fmax = 0.0, err;
+  size_t i, j, k, l, m;
+
+  for (l = 0; l <= lmax; ++l)
+    {
+      for (m = 0; m <= l; ++m)
+        {
+          size_t idx = gsl_sf_legendre_array_index(l, m);
+          alm[2 * idx] = sin(1.3 * idx + 0.1) / (1.0 + l);
+          alm[2 * idx + 1] = (m > 0) ? cos(0.7 * idx + 0.2) / (1.0 + l) : 0.0;
+        }
+    }
+
+  gsl_sf_legendre_sht_synthesis(alm, f, w);
+
+  for (i = 0; i < nlat * nlon; ++i)
+    fmax = GSL_MAX(fmax, fabs(f[i]));
+
+  err = 0.0;
+  for (i = 0; i < 3; ++i)
+    {
+      j = rings[i];
+      gsl_sf_legendre_array(GSL_SF_LEGENDRE_SPHARM, lmax, w->x[j], p);
+
+      for (k = 0; k < nlon; ++k)
+        {
+          const double phi = 2.0 * M_PI * k / nlon;
+          double sum = 0.0;
+
+          for (l = 0; l <= lmax; ++l)
+            {
+              size_t idx = gsl_sf_legendre_array_index(l, 0);
+              sum += alm[2 * idx] * p[idx];
+
+              for (m = 1; m <= l; ++m)
+                {
+                  idx = gsl_sf_legendre_array_index(l, m);
+                  sum += 2.0 * p[idx] * (alm[2 * idx] * cos(m * phi) -
+                                         alm[2 * idx + 1] * sin(m * phi));
+                }
+            }
+
+          err = GSL_MAX(err, fabs(f[j * nlon + k] - sum));
+        }
+    }
+
+  s = err > 1.0e-12 * fmax;
+  gsl_test(s, "gsl_sf_legendre_sht_synthesis lmax=%zu nlat=%zu nlon=%zu error=%e",
+           lmax, nlat, nlon, err / fmax);
+
+  gsl_sf_legendre_sht_analysis(f, blm, w);
+
+  err = 0.0;
+  for (i = 0; i < 2 * nlm; ++i)
+    err = GSL_MAX(err, fabs(blm[i] - alm[i]));
+
+  s += err > 1.0e-12;
+  gsl_test(err > 1.0e-12, "gsl_sf_legendre_sht_analysis lmax=%zu nlat=%zu nlon=%zu error=%e",
+           lmax, nlat, nlon, err);
+
+  free(alm);
+  free(blm);
+  free(f);
+  free(p);
+  gsl_sf_legendre_sht_free(w);
+
+  return s;
+} /* test_legendre_sht() */
+
 int test_legendre(void)
 {
   gsl_sf_result r;
@@ -1071,5 +1162,11 @@ int test_legendre(void)
     /*test_legendre_all(2700);*/
   }
 
+  /* test spherical harmonic transforms */
+  s += test_legendre_sht(0, 1, 1);
+  s += test_legendre_sht(12, 13, 25);
+  s += test_legendre_sht(12, 14, 32);
+  s += test_legendre_sht(700, 701, 1404);
+
   return s;
 }
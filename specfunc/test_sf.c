@@ -2691,6 +2691,156 @@ int test_zeta(void)
   return s;
 }
 
+/* The array functions must agree with the scalar ones to within
+ * 2 ulp, and signal an error once for the whole array. The fast
+ * functions must agree exactly at double precision, and to 1e-8
+ * with the truncated series of the lower precision modes.
+ */
+
+typedef struct
+{
+  const char * name;
+  double (*f)(double);
+  int (*f_array)(const size_t, const double *, double *);
+  double (*f_fast)(double, gsl_mode_t);
+} test_sf_array_fn;
+
+#define ARRAY_FN(f) { #f, f, f ## _array, f ## _fast }
+#define ARRAY_FN_NOFAST(f) { #f, f, f ## _array, NULL }
+
+static const test_sf_array_fn test_sf_array_fns[] = {
+  ARRAY_FN(gsl_sf_erfc), ARRAY_FN(gsl_sf_log_erfc), ARRAY_FN(gsl_sf_erf),
+  ARRAY_FN_NOFAST(gsl_sf_erf_Z), ARRAY_FN(gsl_sf_erf_Q),
+  ARRAY_FN(gsl_sf_hazard),
+  ARRAY_FN_NOFAST(gsl_sf_exp), ARRAY_FN_NOFAST(gsl_sf_expm1),
+  ARRAY_FN_NOFAST(gsl_sf_exprel),
+  ARRAY_FN_NOFAST(gsl_sf_log), ARRAY_FN(gsl_sf_log_1plusx),
+  ARRAY_FN(gsl_sf_log_1plusx_mx),
+  ARRAY_FN_NOFAST(gsl_sf_lngamma), ARRAY_FN(gsl_sf_gamma),
+  ARRAY_FN(gsl_sf_gammastar), ARRAY_FN(gsl_sf_gammainv),
+  ARRAY_FN(gsl_sf_psi),
+  ARRAY_FN(gsl_sf_bessel_J0), ARRAY_FN(gsl_sf_bessel_J1),
+  ARRAY_FN(gsl_sf_bessel_Y0), ARRAY_FN(gsl_sf_bessel_Y1),
+  ARRAY_FN(gsl_sf_bessel_I0), ARRAY_FN(gsl_sf_bessel_I1),
+  ARRAY_FN(gsl_sf_bessel_I0_scaled), ARRAY_FN(gsl_sf_bessel_I1_scaled),
+  ARRAY_FN(gsl_sf_bessel_K0), ARRAY_FN(gsl_sf_bessel_K1),
+  ARRAY_FN(gsl_sf_bessel_K0_scaled), ARRAY_FN(gsl_sf_bessel_K1_scaled),
+  ARRAY_FN(gsl_sf_expint_E1), ARRAY_FN(gsl_sf_expint_E1_scaled),
+  ARRAY_FN(gsl_sf_expint_Ei),
+  ARRAY_FN(gsl_sf_dawson),
+  { NULL, NULL, NULL, NULL }
+};
+
+static int test_sf_handler_calls = 0;
+
+static void
+test_sf_count_handler(const char * reason, const char * file, int line, int gsl_errno)
+{
+  (void) reason; (void) file; (void) line; (void) gsl_errno;
+  test_sf_handler_calls++;
+}
+
+int test_array(void)
+{
+  const size_t n = 2000;
+  double * x = malloc(n * sizeof(double));
+  double * y = malloc(n * sizeof(double));
+  const test_sf_array_fn * t;
+  size_t i;
+  int s = 0;
+
+  /* cover the branches of each function: tiny, moderate and large
+   * arguments of both signs, integers and the region of overflow
+   */
+  for (i = 0; i < n; i++)
+    {
+      const double u = (i + 0.5) / n;
+
+      if (i % 4 == 0)
+        x[i] = -60.0 + 120.0 * u;
+      else if (i % 4 == 1)
+        x[i] = pow(10.0, -300.0 + 310.0 * u);
+      else if (i % 4 == 2)
+        x[i] = -pow(10.0, -300.0 + 304.0 * u);
+      else
+        x[i] = 1000.0 * u;
+    }
+
+  x[0] = 0.0;
+  x[4] = -3.0;
+  x[8] = 1.0;
+  x[12] = 171.0;
+  x[16] = 180.0;
+
+  for (t = test_sf_array_fns; t->name != NULL; t++)
+    {
+      int sa = 0;
+
+      t->f_array(n, x, y);
+
+      for (i = 0; i < n; i++)
+        {
+          const double v = t->f(x[i]);
+
+          if (gsl_isnan(v) && gsl_isnan(y[i]))
+            continue;
+          else if (v == y[i])
+            continue;
+          else if (!(fabs(v - y[i]) <= 2.0 * GSL_DBL_EPSILON * fabs(v)))
+            sa++;
+        }
+
+      gsl_test(sa, "  %s_array", t->name);
+      s += sa;
+
+      if (t->f_fast == NULL)
+        continue;
+
+      sa = 0;
+
+      for (i = 0; i < n; i++)
+        {
+          const double v = t->f(x[i]);
+          const double vd = t->f_fast(x[i], GSL_PREC_DOUBLE);
+          const double vs = t->f_fast(x[i], GSL_PREC_SINGLE);
+
+          if (gsl_isnan(v))
+            sa += !(gsl_isnan(vd) && gsl_isnan(vs));
+          else if (vd != v)
+            sa++;
+          else if (vs != v && !(fabs(vs - v) <= 1.0e-08 * GSL_MAX_DBL(fabs(v), 1.0)))
+            sa++;
+        }
+
+      gsl_test(sa, "  %s_fast", t->name);
+      s += sa;
+    }
+
+  /* the error handler is called once, with the first error found */
+  x[0] = 1.0;
+  x[1] = -1.0;
+  x[2] = 800.0;
+  s += (gsl_sf_log_array(3, x, y) != GSL_EDOM);
+  s += (gsl_sf_exp_array(3, x, y) != GSL_EOVRFLW);
+  s += (gsl_sf_exp_array(2, x, y) != GSL_SUCCESS);
+  s += (gsl_sf_log_array(1, x, y) != GSL_SUCCESS);
+
+  /* the fast functions never call the error handler */
+  test_sf_handler_calls = 0;
+  gsl_set_error_handler (&test_sf_count_handler);
+  s += !gsl_isnan(gsl_sf_bessel_Y0_fast(-1.0, GSL_PREC_SINGLE));
+  s += !gsl_isnan(gsl_sf_log_1plusx_fast(-2.0, GSL_PREC_DOUBLE));
+  s += !gsl_isinf(gsl_sf_gamma_fast(200.0, GSL_PREC_SINGLE));
+  s += !gsl_isinf(gsl_sf_bessel_I0_fast(800.0, GSL_PREC_DOUBLE));
+  gsl_set_error_handler_off ();
+  s += (test_sf_handler_calls != 0);
+
+  free(x);
+  free(y);
+
+  return s;
+}
+
 int test_results(void)
 {
   int s = 0;
@@ -2764,6 +2914,7 @@ int main(int argc, char * argv[])
   gsl_test(test_trig(),        "Trigonometric and Related Functions");
   gsl_test(test_zeta(),        "Zeta Functions");
 
+  gsl_test(test_array(),       "Array Functions");
   gsl_test(test_results(),     "Result Methods");
 
   exit (gsl_test_summary());
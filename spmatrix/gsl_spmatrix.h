@@ -74,7 +74,7 @@ typedef struct
  * [ data[p[i]], data[p[i] + 1], ..., data[p[i+1] - 1] ]
  */
 
-typedef struct
+typedef struct gsl_spmatrix_struct
 {
   size_t size1;  /* number of rows */
   size_t size2;  /* number of columns */
@@ -23,9 +23,12 @@
 
 #include <config.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_wavelet.h>
 #include <gsl/gsl_wavelet2d.h>
 
+#include "lifting.h"
+
 #define ELEMENT(a,stride,i) ((a)[(stride)*(i)])
 
 static int binary_logn (const size_t n);
@@ -115,43 +118,153 @@ dwt_step (const gsl_wavelet * w, double *a, size_t stride, size_t n,
     }
 }
 
-int
-gsl_wavelet_transform (const gsl_wavelet * w, 
-                       double *data, size_t stride, size_t n,
-                       gsl_wavelet_direction dir, 
-                       gsl_wavelet_workspace * work)
+static int
+dwt_check (const gsl_wavelet * w, size_t n, gsl_wavelet_workspace * work,
+           int *periodic)
 {
-  size_t i;
-
   if (work->n < n)
     {
       GSL_ERROR ("not enough workspace provided", GSL_EINVAL);
     }
 
-  if (binary_logn (n) == -1)
+  *periodic = (binary_logn (n) != -1);
+
+  if (!*periodic && w->lifting == NULL)
     {
       GSL_ERROR ("n is not a power of 2", GSL_EINVAL);
     }
 
-  if (n < 2)
+  return GSL_SUCCESS;
+}
+
+/* length of the smooth part after j levels of the transform */
+static size_t
+dwt_level_size (size_t n, size_t j)
+{
+  while (j-- > 0)
     {
-      return GSL_SUCCESS;
+      n = (n + 1) >> 1;
+    }
+
+  return n;
+}
+
+/* number of levels of the transform.  With symmetric extension the
+ * recursion stops once the smooth part is shorter than the filter,
+ * since repeated reflection of the short channels makes the further
+ * levels badly conditioned. */
+static size_t
+dwt_nlevels (const gsl_wavelet * w, size_t n, int periodic)
+{
+  const size_t nmin = periodic ? 2 : GSL_MAX (2, w->nc);
+  size_t j = 0;
+
+  while (n >= nmin)
+    {
+      n = (n + 1) >> 1;
+      j++;
+    }
+
+  return j;
+}
+
+static void
+dwt_level (const gsl_wavelet * w, double *a, size_t stride, size_t n,
+           int periodic, gsl_wavelet_direction dir,
+           gsl_wavelet_workspace * work)
+{
+  if (w->lifting != NULL)
+    {
+      wavelet_lifting_step (w->lifting, a, stride, n, periodic, dir,
+                            work->scratch);
+    }
+  else
+    {
+      dwt_step (w, a, stride, n, dir, work);
+    }
+}
+
+/* copy columns j0 .. j0+ncols-1 of the top nrows rows of a matrix into
+ * contiguous columns of the tile, or back again */
+static void
+dwt_tile_get (const double *data, size_t tda, size_t nrows, size_t j0,
+              size_t ncols, double *tile)
+{
+  size_t i, j;
+
+  for (i = 0; i < nrows; i++)
+    {
+      const double *row = data + i * tda + j0;
+
+      for (j = 0; j < ncols; j++)
+        {
+          tile[j * nrows + i] = row[j];
+        }
+    }
+}
+
+static void
+dwt_tile_set (double *data, size_t tda, size_t nrows, size_t j0,
+              size_t ncols, const double *tile)
+{
+  size_t i, j;
+
+  for (i = 0; i < nrows; i++)
+    {
+      double *row = data + i * tda + j0;
+
+      for (j = 0; j < ncols; j++)
+        {
+          row[j] = tile[j * nrows + i];
+        }
     }
+}
+
+static void
+dwt_transform (const gsl_wavelet * w, double *data, size_t stride, size_t n,
+               int periodic, gsl_wavelet_direction dir,
+               gsl_wavelet_workspace * work)
+{
+  size_t j, nlevels = dwt_nlevels (w, n, periodic);
 
   if (dir == gsl_wavelet_forward)
     {
-      for (i = n; i >= 2; i >>= 1)
+      for (j = 0; j < nlevels; j++)
         {
-          dwt_step (w, data, stride, i, dir, work);
+          dwt_level (w, data, stride, dwt_level_size (n, j), periodic,
+                     dir, work);
         }
     }
   else
     {
-      for (i = 2; i <= n; i <<= 1)
+      for (j = nlevels; j-- > 0;)
         {
-          dwt_step (w, data, stride, i, dir, work);
+          dwt_level (w, data, stride, dwt_level_size (n, j), periodic,
+                     dir, work);
         }
     }
+}
+
+int
+gsl_wavelet_transform (const gsl_wavelet * w, 
+                       double *data, size_t stride, size_t n,
+                       gsl_wavelet_direction dir, 
+                       gsl_wavelet_workspace * work)
+{
+  int periodic;
+  int status = dwt_check (w, n, work, &periodic);
+
+  if (status)
+    {
+      return status;
+    }
+
+  if (n < 2)
+    {
+      return GSL_SUCCESS;
+    }
+
+  dwt_transform (w, data, stride, n, periodic, dir, work);
 
   return GSL_SUCCESS;
 }
@@ -183,27 +296,77 @@ gsl_dwt_vector (const gsl_wavelet * w, gsl_vector *v, gsl_wavelet_direction
 }
 #endif
 
-int
-gsl_wavelet2d_transform (const gsl_wavelet * w, 
-                         double *data, size_t tda, size_t size1,
-                         size_t size2, gsl_wavelet_direction dir,
-                         gsl_wavelet_workspace * work)
+static void
+dwt_rows (const gsl_wavelet * w, double *data, size_t tda, size_t size1,
+          size_t size2, size_t n, int periodic, int full,
+          gsl_wavelet_direction dir, gsl_wavelet_workspace * work)
 {
   size_t i;
 
-  if (size1 != size2)
+  for (i = 0; i < size1; i++)   /* for every row i */
     {
-      GSL_ERROR ("2d dwt works only with square matrix", GSL_EINVAL);
+      double *row = data + i * tda;
+
+      if (full)
+        dwt_transform (w, row, 1, size2, periodic, dir, work);
+      else
+        dwt_level (w, row, 1, n, periodic, dir, work);
     }
+}
+
+/* transform the columns in tiles of work->ntile adjacent columns, so
+ * that the strided accesses of one pass are shared by the whole tile */
+static void
+dwt_columns (const gsl_wavelet * w, double *data, size_t tda, size_t size1,
+             size_t size2, size_t n, int periodic, int full,
+             gsl_wavelet_direction dir, gsl_wavelet_workspace * work)
+{
+  size_t j0, j;
 
-  if (work->n < size1)
+  for (j0 = 0; j0 < size2; j0 += work->ntile)
     {
-      GSL_ERROR ("not enough workspace provided", GSL_EINVAL);
+      const size_t ncols = GSL_MIN (work->ntile, size2 - j0);
+
+      dwt_tile_get (data, tda, size1, j0, ncols, work->tile);
+
+      for (j = 0; j < ncols; j++)       /* for every column j */
+        {
+          double *col = work->tile + j * size1;
+
+          if (full)
+            dwt_transform (w, col, 1, size1, periodic, dir, work);
+          else
+            dwt_level (w, col, 1, n, periodic, dir, work);
+        }
+
+      dwt_tile_set (data, tda, size1, j0, ncols, work->tile);
     }
+}
 
-  if (binary_logn (size1) == -1)
+static int
+dwt_check_2d (const gsl_wavelet * w, size_t size1, size_t size2,
+              gsl_wavelet_workspace * work, int *periodic)
+{
+  if (size1 != size2)
     {
-      GSL_ERROR ("n is not a power of 2", GSL_EINVAL);
+      GSL_ERROR ("2d dwt works only with square matrix", GSL_EINVAL);
+    }
+
+  return dwt_check (w, size1, work, periodic);
+}
+
+int
+gsl_wavelet2d_transform (const gsl_wavelet * w, 
+                         double *data, size_t tda, size_t size1,
+                         size_t size2, gsl_wavelet_direction dir,
+                         gsl_wavelet_workspace * work)
+{
+  int periodic;
+  int status = dwt_check_2d (w, size1, size2, work, &periodic);
+
+  if (status)
+    {
+      return status;
     }
 
   if (size1 < 2)
@@ -213,25 +376,13 @@ gsl_wavelet2d_transform (const gsl_wavelet * w,
 
   if (dir == gsl_wavelet_forward)
     {
-      for (i = 0; i < size1; i++)       /* for every row j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, tda, i), 1, size1, dir, work);
-        }
-      for (i = 0; i < size2; i++)       /* for every column j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, 1, i), tda, size2, dir, work);
-        }
+      dwt_rows (w, data, tda, size1, size2, size2, periodic, 1, dir, work);
+      dwt_columns (w, data, tda, size1, size2, size1, periodic, 1, dir, work);
     }
   else
     {
-      for (i = 0; i < size2; i++)       /* for every column j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, 1, i), tda, size2, dir, work);
-        }
-      for (i = 0; i < size1; i++)       /* for every row j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, tda, i), 1, size1, dir, work);
-        }
+      dwt_columns (w, data, tda, size1, size2, size1, periodic, 1, dir, work);
+      dwt_rows (w, data, tda, size1, size2, size2, periodic, 1, dir, work);
     }
 
   return GSL_SUCCESS;
@@ -243,21 +394,13 @@ gsl_wavelet2d_nstransform (const gsl_wavelet * w,
                            size_t size2, gsl_wavelet_direction dir,
                            gsl_wavelet_workspace * work)
 {
-  size_t i, j;
+  size_t i, j, nlevels;
+  int periodic;
+  int status = dwt_check_2d (w, size1, size2, work, &periodic);
 
-  if (size1 != size2)
+  if (status)
     {
-      GSL_ERROR ("2d dwt works only with square matrix", GSL_EINVAL);
-    }
-
-  if (work->n < size1)
-    {
-      GSL_ERROR ("not enough workspace provided", GSL_EINVAL);
-    }
-
-  if (binary_logn (size1) == -1)
-    {
-      GSL_ERROR ("n is not a power of 2", GSL_EINVAL);
+      return status;
     }
 
   if (size1 < 2)
@@ -265,32 +408,24 @@ gsl_wavelet2d_nstransform (const gsl_wavelet * w,
       return GSL_SUCCESS;
     }
 
+  nlevels = dwt_nlevels (w, size1, periodic);
+
   if (dir == gsl_wavelet_forward)
     {
-      for (i = size1; i >= 2; i >>= 1)
+      for (j = 0; j < nlevels; j++)
         {
-          for (j = 0; j < i; j++)       /* for every row j */
-            {
-              dwt_step (w, &ELEMENT(data, tda, j), 1, i, dir, work);
-            }
-          for (j = 0; j < i; j++)       /* for every column j */
-            {
-              dwt_step (w, &ELEMENT(data, 1, j), tda, i, dir, work);
-            }
+          i = dwt_level_size (size1, j);
+          dwt_rows (w, data, tda, i, i, i, periodic, 0, dir, work);
+          dwt_columns (w, data, tda, i, i, i, periodic, 0, dir, work);
         }
     }
   else
     {
-      for (i = 2; i <= size1; i <<= 1)
+      for (j = nlevels; j-- > 0;)
         {
-          for (j = 0; j < i; j++)       /* for every column j */
-            {
-              dwt_step (w, &ELEMENT(data, 1, j), tda, i, dir, work);
-            }
-          for (j = 0; j < i; j++)       /* for every row j */
-            {
-              dwt_step (w, &ELEMENT(data, tda, j), 1, i, dir, work);
-            }
+          i = dwt_level_size (size1, j);
+          dwt_columns (w, data, tda, i, i, i, periodic, 0, dir, work);
+          dwt_rows (w, data, tda, i, i, i, periodic, 0, dir, work);
         }
     }
 
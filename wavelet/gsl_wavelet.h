@@ -49,6 +49,18 @@ typedef struct
 }
 gsl_wavelet_type;
 
+typedef struct
+{
+  size_t nsteps;        /* number of lifting steps */
+  int *channel;         /* channel updated by step i: 0 = even, 1 = odd */
+  int *lag;             /* lag of the first coefficient of step i */
+  size_t *len;          /* number of coefficients of step i */
+  double *coeff;        /* coefficients of all steps, stored contiguously */
+  double scale[2];      /* final scaling of the even/odd channels */
+  int shift[2];         /* final shift of the even/odd channels */
+}
+gsl_wavelet_lifting;
+
 typedef struct
 {
   const gsl_wavelet_type *type;
@@ -58,6 +70,7 @@ typedef struct
   const double *g2;
   size_t nc;
   size_t offset;
+  gsl_wavelet_lifting *lifting; /* lifting factorization, or NULL */
 }
 gsl_wavelet;
 
@@ -65,6 +78,8 @@ typedef struct
 {
   double *scratch;
   size_t n;
+  double *tile;         /* column tile for 2d transforms, size n * ntile */
+  size_t ntile;         /* number of columns per tile */
 }
 gsl_wavelet_workspace;
 
@@ -0,0 +1,991 @@
+/* wavelet/lifting.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Lifting factorization of the wavelet filter banks.
+ *
+ * The analysis step of a two-channel filter bank can be written in
+ * polyphase form as
+ *
+ *   [h]   [A B] [e]
+ *   [g] = [C D] [o]
+ *
+ * where e and o are the even and odd samples of the input and A, B,
+ * C, D are Laurent polynomials in the shift operator.  Following
+ * Daubechies and Sweldens, "Factoring wavelet transforms into lifting
+ * steps", J. Fourier Anal. Appl. 4 (1998) 247-269, the Euclidean
+ * algorithm applied to the first row factors this matrix into a
+ * product of elementary lifting steps followed by a diagonal scaling.
+ * The lifting form needs roughly half the multiplications of the
+ * filter bank and works in place on the two channels, so that it can
+ * also be used with non-periodic (symmetric) boundary conditions.
+ *
+ * The factorization is computed numerically when the wavelet is
+ * allocated and is checked against the original filters; if it is
+ * not accurate to near machine precision it is discarded and the
+ * filter bank is used instead.  The factorizations of the built-in
+ * wavelets are tabulated in lifting_table.c, so that the search is
+ * only run for other wavelet types. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_wavelet.h>
+
+#include "lifting.h"
+#include "lifting_table.c"
+
+#define LIFT_MAXLEN 64
+#define LIFT_MAXSTEPS 64
+
+/* bound on the number of divisions tried at each node; the polyphase
+ * components have at most LIFT_MAXLEN/2 coefficients */
+#define LIFT_MAXOPT (LIFT_MAXLEN / 2 + 4)
+
+/* bound on the size of the search for a factorization, and on the
+ * lifting coefficients accepted */
+#define LIFT_MAXNODES 20000
+#define LIFT_MAXCOEFF 4.0
+#define LIFT_MAXGROWTH 4.0
+
+typedef struct
+{
+  int lo;                       /* degree of c[0] */
+  size_t len;                   /* number of coefficients */
+  double c[LIFT_MAXLEN];
+}
+lpoly;
+
+static void lpoly_trim (lpoly * p, const double tol);
+static int lpoly_submul (lpoly * a, const lpoly * b, const lpoly * q);
+static double lpoly_divide (const lpoly * a, const lpoly * b, const size_t t,
+                            lpoly * q, double M[][LIFT_MAXLEN + 1]);
+static double lpoly_maxdiff (const lpoly * a, const lpoly * b);
+
+/* remove leading and trailing coefficients smaller than tol */
+static void
+lpoly_trim (lpoly * p, const double tol)
+{
+  size_t i0 = 0, i;
+
+  while (p->len > 0 && fabs (p->c[p->len - 1]) <= tol)
+    p->len--;
+
+  while (i0 < p->len && fabs (p->c[i0]) <= tol)
+    i0++;
+
+  if (i0 > 0)
+    {
+      for (i = i0; i < p->len; i++)
+        p->c[i - i0] = p->c[i];
+
+      p->len -= i0;
+      p->lo += (int) i0;
+    }
+
+  if (p->len == 0)
+    p->lo = 0;
+}
+
+/* a := a - b q */
+static int
+lpoly_submul (lpoly * a, const lpoly * b, const lpoly * q)
+{
+  lpoly r;
+  size_t i, j;
+  int lo, hi;
+
+  if (b->len == 0 || q->len == 0)
+    return GSL_SUCCESS;
+
+  lo = b->lo + q->lo;
+  hi = lo + (int) (b->len + q->len) - 2;
+
+  if (a->len > 0)
+    {
+      lo = GSL_MIN_INT (lo, a->lo);
+      hi = GSL_MAX_INT (hi, a->lo + (int) a->len - 1);
+    }
+
+  if (hi - lo + 1 > LIFT_MAXLEN)
+    return GSL_EFAILED;
+
+  r.lo = lo;
+  r.len = (size_t) (hi - lo + 1);
+
+  for (i = 0; i < r.len; i++)
+    r.c[i] = 0.0;
+
+  for (i = 0; i < a->len; i++)
+    r.c[a->lo - lo + (int) i] = a->c[i];
+
+  for (i = 0; i < b->len; i++)
+    for (j = 0; j < q->len; j++)
+      r.c[b->lo + q->lo - lo + (int) (i + j)] -= b->c[i] * q->c[j];
+
+  *a = r;
+
+  return GSL_SUCCESS;
+}
+
+/* compute q such that a - b q has its top t and bottom a->len -
+ * b->len + 1 - t coefficients cancelled, requires a->len >= b->len > 0.
+ * M is a LIFT_MAXLEN-by-(LIFT_MAXLEN + 1) workspace.  Returns the
+ * largest coefficient of q, or a negative value if the system is
+ * singular. */
+static double
+lpoly_divide (const lpoly * a, const lpoly * b, const size_t t, lpoly * q,
+              double M[][LIFT_MAXLEN + 1])
+{
+  const size_t m = a->len - b->len + 1;
+  double qmax = 0.0;
+  size_t i, j, k;
+
+  q->lo = a->lo - b->lo;
+  q->len = m;
+
+  /* row i cancels coefficient pos of a, column k is q->c[k] */
+  for (i = 0; i < m; i++)
+    {
+      size_t pos = (i < t) ? a->len - 1 - i : i - t;
+
+      for (k = 0; k < m; k++)
+        {
+          M[i][k] = (pos >= k && pos - k < b->len) ? b->c[pos - k] : 0.0;
+        }
+
+      M[i][m] = a->c[pos];
+    }
+
+  /* Gaussian elimination with partial pivoting */
+  for (k = 0; k < m; k++)
+    {
+      size_t p = k;
+
+      for (i = k + 1; i < m; i++)
+        {
+          if (fabs (M[i][k]) > fabs (M[p][k]))
+            p = i;
+        }
+
+      if (M[p][k] == 0.0)
+        return -1.0;
+
+      if (p != k)
+        {
+          for (j = k; j <= m; j++)
+            {
+              double tmp = M[k][j];
+              M[k][j] = M[p][j];
+              M[p][j] = tmp;
+            }
+        }
+
+      for (i = k + 1; i < m; i++)
+        {
+          double f = M[i][k] / M[k][k];
+
+          for (j = k; j <= m; j++)
+            M[i][j] -= f * M[k][j];
+        }
+    }
+
+  for (k = m; k-- > 0;)
+    {
+      double s = M[k][m];
+
+      for (j = k + 1; j < m; j++)
+        s -= M[k][j] * q->c[j];
+
+      q->c[k] = s / M[k][k];
+      qmax = GSL_MAX_DBL (qmax, fabs (q->c[k]));
+    }
+
+  return qmax;
+}
+
+static double
+lpoly_maxdiff (const lpoly * a, const lpoly * b)
+{
+  int lo, hi, k;
+  double dmax = 0.0;
+
+  lo = GSL_MIN_INT (a->lo, b->lo);
+  hi = GSL_MAX_INT (a->lo + (int) a->len, b->lo + (int) b->len);
+
+  for (k = lo; k < hi; k++)
+    {
+      double ak = (k >= a->lo && k < a->lo + (int) a->len) ? a->c[k - a->lo] : 0.0;
+      double bk = (k >= b->lo && k < b->lo + (int) b->len) ? b->c[k - b->lo] : 0.0;
+      dmax = GSL_MAX_DBL (dmax, fabs (ak - bk));
+    }
+
+  return dmax;
+}
+
+/* split the filter f into its even/odd polyphase components, so that
+ * sum_k f[k] x[2i + k - offset] = (fe e)[i] + (fo o)[i] */
+static void
+lift_polyphase (const double *f, const size_t nc, const size_t offset,
+                lpoly * fe, lpoly * fo)
+{
+  size_t i, k;
+  lpoly *p[2];
+
+  p[0] = fe;
+  p[1] = fo;
+
+  for (i = 0; i < 2; i++)
+    {
+      p[i]->lo = INT_MAX;
+      p[i]->len = 0;
+
+      for (k = 0; k < LIFT_MAXLEN; k++)
+        p[i]->c[k] = 0.0;
+    }
+
+  for (k = 0; k < nc; k++)
+    {
+      int j = (int) k - (int) offset;
+      int r = ((j % 2) + 2) % 2;
+      int m = (j - r) / 2;
+
+      p[r]->lo = GSL_MIN_INT (p[r]->lo, m);
+    }
+
+  for (k = 0; k < nc; k++)
+    {
+      int j = (int) k - (int) offset;
+      int r = ((j % 2) + 2) % 2;
+      int m = (j - r) / 2;
+      lpoly *pr = p[r];
+
+      pr->c[m - pr->lo] = f[k];
+      pr->len = GSL_MAX (pr->len, (size_t) (m - pr->lo + 1));
+    }
+
+  for (i = 0; i < 2; i++)
+    {
+      if (p[i]->len == 0)
+        p[i]->lo = 0;
+    }
+}
+
+/* the divisions tried at one node of the search, kept in the heap
+ * rather than on the stack of the recursion */
+typedef struct
+{
+  lpoly q[LIFT_MAXOPT];
+  double qmax[LIFT_MAXOPT];
+  int ch[LIFT_MAXOPT];
+  lpoly R[4];
+}
+lift_node;
+
+typedef struct
+{
+  lpoly P[4];                   /* polyphase matrix of the filter bank */
+  double tol;                   /* tolerance for vanishing coefficients */
+  size_t nodes;                 /* number of search nodes visited */
+  lpoly steps[LIFT_MAXSTEPS];   /* lifting steps on the current path */
+  int channel[LIFT_MAXSTEPS];
+  lpoly best[LIFT_MAXSTEPS];    /* best factorization found so far */
+  int best_channel[LIFT_MAXSTEPS];
+  size_t best_nsteps;
+  size_t best_nmul;             /* multiplications per sample pair */
+  double best_growth;           /* growth of intermediate values */
+  double best_scale[2];
+  int best_shift[2];
+
+  lift_node *node;              /* scratch for each depth of the search */
+  double M[LIFT_MAXLEN][LIFT_MAXLEN + 1];
+}
+lift_search;
+
+/* multiply the factorization out again and return the largest
+ * difference from the polyphase matrix */
+static double
+lift_check (const lift_search * ctx, const size_t nsteps, const lpoly * A,
+            const lpoly * C, const lpoly * D)
+{
+  lpoly R[4];
+  double err = 0.0;
+  size_t i, j;
+
+  R[0] = *A;
+  R[1].lo = 0;
+  R[1].len = 0;
+  R[2] = *C;
+  R[3] = *D;
+
+  for (i = nsteps; i-- > 0;)
+    {
+      lpoly mq = ctx->steps[i];
+      int status;
+
+      for (j = 0; j < mq.len; j++)
+        mq.c[j] = -mq.c[j];
+
+      if (ctx->channel[i] == 1)
+        {
+          /* R := R [1 0; q 1] */
+          status = lpoly_submul (&R[0], &R[1], &mq);
+          status |= lpoly_submul (&R[2], &R[3], &mq);
+        }
+      else
+        {
+          /* R := R [1 q; 0 1] */
+          status = lpoly_submul (&R[1], &R[0], &mq);
+          status |= lpoly_submul (&R[3], &R[2], &mq);
+        }
+
+      if (status)
+        return GSL_POSINF;
+    }
+
+  for (i = 0; i < 4; i++)
+    err = GSL_MAX_DBL (err, lpoly_maxdiff (&R[i], &ctx->P[i]));
+
+  return err;
+}
+
+/* largest infinity norm of the partial products of the lifting
+ * steps, which bounds the growth of the intermediate values */
+static double
+lift_growth (lift_search * ctx, const size_t nsteps)
+{
+  lpoly F[4];
+  double gmax = 1.0;
+  size_t i, j, k;
+
+  for (i = 0; i < 4; i++)
+    {
+      F[i].lo = 0;
+      F[i].len = (i == 0 || i == 3);
+      F[i].c[0] = 1.0;
+    }
+
+  for (i = 0; i < nsteps; i++)
+    {
+      lpoly mq = ctx->steps[i];
+      const int ch = ctx->channel[i];
+      int status;
+
+      for (j = 0; j < mq.len; j++)
+        mq.c[j] = -mq.c[j];
+
+      /* row ch := row ch + q * row (1 - ch) */
+      status = lpoly_submul (&F[2 * ch], &F[2 * (1 - ch)], &mq);
+      status |= lpoly_submul (&F[2 * ch + 1], &F[2 * (1 - ch) + 1], &mq);
+
+      if (status)
+        return GSL_POSINF;
+
+      for (j = 0; j < 2; j++)
+        {
+          double norm = 0.0;
+
+          for (k = 0; k < F[2 * j].len; k++)
+            norm += fabs (F[2 * j].c[k]);
+
+          for (k = 0; k < F[2 * j + 1].len; k++)
+            norm += fabs (F[2 * j + 1].c[k]);
+
+          gmax = GSL_MAX_DBL (gmax, norm);
+        }
+    }
+
+  return gmax;
+}
+
+/* the first row has been reduced to [a 0] or [0 b], complete the
+ * factorization and record it if it is the best one so far */
+static void
+lift_finish (lift_search * ctx, lpoly Q[4], size_t nsteps, size_t nmul,
+             double cmax)
+{
+  lpoly *A = &Q[0], *B = &Q[1], *C = &Q[2], *D = &Q[3];
+  lpoly *t;
+  double growth;
+  size_t i;
+
+  if (A->len == 0)
+    {
+      /* first row is [0 b], swap the columns with two more steps */
+      lpoly one;
+
+      one.lo = 0;
+      one.len = 1;
+      one.c[0] = -1.0;
+
+      ctx->steps[nsteps] = one;
+      ctx->channel[nsteps++] = 1;
+      lpoly_submul (A, B, &one);
+      lpoly_submul (C, D, &one);
+
+      one.c[0] = 1.0;
+      ctx->steps[nsteps] = one;
+      ctx->channel[nsteps++] = 0;
+      lpoly_submul (B, A, &one);
+      lpoly_submul (D, C, &one);
+
+      lpoly_trim (B, ctx->tol);
+      lpoly_trim (D, ctx->tol);
+
+      nmul += 2;
+      cmax = GSL_MAX_DBL (cmax, 1.0);
+    }
+
+  /* the determinant is a monomial, so both diagonal entries must be */
+
+  if (A->len != 1 || D->len != 1 || B->len != 0)
+    return;
+
+  if (lift_check (ctx, nsteps, A, C, D) > ctx->tol)
+    return;
+
+  /* final step o += (C / D) e */
+
+  t = &ctx->steps[nsteps];
+  t->lo = C->lo - D->lo;
+  t->len = C->len;
+
+  for (i = 0; i < C->len; i++)
+    {
+      t->c[i] = C->c[i] / D->c[0];
+      cmax = GSL_MAX_DBL (cmax, fabs (t->c[i]));
+    }
+
+  ctx->channel[nsteps++] = 1;
+  nmul += t->len;
+
+  if (cmax > LIFT_MAXCOEFF)
+    return;
+
+  growth = lift_growth (ctx, nsteps);
+
+  if (growth > LIFT_MAXGROWTH)
+    return;
+
+  if (nmul < ctx->best_nmul
+      || (nmul == ctx->best_nmul && growth < ctx->best_growth))
+    {
+      for (i = 0; i < nsteps; i++)
+        {
+          ctx->best[i] = ctx->steps[i];
+          ctx->best_channel[i] = ctx->channel[i];
+        }
+
+      ctx->best_nsteps = nsteps;
+      ctx->best_nmul = nmul;
+      ctx->best_growth = growth;
+      ctx->best_scale[0] = A->c[0];
+      ctx->best_shift[0] = A->lo;
+      ctx->best_scale[1] = D->c[0];
+      ctx->best_shift[1] = D->lo;
+    }
+}
+
+/* Euclidean algorithm on the first row, applying the same column
+ * operations to the second row.  Each division may cancel
+ * coefficients from either end of the longer polynomial, and either
+ * polynomial may be reduced when they have the same length; the
+ * branches are searched for the factorization with the fewest
+ * multiplications whose lifting coefficients are all bounded by
+ * LIFT_MAXCOEFF, since large coefficients amplify rounding errors. */
+static void
+lift_search_node (lift_search * ctx, const lpoly Q[4], size_t nsteps,
+                  size_t nmul, double cmax)
+{
+  const lpoly *A = &Q[0], *B = &Q[1];
+  lpoly *q;
+  double *qmax;
+  int *ch;
+  size_t nopt = 0, i, t;
+
+  if (ctx->nodes++ > LIFT_MAXNODES)
+    return;
+
+  if (A->len == 0 || B->len == 0)
+    {
+      lpoly R[4];
+
+      for (i = 0; i < 4; i++)
+        R[i] = Q[i];
+
+      lift_finish (ctx, R, nsteps, nmul, cmax);
+      return;
+    }
+
+  if (nsteps + 3 > LIFT_MAXSTEPS)
+    return;
+
+  q = ctx->node[nsteps].q;
+  qmax = ctx->node[nsteps].qmax;
+  ch = ctx->node[nsteps].ch;
+
+  if (A->len > B->len || (A->len == B->len && A->len > 1))
+    {
+      for (t = 0; t <= A->len - B->len + 1 && nopt < LIFT_MAXOPT; t++)
+        {
+          qmax[nopt] = lpoly_divide (A, B, t, &q[nopt], ctx->M);
+          ch[nopt] = 1;
+
+          if (qmax[nopt] >= 0.0 && qmax[nopt] <= LIFT_MAXCOEFF)
+            nopt++;
+        }
+    }
+
+  if (B->len >= A->len)
+    {
+      for (t = 0; t <= B->len - A->len + 1 && nopt < LIFT_MAXOPT; t++)
+        {
+          qmax[nopt] = lpoly_divide (B, A, t, &q[nopt], ctx->M);
+          ch[nopt] = 0;
+
+          if (qmax[nopt] >= 0.0 && qmax[nopt] <= LIFT_MAXCOEFF)
+            nopt++;
+        }
+    }
+
+  /* try the options in order of increasing quotient size */
+
+  while (nopt > 0)
+    {
+      lpoly *R = ctx->node[nsteps].R;
+      size_t k = 0;
+
+      for (i = 1; i < nopt; i++)
+        {
+          if (q[i].len < q[k].len
+              || (q[i].len == q[k].len && qmax[i] < qmax[k]))
+            k = i;
+        }
+
+      if (nmul + q[k].len < ctx->best_nmul)
+        {
+          int status;
+
+          for (i = 0; i < 4; i++)
+            R[i] = Q[i];
+
+          if (ch[k] == 1)
+            {
+              /* A := A - B q, C := C - D q; forward step is o += q e */
+              status = lpoly_submul (&R[0], &R[1], &q[k]);
+              status |= lpoly_submul (&R[2], &R[3], &q[k]);
+            }
+          else
+            {
+              /* B := B - A q, D := D - C q; forward step is e += q o */
+              status = lpoly_submul (&R[1], &R[0], &q[k]);
+              status |= lpoly_submul (&R[3], &R[2], &q[k]);
+            }
+
+          if (status == GSL_SUCCESS)
+            {
+              for (i = 0; i < 4; i++)
+                lpoly_trim (&R[i], ctx->tol);
+
+              ctx->steps[nsteps] = q[k];
+              ctx->channel[nsteps] = ch[k];
+
+              lift_search_node (ctx, R, nsteps + 1, nmul + q[k].len,
+                                GSL_MAX_DBL (cmax, qmax[k]));
+            }
+        }
+
+      /* remove option k */
+      nopt--;
+      q[k] = q[nopt];
+      qmax[k] = qmax[nopt];
+      ch[k] = ch[nopt];
+    }
+}
+
+/* take the factorization from the table of built-in wavelets, if it
+ * has an entry which reproduces the polyphase matrix */
+static int
+lift_table_lookup (lift_search * ctx, const gsl_wavelet * w)
+{
+  const size_t nentries = sizeof (lift_table) / sizeof (lift_table[0]);
+  size_t n, i, j;
+
+  for (n = 0; n < nentries; n++)
+    {
+      const lift_table_entry *e = &lift_table[n];
+      lpoly A, C, D;
+      size_t ncoeff = 0;
+
+      if (e->nc != w->nc || strcmp (e->name, w->type->name) != 0)
+        continue;
+
+      for (i = 0; i < e->nsteps; i++)
+        {
+          ctx->steps[i].lo = e->lag[i];
+          ctx->steps[i].len = e->len[i];
+          ctx->channel[i] = e->channel[i];
+
+          for (j = 0; j < e->len[i]; j++)
+            ctx->steps[i].c[j] = e->coeff[ncoeff++];
+        }
+
+      A.lo = e->shift[0];
+      A.len = 1;
+      A.c[0] = e->scale[0];
+      C.lo = 0;
+      C.len = 0;
+      D.lo = e->shift[1];
+      D.len = 1;
+      D.c[0] = e->scale[1];
+
+      if (lift_check (ctx, e->nsteps, &A, &C, &D) > ctx->tol)
+        continue;
+
+      for (i = 0; i < e->nsteps; i++)
+        {
+          ctx->best[i] = ctx->steps[i];
+          ctx->best_channel[i] = ctx->channel[i];
+        }
+
+      ctx->best_nsteps = e->nsteps;
+
+      for (i = 0; i < 2; i++)
+        {
+          ctx->best_scale[i] = e->scale[i];
+          ctx->best_shift[i] = e->shift[i];
+        }
+
+      return 1;
+    }
+
+  return 0;
+}
+
+gsl_wavelet_lifting *
+wavelet_lifting_alloc (const gsl_wavelet * w)
+{
+  lift_search *ctx;
+  lpoly Q[4];
+  size_t ncoeff = 0, i, j;
+  double pmax = 0.0;
+  gsl_wavelet_lifting *lift;
+
+  if (w->nc > LIFT_MAXLEN)
+    return NULL;
+
+  ctx = (lift_search *) malloc (sizeof (lift_search));
+
+  if (ctx == NULL)
+    return NULL;
+
+  lift_polyphase (w->h1, w->nc, w->offset, &ctx->P[0], &ctx->P[1]);
+  lift_polyphase (w->g1, w->nc, w->offset, &ctx->P[2], &ctx->P[3]);
+
+  for (i = 0; i < 4; i++)
+    for (j = 0; j < ctx->P[i].len; j++)
+      pmax = GSL_MAX_DBL (pmax, fabs (ctx->P[i].c[j]));
+
+  ctx->tol = 1024.0 * GSL_DBL_EPSILON * pmax;
+  ctx->nodes = 0;
+  ctx->best_nsteps = 0;
+  ctx->best_nmul = (size_t) -1;
+  ctx->best_growth = 0.0;
+
+  if (!lift_table_lookup (ctx, w))
+    {
+      ctx->node = (lift_node *) malloc (LIFT_MAXSTEPS * sizeof (lift_node));
+
+      if (ctx->node == NULL)
+        {
+          free (ctx);
+          return NULL;
+        }
+
+      for (i = 0; i < 4; i++)
+        {
+          Q[i] = ctx->P[i];
+          lpoly_trim (&Q[i], ctx->tol);
+        }
+
+      lift_search_node (ctx, Q, 0, 2, 0.0);
+
+      free (ctx->node);
+    }
+
+  if (ctx->best_nsteps == 0)
+    {
+      free (ctx);
+      return NULL;
+    }
+
+  for (i = 0; i < ctx->best_nsteps; i++)
+    ncoeff += ctx->best[i].len;
+
+  lift = (gsl_wavelet_lifting *) malloc (sizeof (gsl_wavelet_lifting));
+
+  if (lift == NULL)
+    {
+      free (ctx);
+      return NULL;
+    }
+
+  lift->channel = (int *) malloc (ctx->best_nsteps * sizeof (int));
+  lift->lag = (int *) malloc (ctx->best_nsteps * sizeof (int));
+  lift->len = (size_t *) malloc (ctx->best_nsteps * sizeof (size_t));
+  lift->coeff = (double *) malloc (ncoeff * sizeof (double));
+
+  if (lift->channel == NULL || lift->lag == NULL || lift->len == NULL
+      || lift->coeff == NULL)
+    {
+      free (ctx);
+      wavelet_lifting_free (lift);
+      return NULL;
+    }
+
+  lift->nsteps = ctx->best_nsteps;
+
+  for (i = 0, ncoeff = 0; i < lift->nsteps; i++)
+    {
+      lift->channel[i] = ctx->best_channel[i];
+      lift->lag[i] = ctx->best[i].lo;
+      lift->len[i] = ctx->best[i].len;
+
+      for (j = 0; j < ctx->best[i].len; j++)
+        lift->coeff[ncoeff++] = ctx->best[i].c[j];
+    }
+
+  for (i = 0; i < 2; i++)
+    {
+      lift->scale[i] = ctx->best_scale[i];
+      lift->shift[i] = ctx->best_shift[i];
+    }
+
+  free (ctx);
+
+  return lift;
+}
+
+void
+wavelet_lifting_free (gsl_wavelet_lifting * lift)
+{
+  RETURN_IF_NULL (lift);
+  free (lift->channel);
+  free (lift->lag);
+  free (lift->len);
+  free (lift->coeff);
+  free (lift);
+}
+
+/* index into a channel of parity r of a signal of length n for the
+ * sample j of that channel, using periodic or whole-sample symmetric
+ * extension of the signal */
+static size_t
+lift_index (long j, const int r, const size_t n, const size_t nr,
+            const int periodic)
+{
+  if (periodic)
+    {
+      j %= (long) nr;
+
+      if (j < 0)
+        j += (long) nr;
+
+      return (size_t) j;
+    }
+  else
+    {
+      const long p = 2 * ((long) n - 1);
+      long t = (2 * j + r) % p;
+
+      if (t < 0)
+        t += p;
+
+      if (t > (long) n - 1)
+        t = p - t;
+
+      return (size_t) ((t - r) / 2);
+    }
+}
+
+/* u := u + sign * (q v), where u and v are the channels of parity ru
+ * and 1 - ru of a signal of length n */
+static void
+lift_apply (double *u, const size_t nu, const int ru,
+            const double *v, const size_t nv,
+            const size_t n, const int periodic,
+            const int lag, const size_t len, const double *q,
+            const double sign)
+{
+  const int rv = 1 - ru;
+  long i, ilo, ihi;
+  size_t k;
+
+  /* range of i for which all v indices lie inside the channel */
+  ilo = GSL_MAX (0L, -(long) lag);
+  ihi = GSL_MIN ((long) nu, (long) nv - (long) lag - (long) len + 1);
+
+  if (ihi < ilo)
+    ihi = ilo = 0;
+
+  for (i = 0; i < ilo; i++)
+    {
+      double s = 0.0;
+      for (k = 0; k < len; k++)
+        s += q[k] * v[lift_index (i + lag + (long) k, rv, n, nv, periodic)];
+      u[i] += sign * s;
+    }
+
+  /* the interior, with the common short steps unrolled */
+
+  if (len == 1)
+    {
+      const double q0 = sign * q[0];
+      const double *vi = v + lag;
+
+      for (i = ilo; i < ihi; i++)
+        u[i] += q0 * vi[i];
+    }
+  else if (len == 2)
+    {
+      const double q0 = sign * q[0], q1 = sign * q[1];
+      const double *vi = v + lag;
+
+      for (i = ilo; i < ihi; i++)
+        u[i] += q0 * vi[i] + q1 * vi[i + 1];
+    }
+  else
+    {
+      for (i = ilo; i < ihi; i++)
+        {
+          const double *vi = v + i + lag;
+          double s = 0.0;
+          for (k = 0; k < len; k++)
+            s += q[k] * vi[k];
+          u[i] += sign * s;
+        }
+    }
+
+  for (i = GSL_MAX (ihi, ilo); i < (long) nu; i++)
+    {
+      double s = 0.0;
+      for (k = 0; k < len; k++)
+        s += q[k] * v[lift_index (i + lag + (long) k, rv, n, nv, periodic)];
+      u[i] += sign * s;
+    }
+}
+
+/* one level of the transform on a[0..n-1].  For periodic boundaries n
+ * must be even and the result agrees with the filter bank; otherwise
+ * whole-sample symmetric extension is used and n may be odd, with the
+ * (n+1)/2 smooth coefficients stored before the n/2 detail
+ * coefficients. */
+void
+wavelet_lifting_step (const gsl_wavelet_lifting * lift, double *a,
+                      size_t stride, size_t n, int periodic,
+                      gsl_wavelet_direction dir, double *scratch)
+{
+  const size_t ne = (n + 1) / 2;
+  const size_t no = n / 2;
+  double *c[2];
+  size_t nch[2];
+  size_t i, s, off;
+
+  c[0] = scratch;
+  c[1] = scratch + ne;
+  nch[0] = ne;
+  nch[1] = no;
+
+  if (dir == gsl_wavelet_forward)
+    {
+      for (i = 0; i < ne; i++)
+        c[0][i] = a[stride * (2 * i)];
+
+      for (i = 0; i < no; i++)
+        c[1][i] = a[stride * (2 * i + 1)];
+
+      for (s = 0, off = 0; s < lift->nsteps; s++)
+        {
+          const int ch = lift->channel[s];
+
+          lift_apply (c[ch], nch[ch], ch, c[1 - ch], nch[1 - ch], n,
+                      periodic, lift->lag[s], lift->len[s],
+                      lift->coeff + off, 1.0);
+          off += lift->len[s];
+        }
+
+      for (s = 0; s < 2; s++)
+        {
+          double *as = a + stride * (s ? ne : 0);
+          const double k = lift->scale[s];
+          const size_t sh =
+            periodic ? lift_index (lift->shift[s], 0, n, nch[s], 1) : 0;
+
+          for (i = 0; i < nch[s]; i++)
+            {
+              size_t j = i + sh;
+
+              if (j >= nch[s])
+                j -= nch[s];
+
+              as[stride * i] = k * c[s][j];
+            }
+        }
+    }
+  else
+    {
+      for (s = 0; s < 2; s++)
+        {
+          const double *as = a + stride * (s ? ne : 0);
+          const double kinv = 1.0 / lift->scale[s];
+          const size_t sh =
+            periodic ? lift_index (lift->shift[s], 0, n, nch[s], 1) : 0;
+
+          for (i = 0; i < nch[s]; i++)
+            {
+              size_t j = i + sh;
+
+              if (j >= nch[s])
+                j -= nch[s];
+
+              c[s][j] = kinv * as[stride * i];
+            }
+        }
+
+      for (off = 0, s = 0; s < lift->nsteps; s++)
+        off += lift->len[s];
+
+      for (s = lift->nsteps; s-- > 0;)
+        {
+          const int ch = lift->channel[s];
+
+          off -= lift->len[s];
+          lift_apply (c[ch], nch[ch], ch, c[1 - ch], nch[1 - ch], n,
+                      periodic, lift->lag[s], lift->len[s],
+                      lift->coeff + off, -1.0);
+        }
+
+      for (i = 0; i < ne; i++)
+        a[stride * (2 * i)] = c[0][i];
+
+      for (i = 0; i < no; i++)
+        a[stride * (2 * i + 1)] = c[1][i];
+    }
+}
@@ -0,0 +1,30 @@
+/* wavelet/lifting.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_WAVELET_LIFTING_H__
+#define __GSL_WAVELET_LIFTING_H__
+
+#include <gsl/gsl_wavelet.h>
+
+gsl_wavelet_lifting *wavelet_lifting_alloc (const gsl_wavelet * w);
+void wavelet_lifting_free (gsl_wavelet_lifting * lift);
+
+void wavelet_lifting_step (const gsl_wavelet_lifting * lift, double *a,
+                           size_t stride, size_t n, int periodic,
+                           gsl_wavelet_direction dir, double *scratch);
+
+#endif /* __GSL_WAVELET_LIFTING_H__ */
@@ -0,0 +1,441 @@
+/* wavelet/lifting_table.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Lifting factorizations of the built-in wavelets, as found by
+ * lift_search_node() in lifting.c.  Each entry is identified by the
+ * name of the wavelet type and the number of filter coefficients, and
+ * is checked against the filters before it is used. */
+
+#define LIFT_TABLE_MAXSTEPS 12
+#define LIFT_TABLE_MAXCOEFF 24
+
+typedef struct
+{
+  const char *name;             /* name of the wavelet type */
+  size_t nc;                    /* number of filter coefficients */
+  size_t nsteps;                /* number of lifting steps */
+  int channel[LIFT_TABLE_MAXSTEPS];
+  int lag[LIFT_TABLE_MAXSTEPS];
+  size_t len[LIFT_TABLE_MAXSTEPS];
+  double coeff[LIFT_TABLE_MAXCOEFF];
+  double scale[2];
+  int shift[2];
+}
+lift_table_entry;
+
+static const lift_table_entry lift_table[] = {
+  {"daubechies", 4, 3,
+   {1, 0, 1},
+   {0, 0, -1},
+   {1, 2, 1},
+   {
+    -1.73205080756887742e+00,  4.33012701892219354e-01, -6.69872981077806740e-02,
+     1.00000000000000000e+00},
+   { 1.93185165257813662e+00, -5.17638090205041479e-01}, {0, 1}},
+  {"daubechies", 6, 4,
+   {0, 1, 0, 1},
+   {0, 0, -1, 0},
+   {1, 2, 2, 1},
+   {
+    -4.12286595051805538e-01,  3.52387657674855526e-01, -1.56513627963083479e+00,
+     4.92151844887738943e-01,  2.84590895797168890e-02, -3.89620389971936931e-01},
+   { 1.91820294623953491e+00, -5.21321272058522411e-01}, {1, 1}},
+  {"daubechies", 8, 5,
+   {1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -1},
+   {1, 2, 2, 2, 1},
+   {
+     3.22275888000281119e-01,  1.11712360511621722e+00, -2.91953126003475338e-01,
+    -1.13551496608092939e-01, -5.40028283419713873e-01,  5.54794696804338350e-01,
+    -9.84234944950844182e-02,  2.14536265544092893e-02},
+   { 6.82921812035414688e-01, -1.46429647197758928e+00}, {1, 2}},
+  {"daubechies", 10, 6,
+   {0, 1, 0, 1, 0, 1},
+   {0, 0, -1, -1, 1, -2},
+   {1, 2, 2, 2, 2, 1},
+   {
+    -2.65145142811588297e-01,  2.47729291360329701e-01, -8.78163028459430728e-01,
+     5.34124646037347883e-01,  2.41421304882298210e-01,  1.98533627273996788e-01,
+    -6.33278411420902465e-01, -8.77884834515479384e-02,  1.37333394089365207e-02,
+    -3.15951370046090654e-02},
+   { 1.23144182875804553e+00, -8.12056222751940560e-01}, {1, 3}},
+  {"daubechies", 12, 7,
+   {1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -2, 2, -3},
+   {1, 2, 2, 2, 2, 2, 1},
+   {
+     2.25506178563788823e-01,  7.27342074097234170e-01, -2.14593450003008196e-01,
+    -3.91113547975628750e-01, -5.07005568565545128e-01,  6.59571413634679860e-01,
+    -2.71846259344538432e-01, -5.90863715104386553e-02,  2.05126796592607297e-01,
+     8.25247864775544293e-02, -1.13865114638919632e-02,  8.19173561613182298e-03},
+   { 9.20950275557957498e-01, -1.08583495389493279e+00}, {1, 4}},
+  {"daubechies", 14, 8,
+   {0, 1, 0, 1, 0, 1, 0, 1},
+   {0, 0, -1, -1, 1, -3, 3, -4},
+   {1, 2, 2, 2, 2, 2, 2, 1},
+   {
+    -1.96328712589519977e-01,  1.89042092071992157e-01, -6.22608114800630830e-01,
+     4.73542027592842918e-01,  5.49384087180210146e-01,  3.16034684854986259e-01,
+    -6.55465383645848720e-01, -3.66062902386695921e-01,  1.43858200306222789e-01,
+     3.58666387501328579e-02, -1.37664284632184442e-01, -3.81852770525199156e-02,
+     4.68475580607821424e-03, -4.40623781685006103e-03},
+   { 9.84788577582964564e-01, -1.01544638388716013e+00}, {1, 5}},
+  {"daubechies", 16, 9,
+   {1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -2, 2, -4, 4, -5},
+   {1, 2, 2, 2, 2, 2, 2, 2, 1},
+   {
+     1.73923883865855028e-01,  5.45240042147073112e-01, -1.68817243718131338e-01,
+    -7.09599782718359107e-01, -4.39913316385216191e-01,  6.35367758893829460e-01,
+    -3.37998430891020940e-01, -2.64173876501386906e-01,  5.57808749785738356e-01,
+     1.87494770015935536e-01, -6.84112899172488464e-02, -2.37060145892253882e-02,
+     1.00713575182088150e-01,  1.62081718691885479e-02, -1.78476477555390505e-03,
+     2.61138182758750880e-03},
+   { 1.09982057961269386e+00, -9.09239214592758027e-01}, {1, 6}},
+  {"daubechies", 18, 10,
+   {0, 1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {0, 0, -1, -1, 1, -3, 3, -5, 5, -6},
+   {1, 2, 2, 2, 2, 2, 2, 2, 2, 3},
+   {
+    -1.56162971588751254e-01,  1.52445307138113162e-01, -4.85553245804086375e-01,
+     4.08468647629512738e-01,  8.68790379793110024e-01,  3.45277623772081932e-01,
+    -6.07888404518982073e-01, -7.68336292378104302e-01,  4.10609206773834057e-01,
+     1.02522638090188078e-01, -2.27669703809380591e-01, -1.99792534572404090e-01,
+     6.70670779358677749e-02,  7.48298857462067687e-03, -3.50522478473644164e-02,
+    -1.43497429170383502e-02,  1.43087874496805470e-03, -7.46242478774676197e-04,
+     9.63375683239779340e-13,  2.69007690390060523e-13},
+   { 8.49804776291423036e-01, -1.17674085613406665e+00}, {1, 7}},
+  {"daubechies", 20, 11,
+   {1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, -1, 0, 0, -2, 2, -4, 4, -5},
+   {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4},
+   {
+     1.41728724739417611e-01,  4.38000642485383507e-01, -1.38937875273882488e-01,
+     7.04898963563006520e-01, -3.79928778742216311e-01,  9.71782554888438010e-01,
+    -5.77808436392856173e-01, -2.02815854158693881e-01, -6.79471927843166901e-01,
+     7.27841745082745573e-01, -3.77292694719338906e-01, -4.97345062903643623e-02,
+     1.17856866279554828e-01,  1.65253734316051559e-01, -5.09493191354569164e-02,
+    -3.00773273576962442e-03,  1.54485272481461808e-02,  9.92703471170837924e-03,
+    -9.03526434814706141e-04,  2.73762163824952938e-04,  3.89339690394790545e-12,
+     1.48015040017767878e-12,  4.40071288978196946e-13},
+   { 7.41921768066705178e-01, -1.34785100402945157e+00}, {2, 7}},
+  {"daubechies-centered", 4, 3,
+   {1, 0, 1},
+   {0, 0, -1},
+   {1, 2, 1},
+   {
+    -1.73205080756887742e+00,  4.33012701892219354e-01, -6.69872981077806740e-02,
+     1.00000000000000000e+00},
+   { 1.93185165257813662e+00, -5.17638090205041479e-01}, {-1, 0}},
+  {"daubechies-centered", 6, 4,
+   {0, 1, 0, 1},
+   {-1, 0, 0, -1},
+   {1, 2, 2, 1},
+   {
+     4.12286595051805593e-01, -4.66756946794238015e-01, -3.52387657674855415e-01,
+     4.92151844887739109e-01, -9.54294390097518846e-02,  1.16193091936362292e-01},
+   { 1.04752372912588920e+00,  9.54632312562937679e-01}, {-1, 0}},
+  {"daubechies-centered", 8, 5,
+   {1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -1},
+   {1, 2, 2, 2, 1},
+   {
+     3.22275888000281119e-01,  1.11712360511621722e+00, -2.91953126003475338e-01,
+    -1.13551496608092939e-01, -5.40028283419713873e-01,  5.54794696804338350e-01,
+    -9.84234944950844182e-02,  2.14536265544092893e-02},
+   { 6.82921812035414688e-01, -1.46429647197758928e+00}, {-1, 0}},
+  {"daubechies-centered", 10, 6,
+   {0, 1, 0, 1, 0, 1},
+   {-1, 0, 0, -2, 2, -3},
+   {1, 2, 2, 2, 2, 1},
+   {
+     2.65145142811588297e-01, -9.94059134324042137e-01, -2.47729291360329701e-01,
+     5.34124646037347661e-01, -2.13274298187734079e-01, -2.24735224857310095e-01,
+     7.16855719316186191e-01,  7.75533344342685393e-02, -1.21321866172617431e-02,
+     3.57649246458821360e-02},
+   { 1.31018443901905157e+00,  7.63251318072981522e-01}, {-2, 1}},
+  {"daubechies-centered", 12, 7,
+   {1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -2, 2, -3},
+   {1, 2, 2, 2, 2, 2, 1},
+   {
+     2.25506178563788823e-01,  7.27342074097234170e-01, -2.14593450003008196e-01,
+    -3.91113547975628750e-01, -5.07005568565545128e-01,  6.59571413634679860e-01,
+    -2.71846259344538432e-01, -5.90863715104386553e-02,  2.05126796592607297e-01,
+     8.25247864775544293e-02, -1.13865114638919632e-02,  8.19173561613182298e-03},
+   { 9.20950275557957498e-01, -1.08583495389493279e+00}, {-2, 1}},
+  {"daubechies-centered", 14, 8,
+   {0, 1, 0, 1, 0, 1, 0, 1},
+   {-1, 0, -1, 0, 0, -2, 2, -3},
+   {1, 2, 2, 2, 2, 2, 2, 1},
+   {
+     1.96328712589520005e-01,  6.22608114800630830e-01, -1.89042092071992102e-01,
+     9.76249493097928855e-01, -4.73542027592842973e-01, -1.77848416909678064e-01,
+    -6.55465383645848609e-01,  6.50489759780289223e-01, -2.55634443013749602e-01,
+    -2.01839393815379485e-02,  7.74705317489830930e-02,  6.78548182159096069e-02,
+    -8.32475964938394000e-03,  2.47960890942687225e-03},
+   { 7.38755334553463761e-01,  1.35362812723977743e+00}, {-2, 1}},
+  {"daubechies-centered", 16, 9,
+   {1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, 0, -2, 2, -4, 4, -5},
+   {1, 2, 2, 2, 2, 2, 2, 2, 1},
+   {
+     1.73923883865855028e-01,  5.45240042147073112e-01, -1.68817243718131338e-01,
+    -7.09599782718359107e-01, -4.39913316385216191e-01,  6.35367758893829460e-01,
+    -3.37998430891020940e-01, -2.64173876501386906e-01,  5.57808749785738356e-01,
+     1.87494770015935536e-01, -6.84112899172488464e-02, -2.37060145892253882e-02,
+     1.00713575182088150e-01,  1.62081718691885479e-02, -1.78476477555390505e-03,
+     2.61138182758750880e-03},
+   { 1.09982057961269386e+00, -9.09239214592758027e-01}, {-3, 2}},
+  {"daubechies-centered", 18, 10,
+   {0, 1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {-1, 0, -1, 0, 0, -2, 2, -4, 4, -5},
+   {1, 2, 2, 2, 2, 2, 2, 2, 2, 3},
+   {
+     1.56162971588751226e-01,  4.85553245804086431e-01, -1.52445307138113190e-01,
+     7.76248401282658151e-01, -4.08468647629512627e-01, -3.86440574171025120e-01,
+    -6.07888404518982628e-01,  6.86494501410083169e-01, -3.66871857381789457e-01,
+    -1.14745075850218869e-01,  2.54811794926850133e-01,  1.78510995468170119e-01,
+    -5.99232142036537629e-02, -8.37508776220212935e-03,  3.92310704531072599e-02,
+     1.28212342784234535e-02, -1.27846413133081383e-03,  8.35207242270809887e-04,
+    -7.18660455903672392e-13, -1.95034346357981485e-13},
+   { 8.99034400800663991e-01,  1.11230448924914582e+00}, {-3, 2}},
+  {"daubechies-centered", 20, 11,
+   {1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1},
+   {0, -1, 0, -1, 0, 0, -2, 2, -4, 4, -5},
+   {1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4},
+   {
+     1.41728724739417611e-01,  4.38000642485383507e-01, -1.38937875273882488e-01,
+     7.04898963563006520e-01, -3.79928778742216311e-01,  9.71782554888438010e-01,
+    -5.77808436392856173e-01, -2.02815854158693881e-01, -6.79471927843166901e-01,
+     7.27841745082745573e-01, -3.77292694719338906e-01, -4.97345062903643623e-02,
+     1.17856866279554828e-01,  1.65253734316051559e-01, -5.09493191354569164e-02,
+    -3.00773273576962442e-03,  1.54485272481461808e-02,  9.92703471170837924e-03,
+    -9.03526434814706141e-04,  2.73762163824952938e-04,  3.89339690394790545e-12,
+     1.48015040017767878e-12,  4.40071288978196946e-13},
+   { 7.41921768066705178e-01, -1.34785100402945157e+00}, {-3, 2}},
+  {"haar", 2, 2,
+   {0, 1},
+   {0, 0},
+   {1, 1},
+   {
+     1.00000000000000000e+00, -5.00000000000000000e-01},
+   { 7.07106781186547573e-01, -1.41421356237309515e+00}, {0, 0}},
+  {"haar-centered", 2, 2,
+   {0, 1},
+   {-1, 1},
+   {1, 1},
+   {
+     1.00000000000000000e+00, -5.00000000000000000e-01},
+   { 7.07106781186547573e-01,  1.41421356237309515e+00}, {0, -1}},
+  {"bspline", 6, 3,
+   {1, 0, 1},
+   {0, -1, -1},
+   {1, 3, 0},
+   {
+    -1.00000000000000000e+00,  6.25000000000000000e-02,  5.00000000000000000e-01,
+    -6.25000000000000000e-02},
+   { 1.41421356237309515e+00, -7.07106781186547573e-01}, {1, 1}},
+  {"bspline", 10, 3,
+   {1, 0, 1},
+   {0, -2, -2},
+   {1, 5, 0},
+   {
+    -1.00000000000000000e+00, -1.17187499999999983e-02,  8.59374999999999861e-02,
+     5.00000000000000000e-01, -8.59374999999999861e-02,  1.17187499999999983e-02},
+   { 1.41421356237309515e+00, -7.07106781186547573e-01}, {2, 2}},
+  {"bspline", 6, 3,
+   {1, 0, 1},
+   {0, -1, -1},
+   {2, 2, 0},
+   {
+    -5.00000000000000000e-01, -5.00000000000000000e-01,  2.50000000000000000e-01,
+     2.50000000000000000e-01},
+   { 1.41421356237309515e+00,  7.07106781186547573e-01}, {1, 1}},
+  {"bspline", 10, 3,
+   {1, 0, 1},
+   {0, -2, -2},
+   {2, 4, 0},
+   {
+    -5.00000000000000000e-01, -4.99999999999999778e-01, -4.68750000000000000e-02,
+     2.96875000000000056e-01,  2.96875000000000056e-01, -4.68750000000000000e-02},
+   { 1.41421356237309492e+00,  7.07106781186547573e-01}, {2, 2}},
+  {"bspline", 14, 3,
+   {1, 0, 1},
+   {0, -3, -3},
+   {2, 6, 0},
+   {
+    -5.00000000000000000e-01, -4.99999999999999889e-01,  9.76562500000000000e-03,
+    -7.61718749999999861e-02,  3.16406250000000000e-01,  3.16406250000000000e-01,
+    -7.61718749999999861e-02,  9.76562500000000000e-03},
+   { 1.41421356237309515e+00,  7.07106781186547573e-01}, {3, 3}},
+  {"bspline", 18, 3,
+   {1, 0, 1},
+   {0, -4, -4},
+   {2, 8, 0},
+   {
+    -5.00000000000000000e-01, -5.00000000000000000e-01, -2.13623046875000000e-03,
+     2.04467773437500000e-02, -9.53979492187499861e-02,  3.27087402343750000e-01,
+     3.27087402343750000e-01, -9.53979492187499861e-02,  2.04467773437500000e-02,
+    -2.13623046875000000e-03},
+   { 1.41421356237309515e+00,  7.07106781186547573e-01}, {4, 4}},
+  {"bspline", 4, 3,
+   {1, 0, 1},
+   {0, -1, 1},
+   {1, 2, 1},
+   {
+    -3.33333333333333370e-01,  1.12500000000000000e+00, -3.75000000000000056e-01,
+    -4.44444444444444420e-01},
+   { 9.42809041582063245e-01,  1.06066017177982119e+00}, {1, 0}},
+  {"bspline", 8, 4,
+   {0, 1, 0, 1},
+   {0, 0, -2, -1},
+   {1, 2, 3, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12500000000000000e+00,
+    -8.33333333333333287e-02,  4.44444444444444475e-01,  8.33333333333333426e-02},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {2, 1}},
+  {"bspline", 12, 4,
+   {0, 1, 0, 1},
+   {0, 0, -3, -2},
+   {1, 2, 5, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12499999999999978e+00,
+     1.73611111111111154e-02, -1.18055555555555580e-01,  4.44444444444444586e-01,
+     1.18055555555555580e-01, -1.73611111111111154e-02},
+   { 2.12132034355964194e+00,  4.71404520791031623e-01}, {3, 2}},
+  {"bspline", 16, 4,
+   {0, 1, 0, 1},
+   {0, 0, -4, -3},
+   {1, 2, 7, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12499999999999978e+00,
+    -3.79774305555555594e-03,  3.25520833333333356e-02, -1.37044270833333343e-01,
+     4.44444444444444475e-01,  1.37044270833333343e-01, -3.25520833333333287e-02,
+     3.79774305555555594e-03},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {4, 3}},
+  {"bspline", 20, 4,
+   {0, 1, 0, 1},
+   {0, 0, -5, -4},
+   {1, 2, 9, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12500000000000000e+00,
+     8.54492187500000000e-04, -8.92469618055555768e-03,  4.45149739583333356e-02,
+    -1.49007161458333343e-01,  4.44444444444444475e-01,  1.49007161458333370e-01,
+    -4.45149739583333356e-02,  8.92469618055555768e-03, -8.54492187500000000e-04},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {5, 4}},
+  {"bspline-centered", 6, 3,
+   {1, 0, 1},
+   {1, -2, 1},
+   {1, 3, 0},
+   {
+    -1.00000000000000000e+00, -6.25000000000000000e-02,  5.00000000000000000e-01,
+     6.25000000000000000e-02},
+   { 1.41421356237309515e+00,  7.07106781186547573e-01}, {0, -1}},
+  {"bspline-centered", 10, 3,
+   {1, 0, 1},
+   {1, -3, 1},
+   {1, 5, 0},
+   {
+    -1.00000000000000000e+00,  1.17187499999999983e-02, -8.59374999999999861e-02,
+     5.00000000000000000e-01,  8.59374999999999861e-02, -1.17187499999999983e-02},
+   { 1.41421356237309515e+00,  7.07106781186547573e-01}, {0, -1}},
+  {"bspline-centered", 6, 5,
+   {0, 1, 1, 0, 1},
+   {-1, 0, 0, 0, 0},
+   {2, 2, 1, 1, 1},
+   {
+    -5.00000000000000000e-01, -5.00000000000000000e-01,  2.50000000000000000e-01,
+     2.50000000000000000e-01, -1.00000000000000000e+00,  1.00000000000000000e+00,
+    -1.00000000000000000e+00},
+   { 1.41421356237309515e+00, -7.07106781186547573e-01}, {-1, 0}},
+  {"bspline-centered", 10, 5,
+   {0, 1, 1, 0, 1},
+   {-1, -1, 0, 0, 0},
+   {2, 4, 1, 1, 1},
+   {
+    -5.00000000000000000e-01, -4.99999999999999778e-01, -4.68750000000000000e-02,
+     2.96875000000000056e-01,  2.96875000000000056e-01, -4.68750000000000000e-02,
+    -1.00000000000000000e+00,  1.00000000000000000e+00, -1.00000000000000000e+00},
+   { 1.41421356237309492e+00, -7.07106781186547573e-01}, {-1, 0}},
+  {"bspline-centered", 14, 5,
+   {0, 1, 1, 0, 1},
+   {-1, -2, 0, 0, 0},
+   {2, 6, 1, 1, 1},
+   {
+    -5.00000000000000000e-01, -4.99999999999999889e-01,  9.76562500000000000e-03,
+    -7.61718749999999861e-02,  3.16406250000000000e-01,  3.16406250000000000e-01,
+    -7.61718749999999861e-02,  9.76562500000000000e-03, -1.00000000000000000e+00,
+     1.00000000000000000e+00, -1.00000000000000000e+00},
+   { 1.41421356237309515e+00, -7.07106781186547573e-01}, {-1, 0}},
+  {"bspline-centered", 18, 5,
+   {0, 1, 1, 0, 1},
+   {-1, -3, 0, 0, 0},
+   {2, 8, 1, 1, 1},
+   {
+    -5.00000000000000000e-01, -5.00000000000000000e-01, -2.13623046875000000e-03,
+     2.04467773437500000e-02, -9.53979492187499861e-02,  3.27087402343750000e-01,
+     3.27087402343750000e-01, -9.53979492187499861e-02,  2.04467773437500000e-02,
+    -2.13623046875000000e-03, -1.00000000000000000e+00,  1.00000000000000000e+00,
+    -1.00000000000000000e+00},
+   { 1.41421356237309515e+00, -7.07106781186547573e-01}, {-1, 0}},
+  {"bspline-centered", 4, 3,
+   {1, 0, 1},
+   {0, -1, 1},
+   {1, 2, 1},
+   {
+    -3.33333333333333370e-01,  1.12500000000000000e+00, -3.75000000000000056e-01,
+    -4.44444444444444420e-01},
+   { 9.42809041582063245e-01,  1.06066017177982119e+00}, {0, -1}},
+  {"bspline-centered", 8, 4,
+   {0, 1, 0, 1},
+   {0, 0, -2, 1},
+   {1, 2, 3, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12500000000000000e+00,
+    -8.33333333333333287e-02,  4.44444444444444475e-01,  8.33333333333333426e-02},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {0, -1}},
+  {"bspline-centered", 12, 4,
+   {0, 1, 0, 1},
+   {0, 0, -3, 1},
+   {1, 2, 5, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12499999999999978e+00,
+     1.73611111111111154e-02, -1.18055555555555580e-01,  4.44444444444444586e-01,
+     1.18055555555555580e-01, -1.73611111111111154e-02},
+   { 2.12132034355964194e+00,  4.71404520791031623e-01}, {0, -1}},
+  {"bspline-centered", 16, 4,
+   {0, 1, 0, 1},
+   {0, 0, -4, 1},
+   {1, 2, 7, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12499999999999978e+00,
+    -3.79774305555555594e-03,  3.25520833333333356e-02, -1.37044270833333343e-01,
+     4.44444444444444475e-01,  1.37044270833333343e-01, -3.25520833333333287e-02,
+     3.79774305555555594e-03},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {0, -1}},
+  {"bspline-centered", 20, 4,
+   {0, 1, 0, 1},
+   {0, 0, -5, 1},
+   {1, 2, 9, 0},
+   {
+    -3.33333333333333315e-01, -3.75000000000000000e-01, -1.12500000000000000e+00,
+     8.54492187500000000e-04, -8.92469618055555768e-03,  4.45149739583333356e-02,
+    -1.49007161458333343e-01,  4.44444444444444475e-01,  1.49007161458333370e-01,
+    -4.45149739583333356e-02,  8.92469618055555768e-03, -8.54492187500000000e-04},
+   { 2.12132034355964239e+00,  4.71404520791031623e-01}, {0, -1}}
+};
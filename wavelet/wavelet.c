@@ -22,6 +22,13 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_wavelet.h>
 
+#include "lifting.h"
+
+/* maximum number of columns in a tile for 2d transforms, and the
+ * target size of a tile in doubles */
+#define TILE_NCOLS 8
+#define TILE_SIZE 131072
+
 gsl_wavelet *
 gsl_wavelet_alloc (const gsl_wavelet_type * T, size_t k)
 {
@@ -46,6 +53,10 @@ gsl_wavelet_alloc (const gsl_wavelet_type * T, size_t k)
       GSL_ERROR_VAL ("invalid wavelet member", GSL_EINVAL, 0);
     }
 
+  /* NULL if the filters cannot be factored accurately, in which case
+     the filter bank is used directly */
+  w->lifting = wavelet_lifting_alloc (w);
+
   return w;
 }
 
@@ -53,6 +64,7 @@ void
 gsl_wavelet_free (gsl_wavelet * w)
 {
   RETURN_IF_NULL (w);
+  wavelet_lifting_free (w->lifting);
   free (w);
 }
 
@@ -120,6 +132,22 @@ gsl_wavelet_workspace_alloc (size_t n)
       GSL_ERROR_VAL ("failed to allocate scratch space", GSL_ENOMEM, 0);
     }
 
+  work->ntile = TILE_SIZE / n;
+
+  if (work->ntile > TILE_NCOLS)
+    work->ntile = TILE_NCOLS;
+  else if (work->ntile < 1)
+    work->ntile = 1;
+
+  work->tile = (double *) malloc (n * work->ntile * sizeof (double));
+
+  if (work->tile == NULL)
+    {
+      free (work->scratch);
+      free (work);
+      GSL_ERROR_VAL ("failed to allocate tile space", GSL_ENOMEM, 0);
+    }
+
   return work;
 }
 
@@ -130,5 +158,7 @@ gsl_wavelet_workspace_free (gsl_wavelet_workspace * work)
   /* release scratch space */
   free (work->scratch);
   work->scratch = NULL;
+  free (work->tile);
+  work->tile = NULL;
   free (work);
 }